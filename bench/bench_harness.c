@@ -0,0 +1,311 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DEFAULT_REPS 31
+#define DEFAULT_WARMUP 3
+
+typedef struct {
+    const char *unit;
+    uint32_t type;
+    uint64_t config;
+} counter_t;
+
+typedef enum {
+    FORMAT_TABLE,
+    FORMAT_CSV,
+    FORMAT_JSON,
+} format_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static format_t s_format = FORMAT_TABLE;
+static unsigned s_reps = DEFAULT_REPS;
+static unsigned s_warmup = DEFAULT_WARMUP;
+static bool s_first_row = true;
+static bool s_counter_warned;
+
+#if defined(__linux__)
+static const counter_t s_counters[] = {
+    {"br-miss/op", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"insn/op", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"l1i-miss/op", PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_L1I | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+};
+#endif
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void usage(const char *prog);
+static int compare_double(const void *a, const void *b);
+#if defined(__linux__)
+static int open_counter(const counter_t *counter);
+#endif
+static void emit(const char *suite, const char *name, const char *unit,
+                 size_t n, double median, double p99, double min, double max);
+
+// *****************************************************************************
+// Public code
+
+int bench_init(int argc, char **argv) {
+    int i;
+    for (i = 1; i < argc && strncmp(argv[i], "--", 2) == 0; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--format") == 0 && val != NULL) {
+            if (strcmp(val, "table") == 0) {
+                s_format = FORMAT_TABLE;
+            } else if (strcmp(val, "csv") == 0) {
+                s_format = FORMAT_CSV;
+            } else if (strcmp(val, "json") == 0) {
+                s_format = FORMAT_JSON;
+            } else {
+                usage(argv[0]);
+            }
+        } else if (strcmp(arg, "--reps") == 0 && val != NULL) {
+            s_reps = (unsigned)strtoul(val, NULL, 10);
+        } else if (strcmp(arg, "--warmup") == 0 && val != NULL) {
+            s_warmup = (unsigned)strtoul(val, NULL, 10);
+        } else {
+            usage(argv[0]);
+        }
+        i++;
+    }
+    if (s_reps == 0) {
+        usage(argv[0]);
+    }
+
+    switch (s_format) {
+    case FORMAT_TABLE:
+        printf("%-16s %-28s %-8s %7s %12s %12s %12s %12s\n", "suite", "name",
+               "unit", "samples", "median", "p99", "min", "max");
+        break;
+    case FORMAT_CSV:
+        printf("suite,name,unit,samples,median,p99,min,max\n");
+        break;
+    case FORMAT_JSON:
+        printf("[");
+        break;
+    }
+    s_first_row = true;
+    return i;
+}
+
+void bench_finish(void) {
+    if (s_format == FORMAT_JSON) {
+        printf("\n]\n");
+    }
+    fflush(stdout);
+}
+
+unsigned bench_reps(void) { return s_reps; }
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t bench_ticks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return 0;
+#endif
+}
+
+void bench_run(const char *suite, const char *name, bench_body_fn body,
+               void *ctx, uint64_t n) {
+    double *ns = malloc(sizeof(double) * s_reps);
+    double *ticks = malloc(sizeof(double) * s_reps);
+    if (ns == NULL || ticks == NULL || n == 0) {
+        fprintf(stderr, "bench_run: bad arguments or out of memory\n");
+        exit(1);
+    }
+    for (unsigned i = 0; i < s_warmup; i++) {
+        body(ctx, n);
+    }
+    for (unsigned i = 0; i < s_reps; i++) {
+        uint64_t t0 = bench_now_ns();
+        uint64_t c0 = bench_ticks();
+        body(ctx, n);
+        uint64_t c1 = bench_ticks();
+        uint64_t t1 = bench_now_ns();
+        ns[i] = (double)(t1 - t0) / (double)n;
+        ticks[i] = (double)(c1 - c0) / (double)n;
+    }
+    bench_report_samples(suite, name, "ns/op", ns, s_reps);
+    if (bench_ticks() != 0) {
+        bench_report_samples(suite, name, "tsc/op", ticks, s_reps);
+    }
+    free(ns);
+    free(ticks);
+}
+
+void bench_run_counters(const char *suite, const char *name,
+                        bench_body_fn body, void *ctx, uint64_t n) {
+    bench_run(suite, name, body, ctx, n);
+#if defined(__linux__)
+    double *per_op = malloc(sizeof(double) * s_reps);
+    if (per_op == NULL) {
+        fprintf(stderr, "bench_run_counters: out of memory\n");
+        exit(1);
+    }
+    for (size_t c = 0; c < sizeof(s_counters) / sizeof(s_counters[0]); c++) {
+        int fd = open_counter(&s_counters[c]);
+        if (fd < 0) {
+            continue;
+        }
+        for (unsigned i = 0; i < s_reps; i++) {
+            uint64_t count = 0;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            body(ctx, n);
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+                count = 0;
+            }
+            per_op[i] = (double)count / (double)n;
+        }
+        close(fd);
+        bench_report_samples(suite, name, s_counters[c].unit, per_op, s_reps);
+    }
+    free(per_op);
+#else
+    if (!s_counter_warned) {
+        fprintf(stderr, "note: hardware counters need Linux; skipped\n");
+        s_counter_warned = true;
+    }
+#endif
+}
+
+void bench_report_samples(const char *suite, const char *name,
+                          const char *unit, double *samples, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    qsort(samples, n, sizeof(double), compare_double);
+    // Nearest-rank percentiles.
+    size_t p50 = (n - 1) / 2;
+    size_t p99 = (n * 99 + 99) / 100 - 1;
+    emit(suite, name, unit, n, samples[p50], samples[p99], samples[0],
+         samples[n - 1]);
+}
+
+void bench_report_value(const char *suite, const char *name, const char *unit,
+                        double value) {
+    emit(suite, name, unit, 1, value, value, value, value);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "usage: %s [--format table|csv|json] [--reps N] [--warmup N] "
+            "[args...]\n",
+            prog);
+    exit(2);
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+#if defined(__linux__)
+static int open_counter(const counter_t *counter) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = counter->type;
+    attr.config = counter->config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0 && !s_counter_warned) {
+        fprintf(stderr, "note: perf_event_open(%s) failed; counter rows "
+                        "skipped (no PMU, or see perf_event_paranoid)\n",
+                counter->unit);
+        s_counter_warned = true;
+    }
+    return fd;
+}
+#endif
+
+static void emit(const char *suite, const char *name, const char *unit,
+                 size_t n, double median, double p99, double min, double max) {
+    switch (s_format) {
+    case FORMAT_TABLE:
+        printf("%-16s %-28s %-8s %7zu %12.3f %12.3f %12.3f %12.3f\n", suite,
+               name, unit, n, median, p99, min, max);
+        break;
+    case FORMAT_CSV:
+        printf("%s,%s,%s,%zu,%.6g,%.6g,%.6g,%.6g\n", suite, name, unit, n,
+               median, p99, min, max);
+        break;
+    case FORMAT_JSON:
+        printf("%s\n  {\"suite\": \"%s\", \"name\": \"%s\", \"unit\": \"%s\", "
+               "\"samples\": %zu, \"median\": %.6g, \"p99\": %.6g, "
+               "\"min\": %.6g, \"max\": %.6g}",
+               s_first_row ? "" : ",", suite, name, unit, n, median, p99, min,
+               max);
+        break;
+    }
+    s_first_row = false;
+    fflush(stdout);
+}
+
+// *****************************************************************************
+// End of file
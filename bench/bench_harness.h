@@ -0,0 +1,136 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_harness.h
+ *
+ * @brief Shared benchmark harness: warmup, repetitions, median/p99 and
+ *        machine-readable output.
+ *
+ * Every benchmark executable accepts:
+ *
+ *     --format table|csv|json   output format (default table)
+ *     --reps N                  timed repetitions per bench_run (default 31)
+ *     --warmup N                untimed repetitions first (default 3)
+ *
+ * Suite and name strings are emitted verbatim, so keep commas and quotes
+ * out of them.
+ *
+ * Each result is a row of (suite, name, unit, samples, median, p99, min,
+ * max), so CSV/JSON from different releases can be diffed or plotted
+ * directly.  bench_run() times with both clock_gettime(CLOCK_MONOTONIC)
+ * and the CPU timestamp counter (rdtsc on x86-64, cntvct_el0 on aarch64)
+ * and reports a row for each.  bench_run_counters() additionally reads
+ * hardware event counters through perf_event_open(2) on Linux.
+ */
+
+#ifndef _BENCH_HARNESS_H_
+#define _BENCH_HARNESS_H_
+
+// *****************************************************************************
+// Includes
+
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief Code under test: perform `n` operations on `ctx`.
+ */
+typedef void (*bench_body_fn)(void *ctx, uint64_t n);
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Parse the options above and start the output (CSV header or JSON
+ *        array).  Exits with a usage message on a bad option.
+ *
+ * @return Index in `argv` of the first non-option argument (`argc` if
+ *         there is none), for benchmarks that take their own parameters.
+ */
+int bench_init(int argc, char **argv);
+
+/**
+ * @brief Finish the output (closes the JSON array).
+ */
+void bench_finish(void);
+
+/** Number of timed repetitions requested. */
+unsigned bench_reps(void);
+
+/** CLOCK_MONOTONIC in nanoseconds. */
+uint64_t bench_now_ns(void);
+
+/** The CPU timestamp counter, or 0 where there is none. */
+uint64_t bench_ticks(void);
+
+/**
+ * @brief Time `body(ctx, n)` for the configured warmup and repetitions and
+ *        report per-operation "ns/op" and "tsc/op" rows.
+ */
+void bench_run(const char *suite, const char *name, bench_body_fn body,
+               void *ctx, uint64_t n);
+
+/**
+ * @brief bench_run(), then the same body again under hardware counters:
+ *        "br-miss/op", "insn/op" and "l1i-miss/op" rows.
+ *
+ * Counters that cannot be opened (no PMU in a VM, perf_event_paranoid,
+ * not Linux) are skipped with a note on stderr, so the timing rows are
+ * always produced.
+ */
+void bench_run_counters(const char *suite, const char *name,
+                        bench_body_fn body, void *ctx, uint64_t n);
+
+/**
+ * @brief Report a set of samples (e.g. per-request latencies).  `samples`
+ *        is sorted in place.
+ */
+void bench_report_samples(const char *suite, const char *name,
+                          const char *unit, double *samples, size_t n);
+
+/**
+ * @brief Report a single measured value (e.g. a throughput).
+ */
+void bench_report_value(const char *suite, const char *name, const char *unit,
+                        double value);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BENCH_HARNESS_H_ */
@@ -0,0 +1,122 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_call.c
+ *
+ * @brief Per-call cost of mu_thunk_call() in each build mode.
+ *
+ * The Makefile builds this file four times: against the separately
+ * compiled mu_thunk.c ("extern"), the same with -flto ("lto"), with
+ * MU_THUNK_HEADER_ONLY ("header_only") and with MU_THUNK_HEADER_ONLY and
+ * MU_THUNK_UNCHECKED ("unchecked"); the mode is the suite name.  Each run
+ * also times _mu_thunk_call() as the floor every mode is aiming for.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#ifndef BENCH_MODE
+#define BENCH_MODE "extern"
+#endif
+
+#define N_THUNKS 1024
+#define N_CALLS (10 * 1000 * 1000)
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    uint64_t count;
+} counting_thunk_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static counting_thunk_t s_thunks[N_THUNKS];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void count_fn(mu_thunk_t *thunk, void *args);
+static void count_twice_fn(mu_thunk_t *thunk, void *args);
+static void run_checked(void *ctx, uint64_t n);
+static void run_unchecked(void *ctx, uint64_t n);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    bench_init(argc, argv);
+    for (int i = 0; i < N_THUNKS; i++) {
+        mu_thunk_init(&s_thunks[i].thunk,
+                      (i & 1) ? count_twice_fn : count_fn);
+    }
+    bench_run("call " BENCH_MODE, "mu_thunk_call", run_checked, NULL, N_CALLS);
+    bench_run("call " BENCH_MODE, "_mu_thunk_call", run_unchecked, NULL,
+              N_CALLS);
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void count_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    ((counting_thunk_t *)thunk)->count++;
+}
+
+static void count_twice_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    ((counting_thunk_t *)thunk)->count += 2;
+}
+
+// The empty asm hides the thunk from the optimizer, so fn is reloaded and
+// called indirectly on every iteration as it would be from a run queue.
+static void run_checked(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_t *thunk = &s_thunks[i & (N_THUNKS - 1)].thunk;
+        __asm__ volatile("" : "+r"(thunk)::"memory");
+        mu_thunk_call(thunk, NULL);
+    }
+}
+
+static void run_unchecked(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_t *thunk = &s_thunks[i & (N_THUNKS - 1)].thunk;
+        __asm__ volatile("" : "+r"(thunk)::"memory");
+        _mu_thunk_call(thunk, NULL);
+    }
+}
+
+// *****************************************************************************
+// End of file
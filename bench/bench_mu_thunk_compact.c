@@ -0,0 +1,176 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_compact.c
+ *
+ * @brief Dispatching a dense table of jobs, each a thunk plus a 32-bit
+ *        argument: `mu_thunk_t` (16-byte records) against
+ *        `mu_thunk_compact_t` (8-byte records).
+ *
+ * The table is far larger than the caches, so the run is bound by how many
+ * bytes each job costs to stream in.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_compact.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_JOBS (4u << 20)
+#define N_FNS 4
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    uint32_t arg;
+} wide_job_t;
+
+typedef struct {
+    mu_thunk_compact_t thunk; /**< Must be first member */
+    uint32_t arg;
+} compact_job_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static uint64_t s_sum;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void run_wide(void *ctx, uint64_t n);
+static void run_compact(void *ctx, uint64_t n);
+static void wide_add(mu_thunk_t *thunk, void *args);
+static void wide_sub(mu_thunk_t *thunk, void *args);
+static void wide_xor(mu_thunk_t *thunk, void *args);
+static void wide_mul(mu_thunk_t *thunk, void *args);
+static void compact_add(mu_thunk_compact_t *thunk, void *args);
+static void compact_sub(mu_thunk_compact_t *thunk, void *args);
+static void compact_xor(mu_thunk_compact_t *thunk, void *args);
+static void compact_mul(mu_thunk_compact_t *thunk, void *args);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    static const mu_thunk_fn wide_fns[N_FNS] = {wide_add, wide_sub, wide_xor,
+                                                wide_mul};
+    static const mu_thunk_compact_fn compact_fns[N_FNS] = {
+        compact_add, compact_sub, compact_xor, compact_mul};
+    mu_thunk_compact_id_t ids[N_FNS];
+    wide_job_t *wide = malloc(sizeof(wide_job_t) * N_JOBS);
+    compact_job_t *compact = malloc(sizeof(compact_job_t) * N_JOBS);
+
+    bench_init(argc, argv);
+    for (int f = 0; f < N_FNS; f++) {
+        ids[f] = mu_thunk_compact_register(compact_fns[f]);
+    }
+    // A short repeating pattern keeps the branch predictor out of the way.
+    for (uint32_t i = 0; i < N_JOBS; i++) {
+        mu_thunk_init(&wide[i].thunk, wide_fns[i % N_FNS]);
+        wide[i].arg = i;
+        mu_thunk_compact_init(&compact[i].thunk, ids[i % N_FNS]);
+        compact[i].arg = i;
+    }
+
+    bench_run("compact dispatch", "mu_thunk_t", run_wide, wide, N_JOBS);
+    bench_run("compact dispatch", "mu_thunk_compact_t", run_compact, compact,
+              N_JOBS);
+    bench_report_value("compact dispatch", "mu_thunk_t", "bytes/job",
+                       (double)sizeof(wide_job_t));
+    bench_report_value("compact dispatch", "mu_thunk_compact_t", "bytes/job",
+                       (double)sizeof(compact_job_t));
+    bench_finish();
+
+    free(compact);
+    free(wide);
+    return (int)(s_sum & 1);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void run_wide(void *ctx, uint64_t n) {
+    wide_job_t *jobs = ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        _mu_thunk_call(&jobs[i].thunk, NULL);
+    }
+}
+
+static void run_compact(void *ctx, uint64_t n) {
+    compact_job_t *jobs = ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        _mu_thunk_compact_call(&jobs[i].thunk, NULL);
+    }
+}
+
+static void wide_add(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    s_sum += ((wide_job_t *)thunk)->arg;
+}
+
+static void wide_sub(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    s_sum -= ((wide_job_t *)thunk)->arg;
+}
+
+static void wide_xor(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    s_sum ^= ((wide_job_t *)thunk)->arg;
+}
+
+static void wide_mul(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    s_sum *= ((wide_job_t *)thunk)->arg | 1;
+}
+
+static void compact_add(mu_thunk_compact_t *thunk, void *args) {
+    (void)args;
+    s_sum += ((compact_job_t *)thunk)->arg;
+}
+
+static void compact_sub(mu_thunk_compact_t *thunk, void *args) {
+    (void)args;
+    s_sum -= ((compact_job_t *)thunk)->arg;
+}
+
+static void compact_xor(mu_thunk_compact_t *thunk, void *args) {
+    (void)args;
+    s_sum ^= ((compact_job_t *)thunk)->arg;
+}
+
+static void compact_mul(mu_thunk_compact_t *thunk, void *args) {
+    (void)args;
+    s_sum *= ((compact_job_t *)thunk)->arg | 1;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,143 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_coro.cpp
+ *
+ * @brief Costs behind mu::task<T>, on one core.
+ *
+ * - "coro await": a task awaits a child task that completes at once; an op
+ *   is creating the child, transferring into it and transferring back.
+ * - "coro post": a task re-posts itself to a mu_thunk_ring and the ring is
+ *   drained; an op is one suspend, one put/get and one _mu_thunk_call().
+ * - "coro frame": allocating and freeing one 128-byte frame through
+ *   mu::coro_frame_pool against global operator new/delete.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk_coro.hpp"
+#include <cstdint>
+#include <new>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_AWAIT_OPS (10 * 1000 * 1000)
+#define N_POST_OPS (10 * 1000 * 1000)
+#define N_FRAME_OPS (10 * 1000 * 1000)
+#define FRAME_SIZE 128
+#define RING_CAPACITY 16
+
+namespace {
+
+// *****************************************************************************
+// Private (static) storage
+
+mu_thunk_ring_t s_ring;
+mu_thunk_t *s_ring_store[RING_CAPACITY];
+uint64_t s_sink;
+
+// *****************************************************************************
+// Private (static) code
+
+template <typename T> inline T *opaque(T *p) {
+    __asm__ volatile("" : "+r"(p)::"memory");
+    return p;
+}
+
+__attribute__((noinline)) mu::task<uint64_t> child(uint64_t i) {
+    co_return i;
+}
+
+mu::task<uint64_t> await_loop(uint64_t n) {
+    uint64_t total = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        total += co_await child(i);
+    }
+    co_return total;
+}
+
+mu::task<void> post_loop(uint64_t n) {
+    for (uint64_t i = 0; i < n; i++) {
+        co_await mu::post(&s_ring);
+    }
+}
+
+void run_await(void *ctx, uint64_t n) {
+    (void)ctx;
+    mu::task<uint64_t> t = await_loop(n);
+    _mu_thunk_call(t.thunk(), nullptr);
+    s_sink += t.result();
+}
+
+void run_post(void *ctx, uint64_t n) {
+    (void)ctx;
+    mu::task<void> t = post_loop(n);
+    _mu_thunk_call(t.thunk(), nullptr);
+    while (!t.done()) {
+        mu_thunk_ring_drain(&s_ring, nullptr);
+    }
+}
+
+void run_frame_pool(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        void *p = opaque(mu::coro_frame_pool::allocate(FRAME_SIZE));
+        mu::coro_frame_pool::deallocate(p, FRAME_SIZE);
+    }
+}
+
+void run_operator_new(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        void *p = opaque(::operator new(FRAME_SIZE));
+        ::operator delete(p, FRAME_SIZE);
+    }
+}
+
+} // namespace
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    bench_init(argc, argv);
+    mu_thunk_ring_init(&s_ring, s_ring_store, RING_CAPACITY);
+
+    bench_run("coro await", "sync child", run_await, nullptr, N_AWAIT_OPS);
+    bench_run("coro post", "ring hop", run_post, nullptr, N_POST_OPS);
+    bench_run("coro frame", "coro_frame_pool", run_frame_pool, nullptr,
+              N_FRAME_OPS);
+    bench_run("coro frame", "operator new", run_operator_new, nullptr,
+              N_FRAME_OPS);
+
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,223 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_dispatch.cpp
+ *
+ * @brief Cost of one deferred call through each kind of dispatch:
+ *        a direct call, a plain function pointer, mu_thunk_call(),
+ *        _mu_thunk_call(), a lambda bound by mu::thunk<F> and
+ *        std::function.
+ *
+ * Every variant walks the same array of 1024 callables (alternating
+ * between two targets) and hides the element from the optimizer, so each
+ * iteration really loads and dispatches rather than being hoisted.
+ *
+ * The "bind" suite binds a lambda with 32 bytes of captures, calls it once
+ * and destroys it: std::function must heap-allocate a capture that large,
+ * mu::thunk<F> keeps it inline.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_bind.hpp"
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_CALLABLES 1024
+#define N_CALLS (10 * 1000 * 1000)
+#define N_BINDS (10 * 1000 * 1000)
+
+namespace {
+
+struct counting_thunk_t {
+    mu_thunk_t thunk; /**< Must be first member */
+    uint64_t count;
+};
+
+typedef void (*plain_fn)(uint64_t *count);
+
+auto bind_count(uint64_t *count) {
+    return [count] { (*count)++; };
+}
+
+auto bind_count_twice(uint64_t *count) {
+    return [count] { *count += 2; };
+}
+
+using bound_count_t = mu::thunk<decltype(bind_count(nullptr))>;
+using bound_count_twice_t = mu::thunk<decltype(bind_count_twice(nullptr))>;
+
+// *****************************************************************************
+// Private (static) storage
+
+counting_thunk_t s_thunks[N_CALLABLES];
+plain_fn s_fns[N_CALLABLES];
+std::function<void()> s_functions[N_CALLABLES];
+std::optional<bound_count_t> s_bound_once[N_CALLABLES / 2];
+std::optional<bound_count_twice_t> s_bound_twice[N_CALLABLES / 2];
+mu_thunk_t *s_bound[N_CALLABLES];
+uint64_t s_counts[N_CALLABLES];
+
+// *****************************************************************************
+// Private (static) code
+
+template <typename T> inline T *opaque(T *p) {
+    __asm__ volatile("" : "+r"(p)::"memory");
+    return p;
+}
+
+void count_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    reinterpret_cast<counting_thunk_t *>(thunk)->count++;
+}
+
+void count_twice_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    reinterpret_cast<counting_thunk_t *>(thunk)->count += 2;
+}
+
+void plain_count(uint64_t *count) { (*count)++; }
+
+void plain_count_twice(uint64_t *count) { *count += 2; }
+
+__attribute__((noinline)) void direct_count(uint64_t *count) { (*count)++; }
+
+void run_direct(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        direct_count(opaque(&s_counts[i & (N_CALLABLES - 1)]));
+    }
+}
+
+void run_fn_pointer(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        size_t k = i & (N_CALLABLES - 1);
+        plain_fn *fn = opaque(&s_fns[k]);
+        (*fn)(&s_counts[k]);
+    }
+}
+
+void run_mu_thunk_call(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_call(opaque(&s_thunks[i & (N_CALLABLES - 1)].thunk), nullptr);
+    }
+}
+
+void run_mu_thunk_call_inline(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        _mu_thunk_call(opaque(&s_thunks[i & (N_CALLABLES - 1)].thunk),
+                       nullptr);
+    }
+}
+
+void run_mu_thunk_bound(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        _mu_thunk_call(*opaque(&s_bound[i & (N_CALLABLES - 1)]), nullptr);
+    }
+}
+
+void run_std_function(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        (*opaque(&s_functions[i & (N_CALLABLES - 1)]))();
+    }
+}
+
+void run_bind_mu_thunk(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        uint64_t *a = &s_counts[i & (N_CALLABLES - 1)];
+        uint64_t b = i, c = i >> 1, d = i >> 2;
+        auto t = mu::thunk([a, b, c, d] { *a += b ^ c ^ d; });
+        _mu_thunk_call(opaque(t.get()), nullptr);
+    }
+}
+
+void run_bind_std_function(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        uint64_t *a = &s_counts[i & (N_CALLABLES - 1)];
+        uint64_t b = i, c = i >> 1, d = i >> 2;
+        std::function<void()> f = [a, b, c, d] { *a += b ^ c ^ d; };
+        (*opaque(&f))();
+    }
+}
+
+} // namespace
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    bench_init(argc, argv);
+    for (int i = 0; i < N_CALLABLES; i++) {
+        mu_thunk_init(&s_thunks[i].thunk, (i & 1) ? count_twice_fn : count_fn);
+        s_fns[i] = (i & 1) ? plain_count_twice : plain_count;
+        uint64_t *count = &s_counts[i];
+        if (i & 1) {
+            s_functions[i] = [count] { *count += 2; };
+        } else {
+            s_functions[i] = [count] { (*count)++; };
+        }
+        if (i & 1) {
+            s_bound[i] =
+                s_bound_twice[i / 2].emplace(bind_count_twice(count)).get();
+        } else {
+            s_bound[i] = s_bound_once[i / 2].emplace(bind_count(count)).get();
+        }
+    }
+
+    bench_run("dispatch", "direct call", run_direct, nullptr, N_CALLS);
+    bench_run("dispatch", "function pointer", run_fn_pointer, nullptr,
+              N_CALLS);
+    bench_run("dispatch", "mu_thunk_call", run_mu_thunk_call, nullptr,
+              N_CALLS);
+    bench_run("dispatch", "_mu_thunk_call", run_mu_thunk_call_inline, nullptr,
+              N_CALLS);
+    bench_run("dispatch", "mu::thunk<F>", run_mu_thunk_bound, nullptr,
+              N_CALLS);
+    bench_run("dispatch", "std::function", run_std_function, nullptr,
+              N_CALLS);
+    bench_run("bind", "mu::thunk<F>", run_bind_mu_thunk, nullptr, N_BINDS);
+    bench_run("bind", "std::function", run_bind_std_function, nullptr,
+              N_BINDS);
+
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,201 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_edf.c
+ *
+ * @brief mu_thunk_edf scheduling overhead, and deadline-miss rate under
+ *        overload with and without shedding late jobs.
+ *
+ * Overhead: a hold model over the real clock; each dispatch reschedules the
+ * task with a fresh deadline, so one op is a pop, a clock read and a push at
+ * the given heap population.
+ *
+ * Overload: 16 periodic tasks on a virtual clock whose total utilization is
+ * swept past 1.0.  With a miss thunk the late job is skipped and the task
+ * moves on to its next period; without one it runs late and the backlog
+ * dominoes.  Miss rate is misses / jobs taken off the queue.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_edf.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_OPS 1000000
+#define MAX_HELD 65536
+#define N_PERIODIC 16
+#define N_JOBS 1000000
+
+typedef struct {
+    mu_thunk_edf_task_t task; /**< Must be first member */
+    uint64_t period;
+    uint64_t cost; /**< Virtual time consumed per job */
+} periodic_task_t;
+
+typedef struct {
+    size_t held;
+} hold_ctx_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_edf_task_t *s_store[MAX_HELD];
+static mu_thunk_edf_task_t s_tasks[MAX_HELD];
+static mu_thunk_edf_t s_edf;
+static uint64_t s_rng = 88172645463325252ull;
+static uint64_t s_vnow;
+static periodic_task_t s_periodic[N_PERIODIC];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void run_hold(void *ctx, uint64_t n);
+static void hold_fn(mu_thunk_t *thunk, void *args);
+static double overload_miss_rate(double utilization, bool shed);
+static void periodic_fn(mu_thunk_t *thunk, void *args);
+static void skip_fn(mu_thunk_t *thunk, void *args);
+static uint64_t virtual_clock(void);
+static uint64_t next_random(uint64_t *state);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    static const size_t helds[] = {16, 1024, MAX_HELD};
+    static const double loads[] = {0.5, 0.9, 1.0, 1.1, 1.5, 2.0};
+    char name[64];
+
+    bench_init(argc, argv);
+    for (size_t i = 0; i < MAX_HELD; i++) {
+        mu_thunk_edf_task_init(&s_tasks[i], hold_fn);
+    }
+    for (size_t i = 0; i < sizeof(helds) / sizeof(helds[0]); i++) {
+        hold_ctx_t ctx = {.held = helds[i]};
+        snprintf(name, sizeof(name), "hold %zu", helds[i]);
+        bench_run("edf overhead", name, run_hold, &ctx, N_OPS);
+    }
+
+    for (size_t i = 0; i < sizeof(loads) / sizeof(loads[0]); i++) {
+        snprintf(name, sizeof(name), "U=%.1f shed", loads[i]);
+        bench_report_value("edf overload", name, "miss %",
+                           100.0 * overload_miss_rate(loads[i], true));
+        snprintf(name, sizeof(name), "U=%.1f run late", loads[i]);
+        bench_report_value("edf overload", name, "miss %",
+                           100.0 * overload_miss_rate(loads[i], false));
+    }
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void run_hold(void *ctx, uint64_t n) {
+    hold_ctx_t *c = ctx;
+    // Deadlines sit far in the future so nothing is ever late here.
+    uint64_t base = mu_thunk_edf_now_ns() + (1ull << 50);
+    mu_thunk_edf_init(&s_edf, s_store, MAX_HELD, NULL, NULL);
+    for (size_t i = 0; i < c->held; i++) {
+        mu_thunk_edf_schedule(&s_edf, &s_tasks[i],
+                              base + (next_random(&s_rng) & 0xfffff));
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_edf_run(&s_edf, &base, 1);
+    }
+    while (mu_thunk_edf_peek(&s_edf) != NULL) {
+        mu_thunk_edf_cancel(&s_edf, mu_thunk_edf_peek(&s_edf));
+    }
+}
+
+static void hold_fn(mu_thunk_t *thunk, void *args) {
+    mu_thunk_edf_task_t *task = (mu_thunk_edf_task_t *)thunk;
+    uint64_t base = *(uint64_t *)args;
+    mu_thunk_edf_schedule(&s_edf, task,
+                          base + (next_random(&s_rng) & 0xfffff));
+}
+
+static double overload_miss_rate(double utilization, bool shed) {
+    static mu_thunk_edf_task_t *store[N_PERIODIC];
+    mu_thunk_t skip;
+    uint64_t rng = 2463534242ull;
+
+    mu_thunk_init(&skip, skip_fn);
+    mu_thunk_edf_init(&s_edf, store, N_PERIODIC, virtual_clock,
+                      shed ? &skip : NULL);
+    s_vnow = 0;
+    for (int i = 0; i < N_PERIODIC; i++) {
+        periodic_task_t *pt = &s_periodic[i];
+        mu_thunk_edf_task_init(&pt->task, periodic_fn);
+        pt->period = 1000 + next_random(&rng) % 15000;
+        pt->cost = (uint64_t)(utilization * (double)pt->period / N_PERIODIC);
+        if (pt->cost == 0) {
+            pt->cost = 1;
+        }
+        mu_thunk_edf_schedule(&s_edf, &pt->task, pt->period);
+    }
+    mu_thunk_edf_run(&s_edf, NULL, N_JOBS);
+    uint64_t misses = mu_thunk_edf_misses(&s_edf);
+    return (double)misses / (double)(misses + mu_thunk_edf_dispatched(&s_edf));
+}
+
+static void periodic_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    periodic_task_t *pt = (periodic_task_t *)thunk;
+    s_vnow += pt->cost;
+    mu_thunk_edf_schedule(&s_edf, &pt->task, pt->task.deadline + pt->period);
+}
+
+static void skip_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    periodic_task_t *pt = (periodic_task_t *)args;
+    // Drop this job; the task resumes with the first period still ahead.
+    uint64_t deadline = pt->task.deadline;
+    while (deadline < s_vnow) {
+        deadline += pt->period;
+    }
+    mu_thunk_edf_schedule(&s_edf, &pt->task, deadline);
+}
+
+static uint64_t virtual_clock(void) { return s_vnow; }
+
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+// *****************************************************************************
+// End of file
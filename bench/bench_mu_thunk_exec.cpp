@@ -0,0 +1,231 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_exec.cpp
+ *
+ * @brief Overhead of the P2300-style schedulers in mu_thunk_exec.hpp over
+ *        posting raw thunks to the same queues.
+ *
+ * - "exec ring": connect, start and drain `schedule() | then(fn)` on a
+ *   ring scheduler, against putting and draining a hand-written thunk.
+ * - "exec fan-out": a `when_all` of FAN_OUT `schedule() | then(fn)`
+ *   senders on a pool scheduler, joined by helping the pool, against the
+ *   same fan-out as raw thunks with an atomic countdown.
+ * - "exec alloc": heap allocations per fan-out op (global operator new is
+ *   counted), which should be zero.
+ *
+ * stdexec's static_thread_pool is not in this tree's dependencies, so the
+ * comparison is against the raw queues instead.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk_exec.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_RING_OPS (10 * 1000 * 1000)
+#define N_FAN_OUT_OPS (200 * 1000)
+#define FAN_OUT 4
+#define N_WORKERS 2
+#define RING_CAPACITY 16
+
+namespace {
+
+struct raw_thunk_t {
+    mu_thunk_t thunk; /**< Must be first member */
+    uint64_t *sum;
+};
+
+/** Completes a pipeline by setting a flag; values are folded into a sum. */
+struct flag_receiver_t {
+    std::atomic<bool> *done;
+    uint64_t *sum;
+
+    template <typename... Vs> void set_value(Vs... vs) && noexcept {
+        *sum += (uint64_t(0) + ... + uint64_t(vs));
+        done->store(true, std::memory_order_release);
+    }
+
+    void set_error(std::exception_ptr) && noexcept { std::abort(); }
+
+    void set_stopped() && noexcept { std::abort(); }
+};
+
+// *****************************************************************************
+// Private (static) storage
+
+mu_thunk_ring_t s_ring;
+mu_thunk_t *s_ring_store[RING_CAPACITY];
+mu_thunk_pool_t s_pool;
+mu_thunk_pool_worker_t s_workers[N_WORKERS];
+uint64_t s_sum;
+std::atomic<size_t> s_allocs;
+
+// *****************************************************************************
+// Private (static) code
+
+void raw_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    raw_thunk_t *raw = reinterpret_cast<raw_thunk_t *>(thunk);
+    (*raw->sum)++;
+}
+
+void run_ring_sender(void *ctx, uint64_t n) {
+    (void)ctx;
+    mu::ring_scheduler sched(&s_ring);
+    std::atomic<bool> done{false};
+    for (uint64_t i = 0; i < n; i++) {
+        auto op = mu::connect(sched.schedule() | mu::then([] { return 1; }),
+                              flag_receiver_t{&done, &s_sum});
+        op.start();
+        mu_thunk_ring_drain(&s_ring, nullptr);
+    }
+}
+
+void run_ring_raw(void *ctx, uint64_t n) {
+    (void)ctx;
+    raw_thunk_t raw;
+    raw.sum = &s_sum;
+    for (uint64_t i = 0; i < n; i++) {
+        _mu_thunk_init(&raw.thunk, raw_fn);
+        mu_thunk_ring_put(&s_ring, &raw.thunk);
+        mu_thunk_ring_drain(&s_ring, nullptr);
+    }
+}
+
+uint64_t work(uint64_t x) {
+    for (int i = 0; i < 64; i++) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+    }
+    return x >> 60;
+}
+
+void run_fan_out_sender(void *ctx, uint64_t n) {
+    (void)ctx;
+    mu::pool_scheduler sched(&s_pool);
+    for (uint64_t i = 0; i < n; i++) {
+        std::atomic<bool> done{false};
+        auto op = mu::connect(
+            mu::when_all(sched.schedule() | mu::then([i] { return work(i); }),
+                         sched.schedule() | mu::then([i] { return work(i); }),
+                         sched.schedule() | mu::then([i] { return work(i); }),
+                         sched.schedule() | mu::then([i] { return work(i); })),
+            flag_receiver_t{&done, &s_sum});
+        op.start();
+        while (!done.load(std::memory_order_acquire)) {
+            mu_thunk_pool_help(&s_pool);
+        }
+    }
+}
+
+struct raw_work_t {
+    mu_thunk_t thunk; /**< Must be first member */
+    uint64_t input;
+    uint64_t output;
+    std::atomic<int> *pending;
+};
+
+void raw_work_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    raw_work_t *w = reinterpret_cast<raw_work_t *>(thunk);
+    w->output = work(w->input);
+    w->pending->fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void run_fan_out_raw(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        std::atomic<int> pending{FAN_OUT};
+        raw_work_t w[FAN_OUT];
+        for (int k = 0; k < FAN_OUT; k++) {
+            _mu_thunk_init(&w[k].thunk, raw_work_fn);
+            w[k].input = i;
+            w[k].pending = &pending;
+            if (!mu_thunk_pool_submit(&s_pool, &w[k].thunk, nullptr)) {
+                raw_work_fn(&w[k].thunk, nullptr);
+            }
+        }
+        while (pending.load(std::memory_order_acquire) != 0) {
+            mu_thunk_pool_help(&s_pool);
+        }
+        for (int k = 0; k < FAN_OUT; k++) {
+            s_sum += w[k].output;
+        }
+    }
+}
+
+} // namespace
+
+// Count every allocation for the "exec alloc" row.
+void *operator new(std::size_t size) {
+    s_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    bench_init(argc, argv);
+    mu_thunk_ring_init(&s_ring, s_ring_store, RING_CAPACITY);
+    if (mu_thunk_pool_init(&s_pool, s_workers, N_WORKERS) == nullptr) {
+        return 1;
+    }
+
+    bench_run("exec ring", "schedule|then", run_ring_sender, nullptr,
+              N_RING_OPS);
+    bench_run("exec ring", "raw thunk", run_ring_raw, nullptr, N_RING_OPS);
+    bench_run("exec fan-out", "when_all x4", run_fan_out_sender, nullptr,
+              N_FAN_OUT_OPS);
+    bench_run("exec fan-out", "raw thunks x4", run_fan_out_raw, nullptr,
+              N_FAN_OUT_OPS);
+
+    size_t before = s_allocs.load();
+    run_fan_out_sender(nullptr, N_FAN_OUT_OPS);
+    bench_report_value("exec alloc", "when_all x4", "alloc/op",
+                       double(s_allocs.load() - before) / N_FAN_OUT_OPS);
+
+    mu_thunk_pool_stop(&s_pool);
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// End of file
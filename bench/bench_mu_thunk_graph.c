@@ -0,0 +1,216 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_graph.c
+ *
+ * @brief mu_thunk_graph on a 100k-node random DAG, run serially and on
+ *        1..N pool workers.
+ *
+ * Node i depends on up to 4 random nodes among the previous WINDOW, and does
+ * a random amount of work (an LCG chain).  For each run the benchmark
+ * reports wall time, speedup over the serial run, and critical-path
+ * efficiency ("cp-eff"): the lower bound max(T1 / P, Tinf) divided by the
+ * measured time, where T1 is the total work and Tinf the work along the
+ * longest path.  A second suite runs the same graph with empty nodes to
+ * show the per-node scheduling overhead.
+ *
+ * Usage: bench_mu_thunk_graph [max_threads]
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk_graph.h"
+#include "mu_thunk_pool.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DEFAULT_MAX_THREADS 8
+#define N_NODES (100 * 1000)
+#define MAX_PREDS 4
+#define MAX_SUCC 8
+#define WINDOW 1000
+#define WORK_MIN 50
+#define WORK_MAX 1000
+#define REPEATS 3
+
+typedef struct {
+    mu_thunk_graph_node_t node; /**< Must be first member */
+    mu_thunk_graph_node_t *succ[MAX_SUCC];
+    uint32_t work;       /**< LCG steps to run */
+    uint64_t path_work;  /**< Heaviest path ending here, inclusive */
+    uint64_t result;
+} work_node_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_graph_t s_graph;
+static mu_thunk_pool_t s_pool;
+static work_node_t *s_nodes;
+static uint64_t s_rng = 0x9e3779b97f4a7c15ull;
+static int s_empty;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static uint64_t next_random(void);
+static void work_fn(mu_thunk_t *thunk, void *args);
+static void build(uint64_t *total_work, uint64_t *span_work);
+static double ns_per_step(void);
+static double run_ms(mu_thunk_pool_t *pool);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    int arg = bench_init(argc, argv);
+    int max_threads = arg < argc ? atoi(argv[arg]) : DEFAULT_MAX_THREADS;
+    mu_thunk_pool_worker_t *workers =
+        malloc(sizeof(mu_thunk_pool_worker_t) * max_threads);
+    s_nodes = malloc(sizeof(work_node_t) * N_NODES);
+
+    uint64_t total_work;
+    uint64_t span_work;
+    build(&total_work, &span_work);
+    double step_ns = ns_per_step();
+    double t1_ms = (double)total_work * step_ns / 1e6;
+    double tinf_ms = (double)span_work * step_ns / 1e6;
+    bench_report_value("graph", "work T1", "ms", t1_ms);
+    bench_report_value("graph", "span Tinf", "ms", tinf_ms);
+    bench_report_value("graph", "parallelism", "T1/Tinf", t1_ms / tinf_ms);
+
+    double serial_ms = run_ms(NULL);
+    bench_report_value("graph", "serial", "ms", serial_ms);
+    bench_report_value("graph", "serial", "cp-eff", t1_ms / serial_ms);
+    s_empty = 1;
+    double empty_serial_ms = run_ms(NULL);
+    bench_report_value("graph empty", "serial", "ns/node",
+                       empty_serial_ms * 1e6 / N_NODES);
+    s_empty = 0;
+
+    for (int n = 1; n <= max_threads; n *= 2) {
+        mu_thunk_pool_init(&s_pool, workers, n);
+        double ms = run_ms(&s_pool);
+        s_empty = 1;
+        double empty_ms = run_ms(&s_pool);
+        s_empty = 0;
+        mu_thunk_pool_stop(&s_pool);
+        double bound = t1_ms / n > tinf_ms ? t1_ms / n : tinf_ms;
+        char name[32];
+        snprintf(name, sizeof(name), "%d threads", n);
+        bench_report_value("graph", name, "ms", ms);
+        bench_report_value("graph", name, "speedup", serial_ms / ms);
+        bench_report_value("graph", name, "cp-eff", bound / ms);
+        bench_report_value("graph empty", name, "ns/node",
+                           empty_ms * 1e6 / N_NODES);
+    }
+
+    bench_finish();
+    free(s_nodes);
+    free(workers);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static uint64_t next_random(void) {
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 7;
+    s_rng ^= s_rng << 17;
+    return s_rng;
+}
+
+static void work_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    work_node_t *w = (work_node_t *)thunk;
+    if (s_empty) {
+        return;
+    }
+    uint64_t x = (uintptr_t)w;
+    for (uint32_t i = 0; i < w->work; i++) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    w->result = x;
+}
+
+/**
+ * Build the DAG.  Edges only run from lower to higher indices, so index
+ * order is a topological order and the heaviest path falls out in one pass.
+ */
+static void build(uint64_t *total_work, uint64_t *span_work) {
+    mu_thunk_graph_init(&s_graph);
+    *total_work = 0;
+    *span_work = 0;
+    for (int i = 0; i < N_NODES; i++) {
+        work_node_t *w = &s_nodes[i];
+        mu_thunk_graph_add(&s_graph, &w->node, work_fn, w->succ, MAX_SUCC);
+        w->work = WORK_MIN + next_random() % (WORK_MAX - WORK_MIN + 1);
+        w->path_work = 0;
+        int n_preds = i == 0 ? 0 : (int)(next_random() % (MAX_PREDS + 1));
+        for (int k = 0; k < n_preds; k++) {
+            int window = i < WINDOW ? i : WINDOW;
+            work_node_t *p = &s_nodes[i - 1 - next_random() % window];
+            if (mu_thunk_graph_depend(&p->node, &w->node) &&
+                p->path_work > w->path_work) {
+                w->path_work = p->path_work;
+            }
+        }
+        w->path_work += w->work;
+        *total_work += w->work;
+        if (w->path_work > *span_work) {
+            *span_work = w->path_work;
+        }
+    }
+}
+
+/** Time one LCG step, in isolation. */
+static double ns_per_step(void) {
+    static work_node_t w = {.work = 10 * 1000 * 1000};
+    uint64_t start = bench_now_ns();
+    work_fn(&w.node.thunk, NULL);
+    return (double)(bench_now_ns() - start) / w.work;
+}
+
+// Best of REPEATS runs, in ms.
+static double run_ms(mu_thunk_pool_t *pool) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        uint64_t start = bench_now_ns();
+        mu_thunk_graph_run(&s_graph, pool, NULL);
+        double ms = (double)(bench_now_ns() - start) / 1e6;
+        best = (r == 0 || ms < best) ? ms : best;
+    }
+    return best;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,180 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_lazy.c
+ *
+ * @brief Cost of reaching a lazily initialized value: mu_thunk_lazy against
+ *        pthread_once and a mutex-guarded flag.
+ *
+ * - "hot": the value is already initialized; measures each access.
+ * - "first": re-arm and force per op; measures an uncontended evaluation
+ *   (pthread_once cannot be re-armed, so it is absent here).
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_lazy.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_HOT_OPS (20 * 1000 * 1000)
+#define N_FIRST_OPS (5 * 1000 * 1000)
+
+typedef struct {
+    mu_thunk_lazy_t lazy; /**< Must be first member */
+    uint64_t table[8];
+} table_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static table_t s_lazy_table;
+static uint64_t s_once_table[8];
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+static uint64_t s_mutex_table[8];
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool s_mutex_done;
+static volatile uint64_t s_sum;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void fill_table(uint64_t *table);
+static void lazy_fn(mu_thunk_t *thunk, void *args);
+static void once_fn(void);
+static uint64_t *mutex_get(void);
+static void run_hot_lazy(void *ctx, uint64_t n);
+static void run_hot_once(void *ctx, uint64_t n);
+static void run_hot_mutex(void *ctx, uint64_t n);
+static void run_first_lazy(void *ctx, uint64_t n);
+static void run_first_mutex(void *ctx, uint64_t n);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    bench_init(argc, argv);
+    mu_thunk_lazy_init(&s_lazy_table.lazy, lazy_fn);
+
+    bench_run("lazy hot", "mu_thunk_lazy", run_hot_lazy, NULL, N_HOT_OPS);
+    bench_run("lazy hot", "pthread_once", run_hot_once, NULL, N_HOT_OPS);
+    bench_run("lazy hot", "mutex", run_hot_mutex, NULL, N_HOT_OPS);
+    bench_run("lazy first", "mu_thunk_lazy", run_first_lazy, NULL,
+              N_FIRST_OPS);
+    bench_run("lazy first", "mutex", run_first_mutex, NULL, N_FIRST_OPS);
+
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void fill_table(uint64_t *table) {
+    for (int i = 0; i < 8; i++) {
+        table[i] = (uint64_t)i * 0x9e3779b97f4a7c15ull;
+    }
+}
+
+static void lazy_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    table_t *t = (table_t *)thunk;
+    fill_table(t->table);
+    t->lazy.value = t->table;
+}
+
+static void once_fn(void) {
+    fill_table(s_once_table);
+}
+
+static uint64_t *mutex_get(void) {
+    pthread_mutex_lock(&s_mutex);
+    if (!s_mutex_done) {
+        fill_table(s_mutex_table);
+        s_mutex_done = true;
+    }
+    pthread_mutex_unlock(&s_mutex);
+    return s_mutex_table;
+}
+
+static void run_hot_lazy(void *ctx, uint64_t n) {
+    (void)ctx;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        uint64_t *table = mu_thunk_lazy_force(&s_lazy_table.lazy, NULL);
+        sum += table[i & 7];
+    }
+    s_sum += sum;
+}
+
+static void run_hot_once(void *ctx, uint64_t n) {
+    (void)ctx;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        pthread_once(&s_once, once_fn);
+        sum += s_once_table[i & 7];
+    }
+    s_sum += sum;
+}
+
+static void run_hot_mutex(void *ctx, uint64_t n) {
+    (void)ctx;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        sum += mutex_get()[i & 7];
+    }
+    s_sum += sum;
+}
+
+static void run_first_lazy(void *ctx, uint64_t n) {
+    (void)ctx;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_lazy_init(&s_lazy_table.lazy, lazy_fn);
+        uint64_t *table = mu_thunk_lazy_force(&s_lazy_table.lazy, NULL);
+        sum += table[i & 7];
+    }
+    s_sum += sum;
+}
+
+static void run_first_mutex(void *ctx, uint64_t n) {
+    (void)ctx;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        s_mutex_done = false;
+        sum += mutex_get()[i & 7];
+    }
+    s_sum += sum;
+}
+
+// *****************************************************************************
+// End of file
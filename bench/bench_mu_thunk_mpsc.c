@@ -0,0 +1,189 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_mpsc.c
+ *
+ * @brief Contention benchmark: 1..N producers posting to one consumer via
+ *        mu_thunk_mpsc versus a mutex-protected intrusive list.
+ *
+ * Usage: bench_mu_thunk_mpsc [max_producers]
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_mpsc.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DEFAULT_MAX_PRODUCERS 8
+#define OPS_PER_PRODUCER 1000000
+#define BATCH 64
+
+typedef struct {
+    pthread_mutex_t lock;
+    mu_thunk_mpsc_node_t *head;
+    mu_thunk_mpsc_node_t *tail;
+} mutex_list_t;
+
+typedef struct {
+    mu_thunk_mpsc_node_t *nodes;
+    int use_mutex;
+} producer_ctx_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_mpsc_t s_q;
+static mutex_list_t s_list = {PTHREAD_MUTEX_INITIALIZER, NULL, NULL};
+static uint64_t s_calls;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void count_fn(mu_thunk_t *thunk, void *args);
+static void mutex_list_put(mutex_list_t *l, mu_thunk_mpsc_node_t *node);
+static size_t mutex_list_drain(mutex_list_t *l, void *args, size_t max);
+static void *producer_fn(void *arg);
+static double run(int n_producers, int use_mutex);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    int arg = bench_init(argc, argv);
+    int max_producers =
+        arg < argc ? atoi(argv[arg]) : DEFAULT_MAX_PRODUCERS;
+    mu_thunk_mpsc_init(&s_q);
+
+    for (int n = 1; n <= max_producers; n *= 2) {
+        char name[32];
+        snprintf(name, sizeof(name), "mpsc %dp", n);
+        bench_report_value("mpsc", name, "ns/op", run(n, 0));
+        snprintf(name, sizeof(name), "mutex list %dp", n);
+        bench_report_value("mpsc", name, "ns/op", run(n, 1));
+    }
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void count_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    s_calls++;
+}
+
+static void mutex_list_put(mutex_list_t *l, mu_thunk_mpsc_node_t *node) {
+    node->next = NULL;
+    pthread_mutex_lock(&l->lock);
+    if (l->tail == NULL) {
+        l->head = node;
+    } else {
+        l->tail->next = node;
+    }
+    l->tail = node;
+    pthread_mutex_unlock(&l->lock);
+}
+
+static size_t mutex_list_drain(mutex_list_t *l, void *args, size_t max) {
+    size_t n = 0;
+    while (n < max) {
+        pthread_mutex_lock(&l->lock);
+        mu_thunk_mpsc_node_t *node = l->head;
+        if (node != NULL) {
+            l->head = node->next;
+            if (l->head == NULL) {
+                l->tail = NULL;
+            }
+        }
+        pthread_mutex_unlock(&l->lock);
+        if (node == NULL) {
+            break;
+        }
+        _mu_thunk_call(&node->thunk, args);
+        n++;
+    }
+    return n;
+}
+
+static void *producer_fn(void *arg) {
+    producer_ctx_t *ctx = (producer_ctx_t *)arg;
+    for (int i = 0; i < OPS_PER_PRODUCER; i++) {
+        if (ctx->use_mutex) {
+            mutex_list_put(&s_list, &ctx->nodes[i]);
+        } else {
+            mu_thunk_mpsc_put(&s_q, &ctx->nodes[i]);
+        }
+    }
+    return NULL;
+}
+
+static double run(int n_producers, int use_mutex) {
+    uint64_t total = (uint64_t)n_producers * OPS_PER_PRODUCER;
+    pthread_t *threads = malloc(sizeof(pthread_t) * n_producers);
+    producer_ctx_t *ctx = malloc(sizeof(producer_ctx_t) * n_producers);
+    mu_thunk_mpsc_node_t *nodes = malloc(sizeof(mu_thunk_mpsc_node_t) * total);
+    for (uint64_t i = 0; i < total; i++) {
+        mu_thunk_mpsc_node_init(&nodes[i], count_fn);
+    }
+
+    s_calls = 0;
+    uint64_t start = bench_now_ns();
+    for (int p = 0; p < n_producers; p++) {
+        ctx[p].nodes = &nodes[(size_t)p * OPS_PER_PRODUCER];
+        ctx[p].use_mutex = use_mutex;
+        pthread_create(&threads[p], NULL, producer_fn, &ctx[p]);
+    }
+    while (s_calls < total) {
+        size_t n = use_mutex ? mutex_list_drain(&s_list, NULL, BATCH)
+                             : mu_thunk_mpsc_drain(&s_q, NULL, BATCH);
+        if (n == 0) {
+            sched_yield();
+        }
+    }
+    for (int p = 0; p < n_producers; p++) {
+        pthread_join(threads[p], NULL);
+    }
+    double ns_per_op = (double)(bench_now_ns() - start) / total;
+
+    free(nodes);
+    free(ctx);
+    free(threads);
+    return ns_per_op;
+}
+
+// *****************************************************************************
+// End of file
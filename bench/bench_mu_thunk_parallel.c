@@ -0,0 +1,187 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_parallel.c
+ *
+ * @brief Scaling of mu_thunk_parallel_for / _reduce on 1..N worker threads
+ *        for a memory-bound kernel (sum a 64 MiB array) and a compute-bound
+ *        one (an LCG chain per index), against a plain serial loop.
+ *
+ * Usage: bench_mu_thunk_parallel [max_threads]
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk_parallel.h"
+#include "mu_thunk_pool.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DEFAULT_MAX_THREADS 8
+#define MEM_ITEMS (16 * 1024 * 1024)
+#define COMPUTE_ITEMS (256 * 1024)
+#define COMPUTE_WORK 64
+#define REPEATS 5
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_pool_t s_pool;
+static uint32_t *s_values;
+static uint64_t *s_out;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void sum_fn(size_t begin, size_t end, void *acc, void *ctx);
+static void add_fn(void *acc, const void *right, void *ctx);
+static void compute_fn(size_t begin, size_t end, void *ctx);
+static double run_mem(bool parallel, uint64_t *sum);
+static double run_compute(bool parallel);
+static void report(const char *kernel, const char *what, double ms,
+                   double base_ms);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    int arg = bench_init(argc, argv);
+    int max_threads = arg < argc ? atoi(argv[arg]) : DEFAULT_MAX_THREADS;
+    mu_thunk_pool_worker_t *workers =
+        malloc(sizeof(mu_thunk_pool_worker_t) * max_threads);
+    s_values = malloc(sizeof(uint32_t) * MEM_ITEMS);
+    s_out = malloc(sizeof(uint64_t) * COMPUTE_ITEMS);
+    for (size_t i = 0; i < MEM_ITEMS; i++) {
+        s_values[i] = (uint32_t)(i * 2654435761u);
+    }
+    // Fault in the output pages before timing anything.
+    memset(s_out, 0, sizeof(uint64_t) * COMPUTE_ITEMS);
+
+    uint64_t expect;
+    double mem_base = run_mem(false, &expect);
+    double compute_base = run_compute(false);
+    report("parallel memory", "serial", mem_base, mem_base);
+    report("parallel compute", "serial", compute_base, compute_base);
+
+    for (int n = 1; n <= max_threads; n *= 2) {
+        mu_thunk_pool_init(&s_pool, workers, n);
+        uint64_t sum;
+        double mem_ms = run_mem(true, &sum);
+        double compute_ms = run_compute(true);
+        mu_thunk_pool_stop(&s_pool);
+        if (sum != expect) {
+            fprintf(stderr, "parallel sum mismatch\n");
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "%d threads", n);
+        report("parallel memory", name, mem_ms, mem_base);
+        report("parallel compute", name, compute_ms, compute_base);
+    }
+
+    bench_finish();
+    free(s_out);
+    free(s_values);
+    free(workers);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void sum_fn(size_t begin, size_t end, void *acc, void *ctx) {
+    (void)ctx;
+    uint64_t sum = 0;
+    for (size_t i = begin; i < end; i++) {
+        sum += s_values[i];
+    }
+    *(uint64_t *)acc += sum;
+}
+
+static void add_fn(void *acc, const void *right, void *ctx) {
+    (void)ctx;
+    *(uint64_t *)acc += *(const uint64_t *)right;
+}
+
+static void compute_fn(size_t begin, size_t end, void *ctx) {
+    (void)ctx;
+    for (size_t i = begin; i < end; i++) {
+        uint64_t x = i;
+        for (int k = 0; k < COMPUTE_WORK; k++) {
+            x = x * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        s_out[i] = x;
+    }
+}
+
+// Best of REPEATS runs, in ms.
+static double run_mem(bool parallel, uint64_t *sum) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        uint64_t acc = 0;
+        uint64_t start = bench_now_ns();
+        if (parallel) {
+            mu_thunk_parallel_reduce(&s_pool, 0, MEM_ITEMS, 0, &acc,
+                                     sizeof(acc), sum_fn, add_fn, NULL);
+        } else {
+            sum_fn(0, MEM_ITEMS, &acc, NULL);
+        }
+        double ms = (double)(bench_now_ns() - start) / 1e6;
+        best = (r == 0 || ms < best) ? ms : best;
+        *sum = acc;
+    }
+    return best;
+}
+
+static double run_compute(bool parallel) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        uint64_t start = bench_now_ns();
+        if (parallel) {
+            mu_thunk_parallel_for(&s_pool, 0, COMPUTE_ITEMS, 0, compute_fn,
+                                  NULL);
+        } else {
+            compute_fn(0, COMPUTE_ITEMS, NULL);
+        }
+        double ms = (double)(bench_now_ns() - start) / 1e6;
+        best = (r == 0 || ms < best) ? ms : best;
+    }
+    return best;
+}
+
+static void report(const char *kernel, const char *what, double ms,
+                   double base_ms) {
+    bench_report_value(kernel, what, "ms", ms);
+    bench_report_value(kernel, what, "speedup", base_ms / ms);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,198 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_pool.c
+ *
+ * @brief Scaling of mu_thunk_pool on 1..N worker threads for recursive
+ *        fork/join spawning (fib) and a flat parallel loop.
+ *
+ * Usage: bench_mu_thunk_pool [max_threads]
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_pool.h"
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DEFAULT_MAX_THREADS 64
+#define FIB_N 32
+#define FIB_CUTOFF 16
+#define LOOP_TASKS 4096
+#define LOOP_WORK 20000
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    int n;
+    long result;
+    atomic_bool done;
+} fib_task_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_pool_t s_pool;
+static atomic_int s_loop_done;
+static volatile uint64_t s_sink;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void submit(mu_thunk_t *thunk, void *args);
+static long fib_serial(int n);
+static long fib_parallel(int n);
+static void fib_fn(mu_thunk_t *thunk, void *args);
+static void loop_fn(mu_thunk_t *thunk, void *args);
+static double run_fib(void);
+static double run_loop(void);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    int arg = bench_init(argc, argv);
+    int max_threads = arg < argc ? atoi(argv[arg]) : DEFAULT_MAX_THREADS;
+    mu_thunk_pool_worker_t *workers =
+        malloc(sizeof(mu_thunk_pool_worker_t) * max_threads);
+    double fib_base = 0;
+    double loop_base = 0;
+
+    for (int n = 1; n <= max_threads; n *= 2) {
+        mu_thunk_pool_init(&s_pool, workers, n);
+        double fib_ms = run_fib();
+        double loop_ms = run_loop();
+        mu_thunk_pool_stop(&s_pool);
+        if (n == 1) {
+            fib_base = fib_ms;
+            loop_base = loop_ms;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "fib %d threads", n);
+        bench_report_value("pool", name, "ms", fib_ms);
+        bench_report_value("pool", name, "speedup", fib_base / fib_ms);
+        snprintf(name, sizeof(name), "loop %d threads", n);
+        bench_report_value("pool", name, "ms", loop_ms);
+        bench_report_value("pool", name, "speedup", loop_base / loop_ms);
+    }
+    bench_finish();
+    free(workers);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void submit(mu_thunk_t *thunk, void *args) {
+    while (!mu_thunk_pool_submit(&s_pool, thunk, args)) {
+        mu_thunk_pool_help(&s_pool);
+    }
+}
+
+static long fib_serial(int n) {
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+// Spawn fib(n-1), compute fib(n-2) inline, then help until the child is done.
+static long fib_parallel(int n) {
+    if (n < FIB_CUTOFF) {
+        return fib_serial(n);
+    }
+    fib_task_t child = {.n = n - 1};
+    atomic_init(&child.done, false);
+    mu_thunk_init(&child.thunk, fib_fn);
+    submit(&child.thunk, NULL);
+    long b = fib_parallel(n - 2);
+    while (!atomic_load_explicit(&child.done, memory_order_acquire)) {
+        if (!mu_thunk_pool_help(&s_pool)) {
+            sched_yield();
+        }
+    }
+    return child.result + b;
+}
+
+static void fib_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    fib_task_t *task = (fib_task_t *)thunk;
+    task->result = fib_parallel(task->n);
+    atomic_store_explicit(&task->done, true, memory_order_release);
+}
+
+static void loop_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    uint64_t x = (uintptr_t)args;
+    for (int i = 0; i < LOOP_WORK; i++) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    s_sink = x;
+    atomic_fetch_add_explicit(&s_loop_done, 1, memory_order_release);
+}
+
+static double run_fib(void) {
+    fib_task_t root = {.n = FIB_N};
+    atomic_init(&root.done, false);
+    mu_thunk_init(&root.thunk, fib_fn);
+    uint64_t start = bench_now_ns();
+    submit(&root.thunk, NULL);
+    while (!atomic_load_explicit(&root.done, memory_order_acquire)) {
+        if (!mu_thunk_pool_help(&s_pool)) {
+            sched_yield();
+        }
+    }
+    double ms = (double)(bench_now_ns() - start) / 1e6;
+    if (root.result != fib_serial(FIB_N)) {
+        fprintf(stderr, "fib(%d) mismatch\n", FIB_N);
+    }
+    return ms;
+}
+
+static double run_loop(void) {
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, loop_fn);
+    atomic_store(&s_loop_done, 0);
+    uint64_t start = bench_now_ns();
+    for (uintptr_t i = 0; i < LOOP_TASKS; i++) {
+        submit(&thunk, (void *)i);
+    }
+    while (atomic_load_explicit(&s_loop_done, memory_order_acquire) <
+           LOOP_TASKS) {
+        if (!mu_thunk_pool_help(&s_pool)) {
+            sched_yield();
+        }
+    }
+    return (double)(bench_now_ns() - start) / 1e6;
+}
+
+// *****************************************************************************
+// End of file
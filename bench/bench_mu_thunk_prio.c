@@ -0,0 +1,231 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_prio.c
+ *
+ * @brief mu_thunk_prio's bitmap run queue against a binary heap keyed by
+ *        (priority, sequence), over 10^6 operations.
+ *
+ * "hold" keeps a fixed population queued and repeatedly gets the next node
+ * and re-puts it at a random level (the classic hold model for event
+ * queues).  "burst" puts 10^6 nodes and then dispatches them all.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_prio.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_OPS 1000000
+#define N_HOLD 1024
+#define N_LEVELS 32 // typical RTOS level count; must be <= MU_THUNK_PRIO_LEVELS
+
+typedef struct {
+    mu_thunk_prio_node_t *node;
+    uint64_t key; /**< priority << 40 | sequence, for FIFO within a level */
+} heap_entry_t;
+
+typedef struct {
+    heap_entry_t *entries;
+    size_t count;
+    uint64_t seq;
+} heap_t;
+
+typedef struct {
+    mu_thunk_prio_node_t *nodes;
+    const uint8_t *prios; /**< Pre-drawn random levels, N_OPS of them */
+    size_t n_nodes;
+} prio_ctx_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_prio_t s_queue;
+static heap_t s_heap;
+static uint64_t s_fired;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void run_hold_bitmap(void *ctx, uint64_t n);
+static void run_hold_heap(void *ctx, uint64_t n);
+static void run_burst_bitmap(void *ctx, uint64_t n);
+static void run_burst_heap(void *ctx, uint64_t n);
+static void heap_put(heap_t *heap, mu_thunk_prio_node_t *node,
+                     unsigned priority);
+static mu_thunk_prio_node_t *heap_get(heap_t *heap);
+static uint64_t next_random(uint64_t *state);
+static void fire_fn(mu_thunk_t *thunk, void *args);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    mu_thunk_prio_node_t *nodes = malloc(sizeof(*nodes) * N_OPS);
+    uint8_t *prios = malloc(N_OPS);
+    uint64_t rng = 88172645463325252ull;
+
+    bench_init(argc, argv);
+    for (size_t i = 0; i < N_OPS; i++) {
+        mu_thunk_prio_node_init(&nodes[i], fire_fn);
+        prios[i] = (uint8_t)(next_random(&rng) % N_LEVELS);
+    }
+    s_heap.entries = malloc(sizeof(heap_entry_t) * N_OPS);
+
+    prio_ctx_t hold = {.nodes = nodes, .prios = prios, .n_nodes = N_HOLD};
+    bench_run("prio hold", "bitmap", run_hold_bitmap, &hold, N_OPS);
+    bench_run("prio hold", "binary heap", run_hold_heap, &hold, N_OPS);
+
+    prio_ctx_t burst = {.nodes = nodes, .prios = prios, .n_nodes = N_OPS};
+    bench_run("prio burst", "bitmap", run_burst_bitmap, &burst, N_OPS);
+    bench_run("prio burst", "binary heap", run_burst_heap, &burst, N_OPS);
+
+    bench_report_value("prio", "thunks fired", "count", (double)s_fired);
+    bench_finish();
+
+    free(s_heap.entries);
+    free(prios);
+    free(nodes);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void run_hold_bitmap(void *ctx, uint64_t n) {
+    prio_ctx_t *c = ctx;
+    mu_thunk_prio_init(&s_queue);
+    for (size_t i = 0; i < c->n_nodes; i++) {
+        mu_thunk_prio_put(&s_queue, &c->nodes[i], c->prios[i]);
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_prio_node_t *node = mu_thunk_prio_get(&s_queue);
+        mu_thunk_prio_put(&s_queue, node, c->prios[i]);
+    }
+    while (mu_thunk_prio_get(&s_queue) != NULL) {
+    }
+}
+
+static void run_hold_heap(void *ctx, uint64_t n) {
+    prio_ctx_t *c = ctx;
+    s_heap.count = 0;
+    s_heap.seq = 0;
+    for (size_t i = 0; i < c->n_nodes; i++) {
+        heap_put(&s_heap, &c->nodes[i], c->prios[i]);
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_prio_node_t *node = heap_get(&s_heap);
+        heap_put(&s_heap, node, c->prios[i]);
+    }
+}
+
+static void run_burst_bitmap(void *ctx, uint64_t n) {
+    prio_ctx_t *c = ctx;
+    mu_thunk_prio_init(&s_queue);
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_prio_put(&s_queue, &c->nodes[i], c->prios[i]);
+    }
+    mu_thunk_prio_drain(&s_queue, NULL, 0);
+}
+
+static void run_burst_heap(void *ctx, uint64_t n) {
+    prio_ctx_t *c = ctx;
+    mu_thunk_prio_node_t *node;
+    s_heap.count = 0;
+    s_heap.seq = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        heap_put(&s_heap, &c->nodes[i], c->prios[i]);
+    }
+    while ((node = heap_get(&s_heap)) != NULL) {
+        _mu_thunk_call(&node->thunk, NULL);
+    }
+}
+
+static void heap_put(heap_t *heap, mu_thunk_prio_node_t *node,
+                     unsigned priority) {
+    heap_entry_t e = {.node = node,
+                      .key = (uint64_t)priority << 40 | heap->seq++};
+    size_t i = heap->count++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (heap->entries[parent].key <= e.key) {
+            break;
+        }
+        heap->entries[i] = heap->entries[parent];
+        i = parent;
+    }
+    heap->entries[i] = e;
+}
+
+static mu_thunk_prio_node_t *heap_get(heap_t *heap) {
+    if (heap->count == 0) {
+        return NULL;
+    }
+    mu_thunk_prio_node_t *top = heap->entries[0].node;
+    heap_entry_t last = heap->entries[--heap->count];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= heap->count) {
+            break;
+        }
+        if (child + 1 < heap->count &&
+            heap->entries[child + 1].key < heap->entries[child].key) {
+            child++;
+        }
+        if (last.key <= heap->entries[child].key) {
+            break;
+        }
+        heap->entries[i] = heap->entries[child];
+        i = child;
+    }
+    heap->entries[i] = last;
+    return top;
+}
+
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void fire_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    s_fired++;
+}
+
+// *****************************************************************************
+// End of file
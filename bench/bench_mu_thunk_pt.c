@@ -0,0 +1,181 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_pt.c
+ *
+ * @brief Resume/yield cost of stackless protothreads (computed-goto and
+ *        switch forms) against stackful mu_thunk_task, on one core.
+ *
+ * - "pt yield": one protothread yields in a loop; an op is one resume
+ *   followed by one yield.  Also reported as millions of yields per second
+ *   over N_RATE_YIELDS.
+ * - "pt round robin": N_PTS protothreads resumed in turn, so each resume
+ *   touches a different struct; also reports the bytes of state per task.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk_pt.h"
+#include "mu_thunk_task.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_YIELD_OPS (20 * 1000 * 1000)
+#define N_RATE_YIELDS (10 * 1000 * 1000)
+#define N_PTS (1000 * 1000)
+#define N_ROUND_ROBIN_OPS (10 * 1000 * 1000)
+#define TASK_STACK (64 * 1024)
+
+typedef struct {
+    mu_thunk_pt_t pt; /**< Must be first member */
+    uint64_t count;
+} counter_pt_t;
+
+typedef struct {
+    const char *name;
+    mu_thunk_t *thunk;
+} subject_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static counter_pt_t s_goto_pt;
+static counter_pt_t s_switch_pt;
+static mu_thunk_task_t s_task;
+static counter_pt_t *s_pts;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void goto_fn(mu_thunk_t *thunk, void *args);
+static void switch_fn(mu_thunk_t *thunk, void *args);
+static void task_body(mu_thunk_t *thunk, void *args);
+static void run_yield(void *ctx, uint64_t n);
+static void run_round_robin(void *ctx, uint64_t n);
+static double yields_per_second(mu_thunk_t *thunk);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    bench_init(argc, argv);
+    void *stack = mu_thunk_task_stack_alloc(TASK_STACK);
+    mu_thunk_pt_init(&s_goto_pt.pt, goto_fn);
+    mu_thunk_pt_init(&s_switch_pt.pt, switch_fn);
+    mu_thunk_task_init(&s_task, task_body, stack, TASK_STACK);
+    subject_t subjects[] = {
+        {"pt computed goto", &s_goto_pt.pt.thunk},
+        {"pt switch", &s_switch_pt.pt.thunk},
+        {"mu_thunk_task", &s_task.thunk},
+    };
+
+    for (size_t i = 0; i < sizeof(subjects) / sizeof(subjects[0]); i++) {
+        bench_run("pt yield", subjects[i].name, run_yield, subjects[i].thunk,
+                  N_YIELD_OPS);
+    }
+    for (size_t i = 0; i < sizeof(subjects) / sizeof(subjects[0]); i++) {
+        bench_report_value("pt yield", subjects[i].name, "Myield/s",
+                           yields_per_second(subjects[i].thunk) / 1e6);
+    }
+
+    s_pts = malloc(sizeof(counter_pt_t) * N_PTS);
+    for (size_t i = 0; i < N_PTS; i++) {
+        mu_thunk_pt_init(&s_pts[i].pt, i % 2 ? goto_fn : switch_fn);
+        s_pts[i].count = 0;
+    }
+    bench_run("pt round robin", "1M protothreads", run_round_robin, NULL,
+              N_ROUND_ROBIN_OPS);
+    bench_report_value("pt round robin", "1M protothreads", "B/task",
+                       (double)sizeof(counter_pt_t));
+
+    bench_finish();
+    free(s_pts);
+    // s_task never finishes; its stack is simply released.
+    mu_thunk_task_stack_free(stack, TASK_STACK);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void goto_fn(mu_thunk_t *thunk, void *args) {
+    counter_pt_t *c = (counter_pt_t *)thunk;
+    (void)args;
+    MU_THUNK_PT_GOTO_BEGIN(&c->pt);
+    for (;;) {
+        c->count++;
+        MU_THUNK_PT_GOTO_YIELD(&c->pt);
+    }
+    MU_THUNK_PT_GOTO_END(&c->pt);
+}
+
+static void switch_fn(mu_thunk_t *thunk, void *args) {
+    counter_pt_t *c = (counter_pt_t *)thunk;
+    (void)args;
+    MU_THUNK_PT_SWITCH_BEGIN(&c->pt);
+    for (;;) {
+        c->count++;
+        MU_THUNK_PT_SWITCH_YIELD(&c->pt);
+    }
+    MU_THUNK_PT_SWITCH_END(&c->pt);
+}
+
+static void task_body(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    for (;;) {
+        mu_thunk_task_yield();
+    }
+}
+
+static void run_yield(void *ctx, uint64_t n) {
+    mu_thunk_t *thunk = (mu_thunk_t *)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        _mu_thunk_call(thunk, NULL);
+    }
+}
+
+static void run_round_robin(void *ctx, uint64_t n) {
+    (void)ctx;
+    size_t k = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        _mu_thunk_call(&s_pts[k].pt.thunk, NULL);
+        k = k + 1 == N_PTS ? 0 : k + 1;
+    }
+}
+
+static double yields_per_second(mu_thunk_t *thunk) {
+    uint64_t start = bench_now_ns();
+    run_yield(thunk, N_RATE_YIELDS);
+    return (double)N_RATE_YIELDS * 1e9 / (double)(bench_now_ns() - start);
+}
+
+// *****************************************************************************
+// End of file
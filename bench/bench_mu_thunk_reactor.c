@@ -0,0 +1,177 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_reactor.c
+ *
+ * @brief Loopback TCP echo served by mu_thunk_reactor: requests per second
+ *        and round-trip latency percentiles for a ping-pong client.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_reactor.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_REQUESTS 100000
+#define MSG_SIZE 64
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    int fd;
+} conn_thunk_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_reactor_t s_reactor;
+static mu_thunk_t s_accept_thunk;
+static conn_thunk_t s_conn;
+static int s_listen_fd;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void accept_fn(mu_thunk_t *thunk, void *args);
+static void echo_fn(mu_thunk_t *thunk, void *args);
+static void *server_main(void *arg);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    struct sockaddr_in addr = {.sin_family = AF_INET,
+                               .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t len = sizeof(addr);
+    int one = 1;
+
+    bench_init(argc, argv);
+
+    s_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    setsockopt(s_listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(s_listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(s_listen_fd, 16) < 0) {
+        perror("bind/listen");
+        return 1;
+    }
+    getsockname(s_listen_fd, (struct sockaddr *)&addr, &len);
+
+    mu_thunk_reactor_init(&s_reactor);
+    mu_thunk_init(&s_accept_thunk, accept_fn);
+    mu_thunk_reactor_add(&s_reactor, s_listen_fd, EPOLLIN, &s_accept_thunk);
+    pthread_t server;
+    pthread_create(&server, NULL, server_main, NULL);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("connect");
+        return 1;
+    }
+
+    double *rtt = malloc(sizeof(double) * N_REQUESTS);
+    char buf[MSG_SIZE] = {0};
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < N_REQUESTS; i++) {
+        uint64_t t0 = bench_now_ns();
+        if (write(fd, buf, MSG_SIZE) != MSG_SIZE) {
+            perror("write");
+            return 1;
+        }
+        for (ssize_t got = 0; got < MSG_SIZE;) {
+            ssize_t n = read(fd, buf + got, MSG_SIZE - got);
+            if (n <= 0) {
+                perror("read");
+                return 1;
+            }
+            got += n;
+        }
+        rtt[i] = (double)(bench_now_ns() - t0) / 1e3;
+    }
+    double elapsed_s = (double)(bench_now_ns() - start) / 1e9;
+
+    bench_report_value("reactor", "tcp echo", "req/s", N_REQUESTS / elapsed_s);
+    bench_report_samples("reactor", "tcp echo rtt", "us", rtt, N_REQUESTS);
+    bench_finish();
+
+    close(fd);
+    mu_thunk_reactor_stop(&s_reactor);
+    pthread_join(server, NULL);
+    mu_thunk_reactor_deinit(&s_reactor);
+    close(s_listen_fd);
+    free(rtt);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void accept_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    int one = 1;
+    s_conn.fd = accept(s_listen_fd, NULL, NULL);
+    setsockopt(s_conn.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    mu_thunk_init(&s_conn.thunk, echo_fn);
+    mu_thunk_reactor_add(&s_reactor, s_conn.fd, EPOLLIN, &s_conn.thunk);
+}
+
+static void echo_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    conn_thunk_t *conn = (conn_thunk_t *)thunk;
+    char buf[4096];
+    ssize_t n = read(conn->fd, buf, sizeof(buf));
+    if (n <= 0) {
+        mu_thunk_reactor_remove(&s_reactor, conn->fd);
+        close(conn->fd);
+        return;
+    }
+    if (write(conn->fd, buf, n) != n) {
+        perror("echo write");
+    }
+}
+
+static void *server_main(void *arg) {
+    (void)arg;
+    mu_thunk_reactor_run(&s_reactor);
+    return NULL;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,173 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_ring.c
+ *
+ * @brief Producer/consumer throughput of mu_thunk_ring versus a
+ *        mutex-protected ring of the same capacity.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_ring.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define CAPACITY 1024
+#define N_OPS 10000000
+
+typedef struct {
+    pthread_mutex_t lock;
+    mu_thunk_t *store[CAPACITY];
+    size_t head;
+    size_t tail;
+} mutex_ring_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_t *s_store[CAPACITY];
+static mu_thunk_ring_t s_ring;
+static mutex_ring_t s_mutex_ring;
+static mu_thunk_t s_thunk;
+static volatile uint64_t s_calls;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void count_fn(mu_thunk_t *thunk, void *args);
+static bool mutex_ring_put(mutex_ring_t *q, mu_thunk_t *thunk);
+static mu_thunk_t *mutex_ring_get(mutex_ring_t *q);
+static void *ring_producer(void *arg);
+static void *mutex_producer(void *arg);
+static double run_ring(void);
+static double run_mutex(void);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    bench_init(argc, argv);
+    mu_thunk_init(&s_thunk, count_fn);
+    mu_thunk_ring_init(&s_ring, s_store, CAPACITY);
+    pthread_mutex_init(&s_mutex_ring.lock, NULL);
+
+    bench_report_value("ring", "mu_thunk_ring", "ns/op", run_ring());
+    bench_report_value("ring", "mutex ring", "ns/op", run_mutex());
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void count_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    s_calls++;
+}
+
+static bool mutex_ring_put(mutex_ring_t *q, mu_thunk_t *thunk) {
+    bool ok = false;
+    pthread_mutex_lock(&q->lock);
+    if (q->tail - q->head < CAPACITY) {
+        q->store[q->tail++ % CAPACITY] = thunk;
+        ok = true;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+static mu_thunk_t *mutex_ring_get(mutex_ring_t *q) {
+    mu_thunk_t *thunk = NULL;
+    pthread_mutex_lock(&q->lock);
+    if (q->head != q->tail) {
+        thunk = q->store[q->head++ % CAPACITY];
+    }
+    pthread_mutex_unlock(&q->lock);
+    return thunk;
+}
+
+static void *ring_producer(void *arg) {
+    (void)arg;
+    for (int i = 0; i < N_OPS; i++) {
+        while (!mu_thunk_ring_put(&s_ring, &s_thunk)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *mutex_producer(void *arg) {
+    (void)arg;
+    for (int i = 0; i < N_OPS; i++) {
+        while (!mutex_ring_put(&s_mutex_ring, &s_thunk)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static double run_ring(void) {
+    pthread_t producer;
+    s_calls = 0;
+    uint64_t start = bench_now_ns();
+    pthread_create(&producer, NULL, ring_producer, NULL);
+    while (s_calls < N_OPS) {
+        if (mu_thunk_ring_drain(&s_ring, NULL) == 0) {
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+    return (double)(bench_now_ns() - start) / N_OPS;
+}
+
+static double run_mutex(void) {
+    pthread_t producer;
+    s_calls = 0;
+    uint64_t start = bench_now_ns();
+    pthread_create(&producer, NULL, mutex_producer, NULL);
+    while (s_calls < N_OPS) {
+        mu_thunk_t *thunk = mutex_ring_get(&s_mutex_ring);
+        if (thunk == NULL) {
+            sched_yield();
+        } else {
+            _mu_thunk_call(thunk, NULL);
+        }
+    }
+    pthread_join(producer, NULL);
+    return (double)(bench_now_ns() - start) / N_OPS;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,196 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_sbo.c
+ *
+ * @brief Cost of posting a thunk with arguments: a heap-allocated
+ *        thunk+args struct through mu_thunk_ring against an inline copy
+ *        through mu_thunk_sbo_ring.
+ *
+ * - "burst": post 64 calls, then drain them, on one thread.  Run for
+ *   payloads of 16, 32 and 48 bytes.
+ * - "handoff": a producer posts 48-byte calls to a consumer thread that
+ *   runs them (and, for malloc, frees them remotely).
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_ring.h"
+#include "mu_thunk_sbo.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define BURST 64
+#define RING_CAPACITY 1024
+#define N_BURST_OPS (2 * 1000 * 1000)
+#define N_HANDOFF_OPS (1000 * 1000)
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    unsigned char args[MU_THUNK_SBO_SIZE];
+} heap_call_t;
+
+typedef struct {
+    bool sbo;
+    size_t size;
+} post_ctx_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_ring_t s_ring;
+static mu_thunk_t *s_ring_store[RING_CAPACITY];
+static mu_thunk_sbo_ring_t s_sbo_ring;
+static mu_thunk_sbo_t s_sbo_store[RING_CAPACITY];
+static volatile uint64_t s_sum;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void heap_fn(mu_thunk_t *thunk, void *args);
+static void sbo_fn(mu_thunk_t *thunk, void *args);
+static void post(const post_ctx_t *pc, const void *args);
+static void run_burst(void *ctx, uint64_t n);
+static void run_handoff(void *ctx, uint64_t n);
+static void *consumer_main(void *arg);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    static const char *names[2][3] = {
+        {"malloc 16B", "malloc 32B", "malloc 48B"},
+        {"mu_thunk_sbo 16B", "mu_thunk_sbo 32B", "mu_thunk_sbo 48B"},
+    };
+    bench_init(argc, argv);
+    mu_thunk_ring_init(&s_ring, s_ring_store, RING_CAPACITY);
+    mu_thunk_sbo_ring_init(&s_sbo_ring, s_sbo_store, RING_CAPACITY);
+
+    for (int i = 0; i < 3; i++) {
+        for (int sbo = 0; sbo <= 1; sbo++) {
+            post_ctx_t pc = {.sbo = sbo, .size = 16 * (size_t)(i + 1)};
+            bench_run("sbo burst", names[sbo][i], run_burst, &pc,
+                      N_BURST_OPS);
+        }
+    }
+    for (int sbo = 0; sbo <= 1; sbo++) {
+        post_ctx_t pc = {.sbo = sbo, .size = MU_THUNK_SBO_SIZE};
+        bench_run("sbo handoff", names[sbo][2], run_handoff, &pc,
+                  N_HANDOFF_OPS);
+    }
+
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void heap_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    uint64_t id;
+    memcpy(&id, ((heap_call_t *)thunk)->args, sizeof(id));
+    s_sum += id;
+    free(thunk);
+}
+
+static void sbo_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    uint64_t id;
+    memcpy(&id, args, sizeof(id));
+    s_sum += id;
+}
+
+static void post(const post_ctx_t *pc, const void *args) {
+    if (pc->sbo) {
+        while (!mu_thunk_sbo_ring_put(&s_sbo_ring, sbo_fn, args, pc->size)) {
+            sched_yield();
+        }
+    } else {
+        heap_call_t *call = malloc(sizeof(heap_call_t));
+        mu_thunk_init(&call->thunk, heap_fn);
+        memcpy(call->args, args, pc->size);
+        while (!mu_thunk_ring_put(&s_ring, &call->thunk)) {
+            sched_yield();
+        }
+    }
+}
+
+static void run_burst(void *ctx, uint64_t n) {
+    const post_ctx_t *pc = (const post_ctx_t *)ctx;
+    unsigned char args[MU_THUNK_SBO_SIZE] = {0};
+    for (uint64_t done = 0; done < n; done += BURST) {
+        for (int i = 0; i < BURST; i++) {
+            uint64_t id = done + i;
+            memcpy(args, &id, sizeof(id));
+            post(pc, args);
+        }
+        if (pc->sbo) {
+            mu_thunk_sbo_ring_drain(&s_sbo_ring);
+        } else {
+            mu_thunk_ring_drain(&s_ring, NULL);
+        }
+    }
+}
+
+static void run_handoff(void *ctx, uint64_t n) {
+    const post_ctx_t *pc = (const post_ctx_t *)ctx;
+    unsigned char args[MU_THUNK_SBO_SIZE] = {0};
+    void *targs[2] = {(void *)pc, &n};
+    pthread_t thread;
+    pthread_create(&thread, NULL, consumer_main, targs);
+    for (uint64_t i = 0; i < n; i++) {
+        memcpy(args, &i, sizeof(i));
+        post(pc, args);
+    }
+    pthread_join(thread, NULL);
+}
+
+static void *consumer_main(void *arg) {
+    void **targs = (void **)arg;
+    const post_ctx_t *pc = (const post_ctx_t *)targs[0];
+    uint64_t remaining = *(uint64_t *)targs[1];
+    while (remaining > 0) {
+        size_t ran = pc->sbo ? mu_thunk_sbo_ring_drain(&s_sbo_ring)
+                             : mu_thunk_ring_drain(&s_ring, NULL);
+        if (ran == 0) {
+            sched_yield();
+        }
+        remaining -= ran;
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,234 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_slab.c
+ *
+ * @brief Allocation churn of thunk-bearing request structs: mu_thunk_slab
+ *        against glibc malloc and aligned_alloc.
+ *
+ * - "burst": allocate 64 requests, run each thunk, free them all.
+ * - "steady": keep 4096 requests live, replacing a random one per op.
+ * - "handoff": a producer allocates requests and passes them through a
+ *   mu_thunk_ring to a consumer that runs and frees them (remote frees).
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_ring.h"
+#include "mu_thunk_slab.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define BURST 64
+#define LIVE_SET 4096
+#define RING_CAPACITY 1024
+#define N_BURST_OPS (2 * 1000 * 1000)
+#define N_STEADY_OPS (2 * 1000 * 1000)
+#define N_HANDOFF_OPS (1000 * 1000)
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    uint64_t id;
+    char payload[40];
+} request_t;
+
+typedef enum {
+    ALLOC_MALLOC,
+    ALLOC_ALIGNED,
+    ALLOC_SLAB,
+} allocator_t;
+
+typedef struct {
+    allocator_t kind;
+    mu_thunk_slab_cache_t *cache;
+} alloc_ctx_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_slab_t s_slab;
+static mu_thunk_slab_cache_t s_cache;
+static mu_thunk_ring_t s_ring;
+static mu_thunk_t *s_ring_store[RING_CAPACITY];
+static volatile uint64_t s_sum;
+static const char *s_names[] = {"malloc", "aligned_alloc", "mu_thunk_slab"};
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void *request_alloc(alloc_ctx_t *ctx);
+static void request_free(alloc_ctx_t *ctx, void *obj);
+static void request_fn(mu_thunk_t *thunk, void *args);
+static void run_burst(void *ctx, uint64_t n);
+static void run_steady(void *ctx, uint64_t n);
+static void run_handoff(void *ctx, uint64_t n);
+static void *consumer_main(void *arg);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    bench_init(argc, argv);
+    mu_thunk_slab_init(&s_slab, sizeof(request_t));
+    mu_thunk_slab_cache_init(&s_cache, &s_slab);
+    mu_thunk_ring_init(&s_ring, s_ring_store, RING_CAPACITY);
+
+    for (int kind = ALLOC_MALLOC; kind <= ALLOC_SLAB; kind++) {
+        alloc_ctx_t ctx = {.kind = (allocator_t)kind, .cache = &s_cache};
+        bench_run("slab burst", s_names[kind], run_burst, &ctx, N_BURST_OPS);
+    }
+    for (int kind = ALLOC_MALLOC; kind <= ALLOC_SLAB; kind++) {
+        alloc_ctx_t ctx = {.kind = (allocator_t)kind, .cache = &s_cache};
+        bench_run("slab steady", s_names[kind], run_steady, &ctx,
+                  N_STEADY_OPS);
+    }
+    for (int kind = ALLOC_MALLOC; kind <= ALLOC_SLAB; kind++) {
+        alloc_ctx_t ctx = {.kind = (allocator_t)kind, .cache = &s_cache};
+        bench_run("slab handoff", s_names[kind], run_handoff, &ctx,
+                  N_HANDOFF_OPS);
+    }
+
+    bench_finish();
+    mu_thunk_slab_deinit(&s_slab);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void *request_alloc(alloc_ctx_t *ctx) {
+    switch (ctx->kind) {
+    case ALLOC_MALLOC:
+        return malloc(sizeof(request_t));
+    case ALLOC_ALIGNED:
+        return aligned_alloc(MU_THUNK_CACHE_LINE, MU_THUNK_CACHE_LINE);
+    case ALLOC_SLAB:
+        return mu_thunk_slab_alloc(ctx->cache);
+    }
+    return NULL;
+}
+
+static void request_free(alloc_ctx_t *ctx, void *obj) {
+    if (ctx->kind == ALLOC_SLAB) {
+        mu_thunk_slab_free(ctx->cache, obj);
+    } else {
+        free(obj);
+    }
+}
+
+static void request_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    s_sum += ((request_t *)thunk)->id;
+}
+
+static void run_burst(void *ctx, uint64_t n) {
+    alloc_ctx_t *ac = (alloc_ctx_t *)ctx;
+    request_t *reqs[BURST];
+    for (uint64_t done = 0; done < n; done += BURST) {
+        for (int i = 0; i < BURST; i++) {
+            reqs[i] = request_alloc(ac);
+            mu_thunk_init(&reqs[i]->thunk, request_fn);
+            reqs[i]->id = done + i;
+        }
+        for (int i = 0; i < BURST; i++) {
+            _mu_thunk_call(&reqs[i]->thunk, NULL);
+            request_free(ac, reqs[i]);
+        }
+    }
+}
+
+static void run_steady(void *ctx, uint64_t n) {
+    alloc_ctx_t *ac = (alloc_ctx_t *)ctx;
+    static request_t *live[LIVE_SET];
+    uint64_t rng = 0x9e3779b97f4a7c15ull;
+    for (int i = 0; i < LIVE_SET; i++) {
+        live[i] = request_alloc(ac);
+        mu_thunk_init(&live[i]->thunk, request_fn);
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        size_t k = rng % LIVE_SET;
+        _mu_thunk_call(&live[k]->thunk, NULL);
+        request_free(ac, live[k]);
+        live[k] = request_alloc(ac);
+        mu_thunk_init(&live[k]->thunk, request_fn);
+        live[k]->id = i;
+    }
+    for (int i = 0; i < LIVE_SET; i++) {
+        request_free(ac, live[i]);
+    }
+}
+
+static void run_handoff(void *ctx, uint64_t n) {
+    alloc_ctx_t *ac = (alloc_ctx_t *)ctx;
+    alloc_ctx_t consumer = {.kind = ac->kind};
+    uint64_t count = n;
+    void *args[2] = {&consumer, &count};
+    pthread_t thread;
+    pthread_create(&thread, NULL, consumer_main, args);
+    for (uint64_t i = 0; i < n; i++) {
+        request_t *req = request_alloc(ac);
+        mu_thunk_init(&req->thunk, request_fn);
+        req->id = i;
+        while (!mu_thunk_ring_put(&s_ring, &req->thunk)) {
+            sched_yield();
+        }
+    }
+    pthread_join(thread, NULL);
+}
+
+static void *consumer_main(void *arg) {
+    void **args = (void **)arg;
+    alloc_ctx_t *ac = (alloc_ctx_t *)args[0];
+    uint64_t remaining = *(uint64_t *)args[1];
+    mu_thunk_slab_cache_t cache;
+    mu_thunk_slab_cache_init(&cache, &s_slab);
+    ac->cache = &cache;
+    while (remaining > 0) {
+        mu_thunk_t *thunk = mu_thunk_ring_get(&s_ring);
+        if (thunk == NULL) {
+            sched_yield();
+            continue;
+        }
+        _mu_thunk_call(thunk, NULL);
+        request_free(ac, thunk);
+        remaining--;
+    }
+    mu_thunk_slab_cache_flush(&cache);
+    return NULL;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,125 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_stats.c
+ *
+ * @brief Overhead of instrumented dispatch: _mu_thunk_call() as built
+ *        without MU_THUNK_STATS (the compiled-out case) against
+ *        mu_thunk_stats_call(), which is what _mu_thunk_call() becomes with
+ *        the flag.  Also exports the recorded histogram as a demonstration.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_stats.h"
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_THUNKS 1024
+#define N_CALLS (5 * 1000 * 1000)
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    uint64_t count;
+} counting_thunk_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static counting_thunk_t s_thunks[N_THUNKS];
+static mu_thunk_stats_snapshot_t s_snap;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void count_fn(mu_thunk_t *thunk, void *args);
+static void count_twice_fn(mu_thunk_t *thunk, void *args);
+static void run_plain(void *ctx, uint64_t n);
+static void run_stats(void *ctx, uint64_t n);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    bench_init(argc, argv);
+    for (int i = 0; i < N_THUNKS; i++) {
+        mu_thunk_init(&s_thunks[i].thunk,
+                      (i & 1) ? count_twice_fn : count_fn);
+    }
+    bench_run("stats", "compiled out", run_plain, NULL, N_CALLS);
+    bench_run("stats", "mu_thunk_stats_call", run_stats, NULL, N_CALLS);
+
+    mu_thunk_stats_snapshot(&s_snap);
+    const mu_thunk_stats_entry_t *e = mu_thunk_stats_find(&s_snap, count_fn);
+    if (e != NULL) {
+        bench_report_value("stats", "count_fn calls", "count",
+                           (double)e->count);
+        bench_report_value("stats", "count_fn p50", "ns",
+                           (double)mu_thunk_stats_percentile(e, 50));
+        bench_report_value("stats", "count_fn p99", "ns",
+                           (double)mu_thunk_stats_percentile(e, 99));
+    }
+    bench_finish();
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void count_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    ((counting_thunk_t *)thunk)->count++;
+}
+
+static void count_twice_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    ((counting_thunk_t *)thunk)->count += 2;
+}
+
+static void run_plain(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_t *thunk = &s_thunks[i & (N_THUNKS - 1)].thunk;
+        __asm__ volatile("" : "+r"(thunk)::"memory");
+        _mu_thunk_call(thunk, NULL);
+    }
+}
+
+static void run_stats(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_t *thunk = &s_thunks[i & (N_THUNKS - 1)].thunk;
+        __asm__ volatile("" : "+r"(thunk)::"memory");
+        mu_thunk_stats_call(thunk, NULL);
+    }
+}
+
+// *****************************************************************************
+// End of file
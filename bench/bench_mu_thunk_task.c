@@ -0,0 +1,236 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_task.c
+ *
+ * @brief mu_thunk_task context switch cost against swapcontext(), and the
+ *        memory footprint of many concurrently suspended tasks.
+ *
+ * - "task switch": a task yields back to a loop that resumes it; one op is
+ *   one switch (half a resume/yield round trip).
+ * - "task footprint": start N tasks (default 1,000,000) that each suspend
+ *   mid-body, report resident bytes per task and the time to create and
+ *   start one, then finish them all.  Stacks of FOOTPRINT_STACK bytes are
+ *   carved from a single mapping: a guard page per stack would need two
+ *   kernel mappings per task, far beyond the default vm.max_map_count of
+ *   65530.  N_GUARDED tasks on guarded stacks are measured separately.
+ *
+ * Usage: bench_mu_thunk_task [n_tasks]
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk_task.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_SWITCH_OPS (4 * 1000 * 1000)
+#define N_UCONTEXT_OPS (1000 * 1000)
+#define SWITCH_STACK (64 * 1024)
+#define DEFAULT_N_TASKS (1000 * 1000)
+#define FOOTPRINT_STACK 2048
+#define GUARDED_STACK 4096
+#define N_GUARDED 10000
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_task_t s_switch_task;
+static ucontext_t s_main_ctx;
+static ucontext_t s_uctx;
+static volatile int s_stop;
+static volatile uint64_t s_sink;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void pingpong_body(mu_thunk_t *thunk, void *args);
+static void uctx_body(void);
+static void suspend_body(mu_thunk_t *thunk, void *args);
+static void run_task_switch(void *ctx, uint64_t n);
+static void run_ucontext_switch(void *ctx, uint64_t n);
+static size_t rss_bytes(void);
+static void footprint(size_t n_tasks);
+static void footprint_guarded(void);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    int arg = bench_init(argc, argv);
+    size_t n_tasks = arg < argc ? (size_t)atol(argv[arg]) : DEFAULT_N_TASKS;
+    void *stack = mu_thunk_task_stack_alloc(SWITCH_STACK);
+    void *ustack = malloc(SWITCH_STACK);
+
+    s_stop = 0;
+    mu_thunk_task_init(&s_switch_task, pingpong_body, stack, SWITCH_STACK);
+    bench_run("task switch", "mu_thunk_task", run_task_switch, NULL,
+              N_SWITCH_OPS);
+    s_stop = 1;
+    mu_thunk_task_resume(&s_switch_task, NULL);
+
+    s_stop = 0;
+    getcontext(&s_uctx);
+    s_uctx.uc_stack.ss_sp = ustack;
+    s_uctx.uc_stack.ss_size = SWITCH_STACK;
+    s_uctx.uc_link = &s_main_ctx;
+    makecontext(&s_uctx, uctx_body, 0);
+    bench_run("task switch", "swapcontext", run_ucontext_switch, NULL,
+              N_UCONTEXT_OPS);
+    s_stop = 1;
+    swapcontext(&s_main_ctx, &s_uctx);
+
+    footprint(n_tasks);
+    footprint_guarded();
+
+    bench_finish();
+    free(ustack);
+    mu_thunk_task_stack_free(stack, SWITCH_STACK);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void pingpong_body(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    while (!s_stop) {
+        mu_thunk_task_yield();
+    }
+}
+
+static void uctx_body(void) {
+    while (!s_stop) {
+        swapcontext(&s_uctx, &s_main_ctx);
+    }
+}
+
+/** Touch a little stack, as a suspended handler would, then wait. */
+static void suspend_body(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    volatile char frame[128];
+    frame[0] = (char)(uintptr_t)thunk;
+    mu_thunk_task_yield();
+    s_sink += (uint64_t)frame[0];
+}
+
+static void run_task_switch(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i += 2) {
+        _mu_thunk_call(&s_switch_task.thunk, NULL);
+    }
+}
+
+static void run_ucontext_switch(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i += 2) {
+        swapcontext(&s_main_ctx, &s_uctx);
+    }
+}
+
+static size_t rss_bytes(void) {
+    unsigned long size = 0;
+    unsigned long resident = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (f != NULL) {
+        if (fscanf(f, "%lu %lu", &size, &resident) != 2) {
+            resident = 0;
+        }
+        fclose(f);
+    }
+    return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+static void footprint(size_t n_tasks) {
+    size_t before = rss_bytes();
+    mu_thunk_task_t *tasks = malloc(sizeof(mu_thunk_task_t) * n_tasks);
+    char *stacks = mmap(NULL, n_tasks * FOOTPRINT_STACK,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (tasks == NULL || stacks == MAP_FAILED) {
+        fprintf(stderr, "footprint: cannot allocate %zu tasks\n", n_tasks);
+        free(tasks);
+        return;
+    }
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n_tasks; i++) {
+        mu_thunk_task_init(&tasks[i], suspend_body,
+                           stacks + i * FOOTPRINT_STACK, FOOTPRINT_STACK);
+        _mu_thunk_call(&tasks[i].thunk, NULL);
+    }
+    double start_ns = (double)(bench_now_ns() - start) / (double)n_tasks;
+    size_t during = rss_bytes();
+    start = bench_now_ns();
+    for (size_t i = 0; i < n_tasks; i++) {
+        _mu_thunk_call(&tasks[i].thunk, NULL);
+    }
+    double finish_ns = (double)(bench_now_ns() - start) / (double)n_tasks;
+
+    char name[32];
+    snprintf(name, sizeof(name), "%zu tasks", n_tasks);
+    bench_report_value("task footprint", name, "B/task",
+                       (double)(during - before) / (double)n_tasks);
+    bench_report_value("task footprint", name, "MiB",
+                       (double)(during - before) / (1024.0 * 1024.0));
+    bench_report_value("task footprint", name, "ns/start", start_ns);
+    bench_report_value("task footprint", name, "ns/finish", finish_ns);
+    munmap(stacks, n_tasks * FOOTPRINT_STACK);
+    free(tasks);
+}
+
+static void footprint_guarded(void) {
+    static mu_thunk_task_t tasks[N_GUARDED];
+    static void *stacks[N_GUARDED];
+    size_t before = rss_bytes();
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < N_GUARDED; i++) {
+        stacks[i] = mu_thunk_task_stack_alloc(GUARDED_STACK);
+        mu_thunk_task_init(&tasks[i], suspend_body, stacks[i],
+                           GUARDED_STACK);
+        _mu_thunk_call(&tasks[i].thunk, NULL);
+    }
+    double start_ns = (double)(bench_now_ns() - start) / N_GUARDED;
+    size_t during = rss_bytes();
+    for (size_t i = 0; i < N_GUARDED; i++) {
+        _mu_thunk_call(&tasks[i].thunk, NULL);
+        mu_thunk_task_stack_free(stacks[i], GUARDED_STACK);
+    }
+    bench_report_value("task footprint", "guarded", "B/task",
+                       (double)(during - before) / N_GUARDED);
+    bench_report_value("task footprint", "guarded", "ns/start", start_ns);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,135 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_trace.c
+ *
+ * @brief Cost of traced dispatch at several sampling rates, against the
+ *        untraced _mu_thunk_call(), plus the cost of flushing a full ring.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_trace.h"
+#include <stdint.h>
+#include <stdio.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_THUNKS 1024
+#define N_CALLS (2 * 1000 * 1000)
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    uint64_t count;
+} counting_thunk_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static counting_thunk_t s_thunks[N_THUNKS];
+static FILE *s_null;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void count_fn(mu_thunk_t *thunk, void *args);
+static void run_plain(void *ctx, uint64_t n);
+static void run_traced(void *ctx, uint64_t n);
+static void run_flush(void *ctx, uint64_t n);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    static const unsigned samplings[] = {1, 16, 256, 0};
+    bench_init(argc, argv);
+    s_null = fopen("/dev/null", "w");
+    for (int i = 0; i < N_THUNKS; i++) {
+        mu_thunk_init(&s_thunks[i].thunk, count_fn);
+    }
+
+    bench_run("trace", "untraced", run_plain, NULL, N_CALLS);
+    for (size_t i = 0; i < sizeof(samplings) / sizeof(samplings[0]); i++) {
+        char name[32];
+        if (samplings[i] == 0) {
+            snprintf(name, sizeof(name), "disabled");
+        } else {
+            snprintf(name, sizeof(name), "sampling 1/%u", samplings[i]);
+        }
+        mu_thunk_trace_set_sampling(samplings[i]);
+        bench_run("trace", name, run_traced, NULL, N_CALLS);
+    }
+    mu_thunk_trace_set_sampling(1);
+    bench_run("trace", "flush per event", run_flush, NULL,
+              MU_THUNK_TRACE_RING_SIZE);
+
+    bench_finish();
+    fclose(s_null);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void count_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    ((counting_thunk_t *)thunk)->count++;
+}
+
+static void run_plain(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_t *thunk = &s_thunks[i & (N_THUNKS - 1)].thunk;
+        __asm__ volatile("" : "+r"(thunk)::"memory");
+        _mu_thunk_call(thunk, NULL);
+    }
+}
+
+static void run_traced(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_t *thunk = &s_thunks[i & (N_THUNKS - 1)].thunk;
+        __asm__ volatile("" : "+r"(thunk)::"memory");
+        mu_thunk_trace_call(thunk, NULL);
+    }
+    mu_thunk_trace_flush(s_null);
+}
+
+// Fill the ring (untimed would be better, but the fill is cheap next to
+// formatting), then flush it.
+static void run_flush(void *ctx, uint64_t n) {
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++) {
+        mu_thunk_trace_call(&s_thunks[0].thunk, NULL);
+    }
+    mu_thunk_trace_flush(s_null);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,328 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_uring.c
+ *
+ * @brief Batched 4 KiB reads from a page-cached file: a blocking pread loop
+ *        against mu_thunk_uring (native io_uring and the epoll fallback),
+ *        64-byte SEND/RECV pairs over a socketpair against a blocking
+ *        write/read loop, plus NOP round trips to show per-completion
+ *        dispatch cost.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_uring.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define FILE_SIZE (64u << 20)
+#define READ_SIZE 4096u
+#define N_READS (FILE_SIZE / READ_SIZE)
+#define QUEUE_DEPTH 32u
+#define N_NOPS 1000000u
+#define MSG_SIZE 64u
+#define N_MSGS 200000u
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    unsigned index;   /**< Buffer slot, also the registered buffer index */
+    bool fixed;       /**< Use READ_FIXED rather than READ */
+} read_thunk_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_uring_t s_uring;
+static read_thunk_t s_reads[QUEUE_DEPTH];
+static char s_buffers[QUEUE_DEPTH][READ_SIZE];
+static struct iovec s_iov[QUEUE_DEPTH];
+static int s_fd;
+static unsigned s_next_block;
+static unsigned s_done;
+static uint64_t s_checksum;
+static mu_thunk_t s_nop_thunk;
+static unsigned s_nops;
+static int s_sv[2];
+static char s_msg_out[MSG_SIZE];
+static char s_msg_in[MSG_SIZE];
+static mu_thunk_t s_send_thunk;
+static mu_thunk_t s_recv_thunk;
+static unsigned s_msgs;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void report(const char *name, unsigned ops, uint64_t ns);
+static void bench_pread(void);
+static void bench_uring_read(unsigned flags, bool fixed);
+static void bench_uring_nop(unsigned flags);
+static void bench_socket_rw(void);
+static void bench_uring_socket(unsigned flags);
+static void queue_read(read_thunk_t *rt);
+static void read_fn(mu_thunk_t *thunk, void *args);
+static void nop_fn(mu_thunk_t *thunk, void *args);
+static void send_fn(mu_thunk_t *thunk, void *args);
+static void recv_fn(mu_thunk_t *thunk, void *args);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    char path[] = "/tmp/bench_mu_thunk_uring_XXXXXX";
+    bench_init(argc, argv);
+    s_fd = mkstemp(path);
+    if (s_fd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+    unlink(path);
+    char *block = malloc(READ_SIZE);
+    for (unsigned i = 0; i < N_READS; i++) {
+        memset(block, (int)i, READ_SIZE);
+        if (write(s_fd, block, READ_SIZE) != (ssize_t)READ_SIZE) {
+            perror("write");
+            return 1;
+        }
+    }
+    free(block);
+    for (unsigned i = 0; i < QUEUE_DEPTH; i++) {
+        s_iov[i].iov_base = s_buffers[i];
+        s_iov[i].iov_len = READ_SIZE;
+    }
+
+    bench_pread();
+    bench_uring_read(0, false);
+    bench_uring_read(0, true);
+    bench_uring_read(MU_THUNK_URING_FALLBACK, false);
+    bench_uring_read(MU_THUNK_URING_FALLBACK, true);
+    bench_uring_nop(0);
+    bench_uring_nop(MU_THUNK_URING_FALLBACK);
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, s_sv) < 0) {
+        perror("socketpair");
+        return 1;
+    }
+    memset(s_msg_out, 'm', MSG_SIZE);
+    bench_socket_rw();
+    bench_uring_socket(0);
+    bench_uring_socket(MU_THUNK_URING_FALLBACK);
+
+    bench_finish();
+    close(s_sv[0]);
+    close(s_sv[1]);
+    close(s_fd);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void report(const char *name, unsigned ops, uint64_t ns) {
+    bench_report_value("uring", name, "ns/op", (double)ns / ops);
+}
+
+static void bench_pread(void) {
+    uint64_t checksum = 0;
+    uint64_t start = bench_now_ns();
+    for (unsigned i = 0; i < N_READS; i++) {
+        if (pread(s_fd, s_buffers[0], READ_SIZE, (off_t)i * READ_SIZE) !=
+            (ssize_t)READ_SIZE) {
+            perror("pread");
+            exit(1);
+        }
+        checksum += (unsigned char)s_buffers[0][0];
+    }
+    report("pread loop", N_READS, bench_now_ns() - start);
+    s_checksum = checksum;
+}
+
+static void bench_uring_read(unsigned flags, bool fixed) {
+    char name[64];
+    if (mu_thunk_uring_init(&s_uring, QUEUE_DEPTH, flags) == NULL) {
+        perror("mu_thunk_uring_init");
+        exit(1);
+    }
+    if (fixed && !mu_thunk_uring_register_buffers(&s_uring, s_iov,
+                                                  QUEUE_DEPTH)) {
+        perror("mu_thunk_uring_register_buffers");
+        exit(1);
+    }
+    snprintf(name, sizeof(name), "uring %s%s",
+             mu_thunk_uring_is_native(&s_uring) ? "native" : "fallback",
+             fixed ? " fixed" : "");
+
+    uint64_t expected = s_checksum;
+    s_checksum = 0;
+    s_next_block = 0;
+    s_done = 0;
+    uint64_t start = bench_now_ns();
+    for (unsigned i = 0; i < QUEUE_DEPTH; i++) {
+        mu_thunk_init(&s_reads[i].thunk, read_fn);
+        s_reads[i].index = i;
+        s_reads[i].fixed = fixed;
+        queue_read(&s_reads[i]);
+    }
+    while (s_done < N_READS) {
+        if (mu_thunk_uring_run_once(&s_uring, 1) < 0) {
+            perror("mu_thunk_uring_run_once");
+            exit(1);
+        }
+    }
+    report(name, N_READS, bench_now_ns() - start);
+    if (s_checksum != expected) {
+        fprintf(stderr, "%s: checksum mismatch\n", name);
+    }
+    s_checksum = expected;
+    mu_thunk_uring_deinit(&s_uring);
+}
+
+static void bench_uring_nop(unsigned flags) {
+    char name[64];
+    mu_thunk_uring_init(&s_uring, QUEUE_DEPTH, flags);
+    snprintf(name, sizeof(name), "uring %s nop",
+             mu_thunk_uring_is_native(&s_uring) ? "native" : "fallback");
+    mu_thunk_init(&s_nop_thunk, nop_fn);
+    s_nops = 0;
+    uint64_t start = bench_now_ns();
+    while (s_nops < N_NOPS) {
+        for (unsigned i = 0; i < QUEUE_DEPTH; i++) {
+            mu_thunk_uring_prep_nop(&s_uring, &s_nop_thunk);
+        }
+        for (unsigned got = 0; got < QUEUE_DEPTH;) {
+            got += mu_thunk_uring_run_once(&s_uring, QUEUE_DEPTH - got);
+        }
+    }
+    report(name, s_nops, bench_now_ns() - start);
+    mu_thunk_uring_deinit(&s_uring);
+}
+
+static void bench_socket_rw(void) {
+    uint64_t start = bench_now_ns();
+    for (unsigned i = 0; i < N_MSGS; i++) {
+        if (write(s_sv[1], s_msg_out, MSG_SIZE) != (ssize_t)MSG_SIZE ||
+            read(s_sv[0], s_msg_in, MSG_SIZE) != (ssize_t)MSG_SIZE) {
+            perror("socket write/read");
+            exit(1);
+        }
+    }
+    report("socket rw loop", N_MSGS, bench_now_ns() - start);
+}
+
+static void bench_uring_socket(unsigned flags) {
+    char name[64];
+    if (mu_thunk_uring_init(&s_uring, QUEUE_DEPTH, flags) == NULL) {
+        perror("mu_thunk_uring_init");
+        exit(1);
+    }
+    snprintf(name, sizeof(name), "uring %s sock",
+             mu_thunk_uring_is_native(&s_uring) ? "native" : "fallback");
+    mu_thunk_init(&s_send_thunk, send_fn);
+    mu_thunk_init(&s_recv_thunk, recv_fn);
+    s_msgs = 0;
+    uint64_t start = bench_now_ns();
+    for (unsigned i = 0; i < N_MSGS; i++) {
+        // The RECV is queued first, so it parks until the SEND lands.
+        mu_thunk_uring_prep_recv(&s_uring, s_sv[0], s_msg_in, MSG_SIZE, 0,
+                                 &s_recv_thunk);
+        mu_thunk_uring_prep_send(&s_uring, s_sv[1], s_msg_out, MSG_SIZE, 0,
+                                 &s_send_thunk);
+        for (unsigned got = 0; got < 2;) {
+            int n = mu_thunk_uring_run_once(&s_uring, 2 - got);
+            if (n < 0) {
+                perror("mu_thunk_uring_run_once");
+                exit(1);
+            }
+            got += (unsigned)n;
+        }
+    }
+    report(name, s_msgs, bench_now_ns() - start);
+    mu_thunk_uring_deinit(&s_uring);
+}
+
+static void queue_read(read_thunk_t *rt) {
+    if (s_next_block >= N_READS) {
+        return;
+    }
+    uint64_t offset = (uint64_t)s_next_block++ * READ_SIZE;
+    if (rt->fixed) {
+        mu_thunk_uring_prep_read_fixed(&s_uring, s_fd, s_buffers[rt->index],
+                                       READ_SIZE, offset, rt->index,
+                                       &rt->thunk);
+    } else {
+        mu_thunk_uring_prep_read(&s_uring, s_fd, s_buffers[rt->index],
+                                 READ_SIZE, offset, &rt->thunk);
+    }
+}
+
+static void read_fn(mu_thunk_t *thunk, void *args) {
+    read_thunk_t *rt = (read_thunk_t *)thunk;
+    struct io_uring_cqe *cqe = (struct io_uring_cqe *)args;
+    if (cqe->res != (int)READ_SIZE) {
+        fprintf(stderr, "read: %d\n", cqe->res);
+        exit(1);
+    }
+    s_checksum += (unsigned char)s_buffers[rt->index][0];
+    s_done++;
+    queue_read(rt);
+}
+
+static void nop_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    s_nops++;
+}
+
+static void send_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    struct io_uring_cqe *cqe = (struct io_uring_cqe *)args;
+    if (cqe->res != (int)MSG_SIZE) {
+        fprintf(stderr, "send: %d\n", cqe->res);
+        exit(1);
+    }
+}
+
+static void recv_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    struct io_uring_cqe *cqe = (struct io_uring_cqe *)args;
+    if (cqe->res != (int)MSG_SIZE) {
+        fprintf(stderr, "recv: %d\n", cqe->res);
+        exit(1);
+    }
+    s_msgs++;
+}
+
+// *****************************************************************************
+// End of file
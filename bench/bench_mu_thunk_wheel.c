@@ -0,0 +1,129 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_thunk_wheel.c
+ *
+ * @brief Cost of schedule, cancel and per-tick advance with 1M live timers
+ *        in a mu_thunk_wheel.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_harness.h"
+#include "mu_thunk.h"
+#include "mu_thunk_wheel.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_TIMERS 1000000
+#define MAX_DELAY (1u << 20)
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_thunk_wheel_t s_wheel;
+static uint64_t s_fired;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static uint64_t next_random(uint64_t *state);
+static void fire_fn(mu_thunk_t *thunk, void *args);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    mu_thunk_timer_t *timers = malloc(sizeof(mu_thunk_timer_t) * N_TIMERS);
+    uint64_t *delays = malloc(sizeof(uint64_t) * N_TIMERS);
+    uint64_t rng = 88172645463325252ull;
+    uint64_t start;
+
+    bench_init(argc, argv);
+    for (size_t i = 0; i < N_TIMERS; i++) {
+        mu_thunk_timer_init(&timers[i], fire_fn);
+        delays[i] = 1 + next_random(&rng) % MAX_DELAY;
+    }
+    mu_thunk_wheel_init(&s_wheel, 0);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < N_TIMERS; i++) {
+        mu_thunk_wheel_schedule(&s_wheel, &timers[i], delays[i], 0);
+    }
+    double schedule_ns = (double)(bench_now_ns() - start) / N_TIMERS;
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < N_TIMERS; i += 2) {
+        mu_thunk_wheel_cancel(&s_wheel, &timers[i]);
+    }
+    double cancel_ns = (double)(bench_now_ns() - start) / (N_TIMERS / 2);
+
+    // Put the cancelled half back so 1M timers are live while ticking.
+    for (size_t i = 0; i < N_TIMERS; i += 2) {
+        mu_thunk_wheel_schedule(&s_wheel, &timers[i], delays[i], 0);
+    }
+
+    start = bench_now_ns();
+    for (uint64_t tick = 1; tick <= MAX_DELAY; tick++) {
+        mu_thunk_wheel_advance(&s_wheel, tick);
+    }
+    double advance_ns = (double)(bench_now_ns() - start);
+
+    bench_report_value("wheel", "schedule", "ns/timer", schedule_ns);
+    bench_report_value("wheel", "cancel", "ns/timer", cancel_ns);
+    bench_report_value("wheel", "advance", "ns/tick", advance_ns / MAX_DELAY);
+    bench_report_value("wheel", "advance", "ns/fired", advance_ns / s_fired);
+    bench_report_value("wheel", "timers fired", "count", (double)s_fired);
+    bench_finish();
+
+    free(delays);
+    free(timers);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void fire_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    s_fired++;
+}
+
+// *****************************************************************************
+// End of file
@@ -28,6 +28,25 @@
  * @brief Minimal deferrable execution unit: a thunk that carries only
  *        its function pointer.  User context must be embedded in your
  *        own struct as the first member.
+ *
+ * Build modes (define before including this header, or with -D):
+ *
+ * - `MU_THUNK_HEADER_ONLY`: `mu_thunk_init()` and `mu_thunk_call()` are
+ *   `static inline` here instead of being compiled in `src/mu_thunk.c`, so
+ *   the dispatch path has no out-of-line call.  Don't link `mu_thunk.c`
+ *   into a translation unit that defines it (other TUs may still use it).
+ * - `MU_THUNK_UNCHECKED`: the NULL checks in `mu_thunk_init()` and
+ *   `mu_thunk_call()` are compiled out, making them equivalent to
+ *   `_mu_thunk_init()` and `_mu_thunk_call()`.  Passing NULL is then
+ *   undefined.  Intended for release builds once tests pass checked.
+ *
+ * - `MU_THUNK_STATS`: every dispatch is timed and recorded per function;
+ *   see `mu_thunk_stats.h`.
+ * - `MU_THUNK_TRACE`: sampled dispatches are recorded as a timeline; see
+ *   `mu_thunk_trace.h`.
+ *
+ * Building the library with `-flto` (see `make lib`) gets most of the
+ * benefit of `MU_THUNK_HEADER_ONLY` without changing any source.
  */
 
 #ifndef _MU_THUNK_H_
@@ -89,17 +108,32 @@ static inline mu_thunk_t *_mu_thunk_init(mu_thunk_t *thunk, mu_thunk_fn fn) {
     return thunk;
 }
 
+#if defined(MU_THUNK_TRACE)
+// Traced dispatch; see mu_thunk_trace.h.
+void mu_thunk_trace_call(mu_thunk_t *thunk, void *args);
+#elif defined(MU_THUNK_STATS)
+// Instrumented dispatch; see mu_thunk_stats.h.
+void mu_thunk_stats_call(mu_thunk_t *thunk, void *args);
+#endif
+
 /**
  * @brief Inline invocation of a thunk.
  *
  * Does no parameter checking.  Use only when you know `thunk` and
- * `thunk->fn` are valid.
+ * `thunk->fn` are valid.  With MU_THUNK_STATS or MU_THUNK_TRACE defined
+ * the call is recorded (see mu_thunk_stats.h, mu_thunk_trace.h).
  *
  * @param thunk Pointer to the thunk instance.
  * @param args  Optional arguments to pass through.
  */
 static inline void _mu_thunk_call(mu_thunk_t *thunk, void *args) {
+#if defined(MU_THUNK_TRACE)
+    mu_thunk_trace_call(thunk, args);
+#elif defined(MU_THUNK_STATS)
+    mu_thunk_stats_call(thunk, args);
+#else
     thunk->fn(thunk, args);
+#endif
 }
 
 /** A null thunk (fn set to NULL). */
@@ -108,6 +142,12 @@ static inline void _mu_thunk_call(mu_thunk_t *thunk, void *args) {
 // *****************************************************************************
 // Public declarations
 
+#ifdef MU_THUNK_HEADER_ONLY
+#define MU_THUNK_API static inline
+#else
+#define MU_THUNK_API
+#endif
+
 /**
  * @brief Initialize a thunk.
  *
@@ -115,20 +155,26 @@ static inline void _mu_thunk_call(mu_thunk_t *thunk, void *args) {
  *
  * @param thunk Pointer to your `mu_thunk_t` (must be non-NULL).
  * @param fn    Function to invoke when `mu_thunk_call()` runs.
- * @return `thunk` on success, or NULL if `thunk` or `fn` is NULL.
+ * @return `thunk` on success, or NULL if `thunk` or `fn` is NULL (unless
+ *         built with MU_THUNK_UNCHECKED).
  */
-mu_thunk_t *mu_thunk_init(mu_thunk_t *thunk, mu_thunk_fn fn);
+MU_THUNK_API mu_thunk_t *mu_thunk_init(mu_thunk_t *thunk, mu_thunk_fn fn);
 
 /**
  * @brief Execute a thunk.
  *
  * Calls the stored function pointer with the thunk and provided `args`.
- * If `thunk` or `thunk->fn` is NULL, this is a no-op.
+ * If `thunk` or `thunk->fn` is NULL, this is a no-op (unless built with
+ * MU_THUNK_UNCHECKED).
  *
  * @param thunk Pointer to the initialized `mu_thunk_t`.
  * @param args  Optional arguments to pass through.
  */
-void mu_thunk_call(mu_thunk_t *thunk, void *args);
+MU_THUNK_API void mu_thunk_call(mu_thunk_t *thunk, void *args);
+
+#ifdef MU_THUNK_HEADER_ONLY
+#include "mu_thunk_impl.h"
+#endif
 
 // *****************************************************************************
 // End of file
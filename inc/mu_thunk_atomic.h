@@ -0,0 +1,71 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_atomic.h
+ *
+ * @brief Portability shims shared by the concurrent mu_thunk modules:
+ *        atomic type spelling for C11 and C++, and cache-line alignment.
+ */
+
+#ifndef _MU_THUNK_ATOMIC_H_
+#define _MU_THUNK_ATOMIC_H_
+
+// *****************************************************************************
+// Includes
+
+#ifdef __cplusplus
+#include <atomic>
+#else
+#include <stdalign.h>
+#include <stdatomic.h>
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief Size in bytes of a cache line.  Fields written by different threads
+ *        are placed at least this far apart to avoid false sharing.
+ */
+#ifndef MU_THUNK_CACHE_LINE
+#define MU_THUNK_CACHE_LINE 64
+#endif
+
+/**
+ * @brief Declare an atomic object of type `T`.
+ *
+ * Expands to `_Atomic(T)` in C and `std::atomic<T>` in C++ so that structs
+ * declared in public headers have the same layout in both languages.
+ */
+#ifdef __cplusplus
+#define MU_THUNK_ATOMIC(T) std::atomic<T>
+#else
+#define MU_THUNK_ATOMIC(T) _Atomic(T)
+#endif
+
+/** Align the following member or object to a cache line boundary. */
+#define MU_THUNK_CACHE_ALIGNED alignas(MU_THUNK_CACHE_LINE)
+
+#endif /* _MU_THUNK_ATOMIC_H_ */
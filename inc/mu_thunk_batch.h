@@ -0,0 +1,121 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_batch.h
+ *
+ * @brief Batch implementations of thunk functions, and a dispatcher that
+ *        uses them.
+ *
+ * Calling `fn` once per item keeps the callee from working across items,
+ * e.g. with SIMD lanes.  A function may register a batch implementation
+ * that receives a whole run of its thunks together with each thunk's
+ * `args`; `mu_thunk_batch_dispatch()` then hands it every run of
+ * consecutive thunks that share that `fn`, and calls everything else one
+ * at a time through `_mu_thunk_call()`.  Order is preserved, so a batch
+ * implementation must have the same effect as calling `fn` on each thunk
+ * in turn.
+ *
+ * The dispatcher only batches *adjacent* thunks.  Feed it queues that are
+ * homogeneous already, or batch by function first (`mu_thunk_group`).
+ *
+ * The registry is process-wide.  Registration takes a lock; lookups are
+ * lock-free and may run concurrently with it.
+ */
+
+#ifndef _MU_THUNK_BATCH_H_
+#define _MU_THUNK_BATCH_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Functions that can have a batch implementation registered. */
+#ifndef MU_THUNK_BATCH_MAX_FNS
+#define MU_THUNK_BATCH_MAX_FNS 64
+#endif
+
+/**
+ * @brief Batch implementation of a thunk function.
+ *
+ * @param thunks `n` thunks whose `fn` is the registered function.
+ * @param args   Each thunk's args (`args[i]` goes with `thunks[i]`), or
+ *               NULL if every thunk's args is NULL.
+ * @param n      Number of thunks, at least 1.
+ */
+typedef void (*mu_thunk_batch_fn)(mu_thunk_t **thunks, void **args,
+                                  size_t n);
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Register (or replace, or with `batch` NULL remove) the batch
+ *        implementation of `fn`.
+ *
+ * Removing a function frees its entry for another; the registry holds up
+ * to MU_THUNK_BATCH_MAX_FNS live entries.  After heavy churn a registration
+ * may rebuild the table, during which a concurrent lookup can miss and its
+ * thunks are called one at a time.
+ *
+ * @return true on success, false if `fn` is NULL or the registry is full.
+ */
+bool mu_thunk_batch_register(mu_thunk_fn fn, mu_thunk_batch_fn batch);
+
+/**
+ * @brief The batch implementation registered for `fn`, or NULL.
+ */
+mu_thunk_batch_fn mu_thunk_batch_lookup(mu_thunk_fn fn);
+
+/**
+ * @brief Invoke `n` thunks in order, batching runs of a registered `fn`.
+ *
+ * @param thunks Thunks to invoke; none may be NULL.
+ * @param args   Per-thunk args, or NULL to pass NULL to every thunk.
+ * @param n      Number of thunks.
+ * @return The number of thunks invoked (`n`), or 0 if `thunks` is NULL.
+ */
+size_t mu_thunk_batch_dispatch(mu_thunk_t **thunks, void **args, size_t n);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_BATCH_H_ */
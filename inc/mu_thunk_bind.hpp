@@ -0,0 +1,133 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_bind.hpp
+ *
+ * @brief `mu::thunk<F>`: a `mu_thunk_t` with a callable stored inline.
+ *
+ * Instead of declaring a context struct, a static trampoline and a cast
+ * for every callback, bind a lambda:
+ *
+ *     auto t = mu::thunk([&count](void *args) { count++; });
+ *     mu_thunk_ring_put(&ring, t.get());
+ *
+ * The callable lives in the object right after the `mu_thunk_t`, which is
+ * at offset 0 as usual.  The thunk's function is a trampoline generated for
+ * `F`, so `_mu_thunk_call()` makes one indirect call that lands in code with
+ * the lambda body inlined; callers that know the type can skip even that
+ * with `operator()`.  Nothing is heap-allocated, and `F` may be move-only.
+ *
+ * `F` is invoked as `f(args)` if it accepts a `void *`, else as `f()`.
+ * A `mu::thunk` must not be moved or destroyed while queued.
+ */
+
+#ifndef _MU_THUNK_BIND_HPP_
+#define _MU_THUNK_BIND_HPP_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// *****************************************************************************
+// Public types and definitions
+
+namespace mu {
+
+template <typename F> class thunk {
+    static_assert(std::is_same_v<F, std::decay_t<F>>,
+                  "mu::thunk<F> stores F by value");
+    static_assert(std::is_invocable_v<F &, void *> || std::is_invocable_v<F &>,
+                  "F must be callable as f(void *) or f()");
+
+  public:
+    /** Bind `fn`, moving it into the thunk. */
+    explicit thunk(F fn) noexcept(std::is_nothrow_move_constructible_v<F>)
+        : thunk(std::in_place, std::move(fn)) {}
+
+    /** Construct `F` in place from `args`. */
+    template <typename... Args>
+    explicit thunk(std::in_place_t, Args &&...args) noexcept(
+        std::is_nothrow_constructible_v<F, Args...>) {
+        static_assert(std::is_standard_layout_v<thunk>,
+                      "mu::thunk must be standard layout");
+        static_assert(offsetof(thunk, m_thunk) == 0,
+                      "the mu_thunk_t must be at offset 0");
+        _mu_thunk_init(&m_thunk, trampoline);
+        ::new (static_cast<void *>(m_storage)) F(std::forward<Args>(args)...);
+    }
+
+    /** Move the callable into a new (unqueued) thunk. */
+    thunk(thunk &&other) noexcept(std::is_nothrow_move_constructible_v<F>)
+        : thunk(std::in_place, std::move(other.callable())) {}
+
+    thunk(const thunk &) = delete;
+    thunk &operator=(const thunk &) = delete;
+    thunk &operator=(thunk &&) = delete;
+
+    ~thunk() { std::destroy_at(&callable()); }
+
+    /** The thunk to post to a run queue. */
+    mu_thunk_t *get() noexcept { return &m_thunk; }
+
+    /** The bound callable. */
+    F &callable() noexcept {
+        return *std::launder(reinterpret_cast<F *>(m_storage));
+    }
+
+    /** Call the bound callable directly, without going through `fn`. */
+    void operator()(void *args = nullptr) { invoke(callable(), args); }
+
+  private:
+    static void invoke(F &f, void *args) {
+        if constexpr (std::is_invocable_v<F &, void *>) {
+            f(args);
+        } else {
+            (void)args;
+            f();
+        }
+    }
+
+    static void trampoline(mu_thunk_t *t, void *args) {
+        invoke(reinterpret_cast<thunk *>(t)->callable(), args);
+    }
+
+    mu_thunk_t m_thunk; /**< Must be first member */
+    alignas(F) unsigned char m_storage[sizeof(F)];
+};
+
+template <typename F> thunk(F) -> thunk<F>;
+
+} // namespace mu
+
+// *****************************************************************************
+// End of file
+
+#endif /* _MU_THUNK_BIND_HPP_ */
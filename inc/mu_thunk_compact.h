@@ -0,0 +1,194 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_compact.h
+ *
+ * @brief Compact thunks: a 16- or 32-bit function id in place of the
+ *        8-byte function pointer.
+ *
+ * Functions are registered once into a process-wide table and a
+ * `mu_thunk_compact_t` stores only the index, so a job record of a thunk
+ * and a 32-bit argument packs into 8 bytes instead of 16.  Dispatch is one
+ * indexed load away from `_mu_thunk_call()`.  Ids are plain integers, so
+ * they can be serialized or placed in memory shared with other processes;
+ * register with `mu_thunk_compact_register_at()` and a fixed numbering to
+ * make them identical in every process that runs the same code.
+ *
+ * Id 0 is reserved as "no function".  Registration takes a lock and is
+ * meant for start-up; register a function before handing thunks that use
+ * it to other threads (the handoff itself orders the table write).
+ */
+
+#ifndef _MU_THUNK_COMPACT_H_
+#define _MU_THUNK_COMPACT_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Width of a function id: 16 or 32. */
+#ifndef MU_THUNK_COMPACT_BITS
+#define MU_THUNK_COMPACT_BITS 32
+#endif
+
+/** Size of the function table (ids 1 .. MAX_FNS - 1 are usable). */
+#ifndef MU_THUNK_COMPACT_MAX_FNS
+#define MU_THUNK_COMPACT_MAX_FNS 256
+#endif
+
+#if MU_THUNK_COMPACT_BITS == 16
+typedef uint16_t mu_thunk_compact_id_t;
+#elif MU_THUNK_COMPACT_BITS == 32
+typedef uint32_t mu_thunk_compact_id_t;
+#else
+#error "MU_THUNK_COMPACT_BITS must be 16 or 32"
+#endif
+
+/** The reserved "no function" id. */
+#define MU_THUNK_COMPACT_NONE ((mu_thunk_compact_id_t)0)
+
+struct _mu_thunk_compact;
+
+/**
+ * @brief Function signature for a compact thunk; as `mu_thunk_fn`.
+ */
+typedef void (*mu_thunk_compact_fn)(struct _mu_thunk_compact *thunk,
+                                    void *args);
+
+/**
+ * @brief A thunk holding a function id.  Embed it as the first member of
+ *        your own struct, as with `mu_thunk_t`.
+ */
+typedef struct _mu_thunk_compact {
+    mu_thunk_compact_id_t id; /**< Index into the function table */
+} mu_thunk_compact_t;
+
+/** The function table; use the functions below rather than writing it. */
+extern mu_thunk_compact_fn mu_thunk_compact_fns[MU_THUNK_COMPACT_MAX_FNS];
+
+/**
+ * @brief Inline initializer.  Does no checking: `id` must be registered.
+ */
+static inline mu_thunk_compact_t *
+_mu_thunk_compact_init(mu_thunk_compact_t *thunk, mu_thunk_compact_id_t id) {
+    thunk->id = id;
+    return thunk;
+}
+
+#if defined(MU_THUNK_TRACE)
+// Traced dispatch; see mu_thunk_trace.h.
+void mu_thunk_trace_compact_call(mu_thunk_compact_fn fn,
+                                 mu_thunk_compact_t *thunk, void *args);
+#elif defined(MU_THUNK_STATS)
+// Instrumented dispatch; see mu_thunk_stats.h.
+void mu_thunk_stats_compact_call(mu_thunk_compact_fn fn,
+                                 mu_thunk_compact_t *thunk, void *args);
+#endif
+
+/**
+ * @brief Inline invocation through the function table.
+ *
+ * Does no checking: `thunk->id` must be registered.  With MU_THUNK_STATS
+ * or MU_THUNK_TRACE defined the call is recorded against the registered
+ * function, as `_mu_thunk_call()` records against `thunk->fn`.
+ */
+static inline void _mu_thunk_compact_call(mu_thunk_compact_t *thunk,
+                                          void *args) {
+#if defined(MU_THUNK_TRACE)
+    mu_thunk_trace_compact_call(mu_thunk_compact_fns[thunk->id], thunk, args);
+#elif defined(MU_THUNK_STATS)
+    mu_thunk_stats_compact_call(mu_thunk_compact_fns[thunk->id], thunk, args);
+#else
+    mu_thunk_compact_fns[thunk->id](thunk, args);
+#endif
+}
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Register a function, or find its existing id.
+ *
+ * @return The function's id, or MU_THUNK_COMPACT_NONE if `fn` is NULL or
+ *         the table is full.
+ */
+mu_thunk_compact_id_t mu_thunk_compact_register(mu_thunk_compact_fn fn);
+
+/**
+ * @brief Register a function at a fixed id, for numbering that is stable
+ *        across builds and processes.
+ *
+ * @return true if `id` now maps to `fn` (including if it already did),
+ *         false if an argument is invalid or `id` is taken by another
+ *         function.
+ */
+bool mu_thunk_compact_register_at(mu_thunk_compact_id_t id,
+                                  mu_thunk_compact_fn fn);
+
+/**
+ * @brief The function registered at `id`, or NULL.
+ */
+mu_thunk_compact_fn mu_thunk_compact_lookup(mu_thunk_compact_id_t id);
+
+/**
+ * @brief The id of a registered function, or MU_THUNK_COMPACT_NONE.
+ */
+mu_thunk_compact_id_t mu_thunk_compact_id_of(mu_thunk_compact_fn fn);
+
+/**
+ * @brief Initialize a compact thunk.
+ *
+ * @return `thunk`, or NULL if `thunk` is NULL or `id` is not registered.
+ */
+mu_thunk_compact_t *mu_thunk_compact_init(mu_thunk_compact_t *thunk,
+                                          mu_thunk_compact_id_t id);
+
+/**
+ * @brief Execute a compact thunk.  A no-op if `thunk` is NULL or its id is
+ *        not registered.
+ */
+void mu_thunk_compact_call(mu_thunk_compact_t *thunk, void *args);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_COMPACT_H_ */
@@ -0,0 +1,425 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_coro.hpp
+ *
+ * @brief C++20 coroutines resumed by calling a thunk.
+ *
+ * `mu::task<T>` is a lazily started coroutine whose promise begins with a
+ * `mu_thunk_mpsc_node_t`, and therefore with a `mu_thunk_t` at offset 0.
+ * The thunk's function resumes the coroutine, so a suspended task can sit
+ * on any mu_thunk run queue (ring, MPSC, pool, prio, wheel, reactor) and
+ * is resumed by the same `_mu_thunk_call()` that drains the queue:
+ *
+ * - `co_await some_task` suspends the caller and starts `some_task`; when
+ *   `some_task` finishes, the caller continues.  Neither transfer resumes
+ *   one coroutine from inside another: each suspends back to the loop in
+ *   the thunk that resumed the task, which then resumes the next one.  So
+ *   await chains of any depth, and any number of awaits of tasks that
+ *   complete synchronously, run in constant stack at any optimization
+ *   level, without relying on the compiler to make transfers tail calls.
+ * - `co_await mu::post(fn)` suspends the current task and hands its thunk
+ *   to `fn(mu_thunk_t *)`, which enqueues it and returns true (or returns
+ *   false to continue at once, e.g. when the queue is full).  The task
+ *   continues on whichever thread later calls the thunk.  Overloads post
+ *   straight to a `mu_thunk_ring_t`, `mu_thunk_mpsc_t` or `mu_thunk_pool_t`.
+ * - Frames come from per-thread free lists binned by size
+ *   (`mu::coro_frame_pool`), so a steady stream of short-lived tasks does
+ *   not reach `operator new`.
+ *
+ * A top-level task is started by calling its thunk, directly or from a
+ * queue.  Once `done()` is true, `result()` returns its value (or rethrows
+ * its exception).  Destroying a task destroys its frame, so a task must
+ * outlive any queue entry that still refers to it.
+ */
+
+#ifndef _MU_THUNK_CORO_HPP_
+#define _MU_THUNK_CORO_HPP_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_mpsc.h"
+#include "mu_thunk_pool.h"
+#include "mu_thunk_ring.h"
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Frame sizes are rounded up to a multiple of this many bytes. */
+#ifndef MU_THUNK_CORO_FRAME_QUANTUM
+#define MU_THUNK_CORO_FRAME_QUANTUM 64
+#endif
+
+/** Size classes pooled; larger frames go straight to `operator new`. */
+#ifndef MU_THUNK_CORO_FRAME_CLASSES
+#define MU_THUNK_CORO_FRAME_CLASSES 16
+#endif
+
+/** Free frames a thread keeps per size class before releasing them. */
+#ifndef MU_THUNK_CORO_FRAME_CACHE
+#define MU_THUNK_CORO_FRAME_CACHE 256
+#endif
+
+namespace mu {
+
+/**
+ * @brief Per-thread, size-binned free lists for coroutine frames.
+ *
+ * A frame is pushed onto the free list of the thread that frees it, which
+ * need not be the thread that allocated it.  Each list is capped at
+ * MU_THUNK_CORO_FRAME_CACHE frames, so a thread that only frees (say, the
+ * one that drains a queue of finished tasks) cannot hoard memory.
+ */
+class coro_frame_pool {
+  public:
+    static void *allocate(std::size_t size) {
+        std::size_t cls = size_class(size);
+        if (cls >= MU_THUNK_CORO_FRAME_CLASSES) {
+            return ::operator new(size);
+        }
+        bin_t &bin = bins().bin[cls];
+        if (bin.head != nullptr) {
+            free_frame_t *frame = bin.head;
+            bin.head = frame->next;
+            bin.count--;
+            return frame;
+        }
+        return ::operator new((cls + 1) * MU_THUNK_CORO_FRAME_QUANTUM);
+    }
+
+    static void deallocate(void *p, std::size_t size) noexcept {
+        std::size_t cls = size_class(size);
+        if (cls >= MU_THUNK_CORO_FRAME_CLASSES) {
+            ::operator delete(p);
+            return;
+        }
+        bin_t &bin = bins().bin[cls];
+        if (bin.count >= MU_THUNK_CORO_FRAME_CACHE) {
+            ::operator delete(p);
+            return;
+        }
+        free_frame_t *frame = static_cast<free_frame_t *>(p);
+        frame->next = bin.head;
+        bin.head = frame;
+        bin.count++;
+    }
+
+    /** Free frames currently cached by the calling thread (all classes). */
+    static std::size_t cached() noexcept {
+        std::size_t n = 0;
+        for (const bin_t &bin : bins().bin) {
+            n += bin.count;
+        }
+        return n;
+    }
+
+  private:
+    struct free_frame_t {
+        free_frame_t *next;
+    };
+
+    struct bin_t {
+        free_frame_t *head = nullptr;
+        std::size_t count = 0;
+    };
+
+    struct bins_t {
+        bin_t bin[MU_THUNK_CORO_FRAME_CLASSES];
+
+        ~bins_t() {
+            for (bin_t &b : bin) {
+                while (b.head != nullptr) {
+                    free_frame_t *frame = b.head;
+                    b.head = frame->next;
+                    ::operator delete(frame);
+                }
+                b.count = 0;
+            }
+        }
+    };
+
+    static std::size_t size_class(std::size_t size) noexcept {
+        return (size - 1) / MU_THUNK_CORO_FRAME_QUANTUM;
+    }
+
+    static bins_t &bins() noexcept {
+        static thread_local bins_t s_bins;
+        return s_bins;
+    }
+};
+
+template <typename T = void> class task;
+
+namespace detail {
+
+/**
+ * @brief State shared by every task promise.  The MPSC node (and so the
+ *        thunk) must stay the first member.
+ */
+struct promise_base {
+    mu_thunk_mpsc_node_t node; /**< Must be first member */
+    std::coroutine_handle<> self;
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+
+    promise_base() noexcept {
+        _mu_thunk_init(&node.thunk, resume_fn);
+        node.next.store(nullptr, std::memory_order_relaxed);
+    }
+
+    static void *operator new(std::size_t size) {
+        return coro_frame_pool::allocate(size);
+    }
+
+    static void operator delete(void *p, std::size_t size) noexcept {
+        coro_frame_pool::deallocate(p, size);
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    /** Leaves the awaiting coroutine, if any, to the resume loop. */
+    struct final_awaiter {
+        bool await_ready() noexcept { return false; }
+
+        template <typename P>
+        void await_suspend(std::coroutine_handle<P> h) noexcept {
+            next() = h.promise().continuation;
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    final_awaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+
+    static void resume_fn(mu_thunk_t *thunk, void *args) {
+        (void)args;
+        // A coroutine that suspends to start or continue another sets
+        // `next()` as its last act; resume that one from here rather than
+        // from inside its frame.  A nested resume_fn (a task calling a
+        // thunk directly) runs its own loop and leaves `next()` empty.
+        std::coroutine_handle<> h =
+            reinterpret_cast<promise_base *>(thunk)->self;
+        do {
+            h.resume();
+            h = std::exchange(next(), {});
+        } while (h);
+    }
+
+    /** The coroutine the calling thread's resume loop runs next. */
+    static std::coroutine_handle<> &next() noexcept {
+        static thread_local std::coroutine_handle<> s_next;
+        return s_next;
+    }
+};
+
+static_assert(std::is_standard_layout_v<promise_base>,
+              "promise_base must be standard layout");
+static_assert(offsetof(promise_base, node) == 0,
+              "the thunk must be at offset 0 of the promise");
+
+template <typename T> struct task_promise : promise_base {
+    std::optional<T> value;
+
+    task<T> get_return_object() noexcept;
+
+    template <typename U> void return_value(U &&v) {
+        value.emplace(std::forward<U>(v));
+    }
+
+    T result() {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+};
+
+template <> struct task_promise<void> : promise_base {
+    task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void result() {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+/** Hands the awaiting task's thunk to a posting function. */
+template <typename F> class post_awaiter {
+  public:
+    explicit post_awaiter(F fn) : m_fn(std::move(fn)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    template <typename P> bool await_suspend(std::coroutine_handle<P> h) {
+        // Once posted, the task may already be running on another thread:
+        // nothing after the call may touch the frame (or this awaiter).
+        return m_fn(&h.promise().node.thunk);
+    }
+
+    void await_resume() const noexcept {}
+
+  private:
+    F m_fn;
+};
+
+} // namespace detail
+
+/**
+ * @brief A lazily started coroutine producing a `T`.
+ *
+ * Awaiting a task starts it and resumes the awaiter when it finishes.  A
+ * task that is never awaited is started by calling its thunk.
+ */
+template <typename T> class [[nodiscard]] task {
+  public:
+    using promise_type = detail::task_promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    task() noexcept = default;
+
+    explicit task(handle_type h) noexcept : m_h(h) {}
+
+    task(task &&other) noexcept : m_h(std::exchange(other.m_h, {})) {}
+
+    task &operator=(task &&other) noexcept {
+        if (this != &other) {
+            if (m_h) {
+                m_h.destroy();
+            }
+            m_h = std::exchange(other.m_h, {});
+        }
+        return *this;
+    }
+
+    task(const task &) = delete;
+    task &operator=(const task &) = delete;
+
+    ~task() {
+        if (m_h) {
+            m_h.destroy();
+        }
+    }
+
+    /** The thunk that resumes this task, for posting to a run queue. */
+    mu_thunk_t *thunk() const noexcept { return &m_h.promise().node.thunk; }
+
+    /** True if the task has no coroutine or has run to completion. */
+    bool done() const noexcept { return !m_h || m_h.done(); }
+
+    /** The returned value (moved out) or the escaped exception. */
+    T result() { return m_h.promise().result(); }
+
+    auto operator co_await() && noexcept { return awaiter{m_h}; }
+    auto operator co_await() & noexcept { return awaiter{m_h}; }
+
+  private:
+    struct awaiter {
+        handle_type h;
+
+        bool await_ready() const noexcept { return !h || h.done(); }
+
+        void await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            h.promise().continuation = awaiting;
+            promise_type::next() = h;
+        }
+
+        T await_resume() { return h.promise().result(); }
+    };
+
+    handle_type m_h;
+};
+
+namespace detail {
+
+template <typename T> task<T> task_promise<T>::get_return_object() noexcept {
+    auto h = std::coroutine_handle<task_promise<T>>::from_promise(*this);
+    self = h;
+    return task<T>{h};
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+    auto h = std::coroutine_handle<task_promise<void>>::from_promise(*this);
+    self = h;
+    return task<void>{h};
+}
+
+} // namespace detail
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Suspend the current task and pass its thunk to `fn`.
+ *
+ * `fn(mu_thunk_t *)` must return true if it enqueued the thunk (the task
+ * resumes when the thunk is called) or false to continue immediately.
+ * The thunk is the first member of a `mu_thunk_mpsc_node_t`.
+ */
+template <typename F> detail::post_awaiter<F> post(F fn) {
+    return detail::post_awaiter<F>(std::move(fn));
+}
+
+/** Continue on whichever thread next drains `ring`; inline if it's full. */
+inline auto post(mu_thunk_ring_t *ring) {
+    return post([ring](mu_thunk_t *t) { return mu_thunk_ring_put(ring, t); });
+}
+
+/** Continue on the consumer of `q`. */
+inline auto post(mu_thunk_mpsc_t *q) {
+    return post([q](mu_thunk_t *t) {
+        auto *node = reinterpret_cast<mu_thunk_mpsc_node_t *>(t);
+        return mu_thunk_mpsc_put(q, node);
+    });
+}
+
+/** Continue on a worker of `pool`; inline if the pool refuses the thunk. */
+inline auto post(mu_thunk_pool_t *pool) {
+    return post([pool](mu_thunk_t *t) {
+        return mu_thunk_pool_submit(pool, t, nullptr);
+    });
+}
+
+} // namespace mu
+
+// *****************************************************************************
+// End of file
+
+#endif /* _MU_THUNK_CORO_HPP_ */
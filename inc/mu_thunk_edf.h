@@ -0,0 +1,214 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_edf.h
+ *
+ * @brief Earliest-deadline-first scheduler for thunks with soft deadlines.
+ *
+ * Each scheduled task carries an absolute deadline and the scheduler always
+ * dispatches the released task whose deadline is nearest.  Ready tasks live
+ * in a 4-ary min-heap over a caller-supplied array: a node's four children
+ * are adjacent, so a sift-down touches one or two cache lines per level and
+ * the tree is half as deep as a binary heap.
+ *
+ * A task may also carry a release time before which it is not eligible to
+ * run, as for the next job of a periodic task.  Such tasks wait in a second
+ * heap, keyed by release time, that grows down from the top of the same
+ * array, and move to the ready heap when `mu_thunk_edf_run()` finds their
+ * release time has passed.
+ *
+ * A task misses when its deadline has already passed by the time it reaches
+ * the head of the queue (because earlier tasks overran, or the system is
+ * simply overloaded).  Misses are counted, and if a miss thunk was given the
+ * late task is handed to it *instead of* being run, so the application can
+ * drop, degrade or reschedule it; without one the task runs late.  Shedding
+ * late work this way is what keeps EDF from cascading under overload.
+ *
+ * Tasks are intrusive: embed `mu_thunk_edf_task_t` as the first member of
+ * your own struct.  The scheduler is not thread-safe.
+ */
+
+#ifndef _MU_THUNK_EDF_H_
+#define _MU_THUNK_EDF_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief Source of the current time, in the same units as deadlines.
+ */
+typedef uint64_t (*mu_thunk_edf_clock_fn)(void);
+
+/**
+ * @brief A thunk with a deadline.
+ */
+typedef struct {
+    mu_thunk_t thunk;  /**< Must be first member */
+    uint64_t release;  /**< Absolute, in clock units; 0 = at once */
+    uint64_t deadline; /**< Absolute, in clock units */
+    size_t index;      /**< Store slot, or SIZE_MAX when not scheduled */
+} mu_thunk_edf_task_t;
+
+/**
+ * @brief An EDF scheduler.  Treat as opaque.
+ */
+typedef struct {
+    mu_thunk_edf_task_t **heap;
+    size_t capacity;
+    size_t count;   /**< Released tasks, in heap[0 .. count) */
+    size_t waiting; /**< Unreleased tasks, at the top of heap */
+    mu_thunk_edf_clock_fn clock;
+    mu_thunk_t *on_miss; /**< Called with the late task as args, or NULL */
+    uint64_t dispatched; /**< Tasks run on time */
+    uint64_t misses;     /**< Tasks found past their deadline */
+} mu_thunk_edf_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a scheduler over a caller-supplied heap array.
+ *
+ * @param edf      Pointer to the scheduler.
+ * @param store    Array of `capacity` task pointers.
+ * @param capacity Maximum number of scheduled tasks, released or not;
+ *                 non-zero.
+ * @param clock    Time source; NULL selects CLOCK_MONOTONIC nanoseconds.
+ * @param on_miss  Thunk invoked as `on_miss(on_miss, task)` for each late
+ *                 task, or NULL to run late tasks anyway.
+ * @return `edf` on success, or NULL if an argument is invalid.
+ */
+mu_thunk_edf_t *mu_thunk_edf_init(mu_thunk_edf_t *edf,
+                                  mu_thunk_edf_task_t **store, size_t capacity,
+                                  mu_thunk_edf_clock_fn clock,
+                                  mu_thunk_t *on_miss);
+
+/**
+ * @brief Initialize a task's thunk and mark it not scheduled.
+ *
+ * @return `task`, or NULL if `task` or `fn` is NULL.
+ */
+mu_thunk_edf_task_t *mu_thunk_edf_task_init(mu_thunk_edf_task_t *task,
+                                            mu_thunk_fn fn);
+
+/**
+ * @brief Return true if the task is waiting in a scheduler.
+ */
+bool mu_thunk_edf_task_is_scheduled(const mu_thunk_edf_task_t *task);
+
+/**
+ * @brief Schedule a task to complete by `deadline`, eligible at once.
+ *
+ * Same as `mu_thunk_edf_schedule_at(edf, task, 0, deadline)`.
+ */
+bool mu_thunk_edf_schedule(mu_thunk_edf_t *edf, mu_thunk_edf_task_t *task,
+                           uint64_t deadline);
+
+/**
+ * @brief Schedule a task to run no earlier than `release` and complete by
+ *        `deadline`.
+ *
+ * A task with a non-zero release time waits, out of deadline contention,
+ * until a run finds the clock at or past it.  A task that is already
+ * scheduled has its release time and deadline moved instead.
+ *
+ * @return true on success, false if an argument is NULL, the store is full,
+ *         or the task is scheduled on another scheduler.
+ */
+bool mu_thunk_edf_schedule_at(mu_thunk_edf_t *edf, mu_thunk_edf_task_t *task,
+                              uint64_t release, uint64_t deadline);
+
+/**
+ * @brief Remove a scheduled task without running it.
+ *
+ * @return true if the task was scheduled on `edf` and has been removed.
+ */
+bool mu_thunk_edf_cancel(mu_thunk_edf_t *edf, mu_thunk_edf_task_t *task);
+
+/**
+ * @brief The released task with the nearest deadline, or NULL if none.
+ */
+mu_thunk_edf_task_t *mu_thunk_edf_peek(const mu_thunk_edf_t *edf);
+
+/**
+ * @brief Earliest release time among unreleased tasks, or UINT64_MAX if
+ *        there are none: when the caller should next run the scheduler.
+ */
+uint64_t mu_thunk_edf_next_release(const mu_thunk_edf_t *edf);
+
+/**
+ * @brief Dispatch up to `max` tasks in deadline order.
+ *
+ * The clock is read once up front and once after each task, so a task is
+ * judged against the time it actually reaches the head of the queue, and
+ * tasks whose release time has passed join the contention each time.  A
+ * task is unscheduled before it (or the miss thunk) is invoked and may
+ * reschedule itself.  At most the number of tasks ready on entry are
+ * taken, so a task that reschedules itself runs at most once per call.
+ *
+ * @param edf  Pointer to the scheduler.
+ * @param args Passed through to every task that runs.
+ * @param max  Upper bound on the batch size (0 means no bound).
+ * @return The number of tasks taken off the queue, late ones included.
+ */
+size_t mu_thunk_edf_run(mu_thunk_edf_t *edf, void *args, size_t max);
+
+/** Number of scheduled tasks, released or not. */
+size_t mu_thunk_edf_count(const mu_thunk_edf_t *edf);
+
+/** Number of tasks run on time since init. */
+uint64_t mu_thunk_edf_dispatched(const mu_thunk_edf_t *edf);
+
+/** Number of deadline misses since init. */
+uint64_t mu_thunk_edf_misses(const mu_thunk_edf_t *edf);
+
+/**
+ * @brief CLOCK_MONOTONIC in nanoseconds (the default clock).
+ */
+uint64_t mu_thunk_edf_now_ns(void);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_EDF_H_ */
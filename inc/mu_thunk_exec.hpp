@@ -0,0 +1,451 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_exec.hpp
+ *
+ * @brief Sender/receiver (P2300) schedulers over mu_thunk run queues.
+ *
+ * `mu::ring_scheduler`, `mu::mpsc_scheduler` and `mu::pool_scheduler` wrap
+ * a `mu_thunk_ring_t`, `mu_thunk_mpsc_t` or `mu_thunk_pool_t`.  Their
+ * `schedule()` sender connects to an operation state that begins with a
+ * `mu_thunk_mpsc_node_t` (so a `mu_thunk_t` at offset 0); `start()` puts
+ * that thunk on the queue, and whoever drains the queue completes the
+ * receiver with `set_value()`.  If the queue refuses the thunk (a full
+ * ring, a full pool injection queue) the receiver gets `set_error()` with
+ * a `std::system_error` for EAGAIN instead.
+ *
+ * `mu::then` and `mu::when_all` compose senders.  Every operation state,
+ * including the children of `when_all` and their results, is held inline
+ * in its parent, so a pipeline connected on the stack allocates nothing.
+ *
+ * The protocol follows the member-function form of P2300R10:
+ * `std::move(sndr).connect(rcvr)`, `op.start()`, and
+ * `std::move(rcvr).set_value(vs...)` / `set_error(std::exception_ptr)` /
+ * `set_stopped()`.  Completion signatures are simplified to one value list
+ * per sender, `value_types`, a `mu::values<Ts...>`.
+ */
+
+#ifndef _MU_THUNK_EXEC_HPP_
+#define _MU_THUNK_EXEC_HPP_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_mpsc.h"
+#include "mu_thunk_pool.h"
+#include "mu_thunk_ring.h"
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// *****************************************************************************
+// Public types and definitions
+
+namespace mu {
+
+/** The values a sender completes with. */
+template <typename... Ts> struct values {};
+
+/** `std::move(sndr).connect(rcvr)`. */
+template <typename S, typename R> auto connect(S &&sndr, R rcvr) {
+    return std::forward<S>(sndr).connect(std::move(rcvr));
+}
+
+template <typename S, typename R>
+using connect_result_t =
+    decltype(mu::connect(std::declval<S>(), std::declval<R>()));
+
+namespace detail {
+
+/**
+ * @brief Start of every schedule operation state.  Must stay standard
+ *        layout with the node first, so the thunk can be cast back.
+ */
+struct thunk_op {
+    mu_thunk_mpsc_node_t node; /**< Must be first member */
+
+    explicit thunk_op(mu_thunk_fn fn) noexcept {
+        _mu_thunk_init(&node.thunk, fn);
+        node.next.store(nullptr, std::memory_order_relaxed);
+    }
+
+    thunk_op(const thunk_op &) = delete;
+    thunk_op &operator=(const thunk_op &) = delete;
+};
+
+static_assert(std::is_standard_layout_v<thunk_op>,
+              "thunk_op must be standard layout");
+static_assert(offsetof(thunk_op, node) == 0,
+              "the thunk must be at offset 0 of the operation state");
+
+inline std::exception_ptr queue_full_error() {
+    return std::make_exception_ptr(
+        std::system_error(EAGAIN, std::generic_category(), "queue full"));
+}
+
+template <typename Sched, typename R> class schedule_op : thunk_op {
+  public:
+    schedule_op(Sched sched, R rcvr)
+        : thunk_op(run), m_sched(sched), m_rcvr(std::move(rcvr)) {}
+
+    void start() & noexcept {
+        // After a successful post the op may complete (and be destroyed)
+        // on another thread; touch nothing once it returns true.
+        if (!m_sched.post(&node)) {
+            std::move(m_rcvr).set_error(queue_full_error());
+        }
+    }
+
+  private:
+    static void run(mu_thunk_t *thunk, void *args) {
+        (void)args;
+        auto *op = static_cast<schedule_op *>(
+            reinterpret_cast<thunk_op *>(thunk));
+        std::move(op->m_rcvr).set_value();
+    }
+
+    Sched m_sched;
+    R m_rcvr;
+};
+
+} // namespace detail
+
+/**
+ * @brief Sender that completes with no values on `Sched`'s queue.
+ */
+template <typename Sched> class schedule_sender {
+  public:
+    using value_types = values<>;
+
+    explicit schedule_sender(Sched sched) noexcept : m_sched(sched) {}
+
+    template <typename R> detail::schedule_op<Sched, R> connect(R rcvr) const {
+        return detail::schedule_op<Sched, R>(m_sched, std::move(rcvr));
+    }
+
+  private:
+    Sched m_sched;
+};
+
+/** Completions run on whichever thread next drains the ring. */
+class ring_scheduler {
+  public:
+    explicit ring_scheduler(mu_thunk_ring_t *ring) noexcept : m_ring(ring) {}
+
+    schedule_sender<ring_scheduler> schedule() const noexcept {
+        return schedule_sender<ring_scheduler>(*this);
+    }
+
+    bool post(mu_thunk_mpsc_node_t *node) const noexcept {
+        return mu_thunk_ring_put(m_ring, &node->thunk);
+    }
+
+    bool operator==(const ring_scheduler &) const = default;
+
+  private:
+    mu_thunk_ring_t *m_ring;
+};
+
+/** Completions run on the consumer of the MPSC queue. */
+class mpsc_scheduler {
+  public:
+    explicit mpsc_scheduler(mu_thunk_mpsc_t *q) noexcept : m_q(q) {}
+
+    schedule_sender<mpsc_scheduler> schedule() const noexcept {
+        return schedule_sender<mpsc_scheduler>(*this);
+    }
+
+    bool post(mu_thunk_mpsc_node_t *node) const noexcept {
+        return mu_thunk_mpsc_put(m_q, node);
+    }
+
+    bool operator==(const mpsc_scheduler &) const = default;
+
+  private:
+    mu_thunk_mpsc_t *m_q;
+};
+
+/** Completions run on a pool worker (or a thread helping the pool). */
+class pool_scheduler {
+  public:
+    explicit pool_scheduler(mu_thunk_pool_t *pool) noexcept : m_pool(pool) {}
+
+    schedule_sender<pool_scheduler> schedule() const noexcept {
+        return schedule_sender<pool_scheduler>(*this);
+    }
+
+    bool post(mu_thunk_mpsc_node_t *node) const noexcept {
+        return mu_thunk_pool_submit(m_pool, &node->thunk, nullptr);
+    }
+
+    bool operator==(const pool_scheduler &) const = default;
+
+  private:
+    mu_thunk_pool_t *m_pool;
+};
+
+/** `sched.schedule()`. */
+template <typename Sched> auto schedule(const Sched &sched) noexcept {
+    return sched.schedule();
+}
+
+namespace detail {
+
+template <typename F, typename Vs> struct then_values;
+
+template <typename F, typename... Ts> struct then_values<F, values<Ts...>> {
+    using result = std::invoke_result_t<F, Ts...>;
+    using type =
+        std::conditional_t<std::is_void_v<result>, values<>, values<result>>;
+};
+
+template <typename F, typename R> struct then_receiver {
+    F fn;
+    R rcvr;
+
+    template <typename... Vs> void set_value(Vs &&...vs) && noexcept {
+        try {
+            using result = std::invoke_result_t<F, Vs...>;
+            if constexpr (std::is_void_v<result>) {
+                std::invoke(std::move(fn), std::forward<Vs>(vs)...);
+                std::move(rcvr).set_value();
+            } else {
+                std::move(rcvr).set_value(
+                    std::invoke(std::move(fn), std::forward<Vs>(vs)...));
+            }
+        } catch (...) {
+            std::move(rcvr).set_error(std::current_exception());
+        }
+    }
+
+    void set_error(std::exception_ptr e) && noexcept {
+        std::move(rcvr).set_error(std::move(e));
+    }
+
+    void set_stopped() && noexcept { std::move(rcvr).set_stopped(); }
+};
+
+} // namespace detail
+
+/**
+ * @brief Sender that calls `fn` with the values of `S` and completes with
+ *        its result.  An exception from `fn` becomes `set_error()`.
+ */
+template <typename S, typename F> class then_sender {
+  public:
+    using value_types =
+        typename detail::then_values<F, typename S::value_types>::type;
+
+    then_sender(S sndr, F fn) : m_sndr(std::move(sndr)), m_fn(std::move(fn)) {}
+
+    template <typename R> auto connect(R rcvr) && {
+        return mu::connect(std::move(m_sndr),
+                           detail::then_receiver<F, R>{std::move(m_fn),
+                                                       std::move(rcvr)});
+    }
+
+  private:
+    S m_sndr;
+    F m_fn;
+};
+
+template <typename S, typename F> then_sender<std::decay_t<S>, F> then(S &&s,
+                                                                      F fn) {
+    return then_sender<std::decay_t<S>, F>(std::forward<S>(s), std::move(fn));
+}
+
+/** Pipeable form: `sched.schedule() | mu::then(fn)`. */
+template <typename F> struct then_closure {
+    F fn;
+};
+
+template <typename F> then_closure<F> then(F fn) { return {std::move(fn)}; }
+
+template <typename S, typename F>
+then_sender<std::decay_t<S>, F> operator|(S &&s, then_closure<F> c) {
+    return then(std::forward<S>(s), std::move(c.fn));
+}
+
+namespace detail {
+
+template <typename... Vs> struct concat_values;
+
+template <> struct concat_values<> {
+    using type = values<>;
+};
+
+template <typename... Ts> struct concat_values<values<Ts...>> {
+    using type = values<Ts...>;
+};
+
+template <typename... Ts, typename... Us, typename... Rest>
+struct concat_values<values<Ts...>, values<Us...>, Rest...> {
+    using type = typename concat_values<values<Ts..., Us...>, Rest...>::type;
+};
+
+/** Storage for one child's values. */
+template <typename Vs> struct value_slot;
+
+template <typename... Ts> struct value_slot<values<Ts...>> {
+    using type = std::optional<std::tuple<Ts...>>;
+};
+
+/** Converts to `fn()`'s result, so immovable ops construct in place. */
+template <typename Fn> struct emplacer {
+    Fn fn;
+    operator std::invoke_result_t<Fn>() && { return std::move(fn)(); }
+};
+
+template <typename Fn> emplacer(Fn) -> emplacer<Fn>;
+
+enum class when_all_state { ok, error, stopped };
+
+template <typename R, typename Is, typename... Ss> class when_all_op;
+
+template <typename R, std::size_t... Is, typename... Ss>
+class when_all_op<R, std::index_sequence<Is...>, Ss...> {
+    template <std::size_t I> struct child_receiver {
+        when_all_op *op;
+
+        template <typename... Vs> void set_value(Vs &&...vs) && noexcept {
+            std::get<I>(op->m_values).emplace(std::forward<Vs>(vs)...);
+            op->arrive();
+        }
+
+        void set_error(std::exception_ptr e) && noexcept {
+            op->fail(when_all_state::error, std::move(e));
+            op->arrive();
+        }
+
+        void set_stopped() && noexcept {
+            op->fail(when_all_state::stopped, nullptr);
+            op->arrive();
+        }
+    };
+
+  public:
+    when_all_op(std::tuple<Ss...> &&sndrs, R rcvr)
+        : m_rcvr(std::move(rcvr)), m_remaining(sizeof...(Ss)),
+          m_state(when_all_state::ok),
+          m_ops(emplacer{[&, this] {
+              return mu::connect(std::move(std::get<Is>(sndrs)),
+                                 child_receiver<Is>{this});
+          }}...) {}
+
+    when_all_op(const when_all_op &) = delete;
+    when_all_op &operator=(const when_all_op &) = delete;
+
+    void start() & noexcept {
+        if constexpr (sizeof...(Ss) == 0) {
+            // No child will ever arrive.
+            std::move(m_rcvr).set_value();
+        } else {
+            // The op cannot complete before the last child has been started.
+            (std::get<Is>(m_ops).start(), ...);
+        }
+    }
+
+  private:
+    void fail(when_all_state state, std::exception_ptr e) noexcept {
+        when_all_state expect = when_all_state::ok;
+        if (m_state.compare_exchange_strong(expect, state,
+                                            std::memory_order_relaxed)) {
+            m_error = std::move(e);
+        }
+    }
+
+    void arrive() noexcept {
+        if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        switch (m_state.load(std::memory_order_relaxed)) {
+        case when_all_state::error:
+            std::move(m_rcvr).set_error(std::move(m_error));
+            break;
+        case when_all_state::stopped:
+            std::move(m_rcvr).set_stopped();
+            break;
+        default:
+            std::apply(
+                [this](auto &&...vs) {
+                    std::move(m_rcvr).set_value(std::move(vs)...);
+                },
+                std::tuple_cat(std::move(*std::get<Is>(m_values))...));
+            break;
+        }
+    }
+
+    R m_rcvr;
+    std::tuple<typename value_slot<typename Ss::value_types>::type...>
+        m_values;
+    std::atomic<std::size_t> m_remaining;
+    std::atomic<when_all_state> m_state;
+    std::exception_ptr m_error;
+    std::tuple<connect_result_t<Ss, child_receiver<Is>>...> m_ops;
+};
+
+} // namespace detail
+
+/**
+ * @brief Sender that starts every child and, once all have completed,
+ *        completes with their values concatenated in order.  The first
+ *        error (or stop) wins; all children still run to completion.
+ *        With no children it completes with no values when started.
+ */
+template <typename... Ss> class when_all_sender {
+  public:
+    using value_types =
+        typename detail::concat_values<typename Ss::value_types...>::type;
+
+    explicit when_all_sender(Ss... sndrs) : m_sndrs(std::move(sndrs)...) {}
+
+    template <typename R> auto connect(R rcvr) && {
+        return detail::when_all_op<R, std::index_sequence_for<Ss...>, Ss...>(
+            std::move(m_sndrs), std::move(rcvr));
+    }
+
+  private:
+    std::tuple<Ss...> m_sndrs;
+};
+
+template <typename... Ss>
+when_all_sender<std::decay_t<Ss>...> when_all(Ss &&...sndrs) {
+    return when_all_sender<std::decay_t<Ss>...>(std::forward<Ss>(sndrs)...);
+}
+
+} // namespace mu
+
+// *****************************************************************************
+// End of file
+
+#endif /* _MU_THUNK_EXEC_HPP_ */
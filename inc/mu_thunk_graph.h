@@ -0,0 +1,170 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_graph.h
+ *
+ * @brief Dependency-graph (DAG) executor for thunks.
+ *
+ * Each node embeds the thunk that does its work and lists its successors in
+ * a caller-supplied array.  A run resets every node's atomic count of
+ * unfinished predecessors, submits the nodes that have none to a
+ * `mu_thunk_pool_t`, and waits.  When a node finishes, the thread that ran
+ * it decrements each successor's count and schedules those that reach zero
+ * -- keeping one to run next itself -- so there is no global lock or
+ * central scheduler.
+ *
+ * Graphs are built once and run any number of times without allocation.
+ * Building (`mu_thunk_graph_add()`, `mu_thunk_graph_depend()`) is not
+ * thread-safe and must not overlap a run.
+ *
+ * Embed a `mu_thunk_graph_node_t` at offset 0 of your own struct: the node
+ * function is called as `fn(&node->thunk, args)`, where `args` is the value
+ * passed to `mu_thunk_graph_run()`.
+ */
+
+#ifndef _MU_THUNK_GRAPH_H_
+#define _MU_THUNK_GRAPH_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_atomic.h"
+#include "mu_thunk_pool.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+struct _mu_thunk_graph;
+
+/**
+ * @brief A graph node.  Only `thunk` is meant to be touched by user code.
+ */
+typedef struct _mu_thunk_graph_node {
+    mu_thunk_t thunk;  /**< Must be first member: the node's work */
+    mu_thunk_t runner; /**< What the pool actually runs */
+    struct _mu_thunk_graph *graph;
+    struct _mu_thunk_graph_node *next;       /**< Next node of the graph */
+    struct _mu_thunk_graph_node *ready_next; /**< Serial run work list */
+    struct _mu_thunk_graph_node **succ;      /**< Successors */
+    uint32_t n_succ;
+    uint32_t succ_cap;
+    uint32_t n_pred;                   /**< Number of predecessors */
+    MU_THUNK_ATOMIC(uint32_t) pending; /**< Unfinished predecessors */
+} mu_thunk_graph_node_t;
+
+/**
+ * @brief A graph: the list of its nodes and the state of the current run.
+ */
+typedef struct _mu_thunk_graph {
+    mu_thunk_graph_node_t *head;
+    mu_thunk_graph_node_t *tail;
+    size_t n_nodes;
+    mu_thunk_pool_t *pool;
+    void *args;
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(size_t) remaining;
+} mu_thunk_graph_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an empty graph.
+ *
+ * @return `graph`, or NULL if `graph` is NULL.
+ */
+mu_thunk_graph_t *mu_thunk_graph_init(mu_thunk_graph_t *graph);
+
+/**
+ * @brief Initialize a node and add it to a graph.
+ *
+ * @param graph    The graph.
+ * @param node     The node, which must not already be in a graph.
+ * @param fn       The node's work.
+ * @param succ     Storage for up to `succ_cap` successor pointers (may be
+ *                 NULL if `succ_cap` is 0).
+ * @param succ_cap Capacity of `succ`.
+ * @return `node`, or NULL if an argument is invalid.
+ */
+mu_thunk_graph_node_t *mu_thunk_graph_add(mu_thunk_graph_t *graph,
+                                          mu_thunk_graph_node_t *node,
+                                          mu_thunk_fn fn,
+                                          mu_thunk_graph_node_t **succ,
+                                          uint32_t succ_cap);
+
+/**
+ * @brief Make `after` wait for `before` to finish.
+ *
+ * @return true on success, false if either node is NULL, they are the same
+ *         node or in different graphs, or `before` has no room for another
+ *         successor.
+ */
+bool mu_thunk_graph_depend(mu_thunk_graph_node_t *before,
+                           mu_thunk_graph_node_t *after);
+
+/**
+ * @brief Return true if the graph has no dependency cycle.  A graph with a
+ *        cycle never finishes a run.  O(nodes + edges); not thread-safe.
+ */
+bool mu_thunk_graph_is_acyclic(mu_thunk_graph_t *graph);
+
+/**
+ * @brief Run every node once, each after all of its predecessors, and wait
+ *        for the last one to finish.
+ *
+ * With a pool, the calling thread helps run pool work while it waits.  With
+ * `pool` NULL, the nodes run on the calling thread in a topological order.
+ *
+ * @param graph An acyclic graph.
+ * @param pool  Pool to run on, or NULL.
+ * @param args  Passed to every node function.
+ * @return true once all nodes have run, false if `graph` is NULL.
+ */
+bool mu_thunk_graph_run(mu_thunk_graph_t *graph, mu_thunk_pool_t *pool,
+                        void *args);
+
+/**
+ * @brief Return the number of nodes (0 if `graph` is NULL).
+ */
+size_t mu_thunk_graph_node_count(const mu_thunk_graph_t *graph);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_GRAPH_H_ */
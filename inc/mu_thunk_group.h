@@ -0,0 +1,196 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_group.h
+ *
+ * @brief Batch dispatch that groups thunks by function.
+ *
+ * Draining a queue of mixed thunks alternates between call targets, which
+ * costs an indirect-branch mispredict and often an i-cache miss per thunk.
+ * A group pass takes a batch, partitions it by `fn` with a stable counting
+ * sort (functions in order of first appearance, thunks in queue order
+ * within each function) and then calls each function's thunks back to
+ * back, so the indirect branch is predictable and the function's code stays
+ * hot for the whole run.
+ *
+ * The price is ordering: thunks of *different* functions no longer run in
+ * queue order.  Only use a group where that is acceptable.
+ *
+ * A function may also be bound to a span handler, which then receives all
+ * of that function's thunks in a pass with a single call, e.g. to vectorize
+ * the work or to amortize a lock.
+ *
+ * A group holds only scratch space; it is not thread-safe, but drains are
+ * safe to use from a ring's or MPSC queue's consumer thread.  A thunk may
+ * dispatch or drain through the group that is running it: the nested call
+ * cannot reuse the scratch space in use, so it runs its thunks ungrouped,
+ * in queue order.
+ */
+
+#ifndef _MU_THUNK_GROUP_H_
+#define _MU_THUNK_GROUP_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_mpsc.h"
+#include "mu_thunk_ring.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * Distinct functions grouped per pass; thunks of further functions run
+ * ungrouped, in queue order, after the groups.  Also the number of span
+ * handlers a group can hold.
+ */
+#ifndef MU_THUNK_GROUP_MAX_FNS
+#define MU_THUNK_GROUP_MAX_FNS 16
+#endif
+
+/**
+ * @brief Handler that receives every thunk of one function in a pass.
+ *
+ * @param thunks The thunks, in queue order.
+ * @param n      Number of thunks, at least 1.
+ * @param args   As passed to the drain.
+ */
+typedef void (*mu_thunk_span_fn)(mu_thunk_t **thunks, size_t n, void *args);
+
+/** Slots in the fn -> bucket hash; a power of two, well above MAX_FNS. */
+#ifndef MU_THUNK_GROUP_HASH_SIZE
+#define MU_THUNK_GROUP_HASH_SIZE 64
+#endif
+
+typedef struct {
+    mu_thunk_fn fn;
+    mu_thunk_span_fn span; /**< NULL: call each thunk */
+    size_t count;
+    size_t offset;
+    size_t slot; /**< Hash slot, cleared after the pass */
+} mu_thunk_group_bucket_t;
+
+typedef struct {
+    mu_thunk_fn fn; /**< NULL: empty */
+    size_t bucket;
+} mu_thunk_group_slot_t;
+
+typedef struct {
+    mu_thunk_fn fn;
+    mu_thunk_span_fn span;
+} mu_thunk_group_binding_t;
+
+/**
+ * @brief Grouping scratch space and span bindings.  Treat as opaque.
+ */
+typedef struct {
+    mu_thunk_t **store; /**< 2 * capacity: staging, then sorted output */
+    size_t capacity;
+    size_t n_buckets;
+    size_t n_bindings;
+    bool running; /**< A pass is invoking thunks; nested calls don't group */
+    mu_thunk_group_bucket_t buckets[MU_THUNK_GROUP_MAX_FNS + 1];
+    mu_thunk_group_binding_t bindings[MU_THUNK_GROUP_MAX_FNS];
+    mu_thunk_group_slot_t slots[MU_THUNK_GROUP_HASH_SIZE];
+} mu_thunk_group_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a group over caller-supplied scratch space.
+ *
+ * @param group    Pointer to the group.
+ * @param store    Array of `2 * capacity` thunk pointers.
+ * @param capacity Largest batch grouped in one pass; non-zero.
+ * @return `group`, or NULL if an argument is invalid.
+ */
+mu_thunk_group_t *mu_thunk_group_init(mu_thunk_group_t *group,
+                                      mu_thunk_t **store, size_t capacity);
+
+/**
+ * @brief Bind (or, with `span` NULL, unbind) a span handler to `fn`.
+ *
+ * @return true on success, false if an argument is invalid or all
+ *         MU_THUNK_GROUP_MAX_FNS bindings are in use.
+ */
+bool mu_thunk_group_set_span(mu_thunk_group_t *group, mu_thunk_fn fn,
+                             mu_thunk_span_fn span);
+
+/**
+ * @brief Group and invoke an array of thunks.
+ *
+ * Batches larger than the group's capacity are handled as consecutive
+ * passes.  `thunks` itself is not modified.
+ *
+ * @return The number of thunks invoked (`n`), or 0 if an argument is NULL.
+ */
+size_t mu_thunk_group_dispatch(mu_thunk_group_t *group, mu_thunk_t **thunks,
+                               size_t n, void *args);
+
+/**
+ * @brief Grouped equivalent of `mu_thunk_ring_drain()`.  Consumer thread
+ *        only.
+ *
+ * Invokes the entries present on entry, in passes of up to `capacity`.
+ * A pass's slots are released to the producer before any of it runs.
+ *
+ * @return The number of thunks invoked.
+ */
+size_t mu_thunk_group_drain_ring(mu_thunk_group_t *group,
+                                 mu_thunk_ring_t *ring, void *args);
+
+/**
+ * @brief Grouped equivalent of `mu_thunk_mpsc_drain()`.  Consumer thread
+ *        only.
+ *
+ * Dequeues up to `max` nodes (0 means all of them), in passes of up to
+ * `capacity`, stopping at the last node queued on entry.  Nodes are
+ * dequeued before they run, so they may re-post themselves; nodes posted
+ * during the drain wait for the next call.
+ *
+ * @return The number of thunks invoked.
+ */
+size_t mu_thunk_group_drain_mpsc(mu_thunk_group_t *group, mu_thunk_mpsc_t *q,
+                                 void *args, size_t max);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_GROUP_H_ */
@@ -0,0 +1,60 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_thunk_hash.h
+ *
+ * @brief Hashing of thunk functions for the library's fn-keyed tables.
+ *        Internal: included by the modules' .c files, not part of the
+ *        public API.
+ */
+
+#ifndef _MU_THUNK_HASH_H_
+#define _MU_THUNK_HASH_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Public code
+
+/**
+ * @brief Slot for `fn` in an open-addressed table of `mask + 1` slots (a
+ *        power of two no larger than 2^24).
+ */
+static inline size_t _mu_thunk_hash_fn(mu_thunk_fn fn, size_t mask) {
+    // Fibonacci hashing; the top bits are the well-mixed ones.
+    uint64_t h = (uint64_t)(uintptr_t)fn * 0x9e3779b97f4a7c15ull;
+    return (size_t)(h >> 40) & mask;
+}
+
+// *****************************************************************************
+// End of file
+
+#endif /* _MU_THUNK_HASH_H_ */
@@ -0,0 +1,68 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_impl.h
+ *
+ * @brief Definitions of the checked thunk API.  Included by `mu_thunk.c`,
+ *        or by `mu_thunk.h` itself when MU_THUNK_HEADER_ONLY is defined.
+ *        Do not include directly.
+ */
+
+#ifndef _MU_THUNK_IMPL_H_
+#define _MU_THUNK_IMPL_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <stddef.h>
+
+// *****************************************************************************
+// Public code
+
+MU_THUNK_API mu_thunk_t *mu_thunk_init(mu_thunk_t *thunk, mu_thunk_fn fn) {
+#ifndef MU_THUNK_UNCHECKED
+    if (thunk == NULL || fn == NULL) {
+        return NULL;
+    }
+#endif
+    // Use the inline initializer
+    return _mu_thunk_init(thunk, fn);
+}
+
+MU_THUNK_API void mu_thunk_call(mu_thunk_t *thunk, void *args) {
+#ifndef MU_THUNK_UNCHECKED
+    if (thunk == NULL || thunk->fn == NULL) {
+        return;
+    }
+#endif
+    // Use the inline call
+    _mu_thunk_call(thunk, args);
+}
+
+// *****************************************************************************
+// End of file
+
+#endif /* _MU_THUNK_IMPL_H_ */
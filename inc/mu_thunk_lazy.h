@@ -0,0 +1,153 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_lazy.h
+ *
+ * @brief Call-by-need thunks: a function that runs at most once, on first
+ *        force, with its result cached for every later force.
+ *
+ * Embed a `mu_thunk_lazy_t` at offset 0 of a struct that holds the result
+ * (or store a pointer to it in `value`), and have the thunk function fill
+ * it in:
+ *
+ *     static void load_config(mu_thunk_t *thunk, void *args) {
+ *         config_t *cfg = (config_t *)thunk;
+ *         parse_config_file(cfg, (const char *)args);
+ *     }
+ *     static config_t s_config = {.lazy = MU_THUNK_LAZY_INIT(load_config)};
+ *     ...
+ *     mu_thunk_lazy_force(&s_config.lazy, "/etc/app.conf");
+ *
+ * `mu_thunk_lazy_force()` is safe to call from any number of threads.  The
+ * first caller runs the function; callers that arrive while it runs sleep
+ * on a futex (Linux) rather than spinning, and everything the function
+ * wrote is visible to every caller once force returns.  Once evaluated, a
+ * force is a single acquire load.
+ *
+ * The function must not force its own lazy value: that deadlocks.
+ */
+
+#ifndef _MU_THUNK_LAZY_H_
+#define _MU_THUNK_LAZY_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_atomic.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Evaluation states of a `mu_thunk_lazy_t`. */
+typedef enum {
+    MU_THUNK_LAZY_UNINIT = 0,  /**< Not yet forced */
+    MU_THUNK_LAZY_RUNNING = 1, /**< Being evaluated, nobody waiting */
+    MU_THUNK_LAZY_WAITING = 2, /**< Being evaluated, forcers asleep */
+    MU_THUNK_LAZY_DONE = 3,    /**< Evaluated; `value` is final */
+} mu_thunk_lazy_state_t;
+
+/**
+ * @brief A lazily evaluated thunk and its cached result.
+ */
+typedef struct {
+    mu_thunk_t thunk;                 /**< Must be first member */
+    MU_THUNK_ATOMIC(uint32_t) state;  /**< A `mu_thunk_lazy_state_t` */
+    void *value;                      /**< Optional result, set by `fn` */
+} mu_thunk_lazy_t;
+
+/**
+ * @brief Static initializer, for lazy values with static storage duration
+ *        that must be usable before any init code runs.
+ */
+#define MU_THUNK_LAZY_INIT(f)                                                  \
+    { .thunk = {.fn = (f)}, .state = MU_THUNK_LAZY_UNINIT, .value = NULL }
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize (or reset) a lazy value.  Not thread-safe: no thread
+ *        may be forcing `lazy` at the time.
+ *
+ * @return `lazy`, or NULL if `lazy` or `fn` is NULL.
+ */
+mu_thunk_lazy_t *mu_thunk_lazy_init(mu_thunk_lazy_t *lazy, mu_thunk_fn fn);
+
+/**
+ * @brief Evaluate `lazy` if nobody has yet, waiting for an evaluation in
+ *        progress on another thread.
+ *
+ * @param lazy Pointer to the lazy value.
+ * @param args Passed to the thunk function if this call evaluates it.
+ * @return `lazy->value` as left by the thunk function, or NULL if `lazy`
+ *         is NULL.
+ */
+void *mu_thunk_lazy_force_slow(mu_thunk_lazy_t *lazy, void *args);
+
+/**
+ * @brief Return true once `lazy` has been evaluated (false if NULL).
+ */
+static inline bool mu_thunk_lazy_is_done(mu_thunk_lazy_t *lazy) {
+    if (lazy == NULL) {
+        return false;
+    }
+#ifdef __cplusplus
+    return lazy->state.load(std::memory_order_acquire) == MU_THUNK_LAZY_DONE;
+#else
+    return atomic_load_explicit(&lazy->state, memory_order_acquire) ==
+           MU_THUNK_LAZY_DONE;
+#endif
+}
+
+/**
+ * @brief Force `lazy` (see `mu_thunk_lazy_force_slow()`).  The evaluated
+ *        case is inlined and costs one acquire load.
+ */
+static inline void *mu_thunk_lazy_force(mu_thunk_lazy_t *lazy, void *args) {
+    if (mu_thunk_lazy_is_done(lazy)) {
+        return lazy->value;
+    }
+    return mu_thunk_lazy_force_slow(lazy, args);
+}
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_LAZY_H_ */
@@ -0,0 +1,150 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_mpsc.h
+ *
+ * @brief Intrusive, unbounded multi-producer / single-consumer run queue of
+ *        thunks (Vyukov's MPSC node queue).
+ *
+ * The link lives in `mu_thunk_mpsc_node_t`, which embeds a `mu_thunk_t` at
+ * offset 0.  Embed the node as the first member of your own struct and the
+ * usual cast-back-to-context pattern still works; posting never allocates.
+ *
+ * Any number of threads may call `mu_thunk_mpsc_put()`; it is wait-free (one
+ * atomic exchange and one store).  Exactly one thread may call
+ * `mu_thunk_mpsc_get()` / `mu_thunk_mpsc_drain()`.
+ */
+
+#ifndef _MU_THUNK_MPSC_H_
+#define _MU_THUNK_MPSC_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_atomic.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief A thunk with an intrusive link for `mu_thunk_mpsc_t`.
+ *
+ * A node may be on at most one queue at a time.  Once dequeued (including
+ * from inside its own thunk function) it may be posted again.
+ */
+typedef struct _mu_thunk_mpsc_node {
+    mu_thunk_t thunk; /**< Must be first member */
+    MU_THUNK_ATOMIC(struct _mu_thunk_mpsc_node *) next;
+} mu_thunk_mpsc_node_t;
+
+/**
+ * @brief MPSC queue.  Producers share `tail`; the consumer owns `head`.
+ */
+typedef struct {
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(mu_thunk_mpsc_node_t *) tail;
+    MU_THUNK_CACHE_ALIGNED mu_thunk_mpsc_node_t *head;
+    mu_thunk_mpsc_node_t stub;
+} mu_thunk_mpsc_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an empty queue.
+ *
+ * @param q Pointer to the queue.
+ * @return `q`, or NULL if `q` is NULL.
+ */
+mu_thunk_mpsc_t *mu_thunk_mpsc_init(mu_thunk_mpsc_t *q);
+
+/**
+ * @brief Initialize a node's thunk and clear its link.
+ *
+ * @param node Pointer to the node.
+ * @param fn   Function to invoke when the node is dispatched.
+ * @return `node`, or NULL if `node` or `fn` is NULL.
+ */
+mu_thunk_mpsc_node_t *mu_thunk_mpsc_node_init(mu_thunk_mpsc_node_t *node,
+                                              mu_thunk_fn fn);
+
+/**
+ * @brief Post a node to the queue.  Safe from any thread.
+ *
+ * @param q    Pointer to the queue.
+ * @param node Node to append; must not currently be on any queue.
+ * @return true on success, false if an argument is NULL.
+ */
+bool mu_thunk_mpsc_put(mu_thunk_mpsc_t *q, mu_thunk_mpsc_node_t *node);
+
+/**
+ * @brief Remove the oldest node.  Consumer thread only.
+ *
+ * Returns NULL if the queue is empty.  It may also return NULL for a brief
+ * window while a producer is between its exchange and its link store; the
+ * node becomes visible as soon as that producer completes its put.
+ *
+ * @param q Pointer to the queue.
+ * @return The dequeued node, or NULL.
+ */
+mu_thunk_mpsc_node_t *mu_thunk_mpsc_get(mu_thunk_mpsc_t *q);
+
+/**
+ * @brief Return true if no node is queued.  Consumer thread only.
+ */
+bool mu_thunk_mpsc_is_empty(mu_thunk_mpsc_t *q);
+
+/**
+ * @brief Dequeue and invoke up to `max` nodes.  Consumer thread only.
+ *
+ * Each node is dequeued before `_mu_thunk_call(&node->thunk, args)` runs, so
+ * a thunk may re-post itself.  Only nodes queued when the drain starts are
+ * invoked; anything posted during the drain (including a re-posted node)
+ * is left for the next call.
+ *
+ * @param q    Pointer to the queue.
+ * @param args Passed through to every thunk.
+ * @param max  Upper bound on the batch size (0 means no bound).
+ * @return The number of thunks invoked.
+ */
+size_t mu_thunk_mpsc_drain(mu_thunk_mpsc_t *q, void *args, size_t max);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_MPSC_H_ */
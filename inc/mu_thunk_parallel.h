@@ -0,0 +1,140 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_parallel.h
+ *
+ * @brief Fork-join loops over an index range on a `mu_thunk_pool_t`.
+ *
+ * `mu_thunk_parallel_for()` splits `[begin, end)` into chunks, builds one
+ * chunk thunk per chunk on the caller's stack, submits all but the first to
+ * the pool and runs the first itself.  It then waits on a join counter,
+ * running pool work via `mu_thunk_pool_help()` while it does, and returns
+ * once every chunk has finished.  Nothing is allocated.
+ *
+ * `mu_thunk_parallel_reduce()` does the same, with each chunk folding its
+ * range into a private accumulator that starts as a copy of the caller's
+ * identity value.  The partial results are combined left to right in range
+ * order, so `combine` need only be associative.
+ *
+ * Both may be called from a pool worker (nested loops) or from any other
+ * thread.
+ */
+
+#ifndef _MU_THUNK_PARALLEL_H_
+#define _MU_THUNK_PARALLEL_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_pool.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Maximum number of chunks per call; bounds the stack used by a call. */
+#ifndef MU_THUNK_PARALLEL_MAX_CHUNKS
+#define MU_THUNK_PARALLEL_MAX_CHUNKS 64
+#endif
+
+/** With automatic grain, chunks per participating thread (for balance). */
+#ifndef MU_THUNK_PARALLEL_CHUNKS_PER_THREAD
+#define MU_THUNK_PARALLEL_CHUNKS_PER_THREAD 4
+#endif
+
+/** Maximum size in bytes of a `mu_thunk_parallel_reduce()` accumulator. */
+#ifndef MU_THUNK_PARALLEL_MAX_ACC
+#define MU_THUNK_PARALLEL_MAX_ACC 64
+#endif
+
+/** Loop body: process indices `[begin, end)`. */
+typedef void (*mu_thunk_parallel_for_fn)(size_t begin, size_t end,
+                                         void *ctx);
+
+/** Reduce body: fold indices `[begin, end)` into `acc`. */
+typedef void (*mu_thunk_parallel_reduce_fn)(size_t begin, size_t end,
+                                            void *acc, void *ctx);
+
+/** Combine: fold `right` (the partial result of a later range) into `acc`. */
+typedef void (*mu_thunk_parallel_combine_fn)(void *acc, const void *right,
+                                             void *ctx);
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Run `body` over `[begin, end)` in parallel and wait for it.
+ *
+ * @param pool  Pool to run chunks on.
+ * @param begin First index.
+ * @param end   One past the last index.
+ * @param grain Minimum indices per chunk, or 0 to size chunks from the
+ *              range and the pool's worker count.  A range of at most one
+ *              grain runs inline on the caller.
+ * @param body  Called once per chunk, from any thread.
+ * @param ctx   Passed through to `body`.
+ * @return true once all chunks have run, false if `pool` or `body` is NULL
+ *         or `begin > end`.
+ */
+bool mu_thunk_parallel_for(mu_thunk_pool_t *pool, size_t begin, size_t end,
+                           size_t grain, mu_thunk_parallel_for_fn body,
+                           void *ctx);
+
+/**
+ * @brief Reduce `[begin, end)` in parallel and wait for the result.
+ *
+ * @param pool     Pool to run chunks on.
+ * @param begin    First index.
+ * @param end      One past the last index.
+ * @param grain    As for `mu_thunk_parallel_for()`.
+ * @param acc      On entry the identity value; on return the result.
+ * @param acc_size Size of `*acc` in bytes (at most MU_THUNK_PARALLEL_MAX_ACC).
+ * @param body     Folds a chunk into an accumulator.
+ * @param combine  Folds a later chunk's accumulator into an earlier one's.
+ * @param ctx      Passed through to `body` and `combine`.
+ * @return true on success, false if an argument is invalid.
+ */
+bool mu_thunk_parallel_reduce(mu_thunk_pool_t *pool, size_t begin, size_t end,
+                              size_t grain, void *acc, size_t acc_size,
+                              mu_thunk_parallel_reduce_fn body,
+                              mu_thunk_parallel_combine_fn combine,
+                              void *ctx);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_PARALLEL_H_ */
@@ -0,0 +1,188 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_pool.h
+ *
+ * @brief Work-stealing thread pool that executes `(thunk, args)` pairs.
+ *
+ * Each worker owns a fixed-size Chase-Lev deque.  A thunk submitted from a
+ * worker thread is pushed onto that worker's deque (LIFO for the owner);
+ * idle workers steal from the opposite end of a randomly chosen victim.
+ * Submissions from threads outside the pool go through a small shared
+ * injection queue.  Workers that find no work park on a futex and are woken
+ * by the next submission.
+ *
+ * All storage is supplied by the caller: the pool struct and an array of
+ * `mu_thunk_pool_worker_t`, one per worker thread.
+ */
+
+#ifndef _MU_THUNK_POOL_H_
+#define _MU_THUNK_POOL_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_atomic.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Slots in each worker's deque.  Must be a power of two. */
+#ifndef MU_THUNK_POOL_DEQUE_CAPACITY
+#define MU_THUNK_POOL_DEQUE_CAPACITY 4096
+#endif
+
+/** Slots in the shared queue used by non-worker threads. */
+#ifndef MU_THUNK_POOL_INJECT_CAPACITY
+#define MU_THUNK_POOL_INJECT_CAPACITY 1024
+#endif
+
+/**
+ * @brief One deque slot.  Both fields are atomic so that a thief may read a
+ *        slot the owner is concurrently overwriting; such a read is always
+ *        discarded by the thief's failed CAS on `top`.
+ */
+typedef struct {
+    MU_THUNK_ATOMIC(mu_thunk_t *) thunk;
+    MU_THUNK_ATOMIC(void *) args;
+} mu_thunk_pool_slot_t;
+
+struct _mu_thunk_pool;
+
+/**
+ * @brief Per-worker state.  Treat as opaque.
+ */
+typedef struct {
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(int64_t) top; /**< Thieves */
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(int64_t) bottom; /**< Owner */
+    struct _mu_thunk_pool *pool;
+    uint64_t rng;
+    pthread_t thread;
+    mu_thunk_pool_slot_t slots[MU_THUNK_POOL_DEQUE_CAPACITY];
+} mu_thunk_pool_worker_t;
+
+/**
+ * @brief A thread pool.  Treat as opaque.
+ */
+typedef struct _mu_thunk_pool {
+    mu_thunk_pool_worker_t *workers;
+    size_t n_workers;
+    /** Injection queue for submissions from outside the pool. */
+    pthread_mutex_t inject_lock;
+    size_t inject_head;
+    size_t inject_tail;
+    MU_THUNK_ATOMIC(size_t) inject_count;
+    struct {
+        mu_thunk_t *thunk;
+        void *args;
+    } inject[MU_THUNK_POOL_INJECT_CAPACITY];
+    /** Parking: sleepers wait on `epoch`, submitters bump it to wake one. */
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(uint32_t) epoch;
+    MU_THUNK_ATOMIC(int) n_sleepers;
+    MU_THUNK_ATOMIC(bool) stopping;
+} mu_thunk_pool_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a pool and start its worker threads.
+ *
+ * @param pool      Pointer to the pool.
+ * @param workers   Array of `n_workers` worker structs.
+ * @param n_workers Number of worker threads to start (at least 1).
+ * @return `pool` on success, or NULL if an argument is invalid or a thread
+ *         could not be created (in which case any started threads are
+ *         stopped again).
+ */
+mu_thunk_pool_t *mu_thunk_pool_init(mu_thunk_pool_t *pool,
+                                    mu_thunk_pool_worker_t *workers,
+                                    size_t n_workers);
+
+/**
+ * @brief Stop and join all worker threads.
+ *
+ * Thunks still queued when the workers exit are not run.  Callers that need
+ * every submitted thunk to complete should wait on their own completion
+ * state first (see `mu_thunk_pool_help()`).
+ *
+ * @param pool Pointer to the pool.
+ */
+void mu_thunk_pool_stop(mu_thunk_pool_t *pool);
+
+/**
+ * @brief Schedule `_mu_thunk_call(thunk, args)` on the pool.
+ *
+ * From a worker thread of this pool the pair is pushed on that worker's own
+ * deque; if the deque is full the thunk is run immediately on the calling
+ * thread instead.  From any other thread the pair goes to the injection
+ * queue, and the call fails if that queue is full.
+ *
+ * @param pool  Pointer to the pool.
+ * @param thunk Thunk to run (it and `thunk->fn` must be non-NULL).
+ * @param args  Passed through to the thunk.
+ * @return true if the thunk was scheduled or run, false otherwise.
+ */
+bool mu_thunk_pool_submit(mu_thunk_pool_t *pool, mu_thunk_t *thunk,
+                          void *args);
+
+/**
+ * @brief Find and run one pending thunk on the calling thread.
+ *
+ * Intended for threads that wait on a result: loop on `help` until your
+ * completion condition holds rather than blocking.  A worker looks at its
+ * own deque first; every caller then tries the injection queue and steals
+ * from the workers.
+ *
+ * @param pool Pointer to the pool.
+ * @return true if a thunk was run, false if none could be found.
+ */
+bool mu_thunk_pool_help(mu_thunk_pool_t *pool);
+
+/**
+ * @brief Return the number of worker threads (0 if `pool` is NULL).
+ */
+size_t mu_thunk_pool_worker_count(const mu_thunk_pool_t *pool);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_POOL_H_ */
@@ -0,0 +1,178 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_prio.h
+ *
+ * @brief Fixed-level priority run queue of thunks (an RTOS-style ready
+ *        list).
+ *
+ * Each of MU_THUNK_PRIO_LEVELS levels is a FIFO, and a one-word bitmap
+ * records which levels are non-empty, so put, get and remove are O(1): the
+ * next thunk comes from the level found by a single count-trailing-zeros.
+ * Level 0 is the highest priority.
+ *
+ * Nodes are intrusive: embed `mu_thunk_prio_node_t` as the first member of
+ * your own struct.  The queue is not thread-safe; drive it from one thread
+ * (or feed it from a `mu_thunk_mpsc` drained on that thread).
+ */
+
+#ifndef _MU_THUNK_PRIO_H_
+#define _MU_THUNK_PRIO_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Number of priority levels, 1..64. */
+#ifndef MU_THUNK_PRIO_LEVELS
+#define MU_THUNK_PRIO_LEVELS 64
+#endif
+
+/** Doubly linked list link; each level uses one as a sentinel. */
+typedef struct _mu_thunk_prio_link {
+    struct _mu_thunk_prio_link *next;
+    struct _mu_thunk_prio_link *prev;
+} mu_thunk_prio_link_t;
+
+struct _mu_thunk_prio;
+
+/**
+ * @brief A thunk that can be queued by priority.
+ */
+typedef struct {
+    mu_thunk_t thunk;             /**< Must be first member */
+    mu_thunk_prio_link_t link;    /**< next == NULL when not queued */
+    struct _mu_thunk_prio *queue; /**< Queue it is on, NULL if none */
+    unsigned priority;            /**< Level it was last queued at */
+} mu_thunk_prio_node_t;
+
+/**
+ * @brief A priority run queue.  Treat as opaque.
+ */
+typedef struct _mu_thunk_prio {
+    uint64_t ready; /**< Bit n set iff level n is non-empty */
+    size_t count;
+    mu_thunk_prio_link_t levels[MU_THUNK_PRIO_LEVELS];
+} mu_thunk_prio_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an empty queue.
+ *
+ * @return `q`, or NULL if `q` is NULL.
+ */
+mu_thunk_prio_t *mu_thunk_prio_init(mu_thunk_prio_t *q);
+
+/**
+ * @brief Initialize a node's thunk and mark it not queued.
+ *
+ * @return `node`, or NULL if `node` or `fn` is NULL.
+ */
+mu_thunk_prio_node_t *mu_thunk_prio_node_init(mu_thunk_prio_node_t *node,
+                                              mu_thunk_fn fn);
+
+/**
+ * @brief Return true if the node is on a queue.
+ */
+bool mu_thunk_prio_node_is_queued(const mu_thunk_prio_node_t *node);
+
+/**
+ * @brief Append a node to the tail of level `priority`.
+ *
+ * @param q        Pointer to the queue.
+ * @param node     Node to queue; must not already be queued.
+ * @param priority Level, 0 (highest) .. MU_THUNK_PRIO_LEVELS - 1.
+ * @return true on success, false if an argument is invalid or the node is
+ *         already queued.
+ */
+bool mu_thunk_prio_put(mu_thunk_prio_t *q, mu_thunk_prio_node_t *node,
+                       unsigned priority);
+
+/**
+ * @brief Remove and return the oldest node of the highest non-empty level.
+ *
+ * @return The node, or NULL if the queue is empty.
+ */
+mu_thunk_prio_node_t *mu_thunk_prio_get(mu_thunk_prio_t *q);
+
+/**
+ * @brief Remove a queued node wherever it is.
+ *
+ * @return true if the node was queued on `q` and has been removed; false
+ *         if it is not queued or is queued on some other queue.
+ */
+bool mu_thunk_prio_remove(mu_thunk_prio_t *q, mu_thunk_prio_node_t *node);
+
+/**
+ * @brief Highest non-empty level, or -1 if the queue is empty.
+ */
+int mu_thunk_prio_highest(const mu_thunk_prio_t *q);
+
+/** Number of queued nodes. */
+size_t mu_thunk_prio_count(const mu_thunk_prio_t *q);
+
+/** Return true if no node is queued. */
+bool mu_thunk_prio_is_empty(const mu_thunk_prio_t *q);
+
+/**
+ * @brief Dequeue and invoke up to `max` nodes, highest priority first.
+ *
+ * Each node is dequeued before `_mu_thunk_call(&node->thunk, args)` runs
+ * and the bitmap is consulted afresh for every node, so a thunk that queues
+ * higher-priority work is pre-empted by it at the next dispatch.  At most
+ * as many nodes as were queued on entry are invoked, so a thunk that
+ * re-queues itself runs once per drain.
+ *
+ * @param q    Pointer to the queue.
+ * @param args Passed through to every thunk.
+ * @param max  Upper bound on the batch size (0: the nodes queued on entry).
+ * @return The number of thunks invoked.
+ */
+size_t mu_thunk_prio_drain(mu_thunk_prio_t *q, void *args, size_t max);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_PRIO_H_ */
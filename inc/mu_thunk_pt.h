@@ -0,0 +1,222 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_pt.h
+ *
+ * @brief Stackless resumable thunks (protothreads).
+ *
+ * A `mu_thunk_pt_t` adds a resume point to a thunk.  Its function brackets
+ * its body with MU_THUNK_PT_BEGIN / MU_THUNK_PT_END and may return early
+ * with MU_THUNK_PT_YIELD or MU_THUNK_PT_WAIT_UNTIL; the next call of the
+ * thunk jumps straight back to where it left off:
+ *
+ *     typedef struct {
+ *         mu_thunk_pt_t pt; // Must be first member
+ *         int i;
+ *     } blinker_t;
+ *
+ *     static void blink_fn(mu_thunk_t *thunk, void *args) {
+ *         blinker_t *b = (blinker_t *)thunk;
+ *         MU_THUNK_PT_BEGIN(&b->pt);
+ *         for (b->i = 0; b->i < 10; b->i++) {
+ *             led_toggle();
+ *             MU_THUNK_PT_YIELD(&b->pt);
+ *         }
+ *         MU_THUNK_PT_END(&b->pt);
+ *     }
+ *
+ * The whole state of a suspended protothread is one word in the user's
+ * struct; nothing is allocated and no stack is kept.  In exchange, local
+ * variables do not survive a yield (keep them in the struct), and only the
+ * function that contains BEGIN can yield.
+ *
+ * Two implementations are provided.  The MU_THUNK_PT_SWITCH_* macros are a
+ * Duff's-device `switch` on `__LINE__`, which is portable C but allows at
+ * most one yield per source line and no yield inside a `switch` of the
+ * body.  The MU_THUNK_PT_GOTO_* macros store a label address (GNU C
+ * "labels as values", with labels numbered by `__COUNTER__`) and have
+ * neither restriction.  MU_THUNK_PT_* use the
+ * computed-goto form where available, unless MU_THUNK_PT_USE_SWITCH is
+ * defined.  Use one form consistently within a function.
+ */
+
+#ifndef _MU_THUNK_PT_H_
+#define _MU_THUNK_PT_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief A resumable thunk.
+ */
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    uintptr_t resume; /**< 0: start; MU_THUNK_PT_DONE: finished */
+} mu_thunk_pt_t;
+
+/** `resume` value of a protothread that has run to its END. */
+#define MU_THUNK_PT_DONE UINTPTR_MAX
+
+#define _MU_THUNK_PT_CAT2(a, b) a##b
+#define _MU_THUNK_PT_CAT(a, b) _MU_THUNK_PT_CAT2(a, b)
+#define _MU_THUNK_PT_LABEL _MU_THUNK_PT_CAT(_mu_thunk_pt_resume_, __COUNTER__)
+
+#if defined(__has_attribute)
+#if __has_attribute(fallthrough)
+#define _MU_THUNK_PT_FALLTHROUGH __attribute__((fallthrough))
+#endif
+#endif
+#ifndef _MU_THUNK_PT_FALLTHROUGH
+#define _MU_THUNK_PT_FALLTHROUGH
+#endif
+
+/** Duff's device form. */
+#define MU_THUNK_PT_SWITCH_BEGIN(pt)                                           \
+    switch ((pt)->resume) {                                                    \
+    case MU_THUNK_PT_DONE:                                                     \
+        return;                                                                \
+    case 0:
+
+#define MU_THUNK_PT_SWITCH_YIELD(pt)                                           \
+    do {                                                                       \
+        (pt)->resume = __LINE__;                                               \
+        return;                                                                \
+    case __LINE__:;                                                            \
+    } while (0)
+
+#define MU_THUNK_PT_SWITCH_WAIT_UNTIL(pt, cond)                                \
+    do {                                                                       \
+        (pt)->resume = __LINE__;                                               \
+        _MU_THUNK_PT_FALLTHROUGH;                                              \
+    case __LINE__:                                                             \
+        if (!(cond)) {                                                         \
+            return;                                                            \
+        }                                                                      \
+    } while (0)
+
+#define MU_THUNK_PT_SWITCH_END(pt)                                             \
+    }                                                                          \
+    (pt)->resume = MU_THUNK_PT_DONE
+
+/** Computed-goto form (GNU C). */
+#define MU_THUNK_PT_GOTO_BEGIN(pt)                                             \
+    do {                                                                       \
+        if ((pt)->resume == MU_THUNK_PT_DONE) {                                \
+            return;                                                            \
+        }                                                                      \
+        if ((pt)->resume != 0) {                                               \
+            goto *(void *)(pt)->resume;                                        \
+        }                                                                      \
+    } while (0)
+
+#define MU_THUNK_PT_GOTO_YIELD(pt)                                             \
+    _MU_THUNK_PT_GOTO_YIELD(pt, _MU_THUNK_PT_LABEL)
+
+#define MU_THUNK_PT_GOTO_WAIT_UNTIL(pt, cond)                                  \
+    _MU_THUNK_PT_GOTO_WAIT_UNTIL(pt, cond, _MU_THUNK_PT_LABEL)
+
+// `label` is expanded once, so both of its uses name the same label.
+#define _MU_THUNK_PT_GOTO_YIELD(pt, label)                                     \
+    do {                                                                       \
+        (pt)->resume = (uintptr_t)&&label;                                     \
+        return;                                                                \
+    label:;                                                                    \
+    } while (0)
+
+#define _MU_THUNK_PT_GOTO_WAIT_UNTIL(pt, cond, label)                          \
+    do {                                                                       \
+        (pt)->resume = (uintptr_t)&&label;                                     \
+    label:                                                                     \
+        if (!(cond)) {                                                         \
+            return;                                                            \
+        }                                                                      \
+    } while (0)
+
+#define MU_THUNK_PT_GOTO_END(pt) (pt)->resume = MU_THUNK_PT_DONE
+
+#if defined(__GNUC__) && !defined(MU_THUNK_PT_USE_SWITCH)
+#define MU_THUNK_PT_BEGIN(pt) MU_THUNK_PT_GOTO_BEGIN(pt)
+#define MU_THUNK_PT_YIELD(pt) MU_THUNK_PT_GOTO_YIELD(pt)
+#define MU_THUNK_PT_WAIT_UNTIL(pt, cond) MU_THUNK_PT_GOTO_WAIT_UNTIL(pt, cond)
+#define MU_THUNK_PT_END(pt) MU_THUNK_PT_GOTO_END(pt)
+#else
+#define MU_THUNK_PT_BEGIN(pt) MU_THUNK_PT_SWITCH_BEGIN(pt)
+#define MU_THUNK_PT_YIELD(pt) MU_THUNK_PT_SWITCH_YIELD(pt)
+#define MU_THUNK_PT_WAIT_UNTIL(pt, cond) MU_THUNK_PT_SWITCH_WAIT_UNTIL(pt, cond)
+#define MU_THUNK_PT_END(pt) MU_THUNK_PT_SWITCH_END(pt)
+#endif
+
+/**
+ * @brief Finish the protothread now, from anywhere between BEGIN and END.
+ */
+#define MU_THUNK_PT_EXIT(pt)                                                   \
+    do {                                                                       \
+        (pt)->resume = MU_THUNK_PT_DONE;                                       \
+        return;                                                                \
+    } while (0)
+
+/**
+ * @brief Initialize (or restart) a protothread to run `fn` from the top.
+ */
+static inline mu_thunk_pt_t *mu_thunk_pt_init(mu_thunk_pt_t *pt,
+                                              mu_thunk_fn fn) {
+    if (pt == NULL || fn == NULL) {
+        return NULL;
+    }
+    _mu_thunk_init(&pt->thunk, fn);
+    pt->resume = 0;
+    return pt;
+}
+
+/**
+ * @brief Return true once the protothread has reached its END or EXIT.
+ */
+static inline bool mu_thunk_pt_is_done(const mu_thunk_pt_t *pt) {
+    return pt == NULL || pt->resume == MU_THUNK_PT_DONE;
+}
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_PT_H_ */
@@ -0,0 +1,174 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_reactor.h
+ *
+ * @brief epoll-based reactor that dispatches fd readiness as thunk calls.
+ *
+ * Each registered fd carries a `mu_thunk_t *`.  When the fd becomes ready
+ * the reactor calls `_mu_thunk_call(thunk, &event)`, where `event` is the
+ * `struct epoll_event` reported by the kernel.  Up to
+ * `MU_THUNK_REACTOR_MAX_EVENTS` events are collected per wakeup.
+ *
+ * Other threads hand work to the loop with `mu_thunk_reactor_post()`, which
+ * queues an `mu_thunk_mpsc_node_t` and wakes a sleeping loop with a single
+ * eventfd write; further posts before the loop runs again do no syscall.
+ *
+ * Linux only.  All functions except `mu_thunk_reactor_post()` and
+ * `mu_thunk_reactor_stop()` must be called from the loop thread.
+ */
+
+#ifndef _MU_THUNK_REACTOR_H_
+#define _MU_THUNK_REACTOR_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_atomic.h"
+#include "mu_thunk_mpsc.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Maximum readiness events dispatched per wakeup. */
+#ifndef MU_THUNK_REACTOR_MAX_EVENTS
+#define MU_THUNK_REACTOR_MAX_EVENTS 64
+#endif
+
+/**
+ * @brief A reactor.  Treat as opaque.
+ */
+typedef struct {
+    int epoll_fd;
+    int wake_fd;            /**< eventfd for cross-thread wakeups */
+    mu_thunk_mpsc_t posted; /**< Thunks posted from other threads */
+    MU_THUNK_ATOMIC(bool) wake_pending;
+    MU_THUNK_ATOMIC(bool) stopping;
+    struct epoll_event events[MU_THUNK_REACTOR_MAX_EVENTS];
+} mu_thunk_reactor_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a reactor, creating its epoll instance and eventfd.
+ *
+ * @param reactor Pointer to the reactor.
+ * @return `reactor` on success, or NULL if `reactor` is NULL or a system
+ *         call failed (errno is left set).
+ */
+mu_thunk_reactor_t *mu_thunk_reactor_init(mu_thunk_reactor_t *reactor);
+
+/**
+ * @brief Close the reactor's file descriptors.  Registered fds are not
+ *        closed.
+ */
+void mu_thunk_reactor_deinit(mu_thunk_reactor_t *reactor);
+
+/**
+ * @brief Register `fd` for `events` (EPOLLIN, EPOLLOUT, EPOLLET, ...).
+ *
+ * @param reactor Pointer to the reactor.
+ * @param fd      File descriptor to watch.
+ * @param events  epoll event mask.
+ * @param thunk   Called as `_mu_thunk_call(thunk, struct epoll_event *)`
+ *                each time `fd` is reported ready.
+ * @return true on success, false on error (errno is left set).
+ */
+bool mu_thunk_reactor_add(mu_thunk_reactor_t *reactor, int fd,
+                          uint32_t events, mu_thunk_t *thunk);
+
+/**
+ * @brief Change the event mask and/or thunk for a registered fd.
+ *
+ * @return true on success, false on error (errno is left set).
+ */
+bool mu_thunk_reactor_modify(mu_thunk_reactor_t *reactor, int fd,
+                             uint32_t events, mu_thunk_t *thunk);
+
+/**
+ * @brief Stop watching `fd`.
+ *
+ * Events for `fd` already collected in the current batch may still be
+ * dispatched if this is called from a thunk of that batch.
+ *
+ * @return true on success, false on error (errno is left set).
+ */
+bool mu_thunk_reactor_remove(mu_thunk_reactor_t *reactor, int fd);
+
+/**
+ * @brief Queue a thunk to run on the loop thread.  Safe from any thread.
+ *
+ * The node's thunk is called with the reactor as `args`.
+ *
+ * @param reactor Pointer to the reactor.
+ * @param node    Node to post; must not currently be queued anywhere.
+ * @return true on success, false if an argument is NULL.
+ */
+bool mu_thunk_reactor_post(mu_thunk_reactor_t *reactor,
+                           mu_thunk_mpsc_node_t *node);
+
+/**
+ * @brief Wait up to `timeout_ms` (-1 = forever) for events, then dispatch
+ *        them and any posted thunks.
+ *
+ * @param reactor    Pointer to the reactor.
+ * @param timeout_ms Maximum time to block.
+ * @return The number of thunks dispatched, or -1 on error (errno is set;
+ *         EINTR is reported as 0 dispatched).
+ */
+int mu_thunk_reactor_run_once(mu_thunk_reactor_t *reactor, int timeout_ms);
+
+/**
+ * @brief Dispatch events until `mu_thunk_reactor_stop()` is called.
+ *
+ * @return 0 after a stop, or -1 on error (errno is set).
+ */
+int mu_thunk_reactor_run(mu_thunk_reactor_t *reactor);
+
+/**
+ * @brief Ask `mu_thunk_reactor_run()` to return.  Safe from any thread.
+ */
+void mu_thunk_reactor_stop(mu_thunk_reactor_t *reactor);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_REACTOR_H_ */
@@ -0,0 +1,172 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_ring.h
+ *
+ * @brief Bounded, lock-free single-producer / single-consumer run queue of
+ *        `mu_thunk_t` pointers.
+ *
+ * Exactly one thread may call `mu_thunk_ring_put()` and exactly one thread
+ * may call `mu_thunk_ring_get()` / `mu_thunk_ring_drain()`.  The backing store
+ * is supplied by the caller and its capacity must be a power of two.
+ */
+
+#ifndef _MU_THUNK_RING_H_
+#define _MU_THUNK_RING_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_atomic.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief SPSC ring of thunk pointers.
+ *
+ * `head` and `tail` are free-running counters; the slot index is the counter
+ * masked by `capacity - 1`.  Each side keeps a private cached copy of the
+ * other side's counter on its own cache line, so the shared counters are
+ * only re-read when the ring appears full (producer) or empty (consumer).
+ */
+typedef struct {
+    /** Consumer side: next slot to read, and cached copy of `tail`. */
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(size_t) head;
+    size_t tail_cache;
+    /** Producer side: next slot to write, and cached copy of `head`. */
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(size_t) tail;
+    size_t head_cache;
+    /** Read-only after init. */
+    MU_THUNK_CACHE_ALIGNED mu_thunk_t **store;
+    size_t mask;
+} mu_thunk_ring_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a ring over a caller-supplied array of thunk pointers.
+ *
+ * @param ring     Pointer to the ring to initialize.
+ * @param store    Array of `capacity` thunk pointers.
+ * @param capacity Number of slots; must be a non-zero power of two.
+ * @return `ring` on success, or NULL if any argument is invalid.
+ */
+mu_thunk_ring_t *mu_thunk_ring_init(mu_thunk_ring_t *ring, mu_thunk_t **store,
+                                    size_t capacity);
+
+/**
+ * @brief Discard all entries.  Not safe while either side is active.
+ *
+ * @param ring Pointer to the ring.
+ * @return `ring`, or NULL if `ring` is NULL.
+ */
+mu_thunk_ring_t *mu_thunk_ring_reset(mu_thunk_ring_t *ring);
+
+/**
+ * @brief Return the number of slots in the ring (0 if `ring` is NULL).
+ */
+size_t mu_thunk_ring_capacity(const mu_thunk_ring_t *ring);
+
+/**
+ * @brief Return the number of queued entries.
+ *
+ * Exact when called from either the producer or consumer thread with the
+ * other side idle; otherwise a snapshot that may already be stale.
+ */
+size_t mu_thunk_ring_count(mu_thunk_ring_t *ring);
+
+/**
+ * @brief Return true if the ring holds no entries (see caveat on count).
+ */
+bool mu_thunk_ring_is_empty(mu_thunk_ring_t *ring);
+
+/**
+ * @brief Append a thunk to the ring.  Producer thread only.
+ *
+ * @param ring  Pointer to the ring.
+ * @param thunk Thunk to enqueue (must be non-NULL).
+ * @return true on success, false if the ring is full or an argument is NULL.
+ */
+bool mu_thunk_ring_put(mu_thunk_ring_t *ring, mu_thunk_t *thunk);
+
+/**
+ * @brief Remove the oldest thunk from the ring.  Consumer thread only.
+ *
+ * @param ring Pointer to the ring.
+ * @return The dequeued thunk, or NULL if the ring is empty or `ring` is NULL.
+ */
+mu_thunk_t *mu_thunk_ring_get(mu_thunk_ring_t *ring);
+
+/**
+ * @brief Remove up to `max` of the oldest thunks at once.  Consumer thread
+ *        only.
+ *
+ * Cheaper than repeated `mu_thunk_ring_get()`: the slots are released to
+ * the producer with a single store after they have all been copied.
+ *
+ * @param ring Pointer to the ring.
+ * @param out  Receives the dequeued thunks, oldest first.
+ * @param max  Capacity of `out`.
+ * @return The number of thunks dequeued, or 0 if an argument is NULL.
+ */
+size_t mu_thunk_ring_get_batch(mu_thunk_ring_t *ring, mu_thunk_t **out,
+                               size_t max);
+
+/**
+ * @brief Invoke every entry present on entry.  Consumer thread only.
+ *
+ * Each entry is removed from the ring before it is invoked via
+ * `_mu_thunk_call(thunk, args)`, so its slot is already available to the
+ * producer while the thunk runs.  Entries added during the drain are left
+ * for the next call, which bounds the time spent in a single drain.  A
+ * thunk may itself get or drain entries from the same ring; those are not
+ * invoked again by the outer drain.
+ *
+ * @param ring Pointer to the ring.
+ * @param args Passed through to every thunk.
+ * @return The number of thunks invoked.
+ */
+size_t mu_thunk_ring_drain(mu_thunk_ring_t *ring, void *args);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_RING_H_ */
@@ -0,0 +1,171 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_sbo.h
+ *
+ * @brief Thunks with their arguments stored inline (small-buffer
+ *        optimization), and an SPSC run queue whose slots hold them.
+ *
+ * `mu_thunk_call(thunk, args)` leaves the lifetime of `args` to the caller,
+ * which for a posted call usually means a heap allocation freed by the
+ * callee.  A `mu_thunk_sbo_t` carries up to MU_THUNK_SBO_SIZE bytes of
+ * arguments next to the function pointer, and `mu_thunk_sbo_ring_put()`
+ * copies the function and the bytes straight into a queue slot, so a post
+ * allocates nothing.  The thunk runs as `fn(thunk, payload)`: `args` points
+ * at the inline copy, so ordinary `mu_thunk_fn` functions work unchanged.
+ *
+ * A payload lives in its slot and is only valid until the thunk returns;
+ * copy out anything that must outlive the call.
+ *
+ * Exactly one thread may put and one thread may get or drain a ring.
+ */
+
+#ifndef _MU_THUNK_SBO_H_
+#define _MU_THUNK_SBO_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_atomic.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * Inline payload capacity in bytes: 16, 32 or 48 (a multiple of 16).  The
+ * default makes a `mu_thunk_sbo_t` exactly one 64-byte cache line.
+ */
+#ifndef MU_THUNK_SBO_SIZE
+#define MU_THUNK_SBO_SIZE 48
+#endif
+
+/**
+ * @brief A thunk and an inline copy of its arguments.
+ */
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    uint32_t size;    /**< Bytes of `payload` in use */
+    alignas(16) unsigned char payload[MU_THUNK_SBO_SIZE];
+} mu_thunk_sbo_t;
+
+/**
+ * @brief SPSC ring of `mu_thunk_sbo_t` slots.  Laid out like
+ *        `mu_thunk_ring_t`: free-running counters, each side caching the
+ *        other's on its own cache line.
+ */
+typedef struct {
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(size_t) head;
+    size_t tail_cache;
+    size_t next;  /**< Next slot to invoke; ahead of `head` while running */
+    size_t depth; /**< Drains in progress on the consumer thread */
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(size_t) tail;
+    size_t head_cache;
+    MU_THUNK_CACHE_ALIGNED mu_thunk_sbo_t *store;
+    size_t mask;
+} mu_thunk_sbo_ring_t;
+
+/**
+ * @brief The inline payload of a thunk that is a `mu_thunk_sbo_t`.
+ */
+static inline void *mu_thunk_sbo_payload(mu_thunk_t *thunk) {
+    return ((mu_thunk_sbo_t *)thunk)->payload;
+}
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a standalone SBO thunk, copying `size` bytes of
+ *        `payload` into it.
+ *
+ * @return `sbo`, or NULL if `sbo` or `fn` is NULL, `size` exceeds
+ *         MU_THUNK_SBO_SIZE, or `payload` is NULL with a non-zero `size`.
+ */
+mu_thunk_sbo_t *mu_thunk_sbo_init(mu_thunk_sbo_t *sbo, mu_thunk_fn fn,
+                                  const void *payload, size_t size);
+
+/**
+ * @brief Invoke an SBO thunk as `fn(&sbo->thunk, sbo->payload)`.  A no-op if
+ *        `sbo` or its `fn` is NULL.
+ */
+void mu_thunk_sbo_call(mu_thunk_sbo_t *sbo);
+
+/**
+ * @brief Initialize a ring over a caller-supplied array of slots.
+ *
+ * @param ring     Pointer to the ring.
+ * @param store    Array of `capacity` slots.
+ * @param capacity Number of slots; must be a non-zero power of two.
+ * @return `ring`, or NULL if an argument is invalid.
+ */
+mu_thunk_sbo_ring_t *mu_thunk_sbo_ring_init(mu_thunk_sbo_ring_t *ring,
+                                            mu_thunk_sbo_t *store,
+                                            size_t capacity);
+
+/** Number of queued thunks.  Exact only when both sides are quiescent. */
+size_t mu_thunk_sbo_ring_count(mu_thunk_sbo_ring_t *ring);
+
+/**
+ * @brief Copy a function and its arguments into the next free slot.
+ *        Producer thread only.
+ *
+ * @return true on success, false if the ring is full or an argument is
+ *         invalid (as for `mu_thunk_sbo_init()`).
+ */
+bool mu_thunk_sbo_ring_put(mu_thunk_sbo_ring_t *ring, mu_thunk_fn fn,
+                           const void *payload, size_t size);
+
+/**
+ * @brief Invoke every thunk present on entry, oldest first.  Consumer
+ *        thread only.
+ *
+ * Each runs as `fn(thunk, payload)` in place in its slot, and the slot is
+ * released to the producer when the thunk returns.  A thunk may itself
+ * drain the same ring: the nested drain skips the running thunks, and
+ * slots are released once the outermost drain's thunk returns.
+ *
+ * @return The number of thunks invoked.
+ */
+size_t mu_thunk_sbo_ring_drain(mu_thunk_sbo_ring_t *ring);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_SBO_H_ */
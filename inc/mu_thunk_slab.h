@@ -0,0 +1,173 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_slab.h
+ *
+ * @brief Slab allocator for fixed-size, thunk-bearing objects.
+ *
+ * The usual pattern is a request struct with a `mu_thunk_t` as its first
+ * member that is allocated when work is created and freed when its thunk
+ * has run, often on another thread.  A slab hands out objects of one size,
+ * each starting on a cache line (so no two objects share a line), from
+ * 64 KiB chunks carved by per-thread caches:
+ *
+ * - Every thread that allocates or frees owns a `mu_thunk_slab_cache_t`.
+ *   Allocation and same-thread free are a pointer pop/push on the cache's
+ *   private free list, with no atomics.
+ * - An object freed by a thread other than the one that allocated it is
+ *   collected into a batch of up to MU_THUNK_SLAB_BATCH objects bound for
+ *   the same owner.  A full batch (or `mu_thunk_slab_cache_flush()`) is
+ *   handed back with one CAS; the owner takes all returned objects with one
+ *   exchange when its own list runs dry.
+ *
+ * A cache must stay valid until every object it allocated has been freed
+ * or the slab is deinitialized; chunks are only released by
+ * `mu_thunk_slab_deinit()`.
+ */
+
+#ifndef _MU_THUNK_SLAB_H_
+#define _MU_THUNK_SLAB_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_atomic.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Bytes per chunk; must be a power of two.  Chunks are aligned to it. */
+#ifndef MU_THUNK_SLAB_CHUNK_SIZE
+#define MU_THUNK_SLAB_CHUNK_SIZE (64 * 1024)
+#endif
+
+/** Remote frees gathered before they are handed back to their owner. */
+#ifndef MU_THUNK_SLAB_BATCH
+#define MU_THUNK_SLAB_BATCH 32
+#endif
+
+/** Free object: the link is stored in the object's first word. */
+typedef struct _mu_thunk_slab_free {
+    struct _mu_thunk_slab_free *next;
+} mu_thunk_slab_free_t;
+
+/**
+ * @brief Allocator shared by all threads for one object size.
+ */
+typedef struct {
+    size_t object_size; /**< Rounded up to a multiple of the cache line */
+    MU_THUNK_ATOMIC(void *) chunks; /**< Every chunk, for deinit */
+} mu_thunk_slab_t;
+
+/**
+ * @brief One thread's view of a slab.  Treat as opaque.
+ */
+typedef struct _mu_thunk_slab_cache {
+    /** Objects this cache owns, returned by other threads */
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(mu_thunk_slab_free_t *) remote;
+    /* Fields below are only touched by the owning thread. */
+    MU_THUNK_CACHE_ALIGNED mu_thunk_slab_t *slab;
+    mu_thunk_slab_free_t *free_list;
+    char *bump;     /**< Next never-used object in the current chunk */
+    char *bump_end; /**< End of the current chunk */
+    struct _mu_thunk_slab_cache *batch_owner;
+    mu_thunk_slab_free_t *batch_head;
+    mu_thunk_slab_free_t *batch_tail;
+    size_t batch_count;
+} mu_thunk_slab_cache_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a slab for objects of `object_size` bytes.
+ *
+ * @param slab        Pointer to the slab.
+ * @param object_size Object size; rounded up to a whole number of cache
+ *                    lines.  Must leave room for at least one object in a
+ *                    chunk after its one-line header.
+ * @return `slab`, or NULL if an argument is invalid.
+ */
+mu_thunk_slab_t *mu_thunk_slab_init(mu_thunk_slab_t *slab,
+                                    size_t object_size);
+
+/**
+ * @brief Release every chunk.  All caches must be finished with the slab.
+ */
+void mu_thunk_slab_deinit(mu_thunk_slab_t *slab);
+
+/**
+ * @brief Return the (rounded) object size.
+ */
+size_t mu_thunk_slab_object_size(const mu_thunk_slab_t *slab);
+
+/**
+ * @brief Attach a calling thread's cache to `slab`.
+ *
+ * @return `cache`, or NULL if an argument is NULL.
+ */
+mu_thunk_slab_cache_t *mu_thunk_slab_cache_init(mu_thunk_slab_cache_t *cache,
+                                                mu_thunk_slab_t *slab);
+
+/**
+ * @brief Allocate one object.  Owning thread only.
+ *
+ * @return A cache-line aligned, uninitialized object, or NULL if a new
+ *         chunk could not be allocated.
+ */
+void *mu_thunk_slab_alloc(mu_thunk_slab_cache_t *cache);
+
+/**
+ * @brief Free an object allocated from any cache of the same slab.
+ *
+ * Call with the calling thread's own cache.  If `obj` belongs to another
+ * thread's cache it joins this cache's outgoing batch.  NULL is ignored.
+ */
+void mu_thunk_slab_free(mu_thunk_slab_cache_t *cache, void *obj);
+
+/**
+ * @brief Hand any partially filled remote-free batch back to its owner.
+ *
+ * Call before a thread goes idle or exits so remote frees don't linger.
+ */
+void mu_thunk_slab_cache_flush(mu_thunk_slab_cache_t *cache);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_SLAB_H_ */
@@ -0,0 +1,173 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_stats.h
+ *
+ * @brief Per-function call counts and latency histograms for thunk
+ *        dispatch.
+ *
+ * Build with `-DMU_THUNK_STATS` and `_mu_thunk_call()` (and therefore
+ * `mu_thunk_call()` and every run queue in this library) dispatches through
+ * `mu_thunk_stats_call()`, which times the call and records it against the
+ * thunk's `fn`.  Without the flag `_mu_thunk_call()` is the bare indirect
+ * call and this module costs nothing.  `mu_thunk_stats_call()` may also be
+ * called directly to instrument selected call sites only.
+ *
+ * Each thread records into its own fixed-size table, so recording uses no
+ * atomic read-modify-writes and no locks; `mu_thunk_stats_snapshot()`
+ * merges all tables (including those of threads that have exited) from
+ * any thread.  A table outlives its thread with its counts intact and is
+ * handed to the next thread that starts recording, so memory is bounded
+ * by the peak number of concurrently recording threads.
+ *
+ * Latencies are wall-clock nanoseconds (timed with the TSC on x86-64,
+ * calibrated once against CLOCK_MONOTONIC), inclusive of any thunks the
+ * call itself dispatches, bucketed log-linearly (HDR style):
+ * 2^MU_THUNK_STATS_SUB_BITS linear sub-buckets per power of two, so a
+ * bucket's width is at most 1/2^SUB_BITS of its value.
+ */
+
+#ifndef _MU_THUNK_STATS_H_
+#define _MU_THUNK_STATS_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_compact.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Distinct functions tracked per thread; calls to others are dropped. */
+#ifndef MU_THUNK_STATS_MAX_FNS
+#define MU_THUNK_STATS_MAX_FNS 64
+#endif
+
+/** log2 of the number of linear sub-buckets per power of two. */
+#ifndef MU_THUNK_STATS_SUB_BITS
+#define MU_THUNK_STATS_SUB_BITS 3
+#endif
+
+/** Latencies at or above 2^RANGE_BITS ns (~69 s) land in the top bucket. */
+#ifndef MU_THUNK_STATS_RANGE_BITS
+#define MU_THUNK_STATS_RANGE_BITS 36
+#endif
+
+/** Number of histogram buckets. */
+#define MU_THUNK_STATS_BUCKETS                                                 \
+    ((MU_THUNK_STATS_RANGE_BITS - MU_THUNK_STATS_SUB_BITS + 1)                 \
+     << MU_THUNK_STATS_SUB_BITS)
+
+/**
+ * @brief Statistics for one thunk function.
+ */
+typedef struct {
+    mu_thunk_fn fn;
+    uint64_t count;    /**< Calls recorded */
+    uint64_t total_ns; /**< Sum of latencies */
+    uint64_t max_ns;   /**< Largest latency */
+    uint64_t buckets[MU_THUNK_STATS_BUCKETS];
+} mu_thunk_stats_entry_t;
+
+/**
+ * @brief A point-in-time copy of the statistics.  Large (about 140 KiB at
+ *        the default sizes): allocate statically or on the heap.
+ */
+typedef struct {
+    size_t n_entries;
+    uint64_t dropped; /**< Calls not recorded because a table was full */
+    mu_thunk_stats_entry_t entries[MU_THUNK_STATS_MAX_FNS];
+} mu_thunk_stats_snapshot_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Call `thunk` and record its latency against `thunk->fn` in the
+ *        calling thread's table.  Does no parameter checking.
+ */
+void mu_thunk_stats_call(mu_thunk_t *thunk, void *args);
+
+/**
+ * @brief As `mu_thunk_stats_call()` for a compact thunk: call `fn` (its
+ *        registered function) and record against `(mu_thunk_fn)fn`.
+ */
+void mu_thunk_stats_compact_call(mu_thunk_compact_fn fn,
+                                 mu_thunk_compact_t *thunk, void *args);
+
+/**
+ * @brief Merge every thread's table into `snap` (which is overwritten).
+ *
+ * Safe to call while other threads are recording; counts from calls in
+ * progress may or may not be included, and an entry's fields may be off
+ * by the few calls recorded while it was being copied.
+ */
+void mu_thunk_stats_snapshot(mu_thunk_stats_snapshot_t *snap);
+
+/**
+ * @brief Add the entries of `src` into `dst`.  Functions present only in
+ *        `src` are appended while `dst` has room, otherwise counted in
+ *        `dst->dropped`.
+ */
+void mu_thunk_stats_merge(mu_thunk_stats_snapshot_t *dst,
+                          const mu_thunk_stats_snapshot_t *src);
+
+/**
+ * @brief Find the entry for `fn`, or NULL if it has no calls recorded.
+ */
+const mu_thunk_stats_entry_t *
+mu_thunk_stats_find(const mu_thunk_stats_snapshot_t *snap, mu_thunk_fn fn);
+
+/**
+ * @brief Latency at percentile `p` (0..100) of an entry: the upper bound of
+ *        the bucket holding that rank, capped at `max_ns`.  0 if empty.
+ */
+uint64_t mu_thunk_stats_percentile(const mu_thunk_stats_entry_t *entry,
+                                   double p);
+
+/** Histogram bucket holding a latency of `ns`. */
+size_t mu_thunk_stats_bucket(uint64_t ns);
+
+/** Smallest latency that falls in bucket `index`. */
+uint64_t mu_thunk_stats_bucket_floor(size_t index);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_STATS_H_ */
@@ -0,0 +1,169 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_task.h
+ *
+ * @brief Stackful coroutines: thunks that can suspend mid-function.
+ *
+ * A `mu_thunk_task_t` runs its body on a stack of its own.  Calling the
+ * task's thunk -- `_mu_thunk_call(&task->thunk, args)`, or handing the
+ * thunk to any queue or reactor that calls it -- switches to that stack
+ * and runs the body until it calls `mu_thunk_task_yield()` or returns; the
+ * call then returns to the resumer.  The next call of the thunk continues
+ * after the yield, which returns that call's `args`.
+ *
+ * The switch is a few instructions of hand-written assembly that save and
+ * restore only the callee-saved registers (x86-64 SysV and AArch64 AAPCS);
+ * unlike `swapcontext()` it makes no system call and leaves the signal
+ * mask alone.  The floating-point control registers are not switched, so a
+ * task must leave the rounding mode as it found it before yielding.
+ *
+ * Stacks are caller-supplied.  `mu_thunk_task_stack_alloc()` maps one with
+ * an inaccessible guard page below it, so an overflow faults instead of
+ * silently corrupting memory.  Each guarded stack costs two kernel memory
+ * mappings; for very large numbers of tasks carve unguarded stacks out of
+ * one allocation instead.
+ *
+ * A suspended task may be resumed from any thread, but by one thread at a
+ * time.  Linux on x86-64 or AArch64 only.
+ */
+
+#ifndef _MU_THUNK_TASK_H_
+#define _MU_THUNK_TASK_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Smallest stack `mu_thunk_task_init()` accepts, in bytes. */
+#ifndef MU_THUNK_TASK_MIN_STACK
+#define MU_THUNK_TASK_MIN_STACK 1024
+#endif
+
+/** Lifecycle of a task. */
+typedef enum {
+    MU_THUNK_TASK_READY,     /**< Initialized, not yet resumed */
+    MU_THUNK_TASK_RUNNING,   /**< Executing on its own stack */
+    MU_THUNK_TASK_SUSPENDED, /**< Stopped in `mu_thunk_task_yield()` */
+    MU_THUNK_TASK_DONE,      /**< Body has returned */
+} mu_thunk_task_state_t;
+
+/**
+ * @brief A stackful coroutine.  Only `thunk` is meant to be touched by user
+ *        code; embed the task at offset 0 of your own struct to reach it
+ *        from the body.
+ */
+typedef struct _mu_thunk_task {
+    mu_thunk_t thunk;            /**< Must be first member: resumes the task */
+    mu_thunk_fn body;            /**< Run as `body(&task->thunk, args)` */
+    void *sp;                    /**< Task stack pointer while not running */
+    void *resumer_sp;            /**< Resumer stack pointer while running */
+    void *transfer;              /**< `args` of the latest resume */
+    struct _mu_thunk_task *prev; /**< Task current when this one resumed */
+    mu_thunk_task_state_t state;
+} mu_thunk_task_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Map a stack of at least `size` bytes with a guard page below it.
+ *
+ * @return The lowest usable address, or NULL if `size` is 0 or the mapping
+ *         failed.  Release with `mu_thunk_task_stack_free()`.
+ */
+void *mu_thunk_task_stack_alloc(size_t size);
+
+/**
+ * @brief Unmap a stack returned by `mu_thunk_task_stack_alloc(size)`.
+ */
+void mu_thunk_task_stack_free(void *stack, size_t size);
+
+/**
+ * @brief Initialize a task to run `body` on the given stack.
+ *
+ * The first resume calls `body(&task->thunk, args)`.  The task must not be
+ * running; a suspended task that is re-initialized is abandoned, and any
+ * cleanup its body would have done after the yield never happens.
+ *
+ * @param task       Pointer to the task.
+ * @param body       The task body.
+ * @param stack      Lowest address of the stack.
+ * @param stack_size Stack size in bytes, at least MU_THUNK_TASK_MIN_STACK.
+ * @return `task`, or NULL if an argument is invalid.
+ */
+mu_thunk_task_t *mu_thunk_task_init(mu_thunk_task_t *task, mu_thunk_fn body,
+                                    void *stack, size_t stack_size);
+
+/**
+ * @brief Run `task` until it yields or finishes.  Same as calling its
+ *        thunk; a no-op if `task` is NULL, running or done.
+ */
+void mu_thunk_task_resume(mu_thunk_task_t *task, void *args);
+
+/**
+ * @brief Suspend the current task and return to its resumer.
+ *
+ * @return The `args` of the call that resumes the task, or NULL at once if
+ *         the caller is not running in a task.
+ */
+void *mu_thunk_task_yield(void);
+
+/**
+ * @brief Return the task running on this thread, or NULL.
+ */
+mu_thunk_task_t *mu_thunk_task_current(void);
+
+/**
+ * @brief Return the state of `task` (MU_THUNK_TASK_DONE if NULL).
+ */
+mu_thunk_task_state_t mu_thunk_task_state(const mu_thunk_task_t *task);
+
+/**
+ * @brief Return true if the body of `task` has returned (or `task` is NULL).
+ */
+bool mu_thunk_task_is_done(const mu_thunk_task_t *task);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_TASK_H_ */
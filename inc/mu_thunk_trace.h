@@ -0,0 +1,131 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_trace.h
+ *
+ * @brief Thunk execution timelines in Chrome trace-event JSON.
+ *
+ * Build with `-DMU_THUNK_TRACE` and `_mu_thunk_call()` (so `mu_thunk_call()`
+ * and every run queue in this library) dispatches through
+ * `mu_thunk_trace_call()`, which records one complete ("X") event per
+ * sampled call: function, thread, start and duration.  Events go into a
+ * per-thread ring of MU_THUNK_TRACE_RING_SIZE entries with a single writer
+ * and no locks; if a ring wraps before it is flushed the oldest events are
+ * overwritten.  A ring outlives its thread until its events are flushed,
+ * then is reused by the next thread that starts tracing, so memory is
+ * bounded by the peak number of tracing threads (given regular flushes).
+ *
+ * `mu_thunk_trace_flush()` drains every ring (from any thread) into a JSON
+ * document that chrome://tracing and ui.perfetto.dev load directly.  Event
+ * names come from `dladdr()`: link with `-rdynamic` to see the names of
+ * non-static functions; others appear as `module+0xoffset`, which
+ * `addr2line -f -e module 0xoffset` resolves.
+ *
+ * With sampling set to N only every Nth call on each thread is timed, so
+ * the layer can stay compiled in; an unsampled call costs a countdown.
+ * May be combined with MU_THUNK_STATS, in which case every call is still
+ * counted and the traced call is the instrumented one.
+ */
+
+#ifndef _MU_THUNK_TRACE_H_
+#define _MU_THUNK_TRACE_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_compact.h"
+#include <stddef.h>
+#include <stdio.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Events buffered per thread; must be a power of two. */
+#ifndef MU_THUNK_TRACE_RING_SIZE
+#define MU_THUNK_TRACE_RING_SIZE 4096
+#endif
+
+/** Initial sampling interval: 1 traces every call. */
+#ifndef MU_THUNK_TRACE_DEFAULT_SAMPLING
+#define MU_THUNK_TRACE_DEFAULT_SAMPLING 1
+#endif
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Call `thunk`, recording it if this call is sampled.  Does no
+ *        parameter checking.
+ */
+void mu_thunk_trace_call(mu_thunk_t *thunk, void *args);
+
+/**
+ * @brief As `mu_thunk_trace_call()` for a compact thunk: call `fn` (its
+ *        registered function), naming the event after `fn`.
+ */
+void mu_thunk_trace_compact_call(mu_thunk_compact_fn fn,
+                                 mu_thunk_compact_t *thunk, void *args);
+
+/**
+ * @brief Trace one call in every `n` on each thread; 0 stops tracing.
+ *        Takes effect on each thread at its next sampled call.
+ */
+void mu_thunk_trace_set_sampling(unsigned n);
+
+/** Current sampling interval. */
+unsigned mu_thunk_trace_sampling(void);
+
+/**
+ * @brief Write every buffered event as a Chrome trace-event JSON document
+ *        and remove them from the rings.
+ *
+ * Safe to call while other threads are tracing; flushes are serialized.
+ *
+ * @param out Stream to write to.
+ * @return The number of events written, or 0 if `out` is NULL.
+ */
+size_t mu_thunk_trace_flush(FILE *out);
+
+/**
+ * @brief Number of events overwritten before they could be flushed.
+ */
+size_t mu_thunk_trace_dropped(void);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_TRACE_H_ */
@@ -0,0 +1,278 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_uring.h
+ *
+ * @brief io_uring proactor: completion-driven thunks.
+ *
+ * Every submission queue entry carries a `mu_thunk_t *` in `user_data`.
+ * When its completion arrives the proactor calls
+ * `_mu_thunk_call(thunk, cqe)` with a pointer to (a copy of) the
+ * `struct io_uring_cqe`, so `cqe->res` holds the result or `-errno`.
+ *
+ * Entries are batched: `mu_thunk_uring_prep_*()` only fill SQEs, and a
+ * single `mu_thunk_uring_submit()` or `mu_thunk_uring_run_once()` hands the
+ * whole batch to the kernel with one `io_uring_enter`.  Buffers and files
+ * may be registered up front for `*_FIXED` ops and `IOSQE_FIXED_FILE`.
+ *
+ * If io_uring is unavailable (old kernel, seccomp, or
+ * `MU_THUNK_URING_FALLBACK` is passed to init), the same API is served by
+ * a `mu_thunk_reactor`: each operation is attempted immediately and, if
+ * it would block, retried when epoll reports the fd ready.  The fallback
+ * supports NOP, READ, WRITE, READ_FIXED, WRITE_FIXED, RECV and SEND, with
+ * at most one operation waiting on a given fd at a time.  Its attempts
+ * never block, even on a pipe or socket opened without O_NONBLOCK, and a
+ * single transfer is capped at the kernel's 2 GiB - 4 KiB limit.
+ *
+ * Linux only.  Not thread-safe: use one proactor per thread.
+ */
+
+#ifndef _MU_THUNK_URING_H_
+#define _MU_THUNK_URING_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include "mu_thunk_reactor.h"
+#include <linux/io_uring.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Upper bound on `entries`; also sizes the fallback's operation table. */
+#ifndef MU_THUNK_URING_MAX_ENTRIES
+#define MU_THUNK_URING_MAX_ENTRIES 256
+#endif
+
+/** Init flag: skip io_uring and use the epoll fallback. */
+#define MU_THUNK_URING_FALLBACK (1u << 0)
+
+/** Offset meaning "the file's current position" for READ and WRITE. */
+#define MU_THUNK_URING_CUR_POS ((uint64_t)-1)
+
+struct _mu_thunk_uring;
+
+/**
+ * @brief An operation in flight under the epoll fallback.  Internal.
+ */
+typedef struct {
+    mu_thunk_t thunk; /**< Registered with the reactor while waiting */
+    struct _mu_thunk_uring *uring;
+    struct io_uring_sqe sqe;
+    struct io_uring_cqe cqe;
+    int wait_fd; /**< fd registered with the reactor, or -1 */
+} mu_thunk_uring_op_t;
+
+/**
+ * @brief A proactor.  Treat as opaque.
+ */
+typedef struct _mu_thunk_uring {
+    bool native; /**< true: io_uring; false: epoll fallback */
+    /* io_uring state */
+    int ring_fd;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned *sq_flags;
+    struct io_uring_sqe *sqes;
+    unsigned sqe_tail;  /**< Next SQE to hand out */
+    unsigned submitted; /**< SQEs already passed to io_uring_enter */
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+    size_t sqes_size;
+    /* epoll fallback state */
+    mu_thunk_reactor_t reactor;
+    const int *files;
+    unsigned n_files;
+    const struct iovec *buffers;
+    unsigned n_buffers;
+    unsigned n_free;
+    unsigned n_prepared;
+    unsigned n_waiting; /**< Operations registered with the reactor */
+    unsigned cq_count;
+    unsigned cq_first;
+    unsigned free_ops[MU_THUNK_URING_MAX_ENTRIES];
+    unsigned prepared[MU_THUNK_URING_MAX_ENTRIES];
+    unsigned completed[MU_THUNK_URING_MAX_ENTRIES];
+    mu_thunk_uring_op_t ops[MU_THUNK_URING_MAX_ENTRIES];
+} mu_thunk_uring_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a proactor with room for `entries` queued submissions.
+ *
+ * @param uring   Pointer to the proactor.
+ * @param entries Submission queue depth, 1..MU_THUNK_URING_MAX_ENTRIES
+ *                (rounded up to a power of two by the kernel).
+ * @param flags   0 or MU_THUNK_URING_FALLBACK.
+ * @return `uring` on success (check `mu_thunk_uring_is_native()` to see
+ *         which backend is in use), or NULL if an argument is invalid or
+ *         neither backend could be set up (errno is left set).
+ */
+mu_thunk_uring_t *mu_thunk_uring_init(mu_thunk_uring_t *uring,
+                                      unsigned entries, unsigned flags);
+
+/**
+ * @brief Release the ring or the fallback reactor.  Operations still in
+ *        flight are abandoned without their thunks being called.
+ */
+void mu_thunk_uring_deinit(mu_thunk_uring_t *uring);
+
+/**
+ * @brief Return true if the proactor is backed by io_uring.
+ */
+bool mu_thunk_uring_is_native(const mu_thunk_uring_t *uring);
+
+/**
+ * @brief Register buffers for READ_FIXED / WRITE_FIXED.
+ *
+ * The array must outlive the registration.
+ *
+ * @return true on success, false on error (errno is left set).
+ */
+bool mu_thunk_uring_register_buffers(mu_thunk_uring_t *uring,
+                                     const struct iovec *buffers,
+                                     unsigned n_buffers);
+
+/**
+ * @brief Register files for use with `IOSQE_FIXED_FILE`, where an SQE's
+ *        `fd` is an index into `fds`.
+ *
+ * The array must outlive the registration.
+ *
+ * @return true on success, false on error (errno is left set).
+ */
+bool mu_thunk_uring_register_files(mu_thunk_uring_t *uring, const int *fds,
+                                   unsigned n_fds);
+
+/**
+ * @brief Claim a zeroed SQE whose completion will be dispatched to `thunk`.
+ *
+ * Fill in the opcode and operands yourself, or use a `prep` helper.
+ *
+ * @param uring Pointer to the proactor.
+ * @param thunk Thunk to call on completion (must be non-NULL).
+ * @return The SQE, or NULL if the submission queue is full (submit or run
+ *         the proactor, then retry) or an argument is NULL.
+ */
+struct io_uring_sqe *mu_thunk_uring_get_sqe(mu_thunk_uring_t *uring,
+                                            mu_thunk_t *thunk);
+
+/** Queue a no-op.  @return The SQE, or NULL (see get_sqe). */
+struct io_uring_sqe *mu_thunk_uring_prep_nop(mu_thunk_uring_t *uring,
+                                             mu_thunk_t *thunk);
+
+/**
+ * @brief Queue a read of up to `len` bytes at `offset` (or
+ *        MU_THUNK_URING_CUR_POS).  @return The SQE, or NULL (see get_sqe).
+ */
+struct io_uring_sqe *mu_thunk_uring_prep_read(mu_thunk_uring_t *uring, int fd,
+                                              void *buf, unsigned len,
+                                              uint64_t offset,
+                                              mu_thunk_t *thunk);
+
+/** Queue a write.  @return The SQE, or NULL (see get_sqe). */
+struct io_uring_sqe *mu_thunk_uring_prep_write(mu_thunk_uring_t *uring,
+                                               int fd, const void *buf,
+                                               unsigned len, uint64_t offset,
+                                               mu_thunk_t *thunk);
+
+/**
+ * @brief Queue a read into registered buffer `buf_index`; `buf` must lie
+ *        within it.  @return The SQE, or NULL (see get_sqe).
+ */
+struct io_uring_sqe *mu_thunk_uring_prep_read_fixed(mu_thunk_uring_t *uring,
+                                                    int fd, void *buf,
+                                                    unsigned len,
+                                                    uint64_t offset,
+                                                    unsigned buf_index,
+                                                    mu_thunk_t *thunk);
+
+/** Queue a write from a registered buffer.  @return The SQE, or NULL. */
+struct io_uring_sqe *
+mu_thunk_uring_prep_write_fixed(mu_thunk_uring_t *uring, int fd,
+                                const void *buf, unsigned len, uint64_t offset,
+                                unsigned buf_index, mu_thunk_t *thunk);
+
+/** Queue a socket recv.  @return The SQE, or NULL (see get_sqe). */
+struct io_uring_sqe *mu_thunk_uring_prep_recv(mu_thunk_uring_t *uring, int fd,
+                                              void *buf, unsigned len,
+                                              int flags, mu_thunk_t *thunk);
+
+/** Queue a socket send.  @return The SQE, or NULL (see get_sqe). */
+struct io_uring_sqe *mu_thunk_uring_prep_send(mu_thunk_uring_t *uring, int fd,
+                                              const void *buf, unsigned len,
+                                              int flags, mu_thunk_t *thunk);
+
+/**
+ * @brief Hand every prepared SQE to the kernel without waiting.
+ *
+ * @return The number of SQEs submitted, or -1 on error (errno is set).
+ */
+int mu_thunk_uring_submit(mu_thunk_uring_t *uring);
+
+/**
+ * @brief Submit prepared SQEs, wait for at least `wait_nr` completions,
+ *        then dispatch every completion that is available.
+ *
+ * Each completion is copied out of the ring and its slot released before
+ * the thunk runs, so thunks may queue new operations.
+ *
+ * @param uring   Pointer to the proactor.
+ * @param wait_nr Minimum completions to wait for (0 = don't block).
+ * @return The number of thunks dispatched, or -1 on error (errno is set;
+ *         EINTR is reported as whatever was dispatched).
+ */
+int mu_thunk_uring_run_once(mu_thunk_uring_t *uring, unsigned wait_nr);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_URING_H_ */
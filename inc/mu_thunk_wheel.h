@@ -0,0 +1,191 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_thunk_wheel.h
+ *
+ * @brief Hierarchical timing wheel for delayed and periodic thunks.
+ *
+ * A timer embeds a `mu_thunk_t` as its first member, so expiry is a plain
+ * `_mu_thunk_call()`.  Embed `mu_thunk_timer_t` as the first member of your
+ * own struct to carry context.  Schedule and cancel are O(1); advancing the
+ * wheel by one tick is O(1) plus the timers that fire, with timers in the
+ * outer levels cascading inward as their range comes due.
+ *
+ * Time is measured in caller-defined ticks.  The wheel is not thread-safe;
+ * drive it from a single thread.
+ */
+
+#ifndef _MU_THUNK_WHEEL_H_
+#define _MU_THUNK_WHEEL_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** log2 of the number of slots in each level of the wheel (at most 6). */
+#ifndef MU_THUNK_WHEEL_BITS
+#define MU_THUNK_WHEEL_BITS 6
+#endif
+
+/**
+ * Number of levels.  Delays up to 2^(BITS * LEVELS) ticks are placed
+ * exactly; longer delays park in the outermost level and are re-placed each
+ * time it comes round.
+ */
+#ifndef MU_THUNK_WHEEL_LEVELS
+#define MU_THUNK_WHEEL_LEVELS 6
+#endif
+
+#define MU_THUNK_WHEEL_SLOTS (1u << MU_THUNK_WHEEL_BITS)
+
+/** Doubly linked list link; slots use one as a sentinel. */
+typedef struct _mu_thunk_timer_link {
+    struct _mu_thunk_timer_link *next;
+    struct _mu_thunk_timer_link *prev;
+} mu_thunk_timer_link_t;
+
+/**
+ * @brief A timer.  `thunk` must remain the first member.
+ */
+typedef struct {
+    mu_thunk_t thunk;           /**< Must be first member */
+    mu_thunk_timer_link_t link; /**< next == NULL when not pending */
+    uint64_t expires;           /**< Absolute tick at which it fires */
+    uint64_t period;            /**< Re-arm interval, or 0 for one-shot */
+} mu_thunk_timer_t;
+
+/**
+ * @brief A timing wheel.  Treat as opaque.
+ */
+typedef struct {
+    uint64_t now; /**< Every timer with expires <= now has fired */
+    size_t count; /**< Number of pending timers */
+    /** Per-level slot occupancy; a set bit may be stale after a cancel. */
+    uint64_t occupied[MU_THUNK_WHEEL_LEVELS];
+    mu_thunk_timer_link_t slots[MU_THUNK_WHEEL_LEVELS][MU_THUNK_WHEEL_SLOTS];
+} mu_thunk_wheel_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an empty wheel.
+ *
+ * @param wheel Pointer to the wheel.
+ * @param now   The current tick.
+ * @return `wheel`, or NULL if `wheel` is NULL.
+ */
+mu_thunk_wheel_t *mu_thunk_wheel_init(mu_thunk_wheel_t *wheel, uint64_t now);
+
+/**
+ * @brief Initialize a timer.  The timer starts out not pending.
+ *
+ * @param timer Pointer to the timer.
+ * @param fn    Function to invoke on expiry.  It is called as
+ *              `fn(&timer->thunk, wheel)`.
+ * @return `timer`, or NULL if `timer` or `fn` is NULL.
+ */
+mu_thunk_timer_t *mu_thunk_timer_init(mu_thunk_timer_t *timer,
+                                      mu_thunk_fn fn);
+
+/**
+ * @brief Return true if the timer is scheduled on a wheel.
+ */
+bool mu_thunk_timer_is_pending(const mu_thunk_timer_t *timer);
+
+/**
+ * @brief Schedule a timer to fire `delay` ticks from now.
+ *
+ * A timer that is already pending is rescheduled.  A delay of 0 fires on
+ * the next tick.  If `period` is non-zero the timer is re-armed to fire
+ * every `period` ticks after its first expiry until cancelled; re-arming
+ * happens before the thunk is called, so the thunk may cancel it.
+ *
+ * @param wheel  Pointer to the wheel.
+ * @param timer  Pointer to an initialized timer.
+ * @param delay  Ticks until the first expiry.
+ * @param period Re-arm interval in ticks, or 0 for a one-shot timer.
+ * @return `timer`, or NULL if `wheel` or `timer` is NULL.
+ */
+mu_thunk_timer_t *mu_thunk_wheel_schedule(mu_thunk_wheel_t *wheel,
+                                          mu_thunk_timer_t *timer,
+                                          uint64_t delay, uint64_t period);
+
+/**
+ * @brief Cancel a pending timer.
+ *
+ * @param wheel Pointer to the wheel the timer is scheduled on.
+ * @param timer Pointer to the timer.
+ * @return true if the timer was pending, false otherwise.
+ */
+bool mu_thunk_wheel_cancel(mu_thunk_wheel_t *wheel, mu_thunk_timer_t *timer);
+
+/**
+ * @brief Advance the wheel to `now`, firing every timer that expires on or
+ *        before it, in order of expiry tick.
+ *
+ * Stretches of ticks with nothing to fire or cascade are skipped using the
+ * slot occupancy bitmaps, so a large jump costs time proportional to the
+ * work done, not to the number of ticks.  Does nothing if `now` is not
+ * after the wheel's current tick.
+ *
+ * @param wheel Pointer to the wheel.
+ * @param now   The new current tick.
+ * @return The number of timers fired.
+ */
+size_t mu_thunk_wheel_advance(mu_thunk_wheel_t *wheel, uint64_t now);
+
+/**
+ * @brief Return the wheel's current tick (0 if `wheel` is NULL).
+ */
+uint64_t mu_thunk_wheel_now(const mu_thunk_wheel_t *wheel);
+
+/**
+ * @brief Return the number of pending timers (0 if `wheel` is NULL).
+ */
+size_t mu_thunk_wheel_count(const mu_thunk_wheel_t *wheel);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_THUNK_WHEEL_H_ */
@@ -26,7 +26,6 @@
 // Includes
 
 #include "mu_thunk.h"
-#include <stddef.h>
 
 // *****************************************************************************
 // Private types and definitions
@@ -46,21 +45,10 @@
 // *****************************************************************************
 // Public code
 
-mu_thunk_t *mu_thunk_init(mu_thunk_t *thunk, mu_thunk_fn fn) {
-    if (thunk == NULL || fn == NULL) {
-        return NULL;
-    }
-    // Use the inline initializer
-    return _mu_thunk_init(thunk, fn);
-}
-
-void mu_thunk_call(mu_thunk_t *thunk, void *args) {
-    if (thunk == NULL || thunk->fn == NULL) {
-        return;
-    }
-    // Use the inline call
-    _mu_thunk_call(thunk, args);
-}
+// The definitions are shared with MU_THUNK_HEADER_ONLY builds.
+#ifndef MU_THUNK_HEADER_ONLY
+#include "mu_thunk_impl.h"
+#endif
 
 // *****************************************************************************
 // Private (static) code
@@ -0,0 +1,234 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_batch.h"
+#include "mu_thunk_atomic.h"
+#include "mu_thunk_hash.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+/** Open-addressed: at most half the slots hold live entries. */
+#define N_SLOTS (2 * MU_THUNK_BATCH_MAX_FNS)
+#define SLOT_MASK (N_SLOTS - 1)
+
+_Static_assert((N_SLOTS & (N_SLOTS - 1)) == 0,
+               "MU_THUNK_BATCH_MAX_FNS must be a power of two");
+
+/**
+ * A removed entry keeps its key with `batch` NULL so lock-free probes do not
+ * stop short; registering another function may take the slot over.  Keys
+ * are only cleared where no probe needs them, or by a rebuild.
+ */
+typedef struct {
+    MU_THUNK_ATOMIC(mu_thunk_fn) fn;          /**< NULL: never used */
+    MU_THUNK_ATOMIC(mu_thunk_batch_fn) batch; /**< NULL: removed */
+} slot_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static slot_t s_slots[N_SLOTS];
+static size_t s_n_fns;  /**< Live entries */
+static size_t s_n_keys; /**< Slots with a key, live or removed */
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void trim_removed(size_t i);
+static void compact(void);
+
+// *****************************************************************************
+// Public code
+
+bool mu_thunk_batch_register(mu_thunk_fn fn, mu_thunk_batch_fn batch) {
+    if (fn == NULL) {
+        return false;
+    }
+    bool ok = true;
+    pthread_mutex_lock(&s_lock);
+    if (batch != NULL && s_n_keys == N_SLOTS - 1) {
+        compact(); // keep one never-used slot to end every probe
+    }
+    slot_t *removed = NULL; // first reusable slot on fn's probe sequence
+    size_t i = _mu_thunk_hash_fn(fn, SLOT_MASK);
+    for (;; i = (i + 1) & SLOT_MASK) {
+        slot_t *slot = &s_slots[i];
+        mu_thunk_fn cur = atomic_load_explicit(&slot->fn, memory_order_relaxed);
+        mu_thunk_batch_fn old =
+            atomic_load_explicit(&slot->batch, memory_order_relaxed);
+        if (cur == fn) {
+            if (old == NULL && batch != NULL) {
+                if (s_n_fns == MU_THUNK_BATCH_MAX_FNS) {
+                    ok = false;
+                    break;
+                }
+                s_n_fns++;
+            } else if (old != NULL && batch == NULL) {
+                s_n_fns--;
+            }
+            atomic_store_explicit(&slot->batch, batch, memory_order_release);
+            if (batch == NULL) {
+                trim_removed(i);
+            }
+            break;
+        }
+        if (cur != NULL && old == NULL && removed == NULL) {
+            removed = slot;
+        }
+        if (cur == NULL) {
+            if (batch == NULL) {
+                break; // never registered: nothing to remove
+            }
+            if (s_n_fns == MU_THUNK_BATCH_MAX_FNS) {
+                ok = false;
+                break;
+            }
+            if (removed == NULL) {
+                removed = slot;
+                s_n_keys++;
+            }
+            // Key first, then the implementation; a lookup that read the
+            // previous key re-checks it after loading `batch`.
+            atomic_store_explicit(&removed->fn, fn, memory_order_release);
+            atomic_store_explicit(&removed->batch, batch,
+                                  memory_order_release);
+            s_n_fns++;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_lock);
+    return ok;
+}
+
+mu_thunk_batch_fn mu_thunk_batch_lookup(mu_thunk_fn fn) {
+    if (fn == NULL) {
+        return NULL;
+    }
+    for (size_t i = _mu_thunk_hash_fn(fn, SLOT_MASK);;
+         i = (i + 1) & SLOT_MASK) {
+        mu_thunk_fn cur = atomic_load_explicit(&s_slots[i].fn,
+                                               memory_order_acquire);
+        if (cur == fn) {
+            mu_thunk_batch_fn batch = atomic_load_explicit(
+                &s_slots[i].batch, memory_order_acquire);
+            // If the slot was taken over since we read its key, `batch`
+            // may be the new function's; fn itself was removed.
+            if (atomic_load_explicit(&s_slots[i].fn, memory_order_relaxed) !=
+                fn) {
+                return NULL;
+            }
+            return batch;
+        }
+        if (cur == NULL) {
+            return NULL;
+        }
+    }
+}
+
+size_t mu_thunk_batch_dispatch(mu_thunk_t **thunks, void **args, size_t n) {
+    if (thunks == NULL) {
+        return 0;
+    }
+    size_t i = 0;
+    while (i < n) {
+        mu_thunk_fn fn = thunks[i]->fn;
+        size_t end = i + 1;
+        while (end < n && thunks[end]->fn == fn) {
+            end++;
+        }
+        mu_thunk_batch_fn batch = mu_thunk_batch_lookup(fn);
+        if (batch != NULL) {
+            batch(thunks + i, args != NULL ? args + i : NULL, end - i);
+        } else {
+            for (; i < end; i++) {
+                _mu_thunk_call(thunks[i], args != NULL ? args[i] : NULL);
+            }
+        }
+        i = end;
+    }
+    return n;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void compact(void) {
+    // Removed slots have used up the table: re-insert the live entries into
+    // a cleared one.  A lookup racing this may miss and fall back to
+    // per-thunk calls, which is what an unregistered function gets anyway.
+    mu_thunk_fn fns[MU_THUNK_BATCH_MAX_FNS];
+    mu_thunk_batch_fn batches[MU_THUNK_BATCH_MAX_FNS];
+    size_t n = 0;
+    for (size_t i = 0; i < N_SLOTS; i++) {
+        mu_thunk_batch_fn batch =
+            atomic_load_explicit(&s_slots[i].batch, memory_order_relaxed);
+        if (batch != NULL) {
+            fns[n] = atomic_load_explicit(&s_slots[i].fn, memory_order_relaxed);
+            batches[n++] = batch;
+        }
+        atomic_store_explicit(&s_slots[i].fn, NULL, memory_order_release);
+        atomic_store_explicit(&s_slots[i].batch, NULL, memory_order_release);
+    }
+    for (size_t k = 0; k < n; k++) {
+        size_t i = _mu_thunk_hash_fn(fns[k], SLOT_MASK);
+        while (atomic_load_explicit(&s_slots[i].fn, memory_order_relaxed) !=
+               NULL) {
+            i = (i + 1) & SLOT_MASK;
+        }
+        atomic_store_explicit(&s_slots[i].fn, fns[k], memory_order_release);
+        atomic_store_explicit(&s_slots[i].batch, batches[k],
+                              memory_order_release);
+    }
+    s_n_keys = n;
+}
+
+static void trim_removed(size_t i) {
+    // No live key's probe runs through a removed slot that is followed by a
+    // never-used one, so such a slot can be returned to never-used, and
+    // then perhaps the removed slot before it.
+    for (;;) {
+        slot_t *slot = &s_slots[i];
+        slot_t *next = &s_slots[(i + 1) & SLOT_MASK];
+        if (atomic_load_explicit(&next->fn, memory_order_relaxed) != NULL ||
+            atomic_load_explicit(&slot->fn, memory_order_relaxed) == NULL ||
+            atomic_load_explicit(&slot->batch, memory_order_relaxed) !=
+                NULL) {
+            return;
+        }
+        atomic_store_explicit(&slot->fn, NULL, memory_order_release);
+        s_n_keys--;
+        i = (i - 1) & SLOT_MASK;
+    }
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,132 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_compact.h"
+#include <pthread.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+_Static_assert(MU_THUNK_COMPACT_MAX_FNS >= 2 &&
+                   MU_THUNK_COMPACT_MAX_FNS - 1 <=
+                       (mu_thunk_compact_id_t)~(mu_thunk_compact_id_t)0,
+               "MU_THUNK_COMPACT_MAX_FNS must fit in an id");
+
+// *****************************************************************************
+// Private (static) storage
+
+mu_thunk_compact_fn mu_thunk_compact_fns[MU_THUNK_COMPACT_MAX_FNS];
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static mu_thunk_compact_id_t find(mu_thunk_compact_fn fn);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_compact_id_t mu_thunk_compact_register(mu_thunk_compact_fn fn) {
+    if (fn == NULL) {
+        return MU_THUNK_COMPACT_NONE;
+    }
+    pthread_mutex_lock(&s_lock);
+    mu_thunk_compact_id_t id = find(fn);
+    if (id == MU_THUNK_COMPACT_NONE) {
+        for (size_t i = 1; i < MU_THUNK_COMPACT_MAX_FNS; i++) {
+            if (mu_thunk_compact_fns[i] == NULL) {
+                mu_thunk_compact_fns[i] = fn;
+                id = (mu_thunk_compact_id_t)i;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&s_lock);
+    return id;
+}
+
+bool mu_thunk_compact_register_at(mu_thunk_compact_id_t id,
+                                  mu_thunk_compact_fn fn) {
+    if (fn == NULL || id == MU_THUNK_COMPACT_NONE ||
+        id >= MU_THUNK_COMPACT_MAX_FNS) {
+        return false;
+    }
+    pthread_mutex_lock(&s_lock);
+    bool ok =
+        mu_thunk_compact_fns[id] == NULL || mu_thunk_compact_fns[id] == fn;
+    if (ok) {
+        mu_thunk_compact_fns[id] = fn;
+    }
+    pthread_mutex_unlock(&s_lock);
+    return ok;
+}
+
+mu_thunk_compact_fn mu_thunk_compact_lookup(mu_thunk_compact_id_t id) {
+    return id < MU_THUNK_COMPACT_MAX_FNS ? mu_thunk_compact_fns[id] : NULL;
+}
+
+mu_thunk_compact_id_t mu_thunk_compact_id_of(mu_thunk_compact_fn fn) {
+    if (fn == NULL) {
+        return MU_THUNK_COMPACT_NONE;
+    }
+    pthread_mutex_lock(&s_lock);
+    mu_thunk_compact_id_t id = find(fn);
+    pthread_mutex_unlock(&s_lock);
+    return id;
+}
+
+mu_thunk_compact_t *mu_thunk_compact_init(mu_thunk_compact_t *thunk,
+                                          mu_thunk_compact_id_t id) {
+    if (thunk == NULL || mu_thunk_compact_lookup(id) == NULL) {
+        return NULL;
+    }
+    return _mu_thunk_compact_init(thunk, id);
+}
+
+void mu_thunk_compact_call(mu_thunk_compact_t *thunk, void *args) {
+    if (thunk == NULL || mu_thunk_compact_lookup(thunk->id) == NULL) {
+        return;
+    }
+    _mu_thunk_compact_call(thunk, args);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static mu_thunk_compact_id_t find(mu_thunk_compact_fn fn) {
+    for (size_t i = 1; i < MU_THUNK_COMPACT_MAX_FNS; i++) {
+        if (mu_thunk_compact_fns[i] == fn) {
+            return (mu_thunk_compact_id_t)i;
+        }
+    }
+    return MU_THUNK_COMPACT_NONE;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,312 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_edf.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define ARITY 4
+#define NOT_SCHEDULED SIZE_MAX
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static mu_thunk_edf_task_t **slot(mu_thunk_edf_t *edf, bool waiting,
+                                  size_t i);
+static uint64_t key(const mu_thunk_edf_task_t *task, bool waiting);
+static bool locate(const mu_thunk_edf_t *edf, const mu_thunk_edf_task_t *task,
+                   bool *waiting, size_t *i);
+static void insert(mu_thunk_edf_t *edf, bool waiting,
+                   mu_thunk_edf_task_t *task);
+static void release_due(mu_thunk_edf_t *edf, uint64_t now);
+static void place(mu_thunk_edf_t *edf, bool waiting, mu_thunk_edf_task_t *task,
+                  size_t i);
+static void sift_up(mu_thunk_edf_t *edf, bool waiting, size_t i);
+static void sift_down(mu_thunk_edf_t *edf, bool waiting, size_t i);
+static void remove_at(mu_thunk_edf_t *edf, bool waiting, size_t i);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_edf_t *mu_thunk_edf_init(mu_thunk_edf_t *edf,
+                                  mu_thunk_edf_task_t **store, size_t capacity,
+                                  mu_thunk_edf_clock_fn clock,
+                                  mu_thunk_t *on_miss) {
+    if (edf == NULL || store == NULL || capacity == 0) {
+        return NULL;
+    }
+    edf->heap = store;
+    edf->capacity = capacity;
+    edf->count = 0;
+    edf->waiting = 0;
+    edf->clock = clock != NULL ? clock : mu_thunk_edf_now_ns;
+    edf->on_miss = on_miss;
+    edf->dispatched = 0;
+    edf->misses = 0;
+    return edf;
+}
+
+mu_thunk_edf_task_t *mu_thunk_edf_task_init(mu_thunk_edf_task_t *task,
+                                            mu_thunk_fn fn) {
+    if (task == NULL || mu_thunk_init(&task->thunk, fn) == NULL) {
+        return NULL;
+    }
+    task->release = 0;
+    task->deadline = 0;
+    task->index = NOT_SCHEDULED;
+    return task;
+}
+
+bool mu_thunk_edf_task_is_scheduled(const mu_thunk_edf_task_t *task) {
+    return task != NULL && task->index != NOT_SCHEDULED;
+}
+
+bool mu_thunk_edf_schedule(mu_thunk_edf_t *edf, mu_thunk_edf_task_t *task,
+                           uint64_t deadline) {
+    return mu_thunk_edf_schedule_at(edf, task, 0, deadline);
+}
+
+bool mu_thunk_edf_schedule_at(mu_thunk_edf_t *edf, mu_thunk_edf_task_t *task,
+                              uint64_t release, uint64_t deadline) {
+    if (edf == NULL || task == NULL) {
+        return false;
+    }
+    bool waiting;
+    size_t i;
+    if (locate(edf, task, &waiting, &i)) {
+        remove_at(edf, waiting, i);
+    } else if (task->index != NOT_SCHEDULED) {
+        return false; // scheduled on some other scheduler
+    } else if (edf->count + edf->waiting == edf->capacity) {
+        return false;
+    }
+    task->release = release;
+    task->deadline = deadline;
+    insert(edf, release != 0, task);
+    return true;
+}
+
+bool mu_thunk_edf_cancel(mu_thunk_edf_t *edf, mu_thunk_edf_task_t *task) {
+    bool waiting;
+    size_t i;
+    if (edf == NULL || task == NULL || !locate(edf, task, &waiting, &i)) {
+        return false;
+    }
+    remove_at(edf, waiting, i);
+    return true;
+}
+
+mu_thunk_edf_task_t *mu_thunk_edf_peek(const mu_thunk_edf_t *edf) {
+    return (edf == NULL || edf->count == 0) ? NULL : edf->heap[0];
+}
+
+uint64_t mu_thunk_edf_next_release(const mu_thunk_edf_t *edf) {
+    if (edf == NULL || edf->waiting == 0) {
+        return UINT64_MAX;
+    }
+    return edf->heap[edf->capacity - 1]->release;
+}
+
+size_t mu_thunk_edf_run(mu_thunk_edf_t *edf, void *args, size_t max) {
+    if (edf == NULL) {
+        return 0;
+    }
+    uint64_t now = edf->clock();
+    release_due(edf, now);
+    // Take at most the tasks ready on entry, so a task that reschedules
+    // itself (or a miss thunk that reschedules it) can't hold the run open.
+    size_t limit = (max == 0 || max > edf->count) ? edf->count : max;
+    size_t n = 0;
+    while (n < limit && edf->count > 0) {
+        mu_thunk_edf_task_t *task = edf->heap[0];
+        remove_at(edf, false, 0);
+        n++;
+        if (now > task->deadline) {
+            edf->misses++;
+            if (edf->on_miss != NULL) {
+                _mu_thunk_call(edf->on_miss, task);
+                now = edf->clock();
+                release_due(edf, now);
+                continue;
+            }
+        } else {
+            edf->dispatched++;
+        }
+        _mu_thunk_call(&task->thunk, args);
+        now = edf->clock();
+        release_due(edf, now);
+    }
+    return n;
+}
+
+size_t mu_thunk_edf_count(const mu_thunk_edf_t *edf) {
+    return edf == NULL ? 0 : edf->count + edf->waiting;
+}
+
+uint64_t mu_thunk_edf_dispatched(const mu_thunk_edf_t *edf) {
+    return edf == NULL ? 0 : edf->dispatched;
+}
+
+uint64_t mu_thunk_edf_misses(const mu_thunk_edf_t *edf) {
+    return edf == NULL ? 0 : edf->misses;
+}
+
+uint64_t mu_thunk_edf_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+// Two heaps share the store: ready tasks keyed by deadline grow up from
+// heap[0], waiting tasks keyed by release grow down from heap[capacity - 1].
+// A task's index is its position in the store, whichever heap it is on.
+
+static mu_thunk_edf_task_t **slot(mu_thunk_edf_t *edf, bool waiting,
+                                  size_t i) {
+    return waiting ? &edf->heap[edf->capacity - 1 - i] : &edf->heap[i];
+}
+
+static uint64_t key(const mu_thunk_edf_task_t *task, bool waiting) {
+    return waiting ? task->release : task->deadline;
+}
+
+static bool locate(const mu_thunk_edf_t *edf, const mu_thunk_edf_task_t *task,
+                   bool *waiting, size_t *i) {
+    size_t at = task->index;
+    if (at >= edf->capacity || edf->heap[at] != task) {
+        return false;
+    }
+    if (at < edf->count) {
+        *waiting = false;
+        *i = at;
+        return true;
+    }
+    if (at >= edf->capacity - edf->waiting) {
+        *waiting = true;
+        *i = edf->capacity - 1 - at;
+        return true;
+    }
+    return false;
+}
+
+static void insert(mu_thunk_edf_t *edf, bool waiting,
+                   mu_thunk_edf_task_t *task) {
+    size_t i = waiting ? edf->waiting++ : edf->count++;
+    place(edf, waiting, task, i);
+    sift_up(edf, waiting, i);
+}
+
+static void release_due(mu_thunk_edf_t *edf, uint64_t now) {
+    while (edf->waiting > 0) {
+        mu_thunk_edf_task_t *task = *slot(edf, true, 0);
+        if (task->release > now) {
+            break;
+        }
+        remove_at(edf, true, 0);
+        insert(edf, false, task);
+    }
+}
+
+static void place(mu_thunk_edf_t *edf, bool waiting, mu_thunk_edf_task_t *task,
+                  size_t i) {
+    *slot(edf, waiting, i) = task;
+    task->index = waiting ? edf->capacity - 1 - i : i;
+}
+
+static void sift_up(mu_thunk_edf_t *edf, bool waiting, size_t i) {
+    mu_thunk_edf_task_t *task = *slot(edf, waiting, i);
+    while (i > 0) {
+        size_t parent = (i - 1) / ARITY;
+        mu_thunk_edf_task_t *up = *slot(edf, waiting, parent);
+        if (key(up, waiting) <= key(task, waiting)) {
+            break;
+        }
+        place(edf, waiting, up, i);
+        i = parent;
+    }
+    place(edf, waiting, task, i);
+}
+
+static void sift_down(mu_thunk_edf_t *edf, bool waiting, size_t i) {
+    size_t count = waiting ? edf->waiting : edf->count;
+    mu_thunk_edf_task_t *task = *slot(edf, waiting, i);
+    for (;;) {
+        size_t first = i * ARITY + 1;
+        if (first >= count) {
+            break;
+        }
+        size_t last = first + ARITY < count ? first + ARITY : count;
+        size_t best = first;
+        uint64_t best_key = key(*slot(edf, waiting, first), waiting);
+        for (size_t c = first + 1; c < last; c++) {
+            uint64_t k = key(*slot(edf, waiting, c), waiting);
+            if (k < best_key) {
+                best = c;
+                best_key = k;
+            }
+        }
+        if (key(task, waiting) <= best_key) {
+            break;
+        }
+        place(edf, waiting, *slot(edf, waiting, best), i);
+        i = best;
+    }
+    place(edf, waiting, task, i);
+}
+
+static void remove_at(mu_thunk_edf_t *edf, bool waiting, size_t i) {
+    mu_thunk_edf_task_t *task = *slot(edf, waiting, i);
+    size_t *count = waiting ? &edf->waiting : &edf->count;
+    mu_thunk_edf_task_t *last = *slot(edf, waiting, --*count);
+    task->index = NOT_SCHEDULED;
+    if (last == task) {
+        return;
+    }
+    place(edf, waiting, last, i);
+    if (i > 0 && key(last, waiting) <
+                     key(*slot(edf, waiting, (i - 1) / ARITY), waiting)) {
+        sift_up(edf, waiting, i);
+    } else {
+        sift_down(edf, waiting, i);
+    }
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,236 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_graph.h"
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define NODE_OF_RUNNER(r)                                                      \
+    ((mu_thunk_graph_node_t *)((char *)(r) -                                   \
+                               offsetof(mu_thunk_graph_node_t, runner)))
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void reset(mu_thunk_graph_t *graph);
+static size_t topo_walk(mu_thunk_graph_t *graph, bool call);
+static void spawn(mu_thunk_graph_t *graph, mu_thunk_graph_node_t *node);
+static void runner_fn(mu_thunk_t *thunk, void *args);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_graph_t *mu_thunk_graph_init(mu_thunk_graph_t *graph) {
+    if (graph == NULL) {
+        return NULL;
+    }
+    graph->head = NULL;
+    graph->tail = NULL;
+    graph->n_nodes = 0;
+    graph->pool = NULL;
+    graph->args = NULL;
+    atomic_store_explicit(&graph->remaining, 0, memory_order_relaxed);
+    return graph;
+}
+
+mu_thunk_graph_node_t *mu_thunk_graph_add(mu_thunk_graph_t *graph,
+                                          mu_thunk_graph_node_t *node,
+                                          mu_thunk_fn fn,
+                                          mu_thunk_graph_node_t **succ,
+                                          uint32_t succ_cap) {
+    if (graph == NULL || node == NULL || fn == NULL ||
+        (succ == NULL && succ_cap != 0)) {
+        return NULL;
+    }
+    _mu_thunk_init(&node->thunk, fn);
+    _mu_thunk_init(&node->runner, runner_fn);
+    node->graph = graph;
+    node->next = NULL;
+    node->ready_next = NULL;
+    node->succ = succ;
+    node->n_succ = 0;
+    node->succ_cap = succ_cap;
+    node->n_pred = 0;
+    atomic_store_explicit(&node->pending, 0, memory_order_relaxed);
+    if (graph->tail == NULL) {
+        graph->head = node;
+    } else {
+        graph->tail->next = node;
+    }
+    graph->tail = node;
+    graph->n_nodes++;
+    return node;
+}
+
+bool mu_thunk_graph_depend(mu_thunk_graph_node_t *before,
+                           mu_thunk_graph_node_t *after) {
+    if (before == NULL || after == NULL || before == after ||
+        before->graph != after->graph || before->n_succ == before->succ_cap) {
+        return false;
+    }
+    before->succ[before->n_succ++] = after;
+    after->n_pred++;
+    return true;
+}
+
+bool mu_thunk_graph_is_acyclic(mu_thunk_graph_t *graph) {
+    return graph == NULL || topo_walk(graph, false) == graph->n_nodes;
+}
+
+bool mu_thunk_graph_run(mu_thunk_graph_t *graph, mu_thunk_pool_t *pool,
+                        void *args) {
+    if (graph == NULL) {
+        return false;
+    }
+    graph->args = args;
+    graph->pool = pool;
+    if (pool == NULL) {
+        topo_walk(graph, true);
+        return true;
+    }
+    reset(graph);
+    atomic_store_explicit(&graph->remaining, graph->n_nodes,
+                          memory_order_release);
+    for (mu_thunk_graph_node_t *n = graph->head; n != NULL; n = n->next) {
+        if (n->n_pred != 0) {
+            continue;
+        }
+        // Roots go through the injection queue; make room if it is full.
+        while (!mu_thunk_pool_submit(pool, &n->runner, NULL)) {
+            if (!mu_thunk_pool_help(pool)) {
+                sched_yield();
+            }
+        }
+    }
+    while (atomic_load_explicit(&graph->remaining, memory_order_acquire) !=
+           0) {
+        if (!mu_thunk_pool_help(pool)) {
+            sched_yield();
+        }
+    }
+    return true;
+}
+
+size_t mu_thunk_graph_node_count(const mu_thunk_graph_t *graph) {
+    return graph == NULL ? 0 : graph->n_nodes;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void reset(mu_thunk_graph_t *graph) {
+    for (mu_thunk_graph_node_t *n = graph->head; n != NULL; n = n->next) {
+        atomic_store_explicit(&n->pending, n->n_pred, memory_order_relaxed);
+    }
+}
+
+/**
+ * Kahn's algorithm over the pending counts: visit every node whose
+ * predecessors have all been visited, calling it if `call` is set.  Returns
+ * the number of nodes visited, which falls short of the node count only if
+ * the graph has a cycle.
+ */
+static size_t topo_walk(mu_thunk_graph_t *graph, bool call) {
+    reset(graph);
+    // A LIFO work list runs a successor right after its last predecessor,
+    // while that predecessor's output is still in cache.
+    mu_thunk_graph_node_t *ready = NULL;
+    for (mu_thunk_graph_node_t *n = graph->head; n != NULL; n = n->next) {
+        if (n->n_pred == 0) {
+            n->ready_next = ready;
+            ready = n;
+        }
+    }
+    size_t visited = 0;
+    while (ready != NULL) {
+        mu_thunk_graph_node_t *n = ready;
+        ready = n->ready_next;
+        visited++;
+        if (call) {
+            _mu_thunk_call(&n->thunk, graph->args);
+        }
+        for (uint32_t i = 0; i < n->n_succ; i++) {
+            mu_thunk_graph_node_t *s = n->succ[i];
+            if (atomic_fetch_sub_explicit(&s->pending, 1,
+                                          memory_order_relaxed) == 1) {
+                s->ready_next = ready;
+                ready = s;
+            }
+        }
+    }
+    return visited;
+}
+
+static void spawn(mu_thunk_graph_t *graph, mu_thunk_graph_node_t *node) {
+    // On a worker this pushes to its own deque and cannot fail; elsewhere
+    // (a helping caller) the injection queue may be full.
+    if (!mu_thunk_pool_submit(graph->pool, &node->runner, NULL)) {
+        runner_fn(&node->runner, NULL);
+    }
+}
+
+static void runner_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    mu_thunk_graph_node_t *node = NODE_OF_RUNNER(thunk);
+    mu_thunk_graph_t *graph = node->graph;
+    while (node != NULL) {
+        _mu_thunk_call(&node->thunk, graph->args);
+        // Run the first successor made ready here next, on this thread,
+        // and hand the rest to the pool.
+        mu_thunk_graph_node_t *next = NULL;
+        for (uint32_t i = 0; i < node->n_succ; i++) {
+            mu_thunk_graph_node_t *s = node->succ[i];
+            if (atomic_fetch_sub_explicit(&s->pending, 1,
+                                          memory_order_acq_rel) != 1) {
+                continue;
+            }
+            if (next == NULL) {
+                next = s;
+            } else {
+                spawn(graph, s);
+            }
+        }
+        // Last touch of the finished node: the caller may return once
+        // `remaining` reaches zero.
+        atomic_fetch_sub_explicit(&graph->remaining, 1, memory_order_release);
+        node = next;
+    }
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,284 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_group.h"
+#include "mu_thunk_hash.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define OVERFLOW MU_THUNK_GROUP_MAX_FNS
+#define HASH_MASK (MU_THUNK_GROUP_HASH_SIZE - 1)
+
+_Static_assert((MU_THUNK_GROUP_HASH_SIZE & HASH_MASK) == 0 &&
+                   MU_THUNK_GROUP_HASH_SIZE > MU_THUNK_GROUP_MAX_FNS,
+               "MU_THUNK_GROUP_HASH_SIZE must be a power of two > MAX_FNS");
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void run_pass(mu_thunk_group_t *group, mu_thunk_t **in, size_t n,
+                     void *args);
+static inline size_t bucket_of(mu_thunk_group_t *group, mu_thunk_fn fn,
+                               bool add);
+static size_t add_bucket(mu_thunk_group_t *group, mu_thunk_fn fn,
+                         size_t slot);
+static mu_thunk_span_fn span_of(const mu_thunk_group_t *group,
+                                mu_thunk_fn fn);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_group_t *mu_thunk_group_init(mu_thunk_group_t *group,
+                                      mu_thunk_t **store, size_t capacity) {
+    if (group == NULL || store == NULL || capacity == 0) {
+        return NULL;
+    }
+    group->store = store;
+    group->capacity = capacity;
+    group->n_buckets = 0;
+    group->n_bindings = 0;
+    group->running = false;
+    for (size_t i = 0; i < MU_THUNK_GROUP_HASH_SIZE; i++) {
+        group->slots[i].fn = NULL;
+    }
+    return group;
+}
+
+bool mu_thunk_group_set_span(mu_thunk_group_t *group, mu_thunk_fn fn,
+                             mu_thunk_span_fn span) {
+    if (group == NULL || fn == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < group->n_bindings; i++) {
+        if (group->bindings[i].fn == fn) {
+            if (span != NULL) {
+                group->bindings[i].span = span;
+            } else {
+                group->bindings[i] = group->bindings[--group->n_bindings];
+            }
+            return true;
+        }
+    }
+    if (span == NULL) {
+        return true;
+    }
+    if (group->n_bindings == MU_THUNK_GROUP_MAX_FNS) {
+        return false;
+    }
+    group->bindings[group->n_bindings].fn = fn;
+    group->bindings[group->n_bindings].span = span;
+    group->n_bindings++;
+    return true;
+}
+
+size_t mu_thunk_group_dispatch(mu_thunk_group_t *group, mu_thunk_t **thunks,
+                               size_t n, void *args) {
+    if (group == NULL || thunks == NULL) {
+        return 0;
+    }
+    if (group->running) {
+        for (size_t i = 0; i < n; i++) {
+            _mu_thunk_call(thunks[i], args);
+        }
+        return n;
+    }
+    for (size_t done = 0; done < n;) {
+        size_t batch = n - done < group->capacity ? n - done : group->capacity;
+        run_pass(group, thunks + done, batch, args);
+        done += batch;
+    }
+    return n;
+}
+
+size_t mu_thunk_group_drain_ring(mu_thunk_group_t *group,
+                                 mu_thunk_ring_t *ring, void *args) {
+    if (group == NULL || ring == NULL) {
+        return 0;
+    }
+    if (group->running) {
+        return mu_thunk_ring_drain(ring, args);
+    }
+    size_t remaining = mu_thunk_ring_count(ring);
+    size_t total = 0;
+    while (remaining > 0) {
+        size_t want = remaining < group->capacity ? remaining : group->capacity;
+        size_t n = mu_thunk_ring_get_batch(ring, group->store, want);
+        if (n == 0) {
+            break;
+        }
+        run_pass(group, group->store, n, args);
+        remaining -= n;
+        total += n;
+    }
+    return total;
+}
+
+size_t mu_thunk_group_drain_mpsc(mu_thunk_group_t *group, mu_thunk_mpsc_t *q,
+                                 void *args, size_t max) {
+    if (group == NULL || q == NULL) {
+        return 0;
+    }
+    if (group->running) {
+        return mu_thunk_mpsc_drain(q, args, max);
+    }
+    // Stop at the tail seen on entry, as mu_thunk_mpsc_drain() does.
+    mu_thunk_mpsc_node_t *last =
+        atomic_load_explicit(&q->tail, memory_order_acquire);
+    size_t total = 0;
+    bool done = false;
+    while (!done) {
+        size_t n = 0;
+        while (n < group->capacity && (max == 0 || total + n < max)) {
+            if (last == &q->stub && q->head == &q->stub) {
+                done = true;
+                break;
+            }
+            mu_thunk_mpsc_node_t *node = mu_thunk_mpsc_get(q);
+            if (node == NULL) {
+                done = true;
+                break;
+            }
+            group->store[n++] = &node->thunk;
+            if (node == last) {
+                done = true;
+                break;
+            }
+        }
+        if (n == 0) {
+            break;
+        }
+        run_pass(group, group->store, n, args);
+        total += n;
+    }
+    return total;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void run_pass(mu_thunk_group_t *group, mu_thunk_t **in, size_t n,
+                     void *args) {
+    mu_thunk_t **out = group->store + group->capacity;
+    mu_thunk_group_bucket_t *buckets = group->buckets;
+
+    // Count per function; fns beyond the table share the overflow bucket.
+    group->n_buckets = 0;
+    buckets[OVERFLOW].fn = NULL;
+    buckets[OVERFLOW].span = NULL;
+    buckets[OVERFLOW].count = 0;
+    for (size_t i = 0; i < n; i++) {
+        buckets[bucket_of(group, in[i]->fn, true)].count++;
+    }
+    size_t offset = 0;
+    for (size_t b = 0; b < group->n_buckets; b++) {
+        buckets[b].offset = offset;
+        offset += buckets[b].count;
+    }
+    buckets[OVERFLOW].offset = offset;
+
+    // Stable scatter: queue order is kept within each bucket.
+    for (size_t i = 0; i < n; i++) {
+        out[buckets[bucket_of(group, in[i]->fn, false)].offset++] = in[i];
+    }
+
+    // Leave the hash empty for the next pass before anything can re-enter.
+    for (size_t b = 0; b < group->n_buckets; b++) {
+        group->slots[buckets[b].slot].fn = NULL;
+    }
+
+    // Nested calls on this group see `running` and leave the scratch
+    // space (out, buckets) alone while we walk it.
+    group->running = true;
+    mu_thunk_t **run = out;
+    for (size_t b = 0; b < group->n_buckets; b++) {
+        mu_thunk_group_bucket_t *bucket = &buckets[b];
+        if (bucket->span != NULL) {
+            bucket->span(run, bucket->count, args);
+        } else {
+            for (size_t i = 0; i < bucket->count; i++) {
+                _mu_thunk_call(run[i], args);
+            }
+        }
+        run += bucket->count;
+    }
+    for (size_t i = 0; i < buckets[OVERFLOW].count; i++) {
+        _mu_thunk_call(run[i], args);
+    }
+    group->running = false;
+}
+
+static inline size_t bucket_of(mu_thunk_group_t *group, mu_thunk_fn fn,
+                               bool add) {
+    // Hashed rather than scanned: a scan's exit branch depends on which fn
+    // this is, and would mispredict as often as the dispatch we are trying
+    // to make predictable.  Probing only on collisions keeps the common
+    // path to one well-predicted compare.
+    size_t slot = _mu_thunk_hash_fn(fn, HASH_MASK);
+    while (group->slots[slot].fn != fn) {
+        if (group->slots[slot].fn == NULL) {
+            return add ? add_bucket(group, fn, slot) : OVERFLOW;
+        }
+        slot = (slot + 1) & HASH_MASK;
+    }
+    return group->slots[slot].bucket;
+}
+
+static size_t add_bucket(mu_thunk_group_t *group, mu_thunk_fn fn,
+                         size_t slot) {
+    if (group->n_buckets == MU_THUNK_GROUP_MAX_FNS) {
+        return OVERFLOW;
+    }
+    mu_thunk_group_bucket_t *bucket = &group->buckets[group->n_buckets];
+    bucket->fn = fn;
+    bucket->span = span_of(group, fn);
+    bucket->count = 0;
+    bucket->slot = slot;
+    group->slots[slot].fn = fn;
+    group->slots[slot].bucket = group->n_buckets;
+    return group->n_buckets++;
+}
+
+static mu_thunk_span_fn span_of(const mu_thunk_group_t *group,
+                                mu_thunk_fn fn) {
+    for (size_t i = 0; i < group->n_bindings; i++) {
+        if (group->bindings[i].fn == fn) {
+            return group->bindings[i].span;
+        }
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+// End of file
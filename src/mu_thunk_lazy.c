@@ -0,0 +1,139 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_lazy.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <time.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+// (none)
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void futex_wait(MU_THUNK_ATOMIC(uint32_t) *addr, uint32_t expected);
+static void futex_wake(MU_THUNK_ATOMIC(uint32_t) *addr, int count);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_lazy_t *mu_thunk_lazy_init(mu_thunk_lazy_t *lazy, mu_thunk_fn fn) {
+    if (lazy == NULL || fn == NULL) {
+        return NULL;
+    }
+    _mu_thunk_init(&lazy->thunk, fn);
+    lazy->value = NULL;
+    atomic_store_explicit(&lazy->state, MU_THUNK_LAZY_UNINIT,
+                          memory_order_release);
+    return lazy;
+}
+
+void *mu_thunk_lazy_force_slow(mu_thunk_lazy_t *lazy, void *args) {
+    if (lazy == NULL) {
+        return NULL;
+    }
+    uint32_t state = atomic_load_explicit(&lazy->state, memory_order_acquire);
+    while (state != MU_THUNK_LAZY_DONE) {
+        if (state == MU_THUNK_LAZY_UNINIT) {
+            if (!atomic_compare_exchange_weak_explicit(
+                    &lazy->state, &state, MU_THUNK_LAZY_RUNNING,
+                    memory_order_acquire, memory_order_acquire)) {
+                continue;
+            }
+            _mu_thunk_call(&lazy->thunk, args);
+            // Publish the result; wake sleepers only if any announced
+            // themselves, so an uncontended evaluation makes no syscall.
+            state = atomic_exchange_explicit(&lazy->state, MU_THUNK_LAZY_DONE,
+                                             memory_order_acq_rel);
+            if (state == MU_THUNK_LAZY_WAITING) {
+                futex_wake(&lazy->state, INT32_MAX);
+            }
+            break;
+        }
+        if (state == MU_THUNK_LAZY_RUNNING &&
+            !atomic_compare_exchange_weak_explicit(
+                &lazy->state, &state, MU_THUNK_LAZY_WAITING,
+                memory_order_acquire, memory_order_acquire)) {
+            continue;
+        }
+        futex_wait(&lazy->state, MU_THUNK_LAZY_WAITING);
+        state = atomic_load_explicit(&lazy->state, memory_order_acquire);
+    }
+    return lazy->value;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+#if defined(__linux__)
+
+static void futex_wait(MU_THUNK_ATOMIC(uint32_t) *addr, uint32_t expected) {
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAIT_PRIVATE, expected, NULL,
+            NULL, 0);
+}
+
+static void futex_wake(MU_THUNK_ATOMIC(uint32_t) *addr, int count) {
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL,
+            0);
+}
+
+#else
+
+// Without futexes, waiting forcers poll the state at a coarse interval.
+static void futex_wait(MU_THUNK_ATOMIC(uint32_t) *addr, uint32_t expected) {
+    struct timespec ts = {.tv_sec = 0, .tv_nsec = 100000};
+    if (atomic_load_explicit(addr, memory_order_acquire) == expected) {
+        nanosleep(&ts, NULL);
+    }
+}
+
+static void futex_wake(MU_THUNK_ATOMIC(uint32_t) *addr, int count) {
+    (void)addr;
+    (void)count;
+}
+
+#endif
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,161 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_mpsc.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+// (none)
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void push(mu_thunk_mpsc_t *q, mu_thunk_mpsc_node_t *node);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_mpsc_t *mu_thunk_mpsc_init(mu_thunk_mpsc_t *q) {
+    if (q == NULL) {
+        return NULL;
+    }
+    q->stub.thunk = MU_THUNK_NULL;
+    atomic_store_explicit(&q->stub.next, NULL, memory_order_relaxed);
+    atomic_store_explicit(&q->tail, &q->stub, memory_order_relaxed);
+    q->head = &q->stub;
+    return q;
+}
+
+mu_thunk_mpsc_node_t *mu_thunk_mpsc_node_init(mu_thunk_mpsc_node_t *node,
+                                              mu_thunk_fn fn) {
+    if (node == NULL || mu_thunk_init(&node->thunk, fn) == NULL) {
+        return NULL;
+    }
+    atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+    return node;
+}
+
+bool mu_thunk_mpsc_put(mu_thunk_mpsc_t *q, mu_thunk_mpsc_node_t *node) {
+    if (q == NULL || node == NULL) {
+        return false;
+    }
+    push(q, node);
+    return true;
+}
+
+mu_thunk_mpsc_node_t *mu_thunk_mpsc_get(mu_thunk_mpsc_t *q) {
+    if (q == NULL) {
+        return NULL;
+    }
+    mu_thunk_mpsc_node_t *head = q->head;
+    mu_thunk_mpsc_node_t *next =
+        atomic_load_explicit(&head->next, memory_order_acquire);
+
+    if (head == &q->stub) {
+        // Skip over the stub.
+        if (next == NULL) {
+            return NULL;
+        }
+        q->head = next;
+        head = next;
+        next = atomic_load_explicit(&head->next, memory_order_acquire);
+    }
+    if (next != NULL) {
+        q->head = next;
+        return head;
+    }
+    if (head != atomic_load_explicit(&q->tail, memory_order_acquire)) {
+        // A producer has swapped tail but not yet linked its node.
+        return NULL;
+    }
+    // head is the last node: re-insert the stub behind it so head can be
+    // handed out without leaving the queue without a node.
+    push(q, &q->stub);
+    next = atomic_load_explicit(&head->next, memory_order_acquire);
+    if (next != NULL) {
+        q->head = next;
+        return head;
+    }
+    return NULL;
+}
+
+bool mu_thunk_mpsc_is_empty(mu_thunk_mpsc_t *q) {
+    if (q == NULL) {
+        return true;
+    }
+    return q->head == atomic_load_explicit(&q->tail, memory_order_acquire) &&
+           q->head == &q->stub;
+}
+
+size_t mu_thunk_mpsc_drain(mu_thunk_mpsc_t *q, void *args, size_t max) {
+    if (q == NULL) {
+        return 0;
+    }
+    // Stop at the tail seen on entry, so nodes posted while draining (a
+    // thunk re-posting itself, say) wait for the next call.  If that tail
+    // is the stub, every node queued on entry lies before it.
+    mu_thunk_mpsc_node_t *last =
+        atomic_load_explicit(&q->tail, memory_order_acquire);
+    size_t n = 0;
+    while (max == 0 || n < max) {
+        if (last == &q->stub && q->head == &q->stub) {
+            break;
+        }
+        mu_thunk_mpsc_node_t *node = mu_thunk_mpsc_get(q);
+        if (node == NULL) {
+            break;
+        }
+        _mu_thunk_call(&node->thunk, args);
+        n++;
+        if (node == last) {
+            break;
+        }
+    }
+    return n;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void push(mu_thunk_mpsc_t *q, mu_thunk_mpsc_node_t *node) {
+    atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+    mu_thunk_mpsc_node_t *prev =
+        atomic_exchange_explicit(&q->tail, node, memory_order_acq_rel);
+    atomic_store_explicit(&prev->next, node, memory_order_release);
+}
+
+// *****************************************************************************
+// End of file
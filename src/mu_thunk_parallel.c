@@ -0,0 +1,195 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_parallel.h"
+#include <sched.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+_Static_assert(MU_THUNK_PARALLEL_MAX_CHUNKS > 0,
+               "MU_THUNK_PARALLEL_MAX_CHUNKS must be positive");
+_Static_assert(MU_THUNK_PARALLEL_CHUNKS_PER_THREAD > 0,
+               "MU_THUNK_PARALLEL_CHUNKS_PER_THREAD must be positive");
+
+/** State shared by the chunks of one call; lives on the caller's stack. */
+typedef struct {
+    mu_thunk_parallel_for_fn for_body;
+    mu_thunk_parallel_reduce_fn reduce_body;
+    void *ctx;
+    atomic_size_t pending; /**< Chunks not yet finished */
+} job_t;
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    job_t *job;
+    size_t begin;
+    size_t end;
+    alignas(max_align_t) unsigned char acc[MU_THUNK_PARALLEL_MAX_ACC];
+} chunk_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static size_t plan(mu_thunk_pool_t *pool, size_t n, size_t *grain);
+static void fork_join(mu_thunk_pool_t *pool, job_t *job, chunk_t *chunks,
+                      size_t n_chunks, size_t begin, size_t end,
+                      size_t grain);
+static void chunk_fn(mu_thunk_t *thunk, void *args);
+
+// *****************************************************************************
+// Public code
+
+bool mu_thunk_parallel_for(mu_thunk_pool_t *pool, size_t begin, size_t end,
+                           size_t grain, mu_thunk_parallel_for_fn body,
+                           void *ctx) {
+    if (pool == NULL || body == NULL || begin > end) {
+        return false;
+    }
+    size_t n_chunks = plan(pool, end - begin, &grain);
+    if (n_chunks <= 1) {
+        if (begin < end) {
+            body(begin, end, ctx);
+        }
+        return true;
+    }
+    job_t job = {.for_body = body, .ctx = ctx};
+    chunk_t chunks[MU_THUNK_PARALLEL_MAX_CHUNKS];
+    fork_join(pool, &job, chunks, n_chunks, begin, end, grain);
+    return true;
+}
+
+bool mu_thunk_parallel_reduce(mu_thunk_pool_t *pool, size_t begin, size_t end,
+                              size_t grain, void *acc, size_t acc_size,
+                              mu_thunk_parallel_reduce_fn body,
+                              mu_thunk_parallel_combine_fn combine,
+                              void *ctx) {
+    if (pool == NULL || acc == NULL || acc_size == 0 ||
+        acc_size > MU_THUNK_PARALLEL_MAX_ACC || body == NULL ||
+        combine == NULL || begin > end) {
+        return false;
+    }
+    size_t n_chunks = plan(pool, end - begin, &grain);
+    if (n_chunks <= 1) {
+        if (begin < end) {
+            body(begin, end, acc, ctx);
+        }
+        return true;
+    }
+    job_t job = {.reduce_body = body, .ctx = ctx};
+    chunk_t chunks[MU_THUNK_PARALLEL_MAX_CHUNKS];
+    // Every chunk starts from its own copy of the identity.
+    for (size_t i = 0; i < n_chunks; i++) {
+        memcpy(chunks[i].acc, acc, acc_size);
+    }
+    fork_join(pool, &job, chunks, n_chunks, begin, end, grain);
+    memcpy(acc, chunks[0].acc, acc_size);
+    for (size_t i = 1; i < n_chunks; i++) {
+        combine(acc, chunks[i].acc, ctx);
+    }
+    return true;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * Choose the grain (if automatic) and return the number of chunks.  The
+ * automatic grain gives each worker, and the caller, a few chunks so that
+ * stealing can even out uneven chunk costs; the chunk count is capped by
+ * widening the grain.
+ */
+static size_t plan(mu_thunk_pool_t *pool, size_t n, size_t *grain) {
+    if (*grain == 0) {
+        size_t target = (mu_thunk_pool_worker_count(pool) + 1) *
+                        MU_THUNK_PARALLEL_CHUNKS_PER_THREAD;
+        *grain = (n + target - 1) / target;
+        if (*grain == 0) {
+            *grain = 1;
+        }
+    }
+    size_t n_chunks = n / *grain + (n % *grain != 0);
+    if (n_chunks > MU_THUNK_PARALLEL_MAX_CHUNKS) {
+        n_chunks = MU_THUNK_PARALLEL_MAX_CHUNKS;
+        *grain = (n + n_chunks - 1) / n_chunks;
+        n_chunks = (n + *grain - 1) / *grain;
+    }
+    return n_chunks;
+}
+
+static void fork_join(mu_thunk_pool_t *pool, job_t *job, chunk_t *chunks,
+                      size_t n_chunks, size_t begin, size_t end,
+                      size_t grain) {
+    atomic_store_explicit(&job->pending, n_chunks, memory_order_relaxed);
+    for (size_t i = 0; i < n_chunks; i++) {
+        chunk_t *c = &chunks[i];
+        _mu_thunk_init(&c->thunk, chunk_fn);
+        c->job = job;
+        c->begin = begin + i * grain;
+        c->end = end - c->begin > grain ? c->begin + grain : end;
+    }
+    // Submit the tail and keep the head: chunk 0 is then run while the
+    // workers wake up.  A chunk the pool cannot take runs here instead.
+    for (size_t i = 1; i < n_chunks; i++) {
+        if (!mu_thunk_pool_submit(pool, &chunks[i].thunk, NULL)) {
+            chunk_fn(&chunks[i].thunk, NULL);
+        }
+    }
+    chunk_fn(&chunks[0].thunk, NULL);
+    while (atomic_load_explicit(&job->pending, memory_order_acquire) != 0) {
+        if (!mu_thunk_pool_help(pool)) {
+            sched_yield();
+        }
+    }
+}
+
+static void chunk_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    chunk_t *c = (chunk_t *)thunk;
+    job_t *job = c->job;
+    if (job->for_body != NULL) {
+        job->for_body(c->begin, c->end, job->ctx);
+    } else {
+        job->reduce_body(c->begin, c->end, c->acc, job->ctx);
+    }
+    // Last touch of the caller's stack: once pending reaches zero the
+    // caller may return and the chunks go out of scope.
+    atomic_fetch_sub_explicit(&job->pending, 1, memory_order_release);
+}
+
+// *****************************************************************************
+// End of file
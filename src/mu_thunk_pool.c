@@ -0,0 +1,409 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_pool.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <time.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DEQUE_MASK ((int64_t)MU_THUNK_POOL_DEQUE_CAPACITY - 1)
+
+/** Rounds of searching for work before a worker parks. */
+#define IDLE_SPINS 64
+
+typedef enum {
+    STEAL_OK,
+    STEAL_EMPTY,
+    STEAL_ABORT, // lost a race with another thief or the owner
+} steal_result_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+/** The worker running on this thread, or NULL for non-worker threads. */
+static _Thread_local mu_thunk_pool_worker_t *s_current_worker;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void stop_workers(mu_thunk_pool_t *pool, size_t n_started);
+static void *worker_main(void *arg);
+static bool find_task(mu_thunk_pool_t *pool, mu_thunk_pool_worker_t *self,
+                      mu_thunk_t **thunk, void **args);
+static void park(mu_thunk_pool_t *pool, mu_thunk_pool_worker_t *self);
+static void wake_one(mu_thunk_pool_t *pool);
+static bool has_work(mu_thunk_pool_t *pool);
+static bool deque_push(mu_thunk_pool_worker_t *w, mu_thunk_t *thunk,
+                       void *args);
+static bool deque_take(mu_thunk_pool_worker_t *w, mu_thunk_t **thunk,
+                       void **args);
+static steal_result_t deque_steal(mu_thunk_pool_worker_t *w,
+                                  mu_thunk_t **thunk, void **args);
+static bool inject_put(mu_thunk_pool_t *pool, mu_thunk_t *thunk, void *args);
+static bool inject_get(mu_thunk_pool_t *pool, mu_thunk_t **thunk,
+                       void **args);
+static uint64_t next_random(uint64_t *state);
+static void futex_wait(MU_THUNK_ATOMIC(uint32_t) *addr, uint32_t expected);
+static void futex_wake(MU_THUNK_ATOMIC(uint32_t) *addr, int count);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_pool_t *mu_thunk_pool_init(mu_thunk_pool_t *pool,
+                                    mu_thunk_pool_worker_t *workers,
+                                    size_t n_workers) {
+    if (pool == NULL || workers == NULL || n_workers == 0) {
+        return NULL;
+    }
+    pool->workers = workers;
+    pool->n_workers = n_workers;
+    pthread_mutex_init(&pool->inject_lock, NULL);
+    pool->inject_head = 0;
+    pool->inject_tail = 0;
+    atomic_store_explicit(&pool->inject_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&pool->epoch, 0, memory_order_relaxed);
+    atomic_store_explicit(&pool->n_sleepers, 0, memory_order_relaxed);
+    atomic_store_explicit(&pool->stopping, false, memory_order_relaxed);
+
+    // Every deque is valid (and empty) before any thread can steal from it.
+    for (size_t i = 0; i < n_workers; i++) {
+        mu_thunk_pool_worker_t *w = &workers[i];
+        atomic_store_explicit(&w->top, 0, memory_order_relaxed);
+        atomic_store_explicit(&w->bottom, 0, memory_order_relaxed);
+        w->pool = pool;
+        w->rng = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+    for (size_t i = 0; i < n_workers; i++) {
+        if (pthread_create(&workers[i].thread, NULL, worker_main,
+                           &workers[i]) != 0) {
+            stop_workers(pool, i);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void mu_thunk_pool_stop(mu_thunk_pool_t *pool) {
+    if (pool == NULL) {
+        return;
+    }
+    stop_workers(pool, pool->n_workers);
+}
+
+bool mu_thunk_pool_submit(mu_thunk_pool_t *pool, mu_thunk_t *thunk,
+                          void *args) {
+    if (pool == NULL || thunk == NULL || thunk->fn == NULL) {
+        return false;
+    }
+    mu_thunk_pool_worker_t *self = s_current_worker;
+    if (self != NULL && self->pool == pool) {
+        if (!deque_push(self, thunk, args)) {
+            // Deque full: running inline keeps the submitter making progress.
+            _mu_thunk_call(thunk, args);
+            return true;
+        }
+    } else if (!inject_put(pool, thunk, args)) {
+        return false;
+    }
+    wake_one(pool);
+    return true;
+}
+
+bool mu_thunk_pool_help(mu_thunk_pool_t *pool) {
+    if (pool == NULL) {
+        return false;
+    }
+    mu_thunk_pool_worker_t *self = s_current_worker;
+    if (self != NULL && self->pool != pool) {
+        self = NULL;
+    }
+    mu_thunk_t *thunk;
+    void *args;
+    if (!find_task(pool, self, &thunk, &args)) {
+        return false;
+    }
+    _mu_thunk_call(thunk, args);
+    return true;
+}
+
+size_t mu_thunk_pool_worker_count(const mu_thunk_pool_t *pool) {
+    return pool == NULL ? 0 : pool->n_workers;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void stop_workers(mu_thunk_pool_t *pool, size_t n_started) {
+    atomic_store_explicit(&pool->stopping, true, memory_order_seq_cst);
+    atomic_fetch_add_explicit(&pool->epoch, 1, memory_order_seq_cst);
+    futex_wake(&pool->epoch, INT32_MAX);
+    for (size_t i = 0; i < n_started; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    pool->n_workers = 0;
+    pthread_mutex_destroy(&pool->inject_lock);
+}
+
+static void *worker_main(void *arg) {
+    mu_thunk_pool_worker_t *self = (mu_thunk_pool_worker_t *)arg;
+    mu_thunk_pool_t *pool = self->pool;
+    mu_thunk_t *thunk;
+    void *args;
+    int idle = 0;
+
+    s_current_worker = self;
+    while (!atomic_load_explicit(&pool->stopping, memory_order_acquire)) {
+        if (find_task(pool, self, &thunk, &args)) {
+            _mu_thunk_call(thunk, args);
+            idle = 0;
+        } else if (++idle < IDLE_SPINS) {
+            sched_yield();
+        } else {
+            park(pool, self);
+            idle = 0;
+        }
+    }
+    s_current_worker = NULL;
+    return NULL;
+}
+
+static bool find_task(mu_thunk_pool_t *pool, mu_thunk_pool_worker_t *self,
+                      mu_thunk_t **thunk, void **args) {
+    if (self != NULL && deque_take(self, thunk, args)) {
+        return true;
+    }
+    if (inject_get(pool, thunk, args)) {
+        return true;
+    }
+    size_t n = pool->n_workers;
+    if (n == 0) {
+        return false;
+    }
+    static _Thread_local uint64_t s_outsider_rng = 0x2545F4914F6CDD1Dull;
+    uint64_t *rng = self != NULL ? &self->rng : &s_outsider_rng;
+    size_t start = (size_t)(next_random(rng) % n);
+    // Visit every victim once, starting at a random one.  A victim that
+    // aborts (contended) is retried on the next call rather than spun on.
+    for (size_t i = 0; i < n; i++) {
+        mu_thunk_pool_worker_t *victim = &pool->workers[(start + i) % n];
+        if (victim == self) {
+            continue;
+        }
+        if (deque_steal(victim, thunk, args) == STEAL_OK) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void park(mu_thunk_pool_t *pool, mu_thunk_pool_worker_t *self) {
+    (void)self;
+    uint32_t epoch = atomic_load_explicit(&pool->epoch, memory_order_acquire);
+    atomic_fetch_add_explicit(&pool->n_sleepers, 1, memory_order_seq_cst);
+    // Re-check after announcing ourselves: a submitter either sees our
+    // sleeper count and bumps the epoch, or we see its work here.
+    if (!has_work(pool) &&
+        !atomic_load_explicit(&pool->stopping, memory_order_acquire)) {
+        futex_wait(&pool->epoch, epoch);
+    }
+    atomic_fetch_sub_explicit(&pool->n_sleepers, 1, memory_order_relaxed);
+}
+
+static void wake_one(mu_thunk_pool_t *pool) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&pool->n_sleepers, memory_order_relaxed) > 0) {
+        atomic_fetch_add_explicit(&pool->epoch, 1, memory_order_release);
+        futex_wake(&pool->epoch, 1);
+    }
+}
+
+static bool has_work(mu_thunk_pool_t *pool) {
+    if (atomic_load_explicit(&pool->inject_count, memory_order_seq_cst) > 0) {
+        return true;
+    }
+    for (size_t i = 0; i < pool->n_workers; i++) {
+        mu_thunk_pool_worker_t *w = &pool->workers[i];
+        int64_t t = atomic_load_explicit(&w->top, memory_order_seq_cst);
+        int64_t b = atomic_load_explicit(&w->bottom, memory_order_seq_cst);
+        if (b > t) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Chase-Lev deque, following Le, Pop, Cohen & Zappa Nardelli, "Correct and
+// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013), with a fixed
+// buffer instead of a growable one.
+
+static bool deque_push(mu_thunk_pool_worker_t *w, mu_thunk_t *thunk,
+                       void *args) {
+    int64_t b = atomic_load_explicit(&w->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&w->top, memory_order_acquire);
+    if (b - t > DEQUE_MASK) {
+        return false;
+    }
+    mu_thunk_pool_slot_t *slot = &w->slots[b & DEQUE_MASK];
+    atomic_store_explicit(&slot->thunk, thunk, memory_order_relaxed);
+    atomic_store_explicit(&slot->args, args, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&w->bottom, b + 1, memory_order_relaxed);
+    return true;
+}
+
+static bool deque_take(mu_thunk_pool_worker_t *w, mu_thunk_t **thunk,
+                       void **args) {
+    int64_t b = atomic_load_explicit(&w->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&w->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&w->top, memory_order_relaxed);
+    if (t > b) {
+        // Empty.
+        atomic_store_explicit(&w->bottom, b + 1, memory_order_relaxed);
+        return false;
+    }
+    mu_thunk_pool_slot_t *slot = &w->slots[b & DEQUE_MASK];
+    *thunk = atomic_load_explicit(&slot->thunk, memory_order_relaxed);
+    *args = atomic_load_explicit(&slot->args, memory_order_relaxed);
+    if (t == b) {
+        // Last entry: race thieves for it.
+        bool won = atomic_compare_exchange_strong_explicit(
+            &w->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&w->bottom, b + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+static steal_result_t deque_steal(mu_thunk_pool_worker_t *w,
+                                  mu_thunk_t **thunk, void **args) {
+    int64_t t = atomic_load_explicit(&w->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&w->bottom, memory_order_acquire);
+    if (t >= b) {
+        return STEAL_EMPTY;
+    }
+    mu_thunk_pool_slot_t *slot = &w->slots[t & DEQUE_MASK];
+    *thunk = atomic_load_explicit(&slot->thunk, memory_order_relaxed);
+    *args = atomic_load_explicit(&slot->args, memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(
+            &w->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        return STEAL_ABORT;
+    }
+    return STEAL_OK;
+}
+
+static bool inject_put(mu_thunk_pool_t *pool, mu_thunk_t *thunk, void *args) {
+    bool ok = false;
+    pthread_mutex_lock(&pool->inject_lock);
+    if (pool->inject_tail - pool->inject_head < MU_THUNK_POOL_INJECT_CAPACITY) {
+        size_t i = pool->inject_tail++ % MU_THUNK_POOL_INJECT_CAPACITY;
+        pool->inject[i].thunk = thunk;
+        pool->inject[i].args = args;
+        atomic_fetch_add_explicit(&pool->inject_count, 1,
+                                  memory_order_seq_cst);
+        ok = true;
+    }
+    pthread_mutex_unlock(&pool->inject_lock);
+    return ok;
+}
+
+static bool inject_get(mu_thunk_pool_t *pool, mu_thunk_t **thunk,
+                       void **args) {
+    // Cheap unlocked check keeps idle workers off the mutex.
+    if (atomic_load_explicit(&pool->inject_count, memory_order_acquire) == 0) {
+        return false;
+    }
+    bool ok = false;
+    pthread_mutex_lock(&pool->inject_lock);
+    if (pool->inject_head != pool->inject_tail) {
+        size_t i = pool->inject_head++ % MU_THUNK_POOL_INJECT_CAPACITY;
+        *thunk = pool->inject[i].thunk;
+        *args = pool->inject[i].args;
+        atomic_fetch_sub_explicit(&pool->inject_count, 1,
+                                  memory_order_relaxed);
+        ok = true;
+    }
+    pthread_mutex_unlock(&pool->inject_lock);
+    return ok;
+}
+
+static uint64_t next_random(uint64_t *state) {
+    // xorshift64
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+#if defined(__linux__)
+
+static void futex_wait(MU_THUNK_ATOMIC(uint32_t) *addr, uint32_t expected) {
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAIT_PRIVATE, expected, NULL,
+            NULL, 0);
+}
+
+static void futex_wake(MU_THUNK_ATOMIC(uint32_t) *addr, int count) {
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL,
+            0);
+}
+
+#else
+
+// Without futexes, parked workers poll the epoch at a coarse interval.
+static void futex_wait(MU_THUNK_ATOMIC(uint32_t) *addr, uint32_t expected) {
+    struct timespec ts = {.tv_sec = 0, .tv_nsec = 100000};
+    if (atomic_load_explicit(addr, memory_order_acquire) == expected) {
+        nanosleep(&ts, NULL);
+    }
+}
+
+static void futex_wake(MU_THUNK_ATOMIC(uint32_t) *addr, int count) {
+    (void)addr;
+    (void)count;
+}
+
+#endif
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,169 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_prio.h"
+#include <stddef.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+_Static_assert(MU_THUNK_PRIO_LEVELS >= 1 && MU_THUNK_PRIO_LEVELS <= 64,
+               "MU_THUNK_PRIO_LEVELS must be 1..64");
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void unlink_node(mu_thunk_prio_t *q, mu_thunk_prio_node_t *node);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_prio_t *mu_thunk_prio_init(mu_thunk_prio_t *q) {
+    if (q == NULL) {
+        return NULL;
+    }
+    q->ready = 0;
+    q->count = 0;
+    for (size_t i = 0; i < MU_THUNK_PRIO_LEVELS; i++) {
+        q->levels[i].next = &q->levels[i];
+        q->levels[i].prev = &q->levels[i];
+    }
+    return q;
+}
+
+mu_thunk_prio_node_t *mu_thunk_prio_node_init(mu_thunk_prio_node_t *node,
+                                              mu_thunk_fn fn) {
+    if (node == NULL || mu_thunk_init(&node->thunk, fn) == NULL) {
+        return NULL;
+    }
+    node->link.next = NULL;
+    node->link.prev = NULL;
+    node->queue = NULL;
+    node->priority = 0;
+    return node;
+}
+
+bool mu_thunk_prio_node_is_queued(const mu_thunk_prio_node_t *node) {
+    return node != NULL && node->link.next != NULL;
+}
+
+bool mu_thunk_prio_put(mu_thunk_prio_t *q, mu_thunk_prio_node_t *node,
+                       unsigned priority) {
+    if (q == NULL || node == NULL || priority >= MU_THUNK_PRIO_LEVELS ||
+        node->link.next != NULL) {
+        return false;
+    }
+    mu_thunk_prio_link_t *level = &q->levels[priority];
+    node->queue = q;
+    node->priority = priority;
+    node->link.next = level;
+    node->link.prev = level->prev;
+    level->prev->next = &node->link;
+    level->prev = &node->link;
+    q->ready |= 1ull << priority;
+    q->count++;
+    return true;
+}
+
+mu_thunk_prio_node_t *mu_thunk_prio_get(mu_thunk_prio_t *q) {
+    if (q == NULL || q->ready == 0) {
+        return NULL;
+    }
+    mu_thunk_prio_link_t *level = &q->levels[__builtin_ctzll(q->ready)];
+    mu_thunk_prio_node_t *node =
+        (mu_thunk_prio_node_t *)((char *)level->next -
+                                 offsetof(mu_thunk_prio_node_t, link));
+    unlink_node(q, node);
+    return node;
+}
+
+bool mu_thunk_prio_remove(mu_thunk_prio_t *q, mu_thunk_prio_node_t *node) {
+    if (q == NULL || node == NULL || node->link.next == NULL ||
+        node->queue != q) {
+        return false;
+    }
+    unlink_node(q, node);
+    return true;
+}
+
+int mu_thunk_prio_highest(const mu_thunk_prio_t *q) {
+    if (q == NULL || q->ready == 0) {
+        return -1;
+    }
+    return __builtin_ctzll(q->ready);
+}
+
+size_t mu_thunk_prio_count(const mu_thunk_prio_t *q) {
+    return q == NULL ? 0 : q->count;
+}
+
+bool mu_thunk_prio_is_empty(const mu_thunk_prio_t *q) {
+    return q == NULL || q->count == 0;
+}
+
+size_t mu_thunk_prio_drain(mu_thunk_prio_t *q, void *args, size_t max) {
+    if (q == NULL) {
+        return 0;
+    }
+    // Bound the drain by what is queued now, so a thunk that re-queues
+    // itself (a cooperative yield) cannot keep it running.
+    size_t limit = q->count;
+    if (max != 0 && max < limit) {
+        limit = max;
+    }
+    size_t n = 0;
+    mu_thunk_prio_node_t *node;
+    while (n < limit && (node = mu_thunk_prio_get(q)) != NULL) {
+        _mu_thunk_call(&node->thunk, args);
+        n++;
+    }
+    return n;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void unlink_node(mu_thunk_prio_t *q, mu_thunk_prio_node_t *node) {
+    mu_thunk_prio_link_t *level = &q->levels[node->priority];
+    node->link.prev->next = node->link.next;
+    node->link.next->prev = node->link.prev;
+    node->link.next = NULL;
+    node->link.prev = NULL;
+    node->queue = NULL;
+    if (level->next == level) {
+        q->ready &= ~(1ull << node->priority);
+    }
+    q->count--;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,213 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_reactor.h"
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+// The wake eventfd is registered with a NULL data pointer; user thunks are
+// never NULL.
+#define WAKE_MARKER NULL
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool control(mu_thunk_reactor_t *reactor, int op, int fd,
+                    uint32_t events, mu_thunk_t *thunk);
+static void wake(mu_thunk_reactor_t *reactor);
+static void consume_wake(mu_thunk_reactor_t *reactor);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_reactor_t *mu_thunk_reactor_init(mu_thunk_reactor_t *reactor) {
+    if (reactor == NULL) {
+        return NULL;
+    }
+    reactor->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (reactor->epoll_fd < 0) {
+        return NULL;
+    }
+    reactor->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (reactor->wake_fd < 0) {
+        close(reactor->epoll_fd);
+        return NULL;
+    }
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = WAKE_MARKER};
+    if (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, reactor->wake_fd, &ev) <
+        0) {
+        int saved = errno;
+        close(reactor->wake_fd);
+        close(reactor->epoll_fd);
+        errno = saved;
+        return NULL;
+    }
+    mu_thunk_mpsc_init(&reactor->posted);
+    atomic_store_explicit(&reactor->wake_pending, false, memory_order_relaxed);
+    atomic_store_explicit(&reactor->stopping, false, memory_order_relaxed);
+    return reactor;
+}
+
+void mu_thunk_reactor_deinit(mu_thunk_reactor_t *reactor) {
+    if (reactor == NULL) {
+        return;
+    }
+    close(reactor->wake_fd);
+    close(reactor->epoll_fd);
+    reactor->wake_fd = -1;
+    reactor->epoll_fd = -1;
+}
+
+bool mu_thunk_reactor_add(mu_thunk_reactor_t *reactor, int fd,
+                          uint32_t events, mu_thunk_t *thunk) {
+    return control(reactor, EPOLL_CTL_ADD, fd, events, thunk);
+}
+
+bool mu_thunk_reactor_modify(mu_thunk_reactor_t *reactor, int fd,
+                             uint32_t events, mu_thunk_t *thunk) {
+    return control(reactor, EPOLL_CTL_MOD, fd, events, thunk);
+}
+
+bool mu_thunk_reactor_remove(mu_thunk_reactor_t *reactor, int fd) {
+    if (reactor == NULL) {
+        errno = EINVAL;
+        return false;
+    }
+    return epoll_ctl(reactor->epoll_fd, EPOLL_CTL_DEL, fd, NULL) == 0;
+}
+
+bool mu_thunk_reactor_post(mu_thunk_reactor_t *reactor,
+                           mu_thunk_mpsc_node_t *node) {
+    if (reactor == NULL || !mu_thunk_mpsc_put(&reactor->posted, node)) {
+        return false;
+    }
+    wake(reactor);
+    return true;
+}
+
+int mu_thunk_reactor_run_once(mu_thunk_reactor_t *reactor, int timeout_ms) {
+    if (reactor == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+    // Posted work left over from a bounded drain must not wait for an event.
+    if (!mu_thunk_mpsc_is_empty(&reactor->posted)) {
+        timeout_ms = 0;
+    }
+    int n = epoll_wait(reactor->epoll_fd, reactor->events,
+                       MU_THUNK_REACTOR_MAX_EVENTS, timeout_ms);
+    if (n < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    int dispatched = 0;
+    for (int i = 0; i < n; i++) {
+        struct epoll_event *ev = &reactor->events[i];
+        if (ev->data.ptr == WAKE_MARKER) {
+            consume_wake(reactor);
+        } else {
+            _mu_thunk_call((mu_thunk_t *)ev->data.ptr, ev);
+            dispatched++;
+        }
+    }
+    dispatched += (int)mu_thunk_mpsc_drain(&reactor->posted, reactor,
+                                           MU_THUNK_REACTOR_MAX_EVENTS);
+    return dispatched;
+}
+
+int mu_thunk_reactor_run(mu_thunk_reactor_t *reactor) {
+    if (reactor == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+    int result = 0;
+    while (!atomic_load_explicit(&reactor->stopping, memory_order_acquire)) {
+        if (mu_thunk_reactor_run_once(reactor, -1) < 0) {
+            result = -1;
+            break;
+        }
+    }
+    // Allow the reactor to be run again.
+    atomic_store_explicit(&reactor->stopping, false, memory_order_relaxed);
+    return result;
+}
+
+void mu_thunk_reactor_stop(mu_thunk_reactor_t *reactor) {
+    if (reactor == NULL) {
+        return;
+    }
+    atomic_store_explicit(&reactor->stopping, true, memory_order_release);
+    wake(reactor);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool control(mu_thunk_reactor_t *reactor, int op, int fd,
+                    uint32_t events, mu_thunk_t *thunk) {
+    if (reactor == NULL || thunk == NULL) {
+        errno = EINVAL;
+        return false;
+    }
+    struct epoll_event ev = {.events = events, .data.ptr = thunk};
+    return epoll_ctl(reactor->epoll_fd, op, fd, &ev) == 0;
+}
+
+static void wake(mu_thunk_reactor_t *reactor) {
+    // Only the first poster since the loop last woke pays for the syscall.
+    if (!atomic_exchange_explicit(&reactor->wake_pending, true,
+                                  memory_order_seq_cst)) {
+        uint64_t one = 1;
+        ssize_t rc = write(reactor->wake_fd, &one, sizeof(one));
+        (void)rc; // EAGAIN means the counter is already non-zero.
+    }
+}
+
+static void consume_wake(mu_thunk_reactor_t *reactor) {
+    uint64_t count;
+    ssize_t rc = read(reactor->wake_fd, &count, sizeof(count));
+    (void)rc;
+    // Cleared before the posted queue is drained, so a post that races with
+    // the drain triggers a fresh wakeup rather than being stranded.
+    atomic_store_explicit(&reactor->wake_pending, false, memory_order_seq_cst);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,178 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_ring.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+// (none)
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool is_power_of_two(size_t n);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_ring_t *mu_thunk_ring_init(mu_thunk_ring_t *ring, mu_thunk_t **store,
+                                    size_t capacity) {
+    if (ring == NULL || store == NULL || !is_power_of_two(capacity)) {
+        return NULL;
+    }
+    ring->store = store;
+    ring->mask = capacity - 1;
+    return mu_thunk_ring_reset(ring);
+}
+
+mu_thunk_ring_t *mu_thunk_ring_reset(mu_thunk_ring_t *ring) {
+    if (ring == NULL) {
+        return NULL;
+    }
+    atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, 0, memory_order_relaxed);
+    ring->tail_cache = 0;
+    ring->head_cache = 0;
+    return ring;
+}
+
+size_t mu_thunk_ring_capacity(const mu_thunk_ring_t *ring) {
+    return ring == NULL ? 0 : ring->mask + 1;
+}
+
+size_t mu_thunk_ring_count(mu_thunk_ring_t *ring) {
+    if (ring == NULL) {
+        return 0;
+    }
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    return tail - head;
+}
+
+bool mu_thunk_ring_is_empty(mu_thunk_ring_t *ring) {
+    return mu_thunk_ring_count(ring) == 0;
+}
+
+bool mu_thunk_ring_put(mu_thunk_ring_t *ring, mu_thunk_t *thunk) {
+    if (ring == NULL || thunk == NULL) {
+        return false;
+    }
+    // Only the producer writes tail, so a relaxed load sees our own value.
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (tail - ring->head_cache > ring->mask) {
+        // Looks full: refresh our view of the consumer.
+        ring->head_cache =
+            atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (tail - ring->head_cache > ring->mask) {
+            return false;
+        }
+    }
+    ring->store[tail & ring->mask] = thunk;
+    // Publish the slot contents before the new tail.
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+mu_thunk_t *mu_thunk_ring_get(mu_thunk_ring_t *ring) {
+    if (ring == NULL) {
+        return NULL;
+    }
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head == ring->tail_cache) {
+        // Looks empty: refresh our view of the producer.
+        ring->tail_cache =
+            atomic_load_explicit(&ring->tail, memory_order_acquire);
+        if (head == ring->tail_cache) {
+            return NULL;
+        }
+    }
+    mu_thunk_t *thunk = ring->store[head & ring->mask];
+    // Release the slot back to the producer only after we've read it.
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return thunk;
+}
+
+size_t mu_thunk_ring_get_batch(mu_thunk_ring_t *ring, mu_thunk_t **out,
+                               size_t max) {
+    if (ring == NULL || out == NULL) {
+        return 0;
+    }
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (ring->tail_cache - head < max) {
+        ring->tail_cache =
+            atomic_load_explicit(&ring->tail, memory_order_acquire);
+    }
+    size_t n = ring->tail_cache - head;
+    if (n > max) {
+        n = max;
+    }
+    for (size_t i = 0; i < n; i++) {
+        out[i] = ring->store[(head + i) & ring->mask];
+    }
+    atomic_store_explicit(&ring->head, head + n, memory_order_release);
+    return n;
+}
+
+size_t mu_thunk_ring_drain(mu_thunk_ring_t *ring, void *args) {
+    if (ring == NULL) {
+        return 0;
+    }
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    ring->tail_cache = tail;
+    size_t n = 0;
+    for (;;) {
+        // Re-read head every time: a thunk may itself have taken entries
+        // from this ring, possibly past the tail we started with.
+        size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        if ((ptrdiff_t)(tail - head) <= 0) {
+            return n;
+        }
+        mu_thunk_t *thunk = ring->store[head & ring->mask];
+        atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+        _mu_thunk_call(thunk, args);
+        n++;
+    }
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool is_power_of_two(size_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+// *****************************************************************************
+// End of file
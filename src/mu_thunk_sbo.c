@@ -0,0 +1,165 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_sbo.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+_Static_assert(MU_THUNK_SBO_SIZE > 0 && MU_THUNK_SBO_SIZE % 16 == 0,
+               "MU_THUNK_SBO_SIZE must be a positive multiple of 16");
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool payload_ok(mu_thunk_fn fn, const void *payload, size_t size);
+static void fill(mu_thunk_sbo_t *sbo, mu_thunk_fn fn, const void *payload,
+                 size_t size);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_sbo_t *mu_thunk_sbo_init(mu_thunk_sbo_t *sbo, mu_thunk_fn fn,
+                                  const void *payload, size_t size) {
+    if (sbo == NULL || !payload_ok(fn, payload, size)) {
+        return NULL;
+    }
+    fill(sbo, fn, payload, size);
+    return sbo;
+}
+
+void mu_thunk_sbo_call(mu_thunk_sbo_t *sbo) {
+    if (sbo == NULL || sbo->thunk.fn == NULL) {
+        return;
+    }
+    _mu_thunk_call(&sbo->thunk, sbo->payload);
+}
+
+mu_thunk_sbo_ring_t *mu_thunk_sbo_ring_init(mu_thunk_sbo_ring_t *ring,
+                                            mu_thunk_sbo_t *store,
+                                            size_t capacity) {
+    if (ring == NULL || store == NULL || capacity == 0 ||
+        (capacity & (capacity - 1)) != 0) {
+        return NULL;
+    }
+    ring->store = store;
+    ring->mask = capacity - 1;
+    atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, 0, memory_order_relaxed);
+    ring->tail_cache = 0;
+    ring->next = 0;
+    ring->depth = 0;
+    ring->head_cache = 0;
+    return ring;
+}
+
+size_t mu_thunk_sbo_ring_count(mu_thunk_sbo_ring_t *ring) {
+    if (ring == NULL) {
+        return 0;
+    }
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    return tail - head;
+}
+
+bool mu_thunk_sbo_ring_put(mu_thunk_sbo_ring_t *ring, mu_thunk_fn fn,
+                           const void *payload, size_t size) {
+    if (ring == NULL || !payload_ok(fn, payload, size)) {
+        return false;
+    }
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (tail - ring->head_cache > ring->mask) {
+        // Looks full: refresh our view of the consumer.
+        ring->head_cache =
+            atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (tail - ring->head_cache > ring->mask) {
+            return false;
+        }
+    }
+    fill(&ring->store[tail & ring->mask], fn, payload, size);
+    // Publish the slot contents before the new tail.
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+size_t mu_thunk_sbo_ring_drain(mu_thunk_sbo_ring_t *ring) {
+    if (ring == NULL) {
+        return 0;
+    }
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    ring->tail_cache = tail;
+    size_t n = 0;
+    for (;;) {
+        // Re-read `next` every time: a thunk may itself have drained this
+        // ring, possibly past the tail we started with.
+        size_t i = ring->next;
+        if ((ptrdiff_t)(tail - i) <= 0) {
+            return n;
+        }
+        ring->next = i + 1;
+        mu_thunk_sbo_t *slot = &ring->store[i & ring->mask];
+        ring->depth++;
+        _mu_thunk_call(&slot->thunk, slot->payload);
+        // Unlike mu_thunk_ring, the slot holds the args: release it only
+        // once the thunk is done with them, and a nested drain's slots
+        // only with the enclosing thunk's.
+        if (--ring->depth == 0) {
+            atomic_store_explicit(&ring->head, ring->next,
+                                  memory_order_release);
+        }
+        n++;
+    }
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool payload_ok(mu_thunk_fn fn, const void *payload, size_t size) {
+    return fn != NULL && size <= MU_THUNK_SBO_SIZE &&
+           (payload != NULL || size == 0);
+}
+
+static void fill(mu_thunk_sbo_t *sbo, mu_thunk_fn fn, const void *payload,
+                 size_t size) {
+    sbo->thunk.fn = fn;
+    sbo->size = (uint32_t)size;
+    if (size > 0) {
+        memcpy(sbo->payload, payload, size);
+    }
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,211 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_slab.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+/**
+ * Occupies the first cache line of every chunk.  Chunks are aligned to
+ * their size, so an object's owner is found by masking its address.
+ */
+typedef struct _chunk_header {
+    mu_thunk_slab_cache_t *owner;
+    struct _chunk_header *next;
+} chunk_header_t;
+
+_Static_assert((MU_THUNK_SLAB_CHUNK_SIZE & (MU_THUNK_SLAB_CHUNK_SIZE - 1)) ==
+                   0,
+               "MU_THUNK_SLAB_CHUNK_SIZE must be a power of two");
+_Static_assert(sizeof(chunk_header_t) <= MU_THUNK_CACHE_LINE,
+               "chunk header must fit in one cache line");
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static chunk_header_t *chunk_of(void *obj);
+static bool new_chunk(mu_thunk_slab_cache_t *cache);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_slab_t *mu_thunk_slab_init(mu_thunk_slab_t *slab,
+                                    size_t object_size) {
+    if (slab == NULL || object_size == 0) {
+        return NULL;
+    }
+    size_t rounded = (object_size + MU_THUNK_CACHE_LINE - 1) &
+                     ~(size_t)(MU_THUNK_CACHE_LINE - 1);
+    if (rounded > MU_THUNK_SLAB_CHUNK_SIZE - MU_THUNK_CACHE_LINE) {
+        return NULL;
+    }
+    slab->object_size = rounded;
+    atomic_init(&slab->chunks, NULL);
+    return slab;
+}
+
+void mu_thunk_slab_deinit(mu_thunk_slab_t *slab) {
+    if (slab == NULL) {
+        return;
+    }
+    chunk_header_t *chunk = atomic_exchange_explicit(&slab->chunks, NULL,
+                                                     memory_order_acquire);
+    while (chunk != NULL) {
+        chunk_header_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+}
+
+size_t mu_thunk_slab_object_size(const mu_thunk_slab_t *slab) {
+    return slab == NULL ? 0 : slab->object_size;
+}
+
+mu_thunk_slab_cache_t *mu_thunk_slab_cache_init(mu_thunk_slab_cache_t *cache,
+                                                mu_thunk_slab_t *slab) {
+    if (cache == NULL || slab == NULL) {
+        return NULL;
+    }
+    atomic_init(&cache->remote, NULL);
+    cache->slab = slab;
+    cache->free_list = NULL;
+    cache->bump = NULL;
+    cache->bump_end = NULL;
+    cache->batch_owner = NULL;
+    cache->batch_head = NULL;
+    cache->batch_tail = NULL;
+    cache->batch_count = 0;
+    return cache;
+}
+
+void *mu_thunk_slab_alloc(mu_thunk_slab_cache_t *cache) {
+    if (cache == NULL) {
+        return NULL;
+    }
+    mu_thunk_slab_free_t *obj = cache->free_list;
+    if (obj == NULL &&
+        atomic_load_explicit(&cache->remote, memory_order_relaxed) != NULL) {
+        // Take back everything other threads have returned in one go.
+        obj = atomic_exchange_explicit(&cache->remote, NULL,
+                                       memory_order_acquire);
+    }
+    if (obj != NULL) {
+        cache->free_list = obj->next;
+        return obj;
+    }
+    size_t size = cache->slab->object_size;
+    if ((size_t)(cache->bump_end - cache->bump) < size && !new_chunk(cache)) {
+        return NULL;
+    }
+    void *fresh = cache->bump;
+    cache->bump += size;
+    return fresh;
+}
+
+void mu_thunk_slab_free(mu_thunk_slab_cache_t *cache, void *obj) {
+    if (cache == NULL || obj == NULL) {
+        return;
+    }
+    mu_thunk_slab_free_t *node = (mu_thunk_slab_free_t *)obj;
+    mu_thunk_slab_cache_t *owner = chunk_of(obj)->owner;
+    if (owner == cache) {
+        node->next = cache->free_list;
+        cache->free_list = node;
+        return;
+    }
+    if (cache->batch_owner != owner) {
+        mu_thunk_slab_cache_flush(cache);
+        cache->batch_owner = owner;
+    }
+    node->next = cache->batch_head;
+    cache->batch_head = node;
+    if (cache->batch_tail == NULL) {
+        cache->batch_tail = node;
+    }
+    if (++cache->batch_count >= MU_THUNK_SLAB_BATCH) {
+        mu_thunk_slab_cache_flush(cache);
+    }
+}
+
+void mu_thunk_slab_cache_flush(mu_thunk_slab_cache_t *cache) {
+    if (cache == NULL || cache->batch_count == 0) {
+        return;
+    }
+    // Push the whole batch onto the owner's return stack.  The owner only
+    // ever exchanges the stack with NULL, so there is no ABA hazard.
+    mu_thunk_slab_cache_t *owner = cache->batch_owner;
+    mu_thunk_slab_free_t *old =
+        atomic_load_explicit(&owner->remote, memory_order_relaxed);
+    do {
+        cache->batch_tail->next = old;
+    } while (!atomic_compare_exchange_weak_explicit(
+        &owner->remote, &old, cache->batch_head, memory_order_release,
+        memory_order_relaxed));
+    cache->batch_owner = NULL;
+    cache->batch_head = NULL;
+    cache->batch_tail = NULL;
+    cache->batch_count = 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static chunk_header_t *chunk_of(void *obj) {
+    return (chunk_header_t *)((uintptr_t)obj &
+                              ~(uintptr_t)(MU_THUNK_SLAB_CHUNK_SIZE - 1));
+}
+
+static bool new_chunk(mu_thunk_slab_cache_t *cache) {
+    chunk_header_t *chunk =
+        aligned_alloc(MU_THUNK_SLAB_CHUNK_SIZE, MU_THUNK_SLAB_CHUNK_SIZE);
+    if (chunk == NULL) {
+        return false;
+    }
+    chunk->owner = cache;
+    void *head = atomic_load_explicit(&cache->slab->chunks,
+                                      memory_order_relaxed);
+    do {
+        chunk->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(
+        &cache->slab->chunks, &head, chunk, memory_order_release,
+        memory_order_relaxed));
+    // The tail of the previous chunk (less than one object) is abandoned.
+    cache->bump = (char *)chunk + MU_THUNK_CACHE_LINE;
+    cache->bump_end = (char *)chunk + MU_THUNK_SLAB_CHUNK_SIZE;
+    return true;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,402 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_stats.h"
+#include "mu_thunk_atomic.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+_Static_assert((MU_THUNK_STATS_MAX_FNS & (MU_THUNK_STATS_MAX_FNS - 1)) == 0,
+               "MU_THUNK_STATS_MAX_FNS must be a power of two");
+_Static_assert(MU_THUNK_STATS_RANGE_BITS < 64 &&
+                   MU_THUNK_STATS_SUB_BITS < MU_THUNK_STATS_RANGE_BITS,
+               "bad MU_THUNK_STATS_RANGE_BITS / SUB_BITS");
+
+/**
+ * One function's counters in one thread's table.  Only the owning thread
+ * writes them; atomics make concurrent snapshots well defined.
+ */
+typedef struct {
+    MU_THUNK_ATOMIC(mu_thunk_fn) fn;
+    MU_THUNK_ATOMIC(uint64_t) count;
+    MU_THUNK_ATOMIC(uint64_t) total_ns;
+    MU_THUNK_ATOMIC(uint64_t) max_ns;
+    MU_THUNK_ATOMIC(uint64_t) buckets[MU_THUNK_STATS_BUCKETS];
+} slot_t;
+
+/**
+ * A thread's open-addressed table, keyed by function pointer.  When its
+ * thread exits the table goes on a free list, counts intact, and the next
+ * new thread adopts it, so the number of tables is bounded by the peak
+ * number of recording threads rather than by every thread ever started.
+ */
+typedef struct _table {
+    struct _table *next;      /**< Every table, for snapshots */
+    struct _table *next_free; /**< Free list link while unowned */
+    MU_THUNK_ATOMIC(uint64_t) dropped;
+    slot_t slots[MU_THUNK_STATS_MAX_FNS];
+} table_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+/** Every table ever created; tables are never unlinked or freed. */
+static MU_THUNK_ATOMIC(table_t *) s_tables;
+
+/** Tables whose threads have exited, awaiting a new owner. */
+static table_t *s_free_tables;
+static pthread_mutex_t s_free_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/** Runs release_table() on thread exit. */
+static pthread_key_t s_table_key;
+static pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
+
+static _Thread_local table_t *tls_table;
+
+#if defined(__x86_64__)
+/** Nanoseconds per TSC tick in 32.32 fixed point, set by calibrate(). */
+static uint64_t s_ns_per_tick;
+static pthread_once_t s_calibrate_once = PTHREAD_ONCE_INIT;
+#endif
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static uint64_t now_ns(void);
+static uint64_t timestamp(void);
+static uint64_t elapsed_ns(uint64_t start, uint64_t end);
+static table_t *thread_table(void);
+static void record(table_t *table, mu_thunk_fn fn, uint64_t elapsed);
+static void make_key(void);
+static void release_table(void *arg);
+static slot_t *find_slot(table_t *table, mu_thunk_fn fn);
+static void bump(MU_THUNK_ATOMIC(uint64_t) * counter, uint64_t delta);
+static uint64_t load(MU_THUNK_ATOMIC(uint64_t) * counter);
+static mu_thunk_stats_entry_t *entry_for(mu_thunk_stats_snapshot_t *snap,
+                                         mu_thunk_fn fn);
+
+// *****************************************************************************
+// Public code
+
+void mu_thunk_stats_call(mu_thunk_t *thunk, void *args) {
+    mu_thunk_fn fn = thunk->fn;
+    table_t *table = thread_table();
+    uint64_t start = timestamp();
+    // Call fn directly: _mu_thunk_call() would recurse here.
+    fn(thunk, args);
+    uint64_t end = timestamp();
+    record(table, fn, elapsed_ns(start, end));
+}
+
+void mu_thunk_stats_compact_call(mu_thunk_compact_fn fn,
+                                 mu_thunk_compact_t *thunk, void *args) {
+    table_t *table = thread_table();
+    uint64_t start = timestamp();
+    fn(thunk, args);
+    uint64_t end = timestamp();
+    // The converted pointer is only a key; it is never called.
+    record(table, (mu_thunk_fn)fn, elapsed_ns(start, end));
+}
+
+void mu_thunk_stats_snapshot(mu_thunk_stats_snapshot_t *snap) {
+    if (snap == NULL) {
+        return;
+    }
+    snap->n_entries = 0;
+    snap->dropped = 0;
+    table_t *table = atomic_load_explicit(&s_tables, memory_order_acquire);
+    for (; table != NULL; table = table->next) {
+        snap->dropped += load(&table->dropped);
+        for (size_t i = 0; i < MU_THUNK_STATS_MAX_FNS; i++) {
+            slot_t *slot = &table->slots[i];
+            mu_thunk_fn fn =
+                atomic_load_explicit(&slot->fn, memory_order_acquire);
+            if (fn == NULL) {
+                continue;
+            }
+            mu_thunk_stats_entry_t *entry = entry_for(snap, fn);
+            if (entry == NULL) {
+                snap->dropped += load(&slot->count);
+                continue;
+            }
+            entry->count += load(&slot->count);
+            entry->total_ns += load(&slot->total_ns);
+            uint64_t max = load(&slot->max_ns);
+            if (max > entry->max_ns) {
+                entry->max_ns = max;
+            }
+            for (size_t b = 0; b < MU_THUNK_STATS_BUCKETS; b++) {
+                entry->buckets[b] += load(&slot->buckets[b]);
+            }
+        }
+    }
+}
+
+void mu_thunk_stats_merge(mu_thunk_stats_snapshot_t *dst,
+                          const mu_thunk_stats_snapshot_t *src) {
+    if (dst == NULL || src == NULL) {
+        return;
+    }
+    dst->dropped += src->dropped;
+    for (size_t i = 0; i < src->n_entries; i++) {
+        const mu_thunk_stats_entry_t *from = &src->entries[i];
+        mu_thunk_stats_entry_t *to = entry_for(dst, from->fn);
+        if (to == NULL) {
+            dst->dropped += from->count;
+            continue;
+        }
+        to->count += from->count;
+        to->total_ns += from->total_ns;
+        if (from->max_ns > to->max_ns) {
+            to->max_ns = from->max_ns;
+        }
+        for (size_t b = 0; b < MU_THUNK_STATS_BUCKETS; b++) {
+            to->buckets[b] += from->buckets[b];
+        }
+    }
+}
+
+const mu_thunk_stats_entry_t *
+mu_thunk_stats_find(const mu_thunk_stats_snapshot_t *snap, mu_thunk_fn fn) {
+    if (snap == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < snap->n_entries; i++) {
+        if (snap->entries[i].fn == fn) {
+            return &snap->entries[i];
+        }
+    }
+    return NULL;
+}
+
+uint64_t mu_thunk_stats_percentile(const mu_thunk_stats_entry_t *entry,
+                                   double p) {
+    if (entry == NULL || entry->count == 0) {
+        return 0;
+    }
+    if (p < 0) {
+        p = 0;
+    } else if (p > 100) {
+        p = 100;
+    }
+    // Nearest rank: the smallest bucket with at least `rank` calls at or
+    // below it.
+    uint64_t rank = (uint64_t)(p / 100.0 * (double)entry->count + 0.999999);
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t b = 0; b < MU_THUNK_STATS_BUCKETS; b++) {
+        seen += entry->buckets[b];
+        if (seen >= rank) {
+            uint64_t upper = b + 1 < MU_THUNK_STATS_BUCKETS
+                                 ? mu_thunk_stats_bucket_floor(b + 1) - 1
+                                 : entry->max_ns;
+            return upper < entry->max_ns ? upper : entry->max_ns;
+        }
+    }
+    return entry->max_ns;
+}
+
+size_t mu_thunk_stats_bucket(uint64_t ns) {
+    const unsigned sub = MU_THUNK_STATS_SUB_BITS;
+    if (ns >= (1ull << MU_THUNK_STATS_RANGE_BITS)) {
+        return MU_THUNK_STATS_BUCKETS - 1;
+    }
+    if (ns < (1ull << sub)) {
+        return (size_t)ns;
+    }
+    unsigned e = 63 - (unsigned)__builtin_clzll(ns);
+    return ((size_t)(e - sub + 1) << sub) +
+           (size_t)((ns >> (e - sub)) - (1ull << sub));
+}
+
+uint64_t mu_thunk_stats_bucket_floor(size_t index) {
+    const unsigned sub = MU_THUNK_STATS_SUB_BITS;
+    if (index < (1u << sub)) {
+        return index;
+    }
+    unsigned e = (unsigned)(index >> sub) + sub - 1;
+    uint64_t mantissa = (1ull << sub) + (index & ((1u << sub) - 1));
+    return mantissa << (e - sub);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+#if defined(__x86_64__)
+// clock_gettime() costs tens of ns even through the vDSO, which would
+// dominate short thunks, so time with the TSC and convert.  Assumes an
+// invariant TSC, which every x86-64 CPU of the last decade provides.
+static void calibrate(void) {
+    uint64_t t0 = now_ns();
+    uint64_t c0 = __rdtsc();
+    while (now_ns() - t0 < 2000000) {
+    }
+    uint64_t t1 = now_ns();
+    uint64_t c1 = __rdtsc();
+    s_ns_per_tick = c1 > c0 ? ((t1 - t0) << 32) / (c1 - c0) : 1ull << 32;
+}
+
+static uint64_t timestamp(void) { return __rdtsc(); }
+
+static uint64_t elapsed_ns(uint64_t start, uint64_t end) {
+    return (uint64_t)(((unsigned __int128)(end - start) * s_ns_per_tick) >>
+                      32);
+}
+#else
+static uint64_t timestamp(void) { return now_ns(); }
+
+static uint64_t elapsed_ns(uint64_t start, uint64_t end) {
+    return end - start;
+}
+#endif
+
+static table_t *thread_table(void) {
+    table_t *table = tls_table;
+    if (table != NULL) {
+        return table;
+    }
+#if defined(__x86_64__)
+    pthread_once(&s_calibrate_once, calibrate);
+#endif
+    pthread_once(&s_key_once, make_key);
+    // The mutex orders the previous owner's last writes before ours.
+    pthread_mutex_lock(&s_free_lock);
+    table = s_free_tables;
+    if (table != NULL) {
+        s_free_tables = table->next_free;
+    }
+    pthread_mutex_unlock(&s_free_lock);
+    if (table == NULL) {
+        table = calloc(1, sizeof(table_t));
+        if (table == NULL) {
+            return NULL;
+        }
+        table_t *head = atomic_load_explicit(&s_tables, memory_order_relaxed);
+        do {
+            table->next = head;
+        } while (!atomic_compare_exchange_weak_explicit(
+            &s_tables, &head, table, memory_order_release,
+            memory_order_relaxed));
+    }
+    tls_table = table;
+    pthread_setspecific(s_table_key, table);
+    return table;
+}
+
+static void make_key(void) { pthread_key_create(&s_table_key, release_table); }
+
+static void release_table(void *arg) {
+    table_t *table = (table_t *)arg;
+    // A later destructor that dispatches a thunk gets a fresh table (and
+    // pthreads calls us again for it) rather than writing to this one.
+    tls_table = NULL;
+    pthread_mutex_lock(&s_free_lock);
+    table->next_free = s_free_tables;
+    s_free_tables = table;
+    pthread_mutex_unlock(&s_free_lock);
+}
+
+static void record(table_t *table, mu_thunk_fn fn, uint64_t elapsed) {
+    if (table == NULL) {
+        return;
+    }
+    slot_t *slot = find_slot(table, fn);
+    if (slot == NULL) {
+        bump(&table->dropped, 1);
+        return;
+    }
+    bump(&slot->count, 1);
+    bump(&slot->total_ns, elapsed);
+    bump(&slot->buckets[mu_thunk_stats_bucket(elapsed)], 1);
+    if (elapsed > load(&slot->max_ns)) {
+        atomic_store_explicit(&slot->max_ns, elapsed, memory_order_relaxed);
+    }
+}
+
+static slot_t *find_slot(table_t *table, mu_thunk_fn fn) {
+    uintptr_t key = (uintptr_t)fn;
+    size_t i = (size_t)((key >> 4) * 0x9e3779b97f4a7c15ull >> 32);
+    for (size_t probe = 0; probe < MU_THUNK_STATS_MAX_FNS; probe++, i++) {
+        slot_t *slot = &table->slots[i & (MU_THUNK_STATS_MAX_FNS - 1)];
+        mu_thunk_fn found =
+            atomic_load_explicit(&slot->fn, memory_order_relaxed);
+        if (found == fn) {
+            return slot;
+        }
+        if (found == NULL) {
+            // Only this thread inserts, so the slot is ours to claim.
+            atomic_store_explicit(&slot->fn, fn, memory_order_release);
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+static void bump(MU_THUNK_ATOMIC(uint64_t) * counter, uint64_t delta) {
+    // Single writer: a relaxed load and store, not an atomic add.
+    atomic_store_explicit(counter, load(counter) + delta,
+                          memory_order_relaxed);
+}
+
+static uint64_t load(MU_THUNK_ATOMIC(uint64_t) * counter) {
+    return atomic_load_explicit(counter, memory_order_relaxed);
+}
+
+static mu_thunk_stats_entry_t *entry_for(mu_thunk_stats_snapshot_t *snap,
+                                         mu_thunk_fn fn) {
+    for (size_t i = 0; i < snap->n_entries; i++) {
+        if (snap->entries[i].fn == fn) {
+            return &snap->entries[i];
+        }
+    }
+    if (snap->n_entries == MU_THUNK_STATS_MAX_FNS) {
+        return NULL;
+    }
+    mu_thunk_stats_entry_t *entry = &snap->entries[snap->n_entries++];
+    memset(entry, 0, sizeof(*entry));
+    entry->fn = fn;
+    return entry;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,287 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_task.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#if !defined(__x86_64__) && !defined(__aarch64__)
+#error "mu_thunk_task supports x86-64 and AArch64 only"
+#endif
+
+_Static_assert(MU_THUNK_TASK_MIN_STACK >= 256,
+               "MU_THUNK_TASK_MIN_STACK is too small for the initial frame");
+
+/**
+ * Save the callee-saved registers on the current stack, store the stack
+ * pointer in `*save_sp`, switch to `load_sp` and restore the registers saved
+ * there.  Returns on the other stack.
+ */
+void _mu_thunk_task_switch(void **save_sp, void *load_sp)
+    __attribute__((visibility("hidden")));
+
+/**
+ * First code run on a new task stack, reached by the initial switch's
+ * return: calls task_main(task) with both taken from callee-saved registers
+ * of the initial frame.
+ */
+void _mu_thunk_task_entry(void) __attribute__((visibility("hidden")));
+
+#if defined(__x86_64__)
+
+// Frame: r15 r14 r13 r12 rbx rbp, then the return address.  Popping it
+// leaves rsp 16 below the top, 16-byte aligned.
+#define FRAME_PAD 16
+#define FRAME_WORDS 7
+#define FRAME_FN 2   // r13
+#define FRAME_TASK 3 // r12
+#define FRAME_RET 6
+
+__asm__(".text\n"
+        ".globl _mu_thunk_task_switch\n"
+        ".hidden _mu_thunk_task_switch\n"
+        ".type _mu_thunk_task_switch, @function\n"
+        "_mu_thunk_task_switch:\n"
+        "    pushq %rbp\n"
+        "    pushq %rbx\n"
+        "    pushq %r12\n"
+        "    pushq %r13\n"
+        "    pushq %r14\n"
+        "    pushq %r15\n"
+        "    movq %rsp, (%rdi)\n"
+        "    movq %rsi, %rsp\n"
+        "    popq %r15\n"
+        "    popq %r14\n"
+        "    popq %r13\n"
+        "    popq %r12\n"
+        "    popq %rbx\n"
+        "    popq %rbp\n"
+        "    ret\n"
+        ".size _mu_thunk_task_switch, .-_mu_thunk_task_switch\n"
+        ".globl _mu_thunk_task_entry\n"
+        ".hidden _mu_thunk_task_entry\n"
+        ".type _mu_thunk_task_entry, @function\n"
+        "_mu_thunk_task_entry:\n"
+        "    movq %r12, %rdi\n"
+        "    callq *%r13\n"
+        "    ud2\n"
+        ".size _mu_thunk_task_entry, .-_mu_thunk_task_entry\n");
+
+#elif defined(__aarch64__)
+
+// Frame: x19..x28, x29 (fp), x30 (lr), d8..d15.  Popping it leaves sp at
+// the top.
+#define FRAME_PAD 0
+#define FRAME_WORDS 20
+#define FRAME_TASK 0 // x19
+#define FRAME_FN 1   // x20
+#define FRAME_RET 11 // x30
+
+__asm__(".text\n"
+        ".globl _mu_thunk_task_switch\n"
+        ".hidden _mu_thunk_task_switch\n"
+        ".type _mu_thunk_task_switch, %function\n"
+        "_mu_thunk_task_switch:\n"
+        "    sub sp, sp, #160\n"
+        "    stp x19, x20, [sp, #0]\n"
+        "    stp x21, x22, [sp, #16]\n"
+        "    stp x23, x24, [sp, #32]\n"
+        "    stp x25, x26, [sp, #48]\n"
+        "    stp x27, x28, [sp, #64]\n"
+        "    stp x29, x30, [sp, #80]\n"
+        "    stp d8, d9, [sp, #96]\n"
+        "    stp d10, d11, [sp, #112]\n"
+        "    stp d12, d13, [sp, #128]\n"
+        "    stp d14, d15, [sp, #144]\n"
+        "    mov x2, sp\n"
+        "    str x2, [x0]\n"
+        "    mov sp, x1\n"
+        "    ldp x19, x20, [sp, #0]\n"
+        "    ldp x21, x22, [sp, #16]\n"
+        "    ldp x23, x24, [sp, #32]\n"
+        "    ldp x25, x26, [sp, #48]\n"
+        "    ldp x27, x28, [sp, #64]\n"
+        "    ldp x29, x30, [sp, #80]\n"
+        "    ldp d8, d9, [sp, #96]\n"
+        "    ldp d10, d11, [sp, #112]\n"
+        "    ldp d12, d13, [sp, #128]\n"
+        "    ldp d14, d15, [sp, #144]\n"
+        "    add sp, sp, #160\n"
+        "    ret\n"
+        ".size _mu_thunk_task_switch, .-_mu_thunk_task_switch\n"
+        ".globl _mu_thunk_task_entry\n"
+        ".hidden _mu_thunk_task_entry\n"
+        ".type _mu_thunk_task_entry, %function\n"
+        "_mu_thunk_task_entry:\n"
+        "    mov x0, x19\n"
+        "    blr x20\n"
+        "    brk #0\n"
+        ".size _mu_thunk_task_entry, .-_mu_thunk_task_entry\n");
+
+#endif
+
+// *****************************************************************************
+// Private (static) storage
+
+static _Thread_local mu_thunk_task_t *s_current;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static size_t page_size(void);
+static void resume_fn(mu_thunk_t *thunk, void *args);
+static void task_main(mu_thunk_task_t *task);
+
+// *****************************************************************************
+// Public code
+
+void *mu_thunk_task_stack_alloc(size_t size) {
+    if (size == 0) {
+        return NULL;
+    }
+    size_t page = page_size();
+    size = (size + page - 1) & ~(page - 1);
+    char *base = mmap(NULL, size + page, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK | MAP_NORESERVE,
+                      -1, 0);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+    // Stacks grow down: the guard goes below the lowest usable page.
+    if (mprotect(base, page, PROT_NONE) != 0) {
+        munmap(base, size + page);
+        return NULL;
+    }
+    return base + page;
+}
+
+void mu_thunk_task_stack_free(void *stack, size_t size) {
+    if (stack == NULL || size == 0) {
+        return;
+    }
+    size_t page = page_size();
+    size = (size + page - 1) & ~(page - 1);
+    munmap((char *)stack - page, size + page);
+}
+
+mu_thunk_task_t *mu_thunk_task_init(mu_thunk_task_t *task, mu_thunk_fn body,
+                                    void *stack, size_t stack_size) {
+    if (task == NULL || body == NULL || stack == NULL ||
+        stack_size < MU_THUNK_TASK_MIN_STACK) {
+        return NULL;
+    }
+    // Build a frame that the first switch "returns" through into
+    // _mu_thunk_task_entry, with the stack 16-byte aligned as at a call.
+    uintptr_t top = ((uintptr_t)stack + stack_size) & ~(uintptr_t)15;
+    void **frame = (void **)(top - FRAME_PAD) - FRAME_WORDS;
+    for (int i = 0; i < FRAME_WORDS; i++) {
+        frame[i] = NULL;
+    }
+    frame[FRAME_TASK] = task;
+    frame[FRAME_FN] = (void *)task_main;
+    frame[FRAME_RET] = (void *)_mu_thunk_task_entry;
+    _mu_thunk_init(&task->thunk, resume_fn);
+    task->body = body;
+    task->sp = frame;
+    task->resumer_sp = NULL;
+    task->transfer = NULL;
+    task->prev = NULL;
+    task->state = MU_THUNK_TASK_READY;
+    return task;
+}
+
+void mu_thunk_task_resume(mu_thunk_task_t *task, void *args) {
+    if (task == NULL) {
+        return;
+    }
+    resume_fn(&task->thunk, args);
+}
+
+void *mu_thunk_task_yield(void) {
+    mu_thunk_task_t *task = s_current;
+    if (task == NULL) {
+        return NULL;
+    }
+    task->state = MU_THUNK_TASK_SUSPENDED;
+    _mu_thunk_task_switch(&task->sp, task->resumer_sp);
+    // Resumed, possibly on another thread: only `task` is trusted here.
+    return task->transfer;
+}
+
+mu_thunk_task_t *mu_thunk_task_current(void) {
+    return s_current;
+}
+
+mu_thunk_task_state_t mu_thunk_task_state(const mu_thunk_task_t *task) {
+    return task == NULL ? MU_THUNK_TASK_DONE : task->state;
+}
+
+bool mu_thunk_task_is_done(const mu_thunk_task_t *task) {
+    return mu_thunk_task_state(task) == MU_THUNK_TASK_DONE;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static size_t page_size(void) {
+    static size_t s_page;
+    if (s_page == 0) {
+        s_page = (size_t)sysconf(_SC_PAGESIZE);
+    }
+    return s_page;
+}
+
+static void resume_fn(mu_thunk_t *thunk, void *args) {
+    mu_thunk_task_t *task = (mu_thunk_task_t *)thunk;
+    if (task->state != MU_THUNK_TASK_READY &&
+        task->state != MU_THUNK_TASK_SUSPENDED) {
+        return;
+    }
+    task->transfer = args;
+    task->prev = s_current;
+    task->state = MU_THUNK_TASK_RUNNING;
+    s_current = task;
+    _mu_thunk_task_switch(&task->resumer_sp, task->sp);
+    // Back from a yield or from the end of the body.
+    s_current = task->prev;
+}
+
+static void task_main(mu_thunk_task_t *task) {
+    task->body(&task->thunk, task->transfer);
+    task->state = MU_THUNK_TASK_DONE;
+    _mu_thunk_task_switch(&task->sp, task->resumer_sp);
+    __builtin_unreachable();
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,414 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // dladdr, pthread_getname_np
+#endif
+
+#include "mu_thunk_trace.h"
+#include "mu_thunk_atomic.h"
+#ifdef MU_THUNK_STATS
+#include "mu_thunk_stats.h"
+#endif
+#include <dlfcn.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+_Static_assert((MU_THUNK_TRACE_RING_SIZE & (MU_THUNK_TRACE_RING_SIZE - 1)) ==
+                   0,
+               "MU_THUNK_TRACE_RING_SIZE must be a power of two");
+
+#define RING_MASK (MU_THUNK_TRACE_RING_SIZE - 1)
+
+/** Distinct functions named per flush; further ones are left unnamed. */
+#define NAME_CACHE_SIZE 256
+
+/** A complete event.  Fields are atomics so a concurrent flush is defined. */
+typedef struct {
+    MU_THUNK_ATOMIC(uintptr_t) fn;
+    MU_THUNK_ATOMIC(uint64_t) start_ns;
+    MU_THUNK_ATOMIC(uint64_t) dur_ns;
+} event_t;
+
+/**
+ * One thread's ring.  The owner bumps `claimed` before overwriting a slot
+ * and publishes it by storing `head`; a flush copies [tail, head) and then
+ * discards anything `claimed` shows may have been overwritten meanwhile.
+ * When its thread exits the ring goes on a free list; once flushed empty
+ * it is handed to the next new thread, so the number of rings is bounded
+ * by the peak number of tracing threads.
+ */
+typedef struct _ring {
+    struct _ring *next;      /**< Every ring, for flushes */
+    struct _ring *next_free; /**< Guarded by s_flush_lock */
+    long tid;                /**< Guarded by s_flush_lock once published */
+    char name[16];           /**< Guarded by s_flush_lock once published */
+    MU_THUNK_CACHE_ALIGNED MU_THUNK_ATOMIC(uint64_t) claimed;
+    MU_THUNK_ATOMIC(uint64_t) head;
+    MU_THUNK_CACHE_ALIGNED uint64_t tail; /**< Guarded by s_flush_lock */
+    event_t events[MU_THUNK_TRACE_RING_SIZE];
+} ring_t;
+
+/** An event as copied out of a ring by a flush. */
+typedef struct {
+    uintptr_t fn;
+    uint64_t start_ns;
+    uint64_t dur_ns;
+} copied_event_t;
+
+typedef struct {
+    uintptr_t fn;
+    char name[96];
+} name_entry_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+/** Every ring ever created; rings are never unlinked or freed. */
+static MU_THUNK_ATOMIC(ring_t *) s_rings;
+static MU_THUNK_ATOMIC(unsigned) s_sampling = MU_THUNK_TRACE_DEFAULT_SAMPLING;
+static pthread_mutex_t s_flush_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Guarded by s_flush_lock:
+static size_t s_dropped;
+static ring_t *s_free_rings; /**< Rings whose threads have exited */
+static copied_event_t s_copy[MU_THUNK_TRACE_RING_SIZE];
+static name_entry_t s_names[NAME_CACHE_SIZE];
+
+/** Runs release_ring() on thread exit. */
+static pthread_key_t s_ring_key;
+static pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
+
+static _Thread_local ring_t *tls_ring;
+static _Thread_local unsigned tls_countdown;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static uint64_t now_ns(void);
+static void dispatch(mu_thunk_t *thunk, void *args);
+static void dispatch_compact(mu_thunk_compact_fn fn, mu_thunk_compact_t *thunk,
+                             void *args);
+static ring_t *sampled_ring(void);
+static ring_t *thread_ring(void);
+static ring_t *adopt_ring(void);
+static void name_ring(ring_t *ring);
+static void make_key(void);
+static void release_ring(void *arg);
+static void record(ring_t *ring, uintptr_t fn, uint64_t start, uint64_t end);
+static const char *symbolize(uintptr_t fn);
+static void write_json_string(FILE *out, const char *s);
+
+// *****************************************************************************
+// Public code
+
+void mu_thunk_trace_call(mu_thunk_t *thunk, void *args) {
+    ring_t *ring = sampled_ring();
+    if (ring == NULL) {
+        dispatch(thunk, args);
+        return;
+    }
+    uintptr_t fn = (uintptr_t)thunk->fn;
+    uint64_t start = now_ns();
+    dispatch(thunk, args);
+    record(ring, fn, start, now_ns());
+}
+
+void mu_thunk_trace_compact_call(mu_thunk_compact_fn fn,
+                                 mu_thunk_compact_t *thunk, void *args) {
+    ring_t *ring = sampled_ring();
+    if (ring == NULL) {
+        dispatch_compact(fn, thunk, args);
+        return;
+    }
+    uint64_t start = now_ns();
+    dispatch_compact(fn, thunk, args);
+    record(ring, (uintptr_t)fn, start, now_ns());
+}
+
+void mu_thunk_trace_set_sampling(unsigned n) {
+    atomic_store_explicit(&s_sampling, n, memory_order_relaxed);
+}
+
+unsigned mu_thunk_trace_sampling(void) {
+    return atomic_load_explicit(&s_sampling, memory_order_relaxed);
+}
+
+size_t mu_thunk_trace_flush(FILE *out) {
+    if (out == NULL) {
+        return 0;
+    }
+    size_t written = 0;
+    bool first = true;
+    pid_t pid = getpid();
+    pthread_mutex_lock(&s_flush_lock);
+    memset(s_names, 0, sizeof(s_names));
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    ring_t *ring = atomic_load_explicit(&s_rings, memory_order_acquire);
+    for (; ring != NULL; ring = ring->next) {
+        fprintf(out,
+                "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+                "\"tid\":%ld,\"args\":{\"name\":",
+                first ? "" : ",", (int)pid, ring->tid);
+        write_json_string(out, ring->name);
+        fprintf(out, "}}");
+        first = false;
+
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint64_t from = ring->tail;
+        if (head - from > MU_THUNK_TRACE_RING_SIZE) {
+            from = head - MU_THUNK_TRACE_RING_SIZE;
+        }
+        for (uint64_t i = from; i < head; i++) {
+            event_t *src = &ring->events[i & RING_MASK];
+            copied_event_t *dst = &s_copy[i & RING_MASK];
+            dst->fn = atomic_load_explicit(&src->fn, memory_order_relaxed);
+            dst->start_ns =
+                atomic_load_explicit(&src->start_ns, memory_order_relaxed);
+            dst->dur_ns =
+                atomic_load_explicit(&src->dur_ns, memory_order_relaxed);
+        }
+        // Slots the writer claimed while we copied may hold newer events.
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t claimed =
+            atomic_load_explicit(&ring->claimed, memory_order_relaxed);
+        uint64_t valid = from;
+        if (claimed > MU_THUNK_TRACE_RING_SIZE &&
+            claimed - MU_THUNK_TRACE_RING_SIZE > valid) {
+            valid = claimed - MU_THUNK_TRACE_RING_SIZE;
+        }
+        if (valid > head) {
+            valid = head;
+        }
+        s_dropped += valid - ring->tail;
+        ring->tail = head;
+
+        for (uint64_t i = valid; i < head; i++) {
+            const copied_event_t *e = &s_copy[i & RING_MASK];
+            uintptr_t fn = e->fn;
+            uint64_t start = e->start_ns;
+            uint64_t dur = e->dur_ns;
+            fprintf(out, ",\n{\"name\":");
+            write_json_string(out, symbolize(fn));
+            fprintf(out,
+                    ",\"cat\":\"thunk\",\"ph\":\"X\",\"ts\":%" PRIu64
+                    ".%03u,\"dur\":%" PRIu64 ".%03u,\"pid\":%d,\"tid\":%ld,"
+                    "\"args\":{\"fn\":\"0x%" PRIxPTR "\"}}",
+                    start / 1000, (unsigned)(start % 1000), dur / 1000,
+                    (unsigned)(dur % 1000), (int)pid, ring->tid, fn);
+            written++;
+        }
+    }
+    fprintf(out, "\n]}\n");
+    fflush(out);
+    pthread_mutex_unlock(&s_flush_lock);
+    return written;
+}
+
+size_t mu_thunk_trace_dropped(void) {
+    pthread_mutex_lock(&s_flush_lock);
+    size_t dropped = s_dropped;
+    pthread_mutex_unlock(&s_flush_lock);
+    return dropped;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void dispatch(mu_thunk_t *thunk, void *args) {
+#ifdef MU_THUNK_STATS
+    mu_thunk_stats_call(thunk, args);
+#else
+    // Call fn directly: _mu_thunk_call() would recurse here.
+    thunk->fn(thunk, args);
+#endif
+}
+
+static void dispatch_compact(mu_thunk_compact_fn fn, mu_thunk_compact_t *thunk,
+                             void *args) {
+#ifdef MU_THUNK_STATS
+    mu_thunk_stats_compact_call(fn, thunk, args);
+#else
+    fn(thunk, args);
+#endif
+}
+
+/** The calling thread's ring if this call is sampled, else NULL. */
+static ring_t *sampled_ring(void) {
+    if (tls_countdown > 1) {
+        tls_countdown--;
+        return NULL;
+    }
+    unsigned sampling =
+        atomic_load_explicit(&s_sampling, memory_order_relaxed);
+    tls_countdown = sampling;
+    return sampling == 0 ? NULL : thread_ring();
+}
+
+static ring_t *thread_ring(void) {
+    ring_t *ring = tls_ring;
+    if (ring != NULL) {
+        return ring;
+    }
+    pthread_once(&s_key_once, make_key);
+    ring = adopt_ring();
+    if (ring == NULL) {
+        ring = calloc(1, sizeof(ring_t));
+        if (ring == NULL) {
+            return NULL;
+        }
+        name_ring(ring);
+        ring_t *head = atomic_load_explicit(&s_rings, memory_order_relaxed);
+        do {
+            ring->next = head;
+        } while (!atomic_compare_exchange_weak_explicit(
+            &s_rings, &head, ring, memory_order_release,
+            memory_order_relaxed));
+    }
+    tls_ring = ring;
+    pthread_setspecific(s_ring_key, ring);
+    return ring;
+}
+
+static ring_t *adopt_ring(void) {
+    // Only a ring with nothing left to flush may change hands: its events
+    // would otherwise be reported under the new thread's tid.
+    pthread_mutex_lock(&s_flush_lock);
+    ring_t **link = &s_free_rings;
+    while (*link != NULL &&
+           (*link)->tail !=
+               atomic_load_explicit(&(*link)->head, memory_order_relaxed)) {
+        link = &(*link)->next_free;
+    }
+    ring_t *ring = *link;
+    if (ring != NULL) {
+        *link = ring->next_free;
+        name_ring(ring);
+    }
+    pthread_mutex_unlock(&s_flush_lock);
+    return ring;
+}
+
+static void name_ring(ring_t *ring) {
+    ring->tid = (long)syscall(SYS_gettid);
+    if (pthread_getname_np(pthread_self(), ring->name, sizeof(ring->name)) !=
+        0) {
+        snprintf(ring->name, sizeof(ring->name), "thread %ld", ring->tid);
+    }
+}
+
+static void make_key(void) { pthread_key_create(&s_ring_key, release_ring); }
+
+static void release_ring(void *arg) {
+    ring_t *ring = (ring_t *)arg;
+    // A later destructor that dispatches a thunk gets a fresh ring (and
+    // pthreads calls us again for it) rather than writing to this one.
+    tls_ring = NULL;
+    pthread_mutex_lock(&s_flush_lock);
+    ring->next_free = s_free_rings;
+    s_free_rings = ring;
+    pthread_mutex_unlock(&s_flush_lock);
+}
+
+static void record(ring_t *ring, uintptr_t fn, uint64_t start, uint64_t end) {
+    uint64_t h = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    event_t *e = &ring->events[h & RING_MASK];
+    // Claim the slot before touching it (seqlock-style), then publish.
+    atomic_store_explicit(&ring->claimed, h + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&e->fn, fn, memory_order_relaxed);
+    atomic_store_explicit(&e->start_ns, start, memory_order_relaxed);
+    atomic_store_explicit(&e->dur_ns, end - start, memory_order_relaxed);
+    atomic_store_explicit(&ring->head, h + 1, memory_order_release);
+}
+
+static const char *symbolize(uintptr_t fn) {
+    static char scratch[96];
+    size_t i = (size_t)((fn >> 4) * 0x9e3779b97f4a7c15ull >> 56) %
+               NAME_CACHE_SIZE;
+    for (size_t probe = 0; probe < NAME_CACHE_SIZE; probe++) {
+        name_entry_t *entry = &s_names[(i + probe) % NAME_CACHE_SIZE];
+        if (entry->fn == fn) {
+            return entry->name;
+        }
+        if (entry->fn != 0) {
+            continue;
+        }
+        Dl_info info;
+        if (dladdr((void *)fn, &info) == 0) {
+            snprintf(entry->name, sizeof(entry->name), "0x%" PRIxPTR, fn);
+        } else if (info.dli_sname != NULL) {
+            snprintf(entry->name, sizeof(entry->name), "%s", info.dli_sname);
+        } else if (info.dli_fname != NULL) {
+            const char *base = strrchr(info.dli_fname, '/');
+            snprintf(entry->name, sizeof(entry->name), "%s+0x%" PRIxPTR,
+                     base != NULL ? base + 1 : info.dli_fname,
+                     fn - (uintptr_t)info.dli_fbase);
+        } else {
+            snprintf(entry->name, sizeof(entry->name), "0x%" PRIxPTR, fn);
+        }
+        entry->fn = fn;
+        return entry->name;
+    }
+    snprintf(scratch, sizeof(scratch), "0x%" PRIxPTR, fn);
+    return scratch;
+}
+
+static void write_json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s != '\0'; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+            fputc(c, out);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// *****************************************************************************
+// End of file
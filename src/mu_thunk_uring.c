@@ -0,0 +1,622 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_uring.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/io_uring.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define OP_INDEX(uring, op) ((unsigned)((op) - (uring)->ops))
+
+// Largest single transfer the fallback attempts, matching the kernel's own
+// MAX_RW_COUNT so a short count always fits in cqe->res.
+#define FALLBACK_MAX_RW (INT_MAX & ~4095)
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool native_init(mu_thunk_uring_t *uring, unsigned entries);
+static void native_deinit(mu_thunk_uring_t *uring);
+static int native_enter(mu_thunk_uring_t *uring, unsigned wait_nr);
+static int native_reap(mu_thunk_uring_t *uring);
+static bool fallback_init(mu_thunk_uring_t *uring, unsigned entries);
+static int fallback_submit(mu_thunk_uring_t *uring);
+static int fallback_run_once(mu_thunk_uring_t *uring, unsigned wait_nr);
+static void fallback_start(mu_thunk_uring_op_t *op);
+static void fallback_ready_fn(mu_thunk_t *thunk, void *args);
+static void fallback_complete(mu_thunk_uring_op_t *op, int res);
+static int fallback_perform(mu_thunk_uring_op_t *op, int *fd_out);
+static bool fixed_buffer_ok(const mu_thunk_uring_t *uring,
+                            const struct io_uring_sqe *sqe);
+static uint32_t fallback_wait_events(const mu_thunk_uring_op_t *op);
+static ssize_t fallback_rw(int fd, void *addr, size_t len, bool write_op);
+static struct io_uring_sqe *prep_rw(mu_thunk_uring_t *uring, uint8_t opcode,
+                                    int fd, const void *buf, unsigned len,
+                                    uint64_t offset, mu_thunk_t *thunk);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_uring_t *mu_thunk_uring_init(mu_thunk_uring_t *uring,
+                                      unsigned entries, unsigned flags) {
+    if (uring == NULL || entries == 0 || entries > MU_THUNK_URING_MAX_ENTRIES) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if ((flags & MU_THUNK_URING_FALLBACK) == 0 && native_init(uring, entries)) {
+        return uring;
+    }
+    return fallback_init(uring, entries) ? uring : NULL;
+}
+
+void mu_thunk_uring_deinit(mu_thunk_uring_t *uring) {
+    if (uring == NULL) {
+        return;
+    }
+    if (uring->native) {
+        native_deinit(uring);
+    } else {
+        mu_thunk_reactor_deinit(&uring->reactor);
+    }
+}
+
+bool mu_thunk_uring_is_native(const mu_thunk_uring_t *uring) {
+    return uring != NULL && uring->native;
+}
+
+bool mu_thunk_uring_register_buffers(mu_thunk_uring_t *uring,
+                                     const struct iovec *buffers,
+                                     unsigned n_buffers) {
+    if (uring == NULL || buffers == NULL || n_buffers == 0) {
+        errno = EINVAL;
+        return false;
+    }
+    if (uring->native) {
+        return syscall(__NR_io_uring_register, uring->ring_fd,
+                       IORING_REGISTER_BUFFERS, buffers, n_buffers) == 0;
+    }
+    uring->buffers = buffers;
+    uring->n_buffers = n_buffers;
+    return true;
+}
+
+bool mu_thunk_uring_register_files(mu_thunk_uring_t *uring, const int *fds,
+                                   unsigned n_fds) {
+    if (uring == NULL || fds == NULL || n_fds == 0) {
+        errno = EINVAL;
+        return false;
+    }
+    if (uring->native) {
+        return syscall(__NR_io_uring_register, uring->ring_fd,
+                       IORING_REGISTER_FILES, fds, n_fds) == 0;
+    }
+    uring->files = fds;
+    uring->n_files = n_fds;
+    return true;
+}
+
+struct io_uring_sqe *mu_thunk_uring_get_sqe(mu_thunk_uring_t *uring,
+                                            mu_thunk_t *thunk) {
+    if (uring == NULL || thunk == NULL) {
+        return NULL;
+    }
+    struct io_uring_sqe *sqe;
+    if (uring->native) {
+        unsigned head = __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE);
+        if (uring->sqe_tail - head >= uring->sq_entries) {
+            return NULL;
+        }
+        sqe = &uring->sqes[uring->sqe_tail & uring->sq_mask];
+        uring->sqe_tail++;
+    } else {
+        if (uring->n_free == 0) {
+            return NULL;
+        }
+        unsigned index = uring->free_ops[--uring->n_free];
+        uring->prepared[uring->n_prepared++] = index;
+        sqe = &uring->ops[index].sqe;
+    }
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = (uint64_t)(uintptr_t)thunk;
+    return sqe;
+}
+
+struct io_uring_sqe *mu_thunk_uring_prep_nop(mu_thunk_uring_t *uring,
+                                             mu_thunk_t *thunk) {
+    struct io_uring_sqe *sqe = mu_thunk_uring_get_sqe(uring, thunk);
+    if (sqe != NULL) {
+        sqe->opcode = IORING_OP_NOP;
+        sqe->fd = -1;
+    }
+    return sqe;
+}
+
+struct io_uring_sqe *mu_thunk_uring_prep_read(mu_thunk_uring_t *uring, int fd,
+                                              void *buf, unsigned len,
+                                              uint64_t offset,
+                                              mu_thunk_t *thunk) {
+    return prep_rw(uring, IORING_OP_READ, fd, buf, len, offset, thunk);
+}
+
+struct io_uring_sqe *mu_thunk_uring_prep_write(mu_thunk_uring_t *uring,
+                                               int fd, const void *buf,
+                                               unsigned len, uint64_t offset,
+                                               mu_thunk_t *thunk) {
+    return prep_rw(uring, IORING_OP_WRITE, fd, buf, len, offset, thunk);
+}
+
+struct io_uring_sqe *mu_thunk_uring_prep_read_fixed(mu_thunk_uring_t *uring,
+                                                    int fd, void *buf,
+                                                    unsigned len,
+                                                    uint64_t offset,
+                                                    unsigned buf_index,
+                                                    mu_thunk_t *thunk) {
+    struct io_uring_sqe *sqe =
+        prep_rw(uring, IORING_OP_READ_FIXED, fd, buf, len, offset, thunk);
+    if (sqe != NULL) {
+        sqe->buf_index = (uint16_t)buf_index;
+    }
+    return sqe;
+}
+
+struct io_uring_sqe *
+mu_thunk_uring_prep_write_fixed(mu_thunk_uring_t *uring, int fd,
+                                const void *buf, unsigned len, uint64_t offset,
+                                unsigned buf_index, mu_thunk_t *thunk) {
+    struct io_uring_sqe *sqe =
+        prep_rw(uring, IORING_OP_WRITE_FIXED, fd, buf, len, offset, thunk);
+    if (sqe != NULL) {
+        sqe->buf_index = (uint16_t)buf_index;
+    }
+    return sqe;
+}
+
+struct io_uring_sqe *mu_thunk_uring_prep_recv(mu_thunk_uring_t *uring, int fd,
+                                              void *buf, unsigned len,
+                                              int flags, mu_thunk_t *thunk) {
+    struct io_uring_sqe *sqe =
+        prep_rw(uring, IORING_OP_RECV, fd, buf, len, 0, thunk);
+    if (sqe != NULL) {
+        sqe->msg_flags = (uint32_t)flags;
+    }
+    return sqe;
+}
+
+struct io_uring_sqe *mu_thunk_uring_prep_send(mu_thunk_uring_t *uring, int fd,
+                                              const void *buf, unsigned len,
+                                              int flags, mu_thunk_t *thunk) {
+    struct io_uring_sqe *sqe =
+        prep_rw(uring, IORING_OP_SEND, fd, buf, len, 0, thunk);
+    if (sqe != NULL) {
+        sqe->msg_flags = (uint32_t)flags;
+    }
+    return sqe;
+}
+
+int mu_thunk_uring_submit(mu_thunk_uring_t *uring) {
+    if (uring == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+    return uring->native ? native_enter(uring, 0) : fallback_submit(uring);
+}
+
+int mu_thunk_uring_run_once(mu_thunk_uring_t *uring, unsigned wait_nr) {
+    if (uring == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (!uring->native) {
+        return fallback_run_once(uring, wait_nr);
+    }
+    if (native_enter(uring, wait_nr) < 0 && errno != EINTR) {
+        return -1;
+    }
+    return native_reap(uring);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool native_init(mu_thunk_uring_t *uring, unsigned entries) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    int fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+    if (fd < 0) {
+        return false;
+    }
+
+    uring->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    uring->cq_ring_size =
+        p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (uring->cq_ring_size > uring->sq_ring_size) {
+            uring->sq_ring_size = uring->cq_ring_size;
+        }
+        uring->cq_ring_size = uring->sq_ring_size;
+    }
+    uring->sq_ring = mmap(NULL, uring->sq_ring_size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (uring->sq_ring == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        uring->cq_ring = uring->sq_ring;
+    } else {
+        uring->cq_ring =
+            mmap(NULL, uring->cq_ring_size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (uring->cq_ring == MAP_FAILED) {
+            munmap(uring->sq_ring, uring->sq_ring_size);
+            close(fd);
+            return false;
+        }
+    }
+    uring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    uring->sqes = mmap(NULL, uring->sqes_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (uring->sqes == MAP_FAILED) {
+        if (uring->cq_ring != uring->sq_ring) {
+            munmap(uring->cq_ring, uring->cq_ring_size);
+        }
+        munmap(uring->sq_ring, uring->sq_ring_size);
+        close(fd);
+        return false;
+    }
+
+    char *sq = (char *)uring->sq_ring;
+    char *cq = (char *)uring->cq_ring;
+    uring->native = true;
+    uring->ring_fd = fd;
+    uring->sq_head = (unsigned *)(sq + p.sq_off.head);
+    uring->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    uring->sq_mask = *(unsigned *)(sq + p.sq_off.ring_mask);
+    uring->sq_entries = *(unsigned *)(sq + p.sq_off.ring_entries);
+    uring->sq_flags = (unsigned *)(sq + p.sq_off.flags);
+    uring->cq_head = (unsigned *)(cq + p.cq_off.head);
+    uring->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    uring->cq_mask = *(unsigned *)(cq + p.cq_off.ring_mask);
+    uring->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    uring->sqe_tail = *uring->sq_tail;
+    uring->submitted = uring->sqe_tail;
+
+    // SQ slot i always points at SQE i, so the index array is set up once.
+    unsigned *array = (unsigned *)(sq + p.sq_off.array);
+    for (unsigned i = 0; i < uring->sq_entries; i++) {
+        array[i] = i;
+    }
+    return true;
+}
+
+static void native_deinit(mu_thunk_uring_t *uring) {
+    munmap(uring->sqes, uring->sqes_size);
+    if (uring->cq_ring != uring->sq_ring) {
+        munmap(uring->cq_ring, uring->cq_ring_size);
+    }
+    munmap(uring->sq_ring, uring->sq_ring_size);
+    close(uring->ring_fd);
+    uring->ring_fd = -1;
+}
+
+static int native_enter(mu_thunk_uring_t *uring, unsigned wait_nr) {
+    // Publish prepared SQEs, then submit them (and optionally wait) in one
+    // system call.
+    __atomic_store_n(uring->sq_tail, uring->sqe_tail, __ATOMIC_RELEASE);
+    unsigned to_submit = uring->sqe_tail - uring->submitted;
+    if (to_submit == 0 && wait_nr == 0) {
+        return 0;
+    }
+    unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+    int rc = (int)syscall(__NR_io_uring_enter, uring->ring_fd, to_submit,
+                          wait_nr, flags, NULL, 0);
+    if (rc < 0) {
+        return -1;
+    }
+    uring->submitted += (unsigned)rc;
+    return rc;
+}
+
+static int native_reap(mu_thunk_uring_t *uring) {
+    int dispatched = 0;
+    unsigned head = *uring->cq_head;
+    unsigned tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        // Copy out and release the slot before calling the thunk.
+        struct io_uring_cqe cqe = uring->cqes[head & uring->cq_mask];
+        head++;
+        __atomic_store_n(uring->cq_head, head, __ATOMIC_RELEASE);
+        _mu_thunk_call((mu_thunk_t *)(uintptr_t)cqe.user_data, &cqe);
+        dispatched++;
+        if (head == tail) {
+            tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+        }
+    }
+    return dispatched;
+}
+
+static bool fallback_init(mu_thunk_uring_t *uring, unsigned entries) {
+    if (mu_thunk_reactor_init(&uring->reactor) == NULL) {
+        return false;
+    }
+    uring->native = false;
+    uring->ring_fd = -1;
+    uring->files = NULL;
+    uring->n_files = 0;
+    uring->buffers = NULL;
+    uring->n_buffers = 0;
+    uring->n_prepared = 0;
+    uring->n_waiting = 0;
+    uring->cq_count = 0;
+    uring->cq_first = 0;
+    uring->n_free = entries;
+    for (unsigned i = 0; i < entries; i++) {
+        // Hand out low indices first.
+        uring->free_ops[i] = entries - 1 - i;
+        uring->ops[i].uring = uring;
+        uring->ops[i].wait_fd = -1;
+    }
+    return true;
+}
+
+static int fallback_submit(mu_thunk_uring_t *uring) {
+    unsigned n = uring->n_prepared;
+    uring->n_prepared = 0;
+    for (unsigned i = 0; i < n; i++) {
+        fallback_start(&uring->ops[uring->prepared[i]]);
+    }
+    return (int)n;
+}
+
+static int fallback_run_once(mu_thunk_uring_t *uring, unsigned wait_nr) {
+    fallback_submit(uring);
+    // Poll the reactor once without blocking to make progress on waiting
+    // operations, or block until enough have completed.
+    while (uring->n_waiting > 0) {
+        bool satisfied = uring->cq_count >= wait_nr;
+        if (mu_thunk_reactor_run_once(&uring->reactor, satisfied ? 0 : -1) <
+            0) {
+            return -1;
+        }
+        if (satisfied) {
+            break;
+        }
+    }
+    int dispatched = 0;
+    while (uring->cq_count > 0) {
+        unsigned index = uring->completed[uring->cq_first];
+        uring->cq_first = (uring->cq_first + 1) % MU_THUNK_URING_MAX_ENTRIES;
+        uring->cq_count--;
+        struct io_uring_cqe cqe = uring->ops[index].cqe;
+        uring->free_ops[uring->n_free++] = index;
+        _mu_thunk_call((mu_thunk_t *)(uintptr_t)cqe.user_data, &cqe);
+        dispatched++;
+    }
+    return dispatched;
+}
+
+static void fallback_start(mu_thunk_uring_op_t *op) {
+    int fd;
+    int res = fallback_perform(op, &fd);
+    if (res != -EAGAIN) {
+        fallback_complete(op, res);
+        return;
+    }
+    mu_thunk_init(&op->thunk, fallback_ready_fn);
+    if (!mu_thunk_reactor_add(&op->uring->reactor, fd,
+                              fallback_wait_events(op) | EPOLLONESHOT,
+                              &op->thunk)) {
+        fallback_complete(op, errno == EEXIST ? -EBUSY : -errno);
+        return;
+    }
+    op->wait_fd = fd;
+    op->uring->n_waiting++;
+}
+
+static void fallback_ready_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    mu_thunk_uring_op_t *op = (mu_thunk_uring_op_t *)thunk;
+    mu_thunk_reactor_t *reactor = &op->uring->reactor;
+    int fd;
+    int res = fallback_perform(op, &fd);
+    if (res == -EAGAIN) {
+        // Spurious wakeup: re-arm the one-shot registration.
+        mu_thunk_reactor_modify(reactor, op->wait_fd,
+                                fallback_wait_events(op) | EPOLLONESHOT,
+                                &op->thunk);
+        return;
+    }
+    mu_thunk_reactor_remove(reactor, op->wait_fd);
+    op->wait_fd = -1;
+    op->uring->n_waiting--;
+    fallback_complete(op, res);
+}
+
+static void fallback_complete(mu_thunk_uring_op_t *op, int res) {
+    mu_thunk_uring_t *uring = op->uring;
+    op->cqe.user_data = op->sqe.user_data;
+    op->cqe.res = res;
+    op->cqe.flags = 0;
+    unsigned slot =
+        (uring->cq_first + uring->cq_count) % MU_THUNK_URING_MAX_ENTRIES;
+    uring->completed[slot] = OP_INDEX(uring, op);
+    uring->cq_count++;
+}
+
+static int fallback_perform(mu_thunk_uring_op_t *op, int *fd_out) {
+    mu_thunk_uring_t *uring = op->uring;
+    const struct io_uring_sqe *sqe = &op->sqe;
+    void *addr = (void *)(uintptr_t)sqe->addr;
+    size_t len = sqe->len;
+    int fd = sqe->fd;
+    ssize_t rc;
+
+    if (sqe->flags & IOSQE_FIXED_FILE) {
+        if (fd < 0 || (unsigned)fd >= uring->n_files) {
+            return -EBADF;
+        }
+        fd = uring->files[fd];
+    }
+    *fd_out = fd;
+
+    switch (sqe->opcode) {
+    case IORING_OP_NOP:
+        return 0;
+    case IORING_OP_READ_FIXED:
+    case IORING_OP_WRITE_FIXED:
+        if (!fixed_buffer_ok(uring, sqe)) {
+            return -EFAULT;
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (len > FALLBACK_MAX_RW) {
+        len = FALLBACK_MAX_RW;
+    }
+
+    switch (sqe->opcode) {
+    case IORING_OP_READ:
+    case IORING_OP_READ_FIXED:
+        rc = sqe->off == MU_THUNK_URING_CUR_POS
+                 ? fallback_rw(fd, addr, len, false)
+                 : pread(fd, addr, len, (off_t)sqe->off);
+        break;
+    case IORING_OP_WRITE:
+    case IORING_OP_WRITE_FIXED:
+        rc = sqe->off == MU_THUNK_URING_CUR_POS
+                 ? fallback_rw(fd, addr, len, true)
+                 : pwrite(fd, addr, len, (off_t)sqe->off);
+        break;
+    case IORING_OP_RECV:
+        rc = recv(fd, addr, len, (int)sqe->msg_flags | MSG_DONTWAIT);
+        break;
+    case IORING_OP_SEND:
+        rc = send(fd, addr, len,
+                  (int)sqe->msg_flags | MSG_DONTWAIT | MSG_NOSIGNAL);
+        break;
+    default:
+        return -EINVAL;
+    }
+    return rc < 0 ? -errno : (int)rc;
+}
+
+/**
+ * @brief Read or write at the current position without blocking the loop.
+ *
+ * Regular files and block devices never report EAGAIN, so they take the
+ * plain syscall.  Sockets use MSG_DONTWAIT.  Anything else (pipes, ttys,
+ * character devices) opened without O_NONBLOCK is switched to non-blocking
+ * for the duration of the call.  That flag lives on the open file
+ * description, so another process sharing it could briefly observe it.
+ */
+static ssize_t fallback_rw(int fd, void *addr, size_t len, bool write_op) {
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        return -1;
+    }
+    if (S_ISREG(st.st_mode) || S_ISBLK(st.st_mode)) {
+        return write_op ? write(fd, addr, len) : read(fd, addr, len);
+    }
+    if (S_ISSOCK(st.st_mode)) {
+        return write_op ? send(fd, addr, len, MSG_DONTWAIT | MSG_NOSIGNAL)
+                        : recv(fd, addr, len, MSG_DONTWAIT);
+    }
+    int fl = fcntl(fd, F_GETFL);
+    if (fl < 0) {
+        return -1;
+    }
+    if ((fl & O_NONBLOCK) == 0 && fcntl(fd, F_SETFL, fl | O_NONBLOCK) < 0) {
+        return -1;
+    }
+    ssize_t rc = write_op ? write(fd, addr, len) : read(fd, addr, len);
+    if ((fl & O_NONBLOCK) == 0) {
+        int saved = errno;
+        fcntl(fd, F_SETFL, fl);
+        errno = saved;
+    }
+    return rc;
+}
+
+static bool fixed_buffer_ok(const mu_thunk_uring_t *uring,
+                            const struct io_uring_sqe *sqe) {
+    if (sqe->buf_index >= uring->n_buffers) {
+        return false;
+    }
+    const struct iovec *iov = &uring->buffers[sqe->buf_index];
+    uintptr_t base = (uintptr_t)iov->iov_base;
+    uintptr_t addr = (uintptr_t)sqe->addr;
+    return addr >= base && addr + sqe->len <= base + iov->iov_len;
+}
+
+static uint32_t fallback_wait_events(const mu_thunk_uring_op_t *op) {
+    switch (op->sqe.opcode) {
+    case IORING_OP_WRITE:
+    case IORING_OP_WRITE_FIXED:
+    case IORING_OP_SEND:
+        return EPOLLOUT;
+    default:
+        return EPOLLIN;
+    }
+}
+
+static struct io_uring_sqe *prep_rw(mu_thunk_uring_t *uring, uint8_t opcode,
+                                    int fd, const void *buf, unsigned len,
+                                    uint64_t offset, mu_thunk_t *thunk) {
+    struct io_uring_sqe *sqe = mu_thunk_uring_get_sqe(uring, thunk);
+    if (sqe != NULL) {
+        sqe->opcode = opcode;
+        sqe->fd = fd;
+        sqe->addr = (uint64_t)(uintptr_t)buf;
+        sqe->len = len;
+        sqe->off = offset;
+    }
+    return sqe;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,322 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_wheel.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#if MU_THUNK_WHEEL_BITS > 6
+#error "MU_THUNK_WHEEL_BITS must be at most 6 (one 64-bit bitmap per level)"
+#endif
+
+#if MU_THUNK_WHEEL_BITS * MU_THUNK_WHEEL_LEVELS >= 64
+#error "MU_THUNK_WHEEL_BITS * MU_THUNK_WHEEL_LEVELS must be less than 64"
+#endif
+
+#define SLOT_MASK ((uint64_t)MU_THUNK_WHEEL_SLOTS - 1)
+
+/** Largest delay that can be placed exactly, plus one. */
+#define WHEEL_RANGE ((uint64_t)1 << (MU_THUNK_WHEEL_BITS * MU_THUNK_WHEEL_LEVELS))
+
+#define TIMER_FROM_LINK(l)                                                     \
+    ((mu_thunk_timer_t *)((char *)(l) - offsetof(mu_thunk_timer_t, link)))
+
+// *****************************************************************************
+// Private (static) storage
+
+// (none)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void place(mu_thunk_wheel_t *wheel, mu_thunk_timer_t *timer);
+static size_t process_tick(mu_thunk_wheel_t *wheel);
+static uint64_t next_event(mu_thunk_wheel_t *wheel);
+static int first_occupied(mu_thunk_wheel_t *wheel, int level, unsigned from);
+static void detach_slot(mu_thunk_wheel_t *wheel, int level, uint64_t slot,
+                        mu_thunk_timer_link_t *to);
+static void list_init(mu_thunk_timer_link_t *head);
+static bool list_is_empty(const mu_thunk_timer_link_t *head);
+static void list_append(mu_thunk_timer_link_t *head,
+                        mu_thunk_timer_link_t *link);
+static void list_unlink(mu_thunk_timer_link_t *link);
+static void list_move_all(mu_thunk_timer_link_t *from,
+                          mu_thunk_timer_link_t *to);
+
+// *****************************************************************************
+// Public code
+
+mu_thunk_wheel_t *mu_thunk_wheel_init(mu_thunk_wheel_t *wheel, uint64_t now) {
+    if (wheel == NULL) {
+        return NULL;
+    }
+    wheel->now = now;
+    wheel->count = 0;
+    for (int level = 0; level < MU_THUNK_WHEEL_LEVELS; level++) {
+        wheel->occupied[level] = 0;
+        for (unsigned slot = 0; slot < MU_THUNK_WHEEL_SLOTS; slot++) {
+            list_init(&wheel->slots[level][slot]);
+        }
+    }
+    return wheel;
+}
+
+mu_thunk_timer_t *mu_thunk_timer_init(mu_thunk_timer_t *timer,
+                                      mu_thunk_fn fn) {
+    if (timer == NULL || mu_thunk_init(&timer->thunk, fn) == NULL) {
+        return NULL;
+    }
+    timer->link.next = NULL;
+    timer->link.prev = NULL;
+    timer->expires = 0;
+    timer->period = 0;
+    return timer;
+}
+
+bool mu_thunk_timer_is_pending(const mu_thunk_timer_t *timer) {
+    return timer != NULL && timer->link.next != NULL;
+}
+
+mu_thunk_timer_t *mu_thunk_wheel_schedule(mu_thunk_wheel_t *wheel,
+                                          mu_thunk_timer_t *timer,
+                                          uint64_t delay, uint64_t period) {
+    if (wheel == NULL || timer == NULL) {
+        return NULL;
+    }
+    mu_thunk_wheel_cancel(wheel, timer);
+    timer->expires = wheel->now + (delay == 0 ? 1 : delay);
+    timer->period = period;
+    place(wheel, timer);
+    wheel->count++;
+    return timer;
+}
+
+bool mu_thunk_wheel_cancel(mu_thunk_wheel_t *wheel, mu_thunk_timer_t *timer) {
+    if (wheel == NULL || !mu_thunk_timer_is_pending(timer)) {
+        return false;
+    }
+    list_unlink(&timer->link);
+    wheel->count--;
+    return true;
+}
+
+size_t mu_thunk_wheel_advance(mu_thunk_wheel_t *wheel, uint64_t now) {
+    if (wheel == NULL) {
+        return 0;
+    }
+    size_t fired = 0;
+    while (wheel->now < now) {
+        uint64_t tick = wheel->count == 0 ? now + 1 : next_event(wheel);
+        if (tick > now) {
+            // Nothing to cascade or fire before `now`: jump straight there.
+            wheel->now = now;
+            break;
+        }
+        wheel->now = tick - 1;
+        fired += process_tick(wheel);
+    }
+    return fired;
+}
+
+uint64_t mu_thunk_wheel_now(const mu_thunk_wheel_t *wheel) {
+    return wheel == NULL ? 0 : wheel->now;
+}
+
+size_t mu_thunk_wheel_count(const mu_thunk_wheel_t *wheel) {
+    return wheel == NULL ? 0 : wheel->count;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * Put `timer` in the slot for its expiry, relative to the next tick to be
+ * processed.  A timer within 2^(BITS*(L+1)) ticks goes in level L, indexed
+ * by the level-L digit of its expiry, so it is cascaded down exactly when
+ * that digit comes round.
+ */
+static void place(mu_thunk_wheel_t *wheel, mu_thunk_timer_t *timer) {
+    uint64_t base = wheel->now + 1;
+    uint64_t expires = timer->expires < base ? base : timer->expires;
+    uint64_t delta = expires - base;
+    if (delta >= WHEEL_RANGE) {
+        // Park in the outermost level; re-placed when it cascades.
+        delta = WHEEL_RANGE - 1;
+        expires = base + delta;
+    }
+    int level = 0;
+    while (level < MU_THUNK_WHEEL_LEVELS - 1 &&
+           (delta >> (MU_THUNK_WHEEL_BITS * (level + 1))) != 0) {
+        level++;
+    }
+    uint64_t slot = (expires >> (MU_THUNK_WHEEL_BITS * level)) & SLOT_MASK;
+    list_append(&wheel->slots[level][slot], &timer->link);
+    wheel->occupied[level] |= (uint64_t)1 << slot;
+}
+
+static size_t process_tick(mu_thunk_wheel_t *wheel) {
+    uint64_t tick = wheel->now + 1;
+    mu_thunk_timer_link_t pending;
+    size_t fired = 0;
+
+    // On each wrap of level L-1, redistribute level L's current slot.
+    for (int level = 1; level < MU_THUNK_WHEEL_LEVELS; level++) {
+        uint64_t low_bits = ((uint64_t)1 << (MU_THUNK_WHEEL_BITS * level)) - 1;
+        if ((tick & low_bits) != 0) {
+            break;
+        }
+        uint64_t slot = (tick >> (MU_THUNK_WHEEL_BITS * level)) & SLOT_MASK;
+        detach_slot(wheel, level, slot, &pending);
+        while (!list_is_empty(&pending)) {
+            mu_thunk_timer_link_t *link = pending.next;
+            list_unlink(link);
+            place(wheel, TIMER_FROM_LINK(link));
+        }
+    }
+
+    // Detach this tick's slot before running anything, so that timers
+    // (re)scheduled by the thunks land on a later tick.
+    detach_slot(wheel, 0, tick & SLOT_MASK, &pending);
+    wheel->now = tick;
+
+    while (!list_is_empty(&pending)) {
+        mu_thunk_timer_t *timer = TIMER_FROM_LINK(pending.next);
+        list_unlink(&timer->link);
+        if (timer->period != 0) {
+            timer->expires += timer->period;
+            place(wheel, timer);
+        } else {
+            wheel->count--;
+        }
+        _mu_thunk_call(&timer->thunk, wheel);
+        fired++;
+    }
+    return fired;
+}
+
+/**
+ * Return the first tick after `now` on which process_tick() could cascade
+ * or fire anything.  Level k only acts on ticks whose low k digits are zero,
+ * so if levels below k are entirely empty and level k has nothing left in
+ * its current rotation, the wheel can skip to the end of that rotation.
+ */
+static uint64_t next_event(mu_thunk_wheel_t *wheel) {
+    uint64_t tick = wheel->now + 1;
+    uint64_t limit = tick;
+    for (int level = 0; level < MU_THUNK_WHEEL_LEVELS; level++) {
+        unsigned shift = MU_THUNK_WHEEL_BITS * level;
+        unsigned next_shift = shift + MU_THUNK_WHEEL_BITS;
+        uint64_t low_bits = ((uint64_t)1 << shift) - 1;
+        unsigned index = (unsigned)((tick >> shift) & SLOT_MASK);
+        // The current slot is still due only if we are on its boundary.
+        unsigned from = (tick & low_bits) == 0 ? index : index + 1;
+        int slot = first_occupied(wheel, level, from);
+        if (slot >= 0) {
+            uint64_t rotation = (tick >> next_shift) << next_shift;
+            // If we are exactly at the start of this rotation, the levels
+            // above may cascade right now.
+            return rotation == tick ? tick
+                                    : rotation | ((uint64_t)slot << shift);
+        }
+        limit = ((tick >> next_shift) + 1) << next_shift;
+        if (wheel->occupied[level] != 0) {
+            // Wrapped entries come due in a later rotation of this level.
+            break;
+        }
+    }
+    return limit;
+}
+
+/**
+ * Return the lowest non-empty slot >= `from` in `level`, or -1.  Clears
+ * stale occupancy bits (left behind by cancel) as it goes.
+ */
+static int first_occupied(mu_thunk_wheel_t *wheel, int level, unsigned from) {
+    while (from < MU_THUNK_WHEEL_SLOTS) {
+        uint64_t bits = wheel->occupied[level] & (~(uint64_t)0 << from);
+        if (bits == 0) {
+            return -1;
+        }
+        int slot = __builtin_ctzll(bits);
+        if (!list_is_empty(&wheel->slots[level][slot])) {
+            return slot;
+        }
+        wheel->occupied[level] &= ~((uint64_t)1 << slot);
+        from = (unsigned)slot + 1;
+    }
+    return -1;
+}
+
+static void detach_slot(mu_thunk_wheel_t *wheel, int level, uint64_t slot,
+                        mu_thunk_timer_link_t *to) {
+    list_init(to);
+    list_move_all(&wheel->slots[level][slot], to);
+    wheel->occupied[level] &= ~((uint64_t)1 << slot);
+}
+
+static void list_init(mu_thunk_timer_link_t *head) {
+    head->next = head;
+    head->prev = head;
+}
+
+static bool list_is_empty(const mu_thunk_timer_link_t *head) {
+    return head->next == head;
+}
+
+static void list_append(mu_thunk_timer_link_t *head,
+                        mu_thunk_timer_link_t *link) {
+    link->prev = head->prev;
+    link->next = head;
+    head->prev->next = link;
+    head->prev = link;
+}
+
+static void list_unlink(mu_thunk_timer_link_t *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = NULL;
+    link->prev = NULL;
+}
+
+static void list_move_all(mu_thunk_timer_link_t *from,
+                          mu_thunk_timer_link_t *to) {
+    if (list_is_empty(from)) {
+        return;
+    }
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    list_init(from);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,213 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_batch.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_LOG 32
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    int id;
+} test_thunk_t;
+
+// Every invocation, single or batched, appends the thunk id; batches also
+// record their size.
+static int s_order[N_LOG];
+static void *s_args[N_LOG];
+static int s_n_order;
+static size_t s_batches[N_LOG];
+static int s_n_batches;
+
+static void log_one(mu_thunk_t *thunk, void *args) {
+    if (s_n_order < N_LOG) {
+        s_order[s_n_order] = ((test_thunk_t *)thunk)->id;
+        s_args[s_n_order] = args;
+    }
+    s_n_order++;
+}
+
+static void a_fn(mu_thunk_t *thunk, void *args) { log_one(thunk, args); }
+
+static void b_fn(mu_thunk_t *thunk, void *args) { log_one(thunk, args); }
+
+static void a_batch(mu_thunk_t **thunks, void **args, size_t n) {
+    if (s_n_batches < N_LOG) {
+        s_batches[s_n_batches] = n;
+    }
+    s_n_batches++;
+    for (size_t i = 0; i < n; i++) {
+        log_one(thunks[i], args != NULL ? args[i] : NULL);
+    }
+}
+
+static void a_batch_alt(mu_thunk_t **thunks, void **args, size_t n) {
+    (void)thunks;
+    (void)args;
+    (void)n;
+}
+
+static void test_thunk_init(test_thunk_t *tt, mu_thunk_fn fn, int id) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_init(&tt->thunk, fn));
+    tt->id = id;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    s_n_order = 0;
+    s_n_batches = 0;
+    TEST_ASSERT_TRUE(mu_thunk_batch_register(a_fn, NULL));
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_batch_param_validation(void) {
+    TEST_ASSERT_FALSE(mu_thunk_batch_register(NULL, a_batch));
+    TEST_ASSERT_NULL(mu_thunk_batch_lookup(NULL));
+    TEST_ASSERT_NULL(mu_thunk_batch_lookup(b_fn));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_batch_dispatch(NULL, NULL, 3));
+    // Removing a function that was never registered is a harmless no-op.
+    TEST_ASSERT_TRUE(mu_thunk_batch_register(b_fn, NULL));
+    TEST_ASSERT_NULL(mu_thunk_batch_lookup(b_fn));
+}
+
+void test_mu_thunk_batch_register_replace_remove(void) {
+    TEST_ASSERT_TRUE(mu_thunk_batch_register(a_fn, a_batch));
+    TEST_ASSERT_EQUAL_PTR(a_batch, mu_thunk_batch_lookup(a_fn));
+    TEST_ASSERT_TRUE(mu_thunk_batch_register(a_fn, a_batch_alt));
+    TEST_ASSERT_EQUAL_PTR(a_batch_alt, mu_thunk_batch_lookup(a_fn));
+    TEST_ASSERT_TRUE(mu_thunk_batch_register(a_fn, NULL));
+    TEST_ASSERT_NULL(mu_thunk_batch_lookup(a_fn));
+}
+
+void test_mu_thunk_batch_remove_frees_capacity(void) {
+    // Distinct keys for the registry; they are looked up, never called.
+#define FAKE_FN(k) ((mu_thunk_fn)(uintptr_t)(0x10000 + 16 * (uintptr_t)(k)))
+    const int max = MU_THUNK_BATCH_MAX_FNS;
+    for (int k = 0; k < max; k++) {
+        TEST_ASSERT_TRUE(mu_thunk_batch_register(FAKE_FN(k), a_batch));
+    }
+    TEST_ASSERT_FALSE(mu_thunk_batch_register(FAKE_FN(max), a_batch));
+    // Replacing a live entry needs no new capacity.
+    TEST_ASSERT_TRUE(mu_thunk_batch_register(FAKE_FN(0), a_batch_alt));
+
+    // Churn well past the table size, never more than `max` live.
+    for (int k = max; k < 16 * max; k++) {
+        TEST_ASSERT_TRUE(mu_thunk_batch_register(FAKE_FN(k - max), NULL));
+        TEST_ASSERT_NULL(mu_thunk_batch_lookup(FAKE_FN(k - max)));
+        TEST_ASSERT_TRUE(mu_thunk_batch_register(FAKE_FN(k), a_batch));
+        TEST_ASSERT_EQUAL_PTR(a_batch, mu_thunk_batch_lookup(FAKE_FN(k)));
+    }
+    for (int k = 15 * max; k < 16 * max; k++) {
+        TEST_ASSERT_EQUAL_PTR(a_batch, mu_thunk_batch_lookup(FAKE_FN(k)));
+        TEST_ASSERT_TRUE(mu_thunk_batch_register(FAKE_FN(k), NULL));
+    }
+#undef FAKE_FN
+}
+
+void test_mu_thunk_batch_dispatch_without_batch(void) {
+    static const int expected[] = {0, 1, 2, 3};
+    test_thunk_t tts[4];
+    mu_thunk_t *thunks[4];
+    void *args[4];
+    for (int i = 0; i < 4; i++) {
+        test_thunk_init(&tts[i], (i == 1) ? b_fn : a_fn, i);
+        thunks[i] = &tts[i].thunk;
+        args[i] = &tts[i];
+    }
+    TEST_ASSERT_EQUAL_size_t(4, mu_thunk_batch_dispatch(thunks, args, 4));
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, s_order, 4);
+    TEST_ASSERT_EQUAL_PTR(&tts[2], s_args[2]);
+    TEST_ASSERT_EQUAL_INT(0, s_n_batches);
+}
+
+void test_mu_thunk_batch_dispatch_batches_runs(void) {
+    // a a b a a a b: runs of a (2, then 3) go to a_batch, b one by one,
+    // and the overall order is unchanged.
+    static const int expected[] = {0, 1, 2, 3, 4, 5, 6};
+    mu_thunk_fn fns[] = {a_fn, a_fn, b_fn, a_fn, a_fn, a_fn, b_fn};
+    test_thunk_t tts[7];
+    mu_thunk_t *thunks[7];
+    void *args[7];
+    for (int i = 0; i < 7; i++) {
+        test_thunk_init(&tts[i], fns[i], i);
+        thunks[i] = &tts[i].thunk;
+        args[i] = &tts[i];
+    }
+    mu_thunk_batch_register(a_fn, a_batch);
+    TEST_ASSERT_EQUAL_size_t(7, mu_thunk_batch_dispatch(thunks, args, 7));
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, s_order, 7);
+    TEST_ASSERT_EQUAL_INT(2, s_n_batches);
+    TEST_ASSERT_EQUAL_size_t(2, s_batches[0]);
+    TEST_ASSERT_EQUAL_size_t(3, s_batches[1]);
+    for (int i = 0; i < 7; i++) {
+        TEST_ASSERT_EQUAL_PTR(&tts[i], s_args[i]);
+    }
+}
+
+void test_mu_thunk_batch_dispatch_null_args(void) {
+    test_thunk_t tts[3];
+    mu_thunk_t *thunks[3];
+    for (int i = 0; i < 3; i++) {
+        test_thunk_init(&tts[i], (i == 2) ? b_fn : a_fn, i);
+        thunks[i] = &tts[i].thunk;
+    }
+    mu_thunk_batch_register(a_fn, a_batch);
+    TEST_ASSERT_EQUAL_size_t(3, mu_thunk_batch_dispatch(thunks, NULL, 3));
+    TEST_ASSERT_EQUAL_INT(3, s_n_order);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_NULL(s_args[i]);
+    }
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_batch_param_validation);
+    RUN_TEST(test_mu_thunk_batch_register_replace_remove);
+    RUN_TEST(test_mu_thunk_batch_remove_frees_capacity);
+    RUN_TEST(test_mu_thunk_batch_dispatch_without_batch);
+    RUN_TEST(test_mu_thunk_batch_dispatch_batches_runs);
+    RUN_TEST(test_mu_thunk_batch_dispatch_null_args);
+
+    return UNITY_END();
+}
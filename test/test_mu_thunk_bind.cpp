@@ -0,0 +1,171 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_bind.hpp"
+#include "mu_thunk_ring.h"
+#include "unity.h"
+#include <cstdint>
+#include <memory>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_CAPACITY 8
+
+namespace {
+
+int s_live;
+
+/** Counts live instances, to check the thunk destroys what it holds. */
+struct tracked_t {
+    int value;
+    explicit tracked_t(int v) : value(v) { s_live++; }
+    tracked_t(tracked_t &&other) noexcept : value(other.value) { s_live++; }
+    ~tracked_t() { s_live--; }
+};
+
+/** A functor with constructor arguments, for in-place construction. */
+struct adder_t {
+    int *total;
+    int step;
+    adder_t(int *t, int s) : total(t), step(s) {}
+    void operator()() { *total += step; }
+};
+
+} // namespace
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) { s_live = 0; }
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_bind_layout(void) {
+    int count = 0;
+    auto t = mu::thunk([&count] { count++; });
+    TEST_ASSERT_EQUAL_PTR(&t, t.get());
+    // One pointer of capture, stored inline after the function pointer.
+    TEST_ASSERT_EQUAL_size_t(2 * sizeof(void *), sizeof(t));
+    auto empty = mu::thunk([] {});
+    TEST_ASSERT_EQUAL_size_t(2 * sizeof(void *), sizeof(empty));
+}
+
+void test_mu_thunk_bind_call(void) {
+    int count = 0;
+    intptr_t seen = 0;
+    auto nullary = mu::thunk([&count] { count++; });
+    auto unary = mu::thunk([&seen](void *args) { seen += (intptr_t)args; });
+    mu_thunk_call(nullary.get(), (void *)(intptr_t)5);
+    _mu_thunk_call(nullary.get(), nullptr);
+    TEST_ASSERT_EQUAL_INT(2, count);
+    mu_thunk_call(unary.get(), (void *)(intptr_t)5);
+    _mu_thunk_call(unary.get(), (void *)(intptr_t)7);
+    TEST_ASSERT_EQUAL_INT(12, (int)seen);
+    // Known type: call the lambda directly.
+    nullary();
+    unary((void *)(intptr_t)1);
+    TEST_ASSERT_EQUAL_INT(3, count);
+    TEST_ASSERT_EQUAL_INT(13, (int)seen);
+}
+
+void test_mu_thunk_bind_move_only(void) {
+    int got = 0;
+    {
+        auto p = std::make_unique<tracked_t>(9);
+        auto t = mu::thunk([p = std::move(p), &got] { got = p->value; });
+        TEST_ASSERT_EQUAL_INT(1, s_live);
+        _mu_thunk_call(t.get(), nullptr);
+        TEST_ASSERT_EQUAL_INT(9, got);
+
+        // Moving hands the capture to a new thunk with its own trampoline.
+        auto moved = std::move(t);
+        got = 0;
+        _mu_thunk_call(moved.get(), nullptr);
+        TEST_ASSERT_EQUAL_INT(9, got);
+        TEST_ASSERT_EQUAL_INT(1, s_live);
+    }
+    TEST_ASSERT_EQUAL_INT(0, s_live);
+
+    {
+        auto t = mu::thunk([v = tracked_t(3), &got] { got = v.value; });
+        TEST_ASSERT_EQUAL_INT(1, s_live);
+        t();
+        TEST_ASSERT_EQUAL_INT(3, got);
+    }
+    TEST_ASSERT_EQUAL_INT(0, s_live);
+}
+
+void test_mu_thunk_bind_in_place(void) {
+    int total = 0;
+    mu::thunk<adder_t> t(std::in_place, &total, 4);
+    _mu_thunk_call(t.get(), nullptr);
+    t();
+    TEST_ASSERT_EQUAL_INT(8, total);
+    t.callable().step = 1;
+    _mu_thunk_call(t.get(), nullptr);
+    TEST_ASSERT_EQUAL_INT(9, total);
+}
+
+void test_mu_thunk_bind_from_ring(void) {
+    mu_thunk_ring_t ring;
+    mu_thunk_t *store[RING_CAPACITY];
+    mu_thunk_ring_init(&ring, store, RING_CAPACITY);
+    int order[3] = {0};
+    int n = 0;
+    auto a = mu::thunk([&] { order[n++] = 1; });
+    auto b = mu::thunk([&](void *args) { order[n++] = (int)(intptr_t)args; });
+    auto c = mu::thunk([&] { order[n++] = 3; });
+    TEST_ASSERT_TRUE(mu_thunk_ring_put(&ring, a.get()));
+    TEST_ASSERT_TRUE(mu_thunk_ring_put(&ring, b.get()));
+    TEST_ASSERT_TRUE(mu_thunk_ring_put(&ring, c.get()));
+    TEST_ASSERT_EQUAL_size_t(3, mu_thunk_ring_drain(&ring, (void *)2));
+    TEST_ASSERT_EQUAL_INT(3, n);
+    TEST_ASSERT_EQUAL_INT(1, order[0]);
+    TEST_ASSERT_EQUAL_INT(2, order[1]);
+    TEST_ASSERT_EQUAL_INT(3, order[2]);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_bind_layout);
+    RUN_TEST(test_mu_thunk_bind_call);
+    RUN_TEST(test_mu_thunk_bind_move_only);
+    RUN_TEST(test_mu_thunk_bind_in_place);
+    RUN_TEST(test_mu_thunk_bind_from_ring);
+
+    return UNITY_END();
+}
@@ -0,0 +1,167 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_compact.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+typedef struct {
+    mu_thunk_compact_t thunk; /**< Must be first member */
+    uint32_t arg;
+} test_job_t;
+
+static int s_a_calls;
+static int s_b_calls;
+static uint32_t s_sum;
+static void *s_last_args;
+
+static void a_fn(mu_thunk_compact_t *thunk, void *args) {
+    s_a_calls++;
+    s_sum += ((test_job_t *)thunk)->arg;
+    s_last_args = args;
+}
+
+static void b_fn(mu_thunk_compact_t *thunk, void *args) {
+    (void)args;
+    s_b_calls++;
+    s_sum += 2 * ((test_job_t *)thunk)->arg;
+}
+
+static void c_fn(mu_thunk_compact_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    s_a_calls = 0;
+    s_b_calls = 0;
+    s_sum = 0;
+    s_last_args = NULL;
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_compact_param_validation(void) {
+    mu_thunk_compact_t thunk = {.id = MU_THUNK_COMPACT_NONE};
+    TEST_ASSERT_EQUAL_UINT32(MU_THUNK_COMPACT_NONE,
+                             mu_thunk_compact_register(NULL));
+    TEST_ASSERT_FALSE(mu_thunk_compact_register_at(1, NULL));
+    TEST_ASSERT_FALSE(
+        mu_thunk_compact_register_at(MU_THUNK_COMPACT_NONE, a_fn));
+    TEST_ASSERT_FALSE(
+        mu_thunk_compact_register_at(MU_THUNK_COMPACT_MAX_FNS, a_fn));
+    TEST_ASSERT_NULL(mu_thunk_compact_lookup(MU_THUNK_COMPACT_NONE));
+    TEST_ASSERT_NULL(mu_thunk_compact_lookup(MU_THUNK_COMPACT_MAX_FNS));
+    TEST_ASSERT_EQUAL_UINT32(MU_THUNK_COMPACT_NONE,
+                             mu_thunk_compact_id_of(NULL));
+    TEST_ASSERT_EQUAL_UINT32(MU_THUNK_COMPACT_NONE,
+                             mu_thunk_compact_id_of(c_fn));
+    TEST_ASSERT_NULL(mu_thunk_compact_init(NULL, 1));
+    TEST_ASSERT_NULL(mu_thunk_compact_init(&thunk, MU_THUNK_COMPACT_NONE));
+    // Calling NULL or an unregistered id is a no-op.
+    mu_thunk_compact_call(NULL, NULL);
+    mu_thunk_compact_call(&thunk, NULL);
+}
+
+void test_mu_thunk_compact_register_is_idempotent(void) {
+    mu_thunk_compact_id_t a = mu_thunk_compact_register(a_fn);
+    mu_thunk_compact_id_t b = mu_thunk_compact_register(b_fn);
+    TEST_ASSERT_NOT_EQUAL(MU_THUNK_COMPACT_NONE, a);
+    TEST_ASSERT_NOT_EQUAL(MU_THUNK_COMPACT_NONE, b);
+    TEST_ASSERT_NOT_EQUAL(a, b);
+    TEST_ASSERT_EQUAL_UINT32(a, mu_thunk_compact_register(a_fn));
+    TEST_ASSERT_EQUAL_UINT32(a, mu_thunk_compact_id_of(a_fn));
+    TEST_ASSERT_EQUAL_PTR(a_fn, mu_thunk_compact_lookup(a));
+    TEST_ASSERT_EQUAL_PTR(b_fn, mu_thunk_compact_lookup(b));
+}
+
+void test_mu_thunk_compact_register_at(void) {
+    const mu_thunk_compact_id_t fixed = MU_THUNK_COMPACT_MAX_FNS - 1;
+    TEST_ASSERT_TRUE(mu_thunk_compact_register_at(fixed, c_fn));
+    TEST_ASSERT_TRUE(mu_thunk_compact_register_at(fixed, c_fn));
+    TEST_ASSERT_FALSE(mu_thunk_compact_register_at(fixed, a_fn));
+    TEST_ASSERT_EQUAL_UINT32(fixed, mu_thunk_compact_id_of(c_fn));
+    // Plain registration finds the fixed slot rather than adding another.
+    TEST_ASSERT_EQUAL_UINT32(fixed, mu_thunk_compact_register(c_fn));
+}
+
+void test_mu_thunk_compact_dispatch(void) {
+    test_job_t jobs[4];
+    mu_thunk_compact_id_t a = mu_thunk_compact_register(a_fn);
+    mu_thunk_compact_id_t b = mu_thunk_compact_register(b_fn);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_NOT_NULL(
+            mu_thunk_compact_init(&jobs[i].thunk, (i & 1) ? b : a));
+        jobs[i].arg = (uint32_t)i + 1;
+    }
+    for (int i = 0; i < 2; i++) {
+        mu_thunk_compact_call(&jobs[i].thunk, &s_sum);
+    }
+    for (int i = 2; i < 4; i++) {
+        _mu_thunk_compact_call(&jobs[i].thunk, &s_sum);
+    }
+    TEST_ASSERT_EQUAL_INT(2, s_a_calls);
+    TEST_ASSERT_EQUAL_INT(2, s_b_calls);
+    TEST_ASSERT_EQUAL_UINT32(1 + 2 * 2 + 3 + 2 * 4, s_sum);
+    TEST_ASSERT_EQUAL_PTR(&s_sum, s_last_args);
+}
+
+void test_mu_thunk_compact_is_small(void) {
+    TEST_ASSERT_EQUAL_size_t(MU_THUNK_COMPACT_BITS / 8,
+                             sizeof(mu_thunk_compact_t));
+    // The job record above packs into 8 bytes (or 4 + 4 with 16-bit ids).
+    TEST_ASSERT_TRUE(sizeof(test_job_t) <= 8);
+    TEST_ASSERT_TRUE(sizeof(test_job_t) <
+                     sizeof(mu_thunk_t) + sizeof(uint32_t));
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_compact_param_validation);
+    RUN_TEST(test_mu_thunk_compact_register_is_idempotent);
+    RUN_TEST(test_mu_thunk_compact_register_at);
+    RUN_TEST(test_mu_thunk_compact_dispatch);
+    RUN_TEST(test_mu_thunk_compact_is_small);
+
+    return UNITY_END();
+}
@@ -0,0 +1,259 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_coro.hpp"
+#include "unity.h"
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_CAPACITY 8
+#define N_WORKERS 2
+// Deep enough that nested resumption would overflow an 8 MiB stack.
+#define CHAIN_DEPTH 200000
+#define N_SYNC_AWAITS 1000000
+
+namespace {
+
+mu_thunk_pool_t s_pool;
+mu_thunk_pool_worker_t s_workers[N_WORKERS];
+
+mu::task<int> answer() { co_return 42; }
+
+mu::task<int> add(int a, int b) { co_return a + b; }
+
+mu::task<int> sum_two() {
+    int a = co_await add(1, 2);
+    int b = co_await add(a, 10);
+    co_return b;
+}
+
+mu::task<long> chain(int depth) {
+    if (depth == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await chain(depth - 1);
+}
+
+mu::task<long> many_sync_awaits() {
+    long total = 0;
+    for (int i = 0; i < N_SYNC_AWAITS; i++) {
+        total += co_await answer();
+    }
+    co_return total;
+}
+
+mu::task<int> hop_ring(mu_thunk_ring_t *ring, int *steps) {
+    for (int i = 0; i < 3; i++) {
+        (*steps)++;
+        co_await mu::post(ring);
+    }
+    co_return *steps;
+}
+
+mu::task<void> hop_mpsc(mu_thunk_mpsc_t *q, int *steps) {
+    (*steps)++;
+    co_await mu::post(q);
+    (*steps)++;
+    co_await mu::post(q);
+    (*steps)++;
+}
+
+mu::task<int> hop_pool(std::atomic<bool> *finished) {
+    int hops = 0;
+    for (int i = 0; i < 100; i++) {
+        co_await mu::post(&s_pool);
+        hops++;
+    }
+    finished->store(true, std::memory_order_release);
+    co_return hops;
+}
+
+mu::task<int> thrower() {
+    throw std::runtime_error("boom");
+    co_return 0;
+}
+
+mu::task<int> catcher() {
+    try {
+        co_await thrower();
+    } catch (const std::runtime_error &) {
+        co_return 1;
+    }
+    co_return 0;
+}
+
+void start(mu_thunk_t *thunk) { _mu_thunk_call(thunk, nullptr); }
+
+} // namespace
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_coro_start_by_thunk(void) {
+    mu::task<int> t = answer();
+    // Lazily started: nothing runs until the thunk is called.
+    TEST_ASSERT_FALSE(t.done());
+    start(t.thunk());
+    TEST_ASSERT_TRUE(t.done());
+    TEST_ASSERT_EQUAL_INT(42, t.result());
+
+    mu::task<int> s = sum_two();
+    start(s.thunk());
+    TEST_ASSERT_TRUE(s.done());
+    TEST_ASSERT_EQUAL_INT(13, s.result());
+
+    mu::task<int> none;
+    TEST_ASSERT_TRUE(none.done());
+}
+
+void test_mu_thunk_coro_deep_await_chain(void) {
+    mu::task<long> deep = chain(CHAIN_DEPTH);
+    start(deep.thunk());
+    TEST_ASSERT_TRUE(deep.done());
+    TEST_ASSERT_EQUAL_INT64(CHAIN_DEPTH, deep.result());
+
+    mu::task<long> wide = many_sync_awaits();
+    start(wide.thunk());
+    TEST_ASSERT_TRUE(wide.done());
+    TEST_ASSERT_EQUAL_INT64(42L * N_SYNC_AWAITS, wide.result());
+}
+
+void test_mu_thunk_coro_post_ring(void) {
+    mu_thunk_ring_t ring;
+    mu_thunk_t *store[RING_CAPACITY];
+    mu_thunk_ring_init(&ring, store, RING_CAPACITY);
+    int steps = 0;
+    mu::task<int> t = hop_ring(&ring, &steps);
+    TEST_ASSERT_TRUE(mu_thunk_ring_put(&ring, t.thunk()));
+    int drains = 0;
+    while (!t.done()) {
+        TEST_ASSERT_EQUAL_size_t(1, mu_thunk_ring_drain(&ring, nullptr));
+        drains++;
+        TEST_ASSERT_EQUAL_INT(drains < 3 ? drains : 3, steps);
+    }
+    // The initial start plus one resume per hop.
+    TEST_ASSERT_EQUAL_INT(4, drains);
+    TEST_ASSERT_EQUAL_INT(3, t.result());
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&ring));
+}
+
+void test_mu_thunk_coro_post_mpsc(void) {
+    mu_thunk_mpsc_t q;
+    mu_thunk_mpsc_init(&q);
+    int steps = 0;
+    mu::task<void> t = hop_mpsc(&q, &steps);
+    start(t.thunk());
+    TEST_ASSERT_EQUAL_INT(1, steps);
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_mpsc_drain(&q, nullptr, 1));
+    TEST_ASSERT_EQUAL_INT(2, steps);
+    TEST_ASSERT_FALSE(t.done());
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_mpsc_drain(&q, nullptr, 0));
+    TEST_ASSERT_EQUAL_INT(3, steps);
+    TEST_ASSERT_TRUE(t.done());
+    t.result();
+}
+
+void test_mu_thunk_coro_post_pool(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_pool_init(&s_pool, s_workers, N_WORKERS));
+    std::atomic<bool> finished{false};
+    mu::task<int> t = hop_pool(&finished);
+    start(t.thunk());
+    while (!finished.load(std::memory_order_acquire)) {
+        mu_thunk_pool_help(&s_pool);
+    }
+    mu_thunk_pool_stop(&s_pool);
+    // Each hop resumed wherever the pool ran the thunk, possibly here.
+    TEST_ASSERT_TRUE(t.done());
+    TEST_ASSERT_EQUAL_INT(100, t.result());
+}
+
+void test_mu_thunk_coro_exception(void) {
+    mu::task<int> c = catcher();
+    start(c.thunk());
+    TEST_ASSERT_EQUAL_INT(1, c.result());
+
+    mu::task<int> t = thrower();
+    start(t.thunk());
+    TEST_ASSERT_TRUE(t.done());
+    bool caught = false;
+    try {
+        t.result();
+    } catch (const std::runtime_error &) {
+        caught = true;
+    }
+    TEST_ASSERT_TRUE(caught);
+}
+
+void test_mu_thunk_coro_frame_pool(void) {
+    mu_thunk_t *first;
+    {
+        mu::task<int> t = answer();
+        first = t.thunk();
+        start(first);
+    }
+    std::size_t cached = mu::coro_frame_pool::cached();
+    TEST_ASSERT_TRUE(cached >= 1);
+    // The next frame of the same size reuses the one just released.
+    mu::task<int> again = answer();
+    TEST_ASSERT_EQUAL_PTR(first, again.thunk());
+    TEST_ASSERT_EQUAL_size_t(cached - 1, mu::coro_frame_pool::cached());
+    // Frames beyond the pooled classes still work.
+    void *big = mu::coro_frame_pool::allocate(64 * 1024);
+    TEST_ASSERT_NOT_NULL(big);
+    mu::coro_frame_pool::deallocate(big, 64 * 1024);
+    TEST_ASSERT_EQUAL_size_t(cached - 1, mu::coro_frame_pool::cached());
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_coro_start_by_thunk);
+    RUN_TEST(test_mu_thunk_coro_deep_await_chain);
+    RUN_TEST(test_mu_thunk_coro_post_ring);
+    RUN_TEST(test_mu_thunk_coro_post_mpsc);
+    RUN_TEST(test_mu_thunk_coro_post_pool);
+    RUN_TEST(test_mu_thunk_coro_exception);
+    RUN_TEST(test_mu_thunk_coro_frame_pool);
+
+    return UNITY_END();
+}
@@ -0,0 +1,365 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_edf.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define CAPACITY 256
+#define N_RANDOM 20000
+
+typedef struct {
+    mu_thunk_edf_task_t task; /**< Must be first member */
+    int id;
+    uint64_t cost; /**< Fake clock advance while running */
+    int n_run;
+} test_task_t;
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    int n_missed;
+    mu_thunk_edf_task_t *last;
+    uint64_t extend; /**< If non-zero, reschedule late tasks by this much */
+} miss_handler_t;
+
+typedef struct {
+    test_task_t tt; /**< Must be first member */
+    uint64_t period;
+} periodic_task_t;
+
+static mu_thunk_edf_task_t *s_store[CAPACITY];
+static mu_thunk_edf_t s_edf;
+static uint64_t s_now;
+static int s_order[CAPACITY];
+static int s_n_order;
+
+static uint64_t fake_clock(void) { return s_now; }
+
+static void run_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    test_task_t *tt = (test_task_t *)thunk;
+    s_now += tt->cost;
+    tt->n_run++;
+    if (s_n_order < CAPACITY) {
+        s_order[s_n_order] = tt->id;
+    }
+    s_n_order++;
+}
+
+static void periodic_fn(mu_thunk_t *thunk, void *args) {
+    periodic_task_t *pt = (periodic_task_t *)thunk;
+    run_fn(thunk, args);
+    // Next job: released one period on, due one period after that.
+    uint64_t release = pt->tt.task.release + pt->period;
+    mu_thunk_edf_schedule_at(&s_edf, &pt->tt.task, release,
+                             release + pt->period);
+}
+
+static void miss_fn(mu_thunk_t *thunk, void *args) {
+    miss_handler_t *mh = (miss_handler_t *)thunk;
+    mh->n_missed++;
+    mh->last = (mu_thunk_edf_task_t *)args;
+    if (mh->extend != 0) {
+        mu_thunk_edf_schedule(&s_edf, mh->last, s_now + mh->extend);
+    }
+}
+
+static void test_task_init(test_task_t *tt, int id, uint64_t cost) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_edf_task_init(&tt->task, run_fn));
+    tt->id = id;
+    tt->cost = cost;
+    tt->n_run = 0;
+}
+
+static void miss_handler_init(miss_handler_t *mh, uint64_t extend) {
+    mu_thunk_init(&mh->thunk, miss_fn);
+    mh->n_missed = 0;
+    mh->last = NULL;
+    mh->extend = extend;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    s_now = 0;
+    s_n_order = 0;
+    TEST_ASSERT_NOT_NULL(
+        mu_thunk_edf_init(&s_edf, s_store, CAPACITY, fake_clock, NULL));
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_edf_param_validation(void) {
+    mu_thunk_edf_t edf;
+    mu_thunk_edf_task_t task, *store[1];
+    TEST_ASSERT_NULL(mu_thunk_edf_init(NULL, store, 1, NULL, NULL));
+    TEST_ASSERT_NULL(mu_thunk_edf_init(&edf, NULL, 1, NULL, NULL));
+    TEST_ASSERT_NULL(mu_thunk_edf_init(&edf, store, 0, NULL, NULL));
+    TEST_ASSERT_NOT_NULL(mu_thunk_edf_init(&edf, store, 1, NULL, NULL));
+    TEST_ASSERT_NULL(mu_thunk_edf_task_init(NULL, run_fn));
+    TEST_ASSERT_NULL(mu_thunk_edf_task_init(&task, NULL));
+    mu_thunk_edf_task_init(&task, run_fn);
+    TEST_ASSERT_FALSE(mu_thunk_edf_task_is_scheduled(&task));
+    TEST_ASSERT_FALSE(mu_thunk_edf_task_is_scheduled(NULL));
+    TEST_ASSERT_FALSE(mu_thunk_edf_schedule(NULL, &task, 1));
+    TEST_ASSERT_FALSE(mu_thunk_edf_schedule(&edf, NULL, 1));
+    TEST_ASSERT_FALSE(mu_thunk_edf_schedule_at(NULL, &task, 1, 2));
+    TEST_ASSERT_FALSE(mu_thunk_edf_schedule_at(&edf, NULL, 1, 2));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, mu_thunk_edf_next_release(&edf));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, mu_thunk_edf_next_release(NULL));
+    TEST_ASSERT_FALSE(mu_thunk_edf_cancel(&edf, &task));
+    TEST_ASSERT_FALSE(mu_thunk_edf_cancel(NULL, &task));
+    TEST_ASSERT_NULL(mu_thunk_edf_peek(&edf));
+    TEST_ASSERT_NULL(mu_thunk_edf_peek(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_edf_run(NULL, NULL, 0));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_edf_count(NULL));
+    TEST_ASSERT_EQUAL_UINT64(0, mu_thunk_edf_misses(NULL));
+    TEST_ASSERT_EQUAL_UINT64(0, mu_thunk_edf_dispatched(NULL));
+
+    // Full heap; a task on one scheduler cannot be moved via another.
+    mu_thunk_edf_task_t other;
+    mu_thunk_edf_task_init(&other, run_fn);
+    TEST_ASSERT_TRUE(mu_thunk_edf_schedule(&edf, &task, 5));
+    TEST_ASSERT_FALSE(mu_thunk_edf_schedule(&edf, &other, 5));
+    TEST_ASSERT_FALSE(mu_thunk_edf_schedule(&s_edf, &task, 5));
+    TEST_ASSERT_FALSE(mu_thunk_edf_cancel(&s_edf, &task));
+
+    // The default clock is monotonic.
+    uint64_t t0 = mu_thunk_edf_now_ns();
+    TEST_ASSERT_TRUE(mu_thunk_edf_now_ns() >= t0);
+}
+
+void test_mu_thunk_edf_deadline_order(void) {
+    static const uint64_t deadlines[] = {50, 10, 40, 20, 30, 60, 5};
+    static const int expected[] = {6, 1, 3, 4, 2, 0, 5};
+    test_task_t tasks[7];
+    for (int i = 0; i < 7; i++) {
+        test_task_init(&tasks[i], i, 0);
+        TEST_ASSERT_TRUE(
+            mu_thunk_edf_schedule(&s_edf, &tasks[i].task, deadlines[i]));
+    }
+    TEST_ASSERT_EQUAL_PTR(&tasks[6].task, mu_thunk_edf_peek(&s_edf));
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_edf_run(&s_edf, NULL, 2));
+    TEST_ASSERT_EQUAL_size_t(5, mu_thunk_edf_count(&s_edf));
+    TEST_ASSERT_EQUAL_size_t(5, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, s_order, 7);
+    TEST_ASSERT_EQUAL_UINT64(7, mu_thunk_edf_dispatched(&s_edf));
+    TEST_ASSERT_EQUAL_UINT64(0, mu_thunk_edf_misses(&s_edf));
+}
+
+void test_mu_thunk_edf_reschedule_and_cancel(void) {
+    test_task_t a, b, c;
+    test_task_init(&a, 0, 0);
+    test_task_init(&b, 1, 0);
+    test_task_init(&c, 2, 0);
+    mu_thunk_edf_schedule(&s_edf, &a.task, 10);
+    mu_thunk_edf_schedule(&s_edf, &b.task, 20);
+    mu_thunk_edf_schedule(&s_edf, &c.task, 30);
+    // Move c to the front and a to the back, then drop b.
+    TEST_ASSERT_TRUE(mu_thunk_edf_schedule(&s_edf, &c.task, 1));
+    TEST_ASSERT_TRUE(mu_thunk_edf_schedule(&s_edf, &a.task, 100));
+    TEST_ASSERT_EQUAL_size_t(3, mu_thunk_edf_count(&s_edf));
+    TEST_ASSERT_TRUE(mu_thunk_edf_cancel(&s_edf, &b.task));
+    TEST_ASSERT_FALSE(mu_thunk_edf_task_is_scheduled(&b.task));
+    TEST_ASSERT_FALSE(mu_thunk_edf_cancel(&s_edf, &b.task));
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(2, s_order[0]);
+    TEST_ASSERT_EQUAL_INT(0, s_order[1]);
+    TEST_ASSERT_EQUAL_INT(0, b.n_run);
+}
+
+void test_mu_thunk_edf_miss_callback(void) {
+    miss_handler_t mh;
+    test_task_t tasks[4];
+    static const uint64_t deadlines[] = {10, 20, 25, 26};
+    miss_handler_init(&mh, 0);
+    mu_thunk_edf_init(&s_edf, s_store, CAPACITY, fake_clock, &mh.thunk);
+    for (int i = 0; i < 4; i++) {
+        test_task_init(&tasks[i], i, 10);
+        mu_thunk_edf_schedule(&s_edf, &tasks[i].task, deadlines[i]);
+    }
+    // Starts at 0, 10, 20: on time.  Task 3 comes up at 30 > 26: shed.
+    TEST_ASSERT_EQUAL_size_t(4, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_UINT64(3, mu_thunk_edf_dispatched(&s_edf));
+    TEST_ASSERT_EQUAL_UINT64(1, mu_thunk_edf_misses(&s_edf));
+    TEST_ASSERT_EQUAL_INT(1, mh.n_missed);
+    TEST_ASSERT_EQUAL_PTR(&tasks[3].task, mh.last);
+    TEST_ASSERT_EQUAL_INT(0, tasks[3].n_run);
+    TEST_ASSERT_FALSE(mu_thunk_edf_task_is_scheduled(&tasks[3].task));
+}
+
+void test_mu_thunk_edf_miss_without_callback_runs_late(void) {
+    test_task_t a, b;
+    test_task_init(&a, 0, 10);
+    test_task_init(&b, 1, 10);
+    mu_thunk_edf_schedule(&s_edf, &a.task, 5);
+    mu_thunk_edf_schedule(&s_edf, &b.task, 6);
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, b.n_run);
+    TEST_ASSERT_EQUAL_UINT64(1, mu_thunk_edf_dispatched(&s_edf));
+    TEST_ASSERT_EQUAL_UINT64(1, mu_thunk_edf_misses(&s_edf));
+}
+
+void test_mu_thunk_edf_miss_callback_reschedules(void) {
+    miss_handler_t mh;
+    test_task_t a, b;
+    miss_handler_init(&mh, 100);
+    mu_thunk_edf_init(&s_edf, s_store, CAPACITY, fake_clock, &mh.thunk);
+    test_task_init(&a, 0, 50);
+    test_task_init(&b, 1, 1);
+    mu_thunk_edf_schedule(&s_edf, &a.task, 0);
+    mu_thunk_edf_schedule(&s_edf, &b.task, 10);
+    // b is late at 50 and gets a new deadline of 150, but runs in the next
+    // batch: a run takes only the tasks ready when it started.
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, mh.n_missed);
+    TEST_ASSERT_EQUAL_INT(0, b.n_run);
+    TEST_ASSERT_EQUAL_UINT64(150, b.task.deadline);
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, b.n_run);
+}
+
+void test_mu_thunk_edf_release_time(void) {
+    test_task_t early, late;
+    test_task_init(&early, 0, 0);
+    test_task_init(&late, 1, 0);
+    // The nearer deadline is not eligible until t = 50.
+    TEST_ASSERT_TRUE(mu_thunk_edf_schedule_at(&s_edf, &early.task, 50, 60));
+    TEST_ASSERT_TRUE(mu_thunk_edf_schedule(&s_edf, &late.task, 100));
+    TEST_ASSERT_EQUAL_PTR(&late.task, mu_thunk_edf_peek(&s_edf));
+    TEST_ASSERT_EQUAL_UINT64(50, mu_thunk_edf_next_release(&s_edf));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0, early.n_run);
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_edf_count(&s_edf));
+    TEST_ASSERT_TRUE(mu_thunk_edf_task_is_scheduled(&early.task));
+
+    // Moving or cancelling a waiting task works as for a ready one.
+    TEST_ASSERT_TRUE(mu_thunk_edf_schedule_at(&s_edf, &early.task, 40, 60));
+    TEST_ASSERT_EQUAL_UINT64(40, mu_thunk_edf_next_release(&s_edf));
+    TEST_ASSERT_TRUE(mu_thunk_edf_cancel(&s_edf, &early.task));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, mu_thunk_edf_next_release(&s_edf));
+    TEST_ASSERT_TRUE(mu_thunk_edf_schedule_at(&s_edf, &early.task, 40, 60));
+    s_now = 40;
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, early.n_run);
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_edf_count(&s_edf));
+}
+
+void test_mu_thunk_edf_periodic_self_reschedule(void) {
+    periodic_task_t pt;
+    test_task_t other;
+    test_task_init(&pt.tt, 7, 1);
+    pt.tt.task.thunk.fn = periodic_fn;
+    pt.period = 10;
+    test_task_init(&other, 0, 0);
+
+    // One job per period, however often the scheduler is run.
+    TEST_ASSERT_TRUE(mu_thunk_edf_schedule_at(&s_edf, &pt.tt.task, 0, 10));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, pt.tt.n_run);
+    TEST_ASSERT_NULL(mu_thunk_edf_peek(&s_edf));
+    TEST_ASSERT_EQUAL_UINT64(10, mu_thunk_edf_next_release(&s_edf));
+
+    // Once released the job competes on deadline: 20 beats 25.
+    mu_thunk_edf_schedule(&s_edf, &other.task, 25);
+    s_now = 10;
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(7, s_order[1]);
+    TEST_ASSERT_EQUAL_INT(0, s_order[2]);
+
+    // Far behind, every backlogged job is already due, yet a run still
+    // returns after the one job that was ready on entry.
+    s_now = 1000;
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_edf_run(&s_edf, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(3, pt.tt.n_run);
+    TEST_ASSERT_EQUAL_UINT64(1, mu_thunk_edf_misses(&s_edf));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_edf_count(&s_edf));
+}
+
+void test_mu_thunk_edf_random(void) {
+    // Pops must come out in non-decreasing deadline order whatever mix of
+    // schedule, reschedule and cancel built the heap.
+    static test_task_t tasks[CAPACITY];
+    size_t expected = 0;
+    srand(4242);
+    for (int i = 0; i < CAPACITY; i++) {
+        test_task_init(&tasks[i], i, 0);
+    }
+    for (int op = 0; op < N_RANDOM; op++) {
+        test_task_t *tt = &tasks[rand() % CAPACITY];
+        bool was = mu_thunk_edf_task_is_scheduled(&tt->task);
+        if (rand() % 4 == 0) {
+            TEST_ASSERT_EQUAL(was, mu_thunk_edf_cancel(&s_edf, &tt->task));
+            expected -= was;
+        } else {
+            TEST_ASSERT_TRUE(mu_thunk_edf_schedule(&s_edf, &tt->task,
+                                                   (uint64_t)rand() % 1000));
+            expected += !was;
+        }
+        TEST_ASSERT_EQUAL_size_t(expected, mu_thunk_edf_count(&s_edf));
+    }
+    uint64_t prev = 0;
+    mu_thunk_edf_task_t *task;
+    while ((task = mu_thunk_edf_peek(&s_edf)) != NULL) {
+        TEST_ASSERT_TRUE(task->deadline >= prev);
+        prev = task->deadline;
+        mu_thunk_edf_cancel(&s_edf, task);
+        expected--;
+    }
+    TEST_ASSERT_EQUAL_size_t(0, expected);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_edf_param_validation);
+    RUN_TEST(test_mu_thunk_edf_deadline_order);
+    RUN_TEST(test_mu_thunk_edf_reschedule_and_cancel);
+    RUN_TEST(test_mu_thunk_edf_miss_callback);
+    RUN_TEST(test_mu_thunk_edf_miss_without_callback_runs_late);
+    RUN_TEST(test_mu_thunk_edf_miss_callback_reschedules);
+    RUN_TEST(test_mu_thunk_edf_release_time);
+    RUN_TEST(test_mu_thunk_edf_periodic_self_reschedule);
+    RUN_TEST(test_mu_thunk_edf_random);
+
+    return UNITY_END();
+}
@@ -0,0 +1,266 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_exec.hpp"
+#include "unity.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_CAPACITY 8
+#define N_WORKERS 2
+
+namespace {
+
+struct outcome_t {
+    int values;
+    int errors;
+    int stops;
+    size_t n_values;
+    double sum;
+    std::exception_ptr error;
+    std::atomic<bool> done;
+};
+
+/** Records how (and with what) a sender completed. */
+struct recorder_t {
+    outcome_t *out;
+
+    template <typename... Vs> void set_value(Vs... vs) && noexcept {
+        out->values++;
+        out->n_values = sizeof...(Vs);
+        out->sum = (0.0 + ... + static_cast<double>(vs));
+        out->done.store(true, std::memory_order_release);
+    }
+
+    void set_error(std::exception_ptr e) && noexcept {
+        out->errors++;
+        out->error = e;
+        out->done.store(true, std::memory_order_release);
+    }
+
+    void set_stopped() && noexcept {
+        out->stops++;
+        out->done.store(true, std::memory_order_release);
+    }
+};
+
+mu_thunk_ring_t s_ring;
+mu_thunk_t *s_ring_store[RING_CAPACITY];
+mu_thunk_pool_t s_pool;
+mu_thunk_pool_worker_t s_workers[N_WORKERS];
+outcome_t s_out;
+std::atomic<size_t> s_allocs;
+
+int error_code_of(std::exception_ptr e) {
+    try {
+        std::rethrow_exception(e);
+    } catch (const std::system_error &err) {
+        return err.code().value();
+    } catch (...) {
+        return -1;
+    }
+}
+
+} // namespace
+
+// Count every allocation, so the tests can check pipelines make none.
+void *operator new(std::size_t size) {
+    s_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    mu_thunk_ring_init(&s_ring, s_ring_store, RING_CAPACITY);
+    s_out.values = s_out.errors = s_out.stops = 0;
+    s_out.n_values = 0;
+    s_out.sum = 0;
+    s_out.error = nullptr;
+    s_out.done.store(false);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_exec_schedule_ring(void) {
+    mu::ring_scheduler sched(&s_ring);
+    TEST_ASSERT_TRUE(sched == mu::ring_scheduler(&s_ring));
+    auto op = mu::connect(mu::schedule(sched), recorder_t{&s_out});
+    op.start();
+    // Enqueued, not run: the queued thunk is the op state itself.
+    TEST_ASSERT_EQUAL_INT(0, s_out.values);
+    mu_thunk_t *queued = mu_thunk_ring_get(&s_ring);
+    TEST_ASSERT_EQUAL_PTR(&op, queued);
+    _mu_thunk_call(queued, nullptr);
+    TEST_ASSERT_EQUAL_INT(1, s_out.values);
+    TEST_ASSERT_EQUAL_size_t(0, s_out.n_values);
+}
+
+void test_mu_thunk_exec_then_mpsc(void) {
+    mu_thunk_mpsc_t q;
+    mu_thunk_mpsc_init(&q);
+    mu::mpsc_scheduler sched(&q);
+    auto sndr = sched.schedule() | mu::then([] { return 2; }) |
+                mu::then([](int x) { return x * 3; });
+    static_assert(
+        std::is_same_v<decltype(sndr)::value_types, mu::values<int>>);
+    auto op = mu::connect(std::move(sndr), recorder_t{&s_out});
+    op.start();
+    TEST_ASSERT_FALSE(s_out.done.load());
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_mpsc_drain(&q, nullptr, 0));
+    TEST_ASSERT_EQUAL_INT(1, s_out.values);
+    TEST_ASSERT_EQUAL_size_t(1, s_out.n_values);
+    TEST_ASSERT_TRUE(s_out.sum == 6.0);
+}
+
+void test_mu_thunk_exec_then_throws(void) {
+    mu::ring_scheduler sched(&s_ring);
+    bool ran_next = false;
+    auto sndr = sched.schedule() |
+                mu::then([]() -> int { throw std::runtime_error("boom"); }) |
+                mu::then([&](int) { ran_next = true; });
+    auto op = mu::connect(std::move(sndr), recorder_t{&s_out});
+    op.start();
+    mu_thunk_ring_drain(&s_ring, nullptr);
+    TEST_ASSERT_FALSE(ran_next);
+    TEST_ASSERT_EQUAL_INT(1, s_out.errors);
+    TEST_ASSERT_EQUAL_INT(-1, error_code_of(s_out.error));
+}
+
+void test_mu_thunk_exec_when_all_pool(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_pool_init(&s_pool, s_workers, N_WORKERS));
+    mu::pool_scheduler sched(&s_pool);
+    std::atomic<int> side{0};
+    auto op = mu::connect(
+        mu::when_all(sched.schedule() | mu::then([] { return 1; }),
+                     sched.schedule() | mu::then([&] { side++; }),
+                     sched.schedule() | mu::then([] { return 2.5; }),
+                     sched.schedule() | mu::then([] { return 'c'; })),
+        recorder_t{&s_out});
+    op.start();
+    while (!s_out.done.load(std::memory_order_acquire)) {
+        mu_thunk_pool_help(&s_pool);
+    }
+    mu_thunk_pool_stop(&s_pool);
+    TEST_ASSERT_EQUAL_INT(1, s_out.values);
+    TEST_ASSERT_EQUAL_INT(1, side.load());
+    // The void child contributes no value.
+    TEST_ASSERT_EQUAL_size_t(3, s_out.n_values);
+    TEST_ASSERT_TRUE(s_out.sum == 1 + 2.5 + 'c');
+}
+
+void test_mu_thunk_exec_when_all_empty(void) {
+    auto op = mu::connect(mu::when_all(), recorder_t{&s_out});
+    TEST_ASSERT_FALSE(s_out.done.load());
+    op.start();
+    TEST_ASSERT_EQUAL_INT(1, s_out.values);
+    TEST_ASSERT_EQUAL_size_t(0, s_out.n_values);
+}
+
+void test_mu_thunk_exec_queue_full(void) {
+    mu_thunk_t filler;
+    for (int i = 0; i < RING_CAPACITY; i++) {
+        mu_thunk_ring_put(&s_ring, &filler);
+    }
+    mu::ring_scheduler sched(&s_ring);
+    auto op = mu::connect(sched.schedule(), recorder_t{&s_out});
+    op.start();
+    TEST_ASSERT_EQUAL_INT(1, s_out.errors);
+    TEST_ASSERT_EQUAL_INT(EAGAIN, error_code_of(s_out.error));
+
+    // In when_all the error wins, but only once every child is done.
+    mu_thunk_ring_get(&s_ring);
+    setUp();
+    for (int i = 0; i < RING_CAPACITY - 1; i++) {
+        mu_thunk_ring_put(&s_ring, &filler);
+    }
+    auto both = mu::connect(mu::when_all(sched.schedule(), sched.schedule()),
+                            recorder_t{&s_out});
+    both.start();
+    TEST_ASSERT_FALSE(s_out.done.load());
+    for (int i = 0; i < RING_CAPACITY - 1; i++) {
+        mu_thunk_ring_get(&s_ring);
+    }
+    mu_thunk_ring_drain(&s_ring, nullptr);
+    TEST_ASSERT_EQUAL_INT(1, s_out.errors);
+    TEST_ASSERT_EQUAL_INT(0, s_out.values);
+    TEST_ASSERT_EQUAL_INT(EAGAIN, error_code_of(s_out.error));
+}
+
+void test_mu_thunk_exec_no_allocation(void) {
+    mu::ring_scheduler sched(&s_ring);
+    size_t before = s_allocs.load();
+    {
+        auto op = mu::connect(
+            mu::when_all(sched.schedule() | mu::then([] { return 1; }),
+                         sched.schedule() | mu::then([] { return 2; })) |
+                mu::then([](int a, int b) { return a + b; }),
+            recorder_t{&s_out});
+        op.start();
+        mu_thunk_ring_drain(&s_ring, nullptr);
+    }
+    TEST_ASSERT_EQUAL_size_t(before, s_allocs.load());
+    TEST_ASSERT_EQUAL_INT(1, s_out.values);
+    TEST_ASSERT_TRUE(s_out.sum == 3.0);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_exec_schedule_ring);
+    RUN_TEST(test_mu_thunk_exec_then_mpsc);
+    RUN_TEST(test_mu_thunk_exec_then_throws);
+    RUN_TEST(test_mu_thunk_exec_when_all_pool);
+    RUN_TEST(test_mu_thunk_exec_when_all_empty);
+    RUN_TEST(test_mu_thunk_exec_queue_full);
+    RUN_TEST(test_mu_thunk_exec_no_allocation);
+
+    return UNITY_END();
+}
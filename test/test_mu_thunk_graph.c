@@ -0,0 +1,229 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_graph.h"
+#include "unity.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_WORKERS 4
+#define N_NODES 2000
+#define MAX_SUCC 4
+
+typedef struct {
+    mu_thunk_graph_node_t node; /**< Must be first member */
+    mu_thunk_graph_node_t *succ[MAX_SUCC];
+    int id;
+    atomic_int runs;
+    int seq;    /**< Position in the global completion order */
+    void *args; /**< As passed to the last run */
+} task_t;
+
+static mu_thunk_pool_t s_pool;
+static mu_thunk_pool_worker_t s_workers[N_WORKERS];
+static mu_thunk_graph_t s_graph;
+static task_t s_tasks[N_NODES];
+static atomic_int s_seq;
+
+static void task_fn(mu_thunk_t *thunk, void *args) {
+    task_t *t = (task_t *)thunk;
+    t->args = args;
+    atomic_fetch_add(&t->runs, 1);
+    t->seq = atomic_fetch_add(&s_seq, 1);
+}
+
+static void add_task(int i) {
+    s_tasks[i].id = i;
+    atomic_store(&s_tasks[i].runs, 0);
+    s_tasks[i].args = NULL;
+    TEST_ASSERT_NOT_NULL(mu_thunk_graph_add(&s_graph, &s_tasks[i].node,
+                                            task_fn, s_tasks[i].succ,
+                                            MAX_SUCC));
+}
+
+static bool depend(int before, int after) {
+    return mu_thunk_graph_depend(&s_tasks[before].node, &s_tasks[after].node);
+}
+
+/** Random DAG: node i depends on up to 3 earlier nodes, within a window. */
+static void build_random(void) {
+    uint64_t rng = 0x9e3779b97f4a7c15ull;
+    for (int i = 0; i < N_NODES; i++) {
+        add_task(i);
+    }
+    for (int i = 1; i < N_NODES; i++) {
+        for (int k = 0; k < 3; k++) {
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            int window = i < 50 ? i : 50;
+            int before = i - 1 - (int)(rng % (uint64_t)window);
+            // Fails harmlessly once `before` has MAX_SUCC successors.
+            depend(before, i);
+        }
+    }
+}
+
+/** Every one of the first `n` nodes was passed `args`. */
+static void check_args(int n, void *args) {
+    for (int i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_PTR(args, s_tasks[i].args);
+    }
+}
+
+/** Every node ran exactly `runs` times, and after all its predecessors. */
+static void check_order(int runs) {
+    for (int i = 0; i < N_NODES; i++) {
+        task_t *t = &s_tasks[i];
+        TEST_ASSERT_EQUAL_INT(runs, atomic_load(&t->runs));
+        for (uint32_t k = 0; k < t->node.n_succ; k++) {
+            task_t *s = (task_t *)t->node.succ[k];
+            TEST_ASSERT_TRUE(t->seq < s->seq);
+        }
+    }
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_graph_init(&s_graph));
+    atomic_store(&s_seq, 0);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_graph_param_validation(void) {
+    mu_thunk_graph_t other;
+    mu_thunk_graph_init(&other);
+    TEST_ASSERT_NULL(mu_thunk_graph_init(NULL));
+    TEST_ASSERT_NULL(mu_thunk_graph_add(NULL, &s_tasks[0].node, task_fn,
+                                        NULL, 0));
+    TEST_ASSERT_NULL(mu_thunk_graph_add(&s_graph, NULL, task_fn, NULL, 0));
+    TEST_ASSERT_NULL(mu_thunk_graph_add(&s_graph, &s_tasks[0].node, NULL,
+                                        NULL, 0));
+    TEST_ASSERT_NULL(mu_thunk_graph_add(&s_graph, &s_tasks[0].node, task_fn,
+                                        NULL, 1));
+    TEST_ASSERT_NOT_NULL(mu_thunk_graph_add(&s_graph, &s_tasks[0].node,
+                                            task_fn, s_tasks[0].succ, 1));
+    TEST_ASSERT_NOT_NULL(mu_thunk_graph_add(&s_graph, &s_tasks[1].node,
+                                            task_fn, NULL, 0));
+    TEST_ASSERT_NOT_NULL(mu_thunk_graph_add(&other, &s_tasks[2].node,
+                                            task_fn, NULL, 0));
+    TEST_ASSERT_FALSE(mu_thunk_graph_depend(NULL, &s_tasks[1].node));
+    TEST_ASSERT_FALSE(mu_thunk_graph_depend(&s_tasks[0].node, NULL));
+    TEST_ASSERT_FALSE(depend(0, 0));
+    TEST_ASSERT_FALSE(depend(0, 2));
+    TEST_ASSERT_FALSE(depend(1, 0)); // no room in node 1
+    TEST_ASSERT_TRUE(depend(0, 1));
+    TEST_ASSERT_FALSE(depend(0, 1)); // node 0 is now full
+    TEST_ASSERT_FALSE(mu_thunk_graph_run(NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_graph_node_count(&s_graph));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_graph_node_count(NULL));
+}
+
+void test_mu_thunk_graph_serial_diamond(void) {
+    int args;
+    for (int i = 0; i < 4; i++) {
+        add_task(i);
+    }
+    // 0 -> {1, 2} -> 3
+    TEST_ASSERT_TRUE(depend(0, 1));
+    TEST_ASSERT_TRUE(depend(0, 2));
+    TEST_ASSERT_TRUE(depend(1, 3));
+    TEST_ASSERT_TRUE(depend(2, 3));
+    TEST_ASSERT_TRUE(mu_thunk_graph_is_acyclic(&s_graph));
+    TEST_ASSERT_TRUE(mu_thunk_graph_run(&s_graph, NULL, &args));
+    check_args(4, &args);
+    TEST_ASSERT_EQUAL_INT(0, s_tasks[0].seq);
+    TEST_ASSERT_EQUAL_INT(3, s_tasks[3].seq);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(1, atomic_load(&s_tasks[i].runs));
+    }
+}
+
+void test_mu_thunk_graph_detects_cycle(void) {
+    for (int i = 0; i < 3; i++) {
+        add_task(i);
+    }
+    TEST_ASSERT_TRUE(depend(0, 1));
+    TEST_ASSERT_TRUE(depend(1, 2));
+    TEST_ASSERT_TRUE(mu_thunk_graph_is_acyclic(&s_graph));
+    TEST_ASSERT_TRUE(depend(2, 1));
+    TEST_ASSERT_FALSE(mu_thunk_graph_is_acyclic(&s_graph));
+    TEST_ASSERT_TRUE(mu_thunk_graph_is_acyclic(NULL));
+}
+
+void test_mu_thunk_graph_pool_random_dag(void) {
+    int args;
+    build_random();
+    TEST_ASSERT_TRUE(mu_thunk_graph_is_acyclic(&s_graph));
+    TEST_ASSERT_NOT_NULL(mu_thunk_pool_init(&s_pool, s_workers, N_WORKERS));
+    TEST_ASSERT_TRUE(mu_thunk_graph_run(&s_graph, &s_pool, &args));
+    mu_thunk_pool_stop(&s_pool);
+    check_args(N_NODES, &args);
+    TEST_ASSERT_EQUAL_INT(N_NODES, atomic_load(&s_seq));
+    check_order(1);
+}
+
+void test_mu_thunk_graph_reusable(void) {
+    build_random();
+    TEST_ASSERT_NOT_NULL(mu_thunk_pool_init(&s_pool, s_workers, N_WORKERS));
+    for (int run = 1; run <= 3; run++) {
+        // Alternate pool and serial runs over the same nodes and edges.
+        TEST_ASSERT_TRUE(mu_thunk_graph_run(&s_graph, &s_pool, NULL));
+        check_order(2 * run - 1);
+        TEST_ASSERT_TRUE(mu_thunk_graph_run(&s_graph, NULL, NULL));
+        check_order(2 * run);
+    }
+    mu_thunk_pool_stop(&s_pool);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_graph_param_validation);
+    RUN_TEST(test_mu_thunk_graph_serial_diamond);
+    RUN_TEST(test_mu_thunk_graph_detects_cycle);
+    RUN_TEST(test_mu_thunk_graph_pool_random_dag);
+    RUN_TEST(test_mu_thunk_graph_reusable);
+
+    return UNITY_END();
+}
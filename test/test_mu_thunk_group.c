@@ -0,0 +1,329 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_group.h"
+#include "unity.h"
+#include <stddef.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define CAPACITY 32
+#define N_MANY_FNS (MU_THUNK_GROUP_MAX_FNS + 4)
+
+typedef struct {
+    mu_thunk_mpsc_node_t node; /**< Must be first member; thunk at offset 0 */
+    int id;
+    int calls;
+} test_thunk_t;
+
+static mu_thunk_t *s_store[2 * CAPACITY];
+static mu_thunk_group_t s_group;
+static int s_order[4 * CAPACITY];
+static int s_n_order;
+static size_t s_spans[8];
+static int s_n_spans;
+static mu_thunk_mpsc_t *s_repost_q;
+static mu_thunk_ring_t *s_nested_ring;
+
+static void record(mu_thunk_t *thunk) {
+    test_thunk_t *tt = (test_thunk_t *)thunk;
+    tt->calls++;
+    if (s_n_order < 4 * CAPACITY) {
+        s_order[s_n_order] = tt->id;
+    }
+    s_n_order++;
+}
+
+static void a_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    record(thunk);
+}
+
+static void b_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    record(thunk);
+}
+
+static void c_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    record(thunk);
+}
+
+static void repost_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    record(thunk);
+    mu_thunk_mpsc_put(s_repost_q, (mu_thunk_mpsc_node_t *)thunk);
+}
+
+static void nested_fn(mu_thunk_t *thunk, void *args) {
+    record(thunk);
+    mu_thunk_group_drain_ring(&s_group, s_nested_ring, args);
+}
+
+static void span_fn(mu_thunk_t **thunks, size_t n, void *args) {
+    (void)args;
+    if (s_n_spans < 8) {
+        s_spans[s_n_spans] = n;
+    }
+    s_n_spans++;
+    for (size_t i = 0; i < n; i++) {
+        record(thunks[i]);
+    }
+}
+
+// Enough distinct functions to overflow the group's table.
+#define MANY(n)                                                                \
+    static void many_##n(mu_thunk_t *thunk, void *args) {                      \
+        (void)args;                                                            \
+        record(thunk);                                                         \
+    }
+MANY(0) MANY(1) MANY(2) MANY(3) MANY(4) MANY(5) MANY(6) MANY(7) MANY(8)
+MANY(9) MANY(10) MANY(11) MANY(12) MANY(13) MANY(14) MANY(15) MANY(16)
+MANY(17) MANY(18) MANY(19)
+static const mu_thunk_fn s_many[] = {
+    many_0,  many_1,  many_2,  many_3,  many_4,  many_5,  many_6,
+    many_7,  many_8,  many_9,  many_10, many_11, many_12, many_13,
+    many_14, many_15, many_16, many_17, many_18, many_19};
+_Static_assert(sizeof(s_many) / sizeof(s_many[0]) >= N_MANY_FNS,
+               "define more MANY() functions");
+
+static void test_thunk_init(test_thunk_t *tt, mu_thunk_fn fn, int id) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_mpsc_node_init(&tt->node, fn));
+    tt->id = id;
+    tt->calls = 0;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_group_init(&s_group, s_store, CAPACITY));
+    s_n_order = 0;
+    s_n_spans = 0;
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_group_param_validation(void) {
+    mu_thunk_group_t group;
+    mu_thunk_t *thunks[1];
+    TEST_ASSERT_NULL(mu_thunk_group_init(NULL, s_store, CAPACITY));
+    TEST_ASSERT_NULL(mu_thunk_group_init(&group, NULL, CAPACITY));
+    TEST_ASSERT_NULL(mu_thunk_group_init(&group, s_store, 0));
+    TEST_ASSERT_FALSE(mu_thunk_group_set_span(NULL, a_fn, span_fn));
+    TEST_ASSERT_FALSE(mu_thunk_group_set_span(&s_group, NULL, span_fn));
+    TEST_ASSERT_TRUE(mu_thunk_group_set_span(&s_group, a_fn, NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_group_dispatch(NULL, thunks, 1, NULL));
+    TEST_ASSERT_EQUAL_size_t(
+        0, mu_thunk_group_dispatch(&s_group, NULL, 1, NULL));
+    TEST_ASSERT_EQUAL_size_t(
+        0, mu_thunk_group_dispatch(&s_group, thunks, 0, NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_group_drain_ring(NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_group_drain_mpsc(NULL, NULL, NULL, 0));
+}
+
+void test_mu_thunk_group_groups_stably(void) {
+    // a b a c b a  ->  a a a (0 2 5), b b (1 4), c (3)
+    static const int expected[] = {0, 2, 5, 1, 4, 3};
+    mu_thunk_fn fns[] = {a_fn, b_fn, a_fn, c_fn, b_fn, a_fn};
+    test_thunk_t tts[6];
+    mu_thunk_t *thunks[6];
+    for (int i = 0; i < 6; i++) {
+        test_thunk_init(&tts[i], fns[i], i);
+        thunks[i] = &tts[i].node.thunk;
+    }
+    TEST_ASSERT_EQUAL_size_t(
+        6, mu_thunk_group_dispatch(&s_group, thunks, 6, NULL));
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, s_order, 6);
+    // The caller's array is left as it was.
+    TEST_ASSERT_EQUAL_PTR(&tts[1].node.thunk, thunks[1]);
+}
+
+void test_mu_thunk_group_span_handler(void) {
+    static const int expected[] = {0, 2, 1, 3};
+    mu_thunk_fn fns[] = {a_fn, b_fn, a_fn, b_fn};
+    test_thunk_t tts[4];
+    mu_thunk_t *thunks[4];
+    for (int i = 0; i < 4; i++) {
+        test_thunk_init(&tts[i], fns[i], i);
+        thunks[i] = &tts[i].node.thunk;
+    }
+    TEST_ASSERT_TRUE(mu_thunk_group_set_span(&s_group, b_fn, span_fn));
+    mu_thunk_group_dispatch(&s_group, thunks, 4, NULL);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, s_order, 4);
+    TEST_ASSERT_EQUAL_INT(1, s_n_spans);
+    TEST_ASSERT_EQUAL_size_t(2, s_spans[0]);
+
+    // Unbinding restores per-thunk calls.
+    TEST_ASSERT_TRUE(mu_thunk_group_set_span(&s_group, b_fn, NULL));
+    mu_thunk_group_dispatch(&s_group, thunks, 4, NULL);
+    TEST_ASSERT_EQUAL_INT(1, s_n_spans);
+    TEST_ASSERT_EQUAL_INT(8, s_n_order);
+}
+
+void test_mu_thunk_group_overflow_runs_in_order(void) {
+    // Two rounds over N_MANY_FNS functions: the first MAX_FNS are grouped,
+    // the rest run after them in their original order.
+    test_thunk_t tts[2 * N_MANY_FNS];
+    mu_thunk_t *thunks[2 * N_MANY_FNS];
+    mu_thunk_t *store[4 * N_MANY_FNS];
+    mu_thunk_group_t group;
+    int expected[2 * N_MANY_FNS];
+    int k = 0;
+    // Large enough for a single pass.
+    mu_thunk_group_init(&group, store, 2 * N_MANY_FNS);
+    for (int i = 0; i < 2 * N_MANY_FNS; i++) {
+        test_thunk_init(&tts[i], s_many[i % N_MANY_FNS], i);
+        thunks[i] = &tts[i].node.thunk;
+    }
+    for (int f = 0; f < MU_THUNK_GROUP_MAX_FNS; f++) {
+        expected[k++] = f;
+        expected[k++] = f + N_MANY_FNS;
+    }
+    for (int i = 0; i < 2 * N_MANY_FNS; i++) {
+        if (i % N_MANY_FNS >= MU_THUNK_GROUP_MAX_FNS) {
+            expected[k++] = i;
+        }
+    }
+    mu_thunk_group_dispatch(&group, thunks, 2 * N_MANY_FNS, NULL);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, s_order, 2 * N_MANY_FNS);
+}
+
+void test_mu_thunk_group_drain_ring(void) {
+    mu_thunk_t *ring_store[4 * CAPACITY];
+    mu_thunk_ring_t ring;
+    test_thunk_t tts[3 * CAPACITY];
+    mu_thunk_ring_init(&ring, ring_store, 4 * CAPACITY);
+    for (int i = 0; i < 3 * CAPACITY; i++) {
+        test_thunk_init(&tts[i], (i & 1) ? b_fn : a_fn, i);
+        mu_thunk_ring_put(&ring, &tts[i].node.thunk);
+    }
+    // Three passes of CAPACITY; each runs its evens, then its odds.
+    TEST_ASSERT_EQUAL_size_t(3 * CAPACITY,
+                             mu_thunk_group_drain_ring(&s_group, &ring, NULL));
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&ring));
+    for (int pass = 0; pass < 3; pass++) {
+        for (int j = 0; j < CAPACITY / 2; j++) {
+            TEST_ASSERT_EQUAL_INT(pass * CAPACITY + 2 * j,
+                                  s_order[pass * CAPACITY + j]);
+            TEST_ASSERT_EQUAL_INT(pass * CAPACITY + 2 * j + 1,
+                                  s_order[pass * CAPACITY + CAPACITY / 2 + j]);
+        }
+    }
+}
+
+void test_mu_thunk_group_drain_mpsc(void) {
+    mu_thunk_mpsc_t q;
+    test_thunk_t tts[CAPACITY + 8];
+    mu_thunk_mpsc_init(&q);
+    for (int i = 0; i < CAPACITY + 8; i++) {
+        test_thunk_init(&tts[i], (i % 3 == 0) ? c_fn : a_fn, i);
+        mu_thunk_mpsc_put(&q, &tts[i].node);
+    }
+    TEST_ASSERT_EQUAL_size_t(5,
+                             mu_thunk_group_drain_mpsc(&s_group, &q, NULL, 5));
+    TEST_ASSERT_EQUAL_size_t(CAPACITY + 3,
+                             mu_thunk_group_drain_mpsc(&s_group, &q, NULL, 0));
+    TEST_ASSERT_TRUE(mu_thunk_mpsc_is_empty(&q));
+    for (int i = 0; i < CAPACITY + 8; i++) {
+        TEST_ASSERT_EQUAL_INT(1, tts[i].calls);
+    }
+}
+
+void test_mu_thunk_group_drain_mpsc_repost(void) {
+    mu_thunk_mpsc_t q;
+    test_thunk_t again, once;
+    mu_thunk_mpsc_init(&q);
+    s_repost_q = &q;
+    test_thunk_init(&again, repost_fn, 0);
+    test_thunk_init(&once, a_fn, 1);
+    mu_thunk_mpsc_put(&q, &again.node);
+    mu_thunk_mpsc_put(&q, &once.node);
+    // Unbounded, yet a node that re-posts itself runs once per drain.
+    TEST_ASSERT_EQUAL_size_t(2,
+                             mu_thunk_group_drain_mpsc(&s_group, &q, NULL, 0));
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_size_t(
+            1, mu_thunk_group_drain_mpsc(&s_group, &q, NULL, 0));
+    }
+    TEST_ASSERT_EQUAL_INT(4, again.calls);
+    TEST_ASSERT_EQUAL_INT(1, once.calls);
+}
+
+void test_mu_thunk_group_nested_drain(void) {
+    mu_thunk_t *ring_store[4];
+    mu_thunk_ring_t ring;
+    test_thunk_t outer[3], inner[3];
+    static const int expected[] = {0, 2, 1, 10, 11, 12};
+    mu_thunk_ring_init(&ring, ring_store, 4);
+    s_nested_ring = &ring;
+    test_thunk_init(&outer[0], a_fn, 0);
+    test_thunk_init(&outer[1], nested_fn, 1);
+    test_thunk_init(&outer[2], a_fn, 2);
+    for (int i = 0; i < 3; i++) {
+        test_thunk_init(&inner[i], (i & 1) ? a_fn : b_fn, 10 + i);
+        mu_thunk_ring_put(&ring, &inner[i].node.thunk);
+    }
+    mu_thunk_t *thunks[] = {&outer[0].node.thunk, &outer[1].node.thunk,
+                            &outer[2].node.thunk};
+    // The nested drain runs ungrouped, leaving the outer pass intact.
+    TEST_ASSERT_EQUAL_size_t(
+        3, mu_thunk_group_dispatch(&s_group, thunks, 3, NULL));
+    TEST_ASSERT_EQUAL_INT(6, s_n_order);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, s_order, 6);
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&ring));
+
+    // Grouping resumes once the outer pass is over.
+    TEST_ASSERT_EQUAL_size_t(
+        3, mu_thunk_group_dispatch(&s_group, thunks, 3, NULL));
+    TEST_ASSERT_EQUAL_INT(0, s_order[6]);
+    TEST_ASSERT_EQUAL_INT(2, s_order[7]);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_group_param_validation);
+    RUN_TEST(test_mu_thunk_group_groups_stably);
+    RUN_TEST(test_mu_thunk_group_span_handler);
+    RUN_TEST(test_mu_thunk_group_overflow_runs_in_order);
+    RUN_TEST(test_mu_thunk_group_drain_ring);
+    RUN_TEST(test_mu_thunk_group_drain_mpsc);
+    RUN_TEST(test_mu_thunk_group_drain_mpsc_repost);
+    RUN_TEST(test_mu_thunk_group_nested_drain);
+
+    return UNITY_END();
+}
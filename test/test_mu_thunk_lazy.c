@@ -0,0 +1,168 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_lazy.h"
+#include "unity.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_FORCERS 8
+#define TABLE_SIZE 256
+
+typedef struct {
+    mu_thunk_lazy_t lazy; /**< Must be first member */
+    uint32_t table[TABLE_SIZE];
+} squares_t;
+
+static atomic_int s_evaluations;
+static void *s_last_args;
+static squares_t s_squares;
+static void *s_forced[N_FORCERS];
+
+static void squares_fn(mu_thunk_t *thunk, void *args) {
+    squares_t *sq = (squares_t *)thunk;
+    atomic_fetch_add(&s_evaluations, 1);
+    s_last_args = args;
+    for (uint32_t i = 0; i < TABLE_SIZE; i++) {
+        sq->table[i] = i * i;
+    }
+    sq->lazy.value = sq->table;
+}
+
+static void slow_squares_fn(mu_thunk_t *thunk, void *args) {
+    // Stay in the running state long enough for the other forcers to
+    // arrive and sleep.
+    struct timespec ts = {.tv_sec = 0, .tv_nsec = 20 * 1000 * 1000};
+    nanosleep(&ts, NULL);
+    squares_fn(thunk, args);
+}
+
+static squares_t s_static_squares = {.lazy = MU_THUNK_LAZY_INIT(squares_fn)};
+
+static void *forcer_fn(void *arg) {
+    size_t i = (size_t)(uintptr_t)arg;
+    s_forced[i] = mu_thunk_lazy_force(&s_squares.lazy, arg);
+    return NULL;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_lazy_init(&s_squares.lazy, squares_fn));
+    atomic_store(&s_evaluations, 0);
+    s_last_args = NULL;
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_lazy_param_validation(void) {
+    mu_thunk_lazy_t lazy;
+    TEST_ASSERT_NULL(mu_thunk_lazy_init(NULL, squares_fn));
+    TEST_ASSERT_NULL(mu_thunk_lazy_init(&lazy, NULL));
+    TEST_ASSERT_NULL(mu_thunk_lazy_force(NULL, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_lazy_is_done(NULL));
+}
+
+void test_mu_thunk_lazy_evaluates_once(void) {
+    int a = 1, b = 2;
+    TEST_ASSERT_FALSE(mu_thunk_lazy_is_done(&s_squares.lazy));
+    uint32_t *table = mu_thunk_lazy_force(&s_squares.lazy, &a);
+    TEST_ASSERT_TRUE(mu_thunk_lazy_is_done(&s_squares.lazy));
+    TEST_ASSERT_EQUAL_PTR(s_squares.table, table);
+    TEST_ASSERT_EQUAL_UINT32(49, table[7]);
+    TEST_ASSERT_EQUAL_PTR(&a, s_last_args);
+    // Later forces return the cached result and ignore their args.
+    TEST_ASSERT_EQUAL_PTR(table, mu_thunk_lazy_force(&s_squares.lazy, &b));
+    TEST_ASSERT_EQUAL_PTR(table, mu_thunk_lazy_force_slow(&s_squares.lazy,
+                                                          &b));
+    TEST_ASSERT_EQUAL_INT(1, atomic_load(&s_evaluations));
+    TEST_ASSERT_EQUAL_PTR(&a, s_last_args);
+}
+
+void test_mu_thunk_lazy_static_initializer(void) {
+    TEST_ASSERT_FALSE(mu_thunk_lazy_is_done(&s_static_squares.lazy));
+    uint32_t *table = mu_thunk_lazy_force(&s_static_squares.lazy, NULL);
+    TEST_ASSERT_EQUAL_PTR(s_static_squares.table, table);
+    TEST_ASSERT_EQUAL_UINT32(100, table[10]);
+    TEST_ASSERT_EQUAL_INT(1, atomic_load(&s_evaluations));
+}
+
+void test_mu_thunk_lazy_reinit_reevaluates(void) {
+    mu_thunk_lazy_force(&s_squares.lazy, NULL);
+    s_squares.table[3] = 0;
+    TEST_ASSERT_NOT_NULL(mu_thunk_lazy_init(&s_squares.lazy, squares_fn));
+    TEST_ASSERT_NULL(s_squares.lazy.value);
+    uint32_t *table = mu_thunk_lazy_force(&s_squares.lazy, NULL);
+    TEST_ASSERT_EQUAL_UINT32(9, table[3]);
+    TEST_ASSERT_EQUAL_INT(2, atomic_load(&s_evaluations));
+}
+
+void test_mu_thunk_lazy_concurrent_force(void) {
+    pthread_t threads[N_FORCERS];
+    TEST_ASSERT_NOT_NULL(mu_thunk_lazy_init(&s_squares.lazy, slow_squares_fn));
+    for (size_t i = 0; i < N_FORCERS; i++) {
+        s_forced[i] = NULL;
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, forcer_fn,
+                                                (void *)(uintptr_t)i));
+    }
+    for (size_t i = 0; i < N_FORCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(1, atomic_load(&s_evaluations));
+    for (size_t i = 0; i < N_FORCERS; i++) {
+        // Every forcer, including those that slept, sees the full table.
+        TEST_ASSERT_EQUAL_PTR(s_squares.table, s_forced[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(255 * 255, s_squares.table[255]);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_lazy_param_validation);
+    RUN_TEST(test_mu_thunk_lazy_evaluates_once);
+    RUN_TEST(test_mu_thunk_lazy_static_initializer);
+    RUN_TEST(test_mu_thunk_lazy_reinit_reevaluates);
+    RUN_TEST(test_mu_thunk_lazy_concurrent_force);
+
+    return UNITY_END();
+}
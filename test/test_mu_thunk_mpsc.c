@@ -0,0 +1,232 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mu_thunk_mpsc.h"
+#include "unity.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_NODES 8
+#define N_PRODUCERS 4
+#define PER_PRODUCER 20000
+
+typedef struct {
+    mu_thunk_mpsc_node_t node; /**< Must be first member */
+    int id;
+    int call_count;
+} counting_node_t;
+
+typedef struct {
+    mu_thunk_mpsc_node_t node; /**< Must be first member */
+    int producer;
+    int seq;
+} tagged_node_t;
+
+typedef struct {
+    mu_thunk_mpsc_t *q;
+    tagged_node_t *nodes;
+} producer_ctx_t;
+
+static mu_thunk_mpsc_t s_q;
+static counting_node_t s_nodes[N_NODES];
+static int s_reposts;
+
+static void counting_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    counting_node_t *cn = (counting_node_t *)thunk;
+    cn->call_count++;
+}
+
+// Re-posts itself until s_reposts reaches zero.
+static void repost_fn(mu_thunk_t *thunk, void *args) {
+    counting_node_t *cn = (counting_node_t *)thunk;
+    cn->call_count++;
+    if (s_reposts-- > 0) {
+        mu_thunk_mpsc_put((mu_thunk_mpsc_t *)args, &cn->node);
+    }
+}
+
+static void tagged_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+static void *producer_fn(void *arg) {
+    producer_ctx_t *ctx = (producer_ctx_t *)arg;
+    for (int i = 0; i < PER_PRODUCER; i++) {
+        mu_thunk_mpsc_put(ctx->q, &ctx->nodes[i].node);
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_mpsc_init(&s_q));
+    for (int i = 0; i < N_NODES; i++) {
+        mu_thunk_mpsc_node_init(&s_nodes[i].node, counting_fn);
+        s_nodes[i].id = i;
+        s_nodes[i].call_count = 0;
+    }
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_mpsc_param_validation(void) {
+    mu_thunk_mpsc_node_t node;
+    TEST_ASSERT_NULL(mu_thunk_mpsc_init(NULL));
+    TEST_ASSERT_NULL(mu_thunk_mpsc_node_init(NULL, counting_fn));
+    TEST_ASSERT_NULL(mu_thunk_mpsc_node_init(&node, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_mpsc_put(NULL, &s_nodes[0].node));
+    TEST_ASSERT_FALSE(mu_thunk_mpsc_put(&s_q, NULL));
+    TEST_ASSERT_NULL(mu_thunk_mpsc_get(NULL));
+    TEST_ASSERT_TRUE(mu_thunk_mpsc_is_empty(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_mpsc_drain(NULL, NULL, 0));
+}
+
+void test_mu_thunk_mpsc_put_get_fifo(void) {
+    TEST_ASSERT_TRUE(mu_thunk_mpsc_is_empty(&s_q));
+    TEST_ASSERT_NULL(mu_thunk_mpsc_get(&s_q));
+
+    for (int i = 0; i < N_NODES; i++) {
+        TEST_ASSERT_TRUE(mu_thunk_mpsc_put(&s_q, &s_nodes[i].node));
+        TEST_ASSERT_FALSE(mu_thunk_mpsc_is_empty(&s_q));
+    }
+    for (int i = 0; i < N_NODES; i++) {
+        TEST_ASSERT_EQUAL_PTR(&s_nodes[i].node, mu_thunk_mpsc_get(&s_q));
+    }
+    TEST_ASSERT_NULL(mu_thunk_mpsc_get(&s_q));
+    TEST_ASSERT_TRUE(mu_thunk_mpsc_is_empty(&s_q));
+}
+
+void test_mu_thunk_mpsc_single_node_cycles(void) {
+    // Exercises the path where the stub is re-inserted behind the last node.
+    for (int i = 0; i < 3; i++) {
+        mu_thunk_mpsc_put(&s_q, &s_nodes[0].node);
+        TEST_ASSERT_EQUAL_PTR(&s_nodes[0].node, mu_thunk_mpsc_get(&s_q));
+        TEST_ASSERT_NULL(mu_thunk_mpsc_get(&s_q));
+        TEST_ASSERT_TRUE(mu_thunk_mpsc_is_empty(&s_q));
+    }
+}
+
+void test_mu_thunk_mpsc_drain_batches(void) {
+    for (int i = 0; i < N_NODES; i++) {
+        mu_thunk_mpsc_put(&s_q, &s_nodes[i].node);
+    }
+    TEST_ASSERT_EQUAL_size_t(3, mu_thunk_mpsc_drain(&s_q, NULL, 3));
+    TEST_ASSERT_EQUAL_INT(1, s_nodes[2].call_count);
+    TEST_ASSERT_EQUAL_INT(0, s_nodes[3].call_count);
+    TEST_ASSERT_EQUAL_size_t(N_NODES - 3, mu_thunk_mpsc_drain(&s_q, NULL, 0));
+    for (int i = 0; i < N_NODES; i++) {
+        TEST_ASSERT_EQUAL_INT(1, s_nodes[i].call_count);
+    }
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_mpsc_drain(&s_q, NULL, 0));
+}
+
+void test_mu_thunk_mpsc_repost_from_thunk(void) {
+    counting_node_t cn = {.call_count = 0};
+    mu_thunk_mpsc_node_init(&cn.node, repost_fn);
+    s_reposts = 4;
+    mu_thunk_mpsc_put(&s_q, &cn.node);
+    // Each unbounded drain runs only what was queued on entry, so a node
+    // that always re-posts itself cannot keep the drain going.
+    for (int i = 1; i <= 5; i++) {
+        TEST_ASSERT_EQUAL_size_t(1, mu_thunk_mpsc_drain(&s_q, &s_q, 0));
+        TEST_ASSERT_EQUAL_INT(i, cn.call_count);
+    }
+    TEST_ASSERT_TRUE(mu_thunk_mpsc_is_empty(&s_q));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_mpsc_drain(&s_q, &s_q, 0));
+
+    // Re-posted ahead of other nodes: those still run, the re-post waits.
+    s_reposts = 1;
+    mu_thunk_mpsc_put(&s_q, &cn.node);
+    mu_thunk_mpsc_put(&s_q, &s_nodes[0].node);
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_mpsc_drain(&s_q, &s_q, 0));
+    TEST_ASSERT_EQUAL_INT(1, s_nodes[0].call_count);
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_mpsc_drain(&s_q, &s_q, 0));
+    TEST_ASSERT_EQUAL_INT(7, cn.call_count);
+    TEST_ASSERT_TRUE(mu_thunk_mpsc_is_empty(&s_q));
+}
+
+// Several producers: every node arrives exactly once and each producer's
+// nodes arrive in the order they were posted.
+void test_mu_thunk_mpsc_threaded(void) {
+    static tagged_node_t nodes[N_PRODUCERS][PER_PRODUCER];
+    producer_ctx_t ctx[N_PRODUCERS];
+    pthread_t threads[N_PRODUCERS];
+    int next_seq[N_PRODUCERS] = {0};
+
+    for (int p = 0; p < N_PRODUCERS; p++) {
+        for (int i = 0; i < PER_PRODUCER; i++) {
+            mu_thunk_mpsc_node_init(&nodes[p][i].node, tagged_fn);
+            nodes[p][i].producer = p;
+            nodes[p][i].seq = i;
+        }
+        ctx[p].q = &s_q;
+        ctx[p].nodes = nodes[p];
+        pthread_create(&threads[p], NULL, producer_fn, &ctx[p]);
+    }
+
+    int received = 0;
+    while (received < N_PRODUCERS * PER_PRODUCER) {
+        tagged_node_t *tn = (tagged_node_t *)mu_thunk_mpsc_get(&s_q);
+        if (tn == NULL) {
+            sched_yield();
+            continue;
+        }
+        TEST_ASSERT_EQUAL_INT(next_seq[tn->producer], tn->seq);
+        next_seq[tn->producer]++;
+        received++;
+    }
+    for (int p = 0; p < N_PRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+    }
+    TEST_ASSERT_TRUE(mu_thunk_mpsc_is_empty(&s_q));
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_mpsc_param_validation);
+    RUN_TEST(test_mu_thunk_mpsc_put_get_fifo);
+    RUN_TEST(test_mu_thunk_mpsc_single_node_cycles);
+    RUN_TEST(test_mu_thunk_mpsc_drain_batches);
+    RUN_TEST(test_mu_thunk_mpsc_repost_from_thunk);
+    RUN_TEST(test_mu_thunk_mpsc_threaded);
+
+    return UNITY_END();
+}
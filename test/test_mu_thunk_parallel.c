@@ -0,0 +1,233 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_parallel.h"
+#include "unity.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_WORKERS 4
+#define N_ITEMS 100000
+#define N_OUTER 16
+#define N_INNER 1000
+
+/** Accumulator that records which contiguous range it has covered. */
+typedef struct {
+    size_t first;
+    size_t last;
+    bool empty;
+    bool ordered;
+} span_acc_t;
+
+static mu_thunk_pool_t s_pool;
+static mu_thunk_pool_worker_t s_workers[N_WORKERS];
+static atomic_uchar s_hits[N_ITEMS];
+static atomic_int s_inner_total;
+
+static void mark_fn(size_t begin, size_t end, void *ctx) {
+    (void)ctx;
+    for (size_t i = begin; i < end; i++) {
+        atomic_fetch_add(&s_hits[i], 1);
+    }
+}
+
+static void sum_fn(size_t begin, size_t end, void *acc, void *ctx) {
+    const uint32_t *values = ctx;
+    for (size_t i = begin; i < end; i++) {
+        *(uint64_t *)acc += values[i];
+    }
+}
+
+static void add_fn(void *acc, const void *right, void *ctx) {
+    (void)ctx;
+    *(uint64_t *)acc += *(const uint64_t *)right;
+}
+
+static void span_fn(size_t begin, size_t end, void *acc, void *ctx) {
+    (void)ctx;
+    span_acc_t *a = acc;
+    if (a->empty) {
+        a->first = begin;
+        a->empty = false;
+    } else if (begin != a->last) {
+        a->ordered = false;
+    }
+    a->last = end;
+}
+
+static void span_combine_fn(void *acc, const void *right, void *ctx) {
+    (void)ctx;
+    span_acc_t *a = acc;
+    const span_acc_t *b = right;
+    if (b->empty) {
+        return;
+    }
+    if (a->empty) {
+        *a = *b;
+        return;
+    }
+    a->ordered = a->ordered && b->ordered && a->last == b->first;
+    a->last = b->last;
+}
+
+static void inner_fn(size_t begin, size_t end, void *ctx) {
+    (void)ctx;
+    atomic_fetch_add(&s_inner_total, (int)(end - begin));
+}
+
+static void outer_fn(size_t begin, size_t end, void *ctx) {
+    (void)ctx;
+    for (size_t i = begin; i < end; i++) {
+        mu_thunk_parallel_for(&s_pool, 0, N_INNER, 10, inner_fn, NULL);
+    }
+}
+
+static void clear_hits(void) {
+    for (size_t i = 0; i < N_ITEMS; i++) {
+        atomic_store(&s_hits[i], 0);
+    }
+}
+
+static bool hit_once(size_t begin, size_t end) {
+    for (size_t i = 0; i < N_ITEMS; i++) {
+        unsigned expect = (i >= begin && i < end) ? 1 : 0;
+        if (atomic_load(&s_hits[i]) != expect) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_pool_init(&s_pool, s_workers, N_WORKERS));
+    clear_hits();
+    atomic_store(&s_inner_total, 0);
+}
+
+void tearDown(void) {
+    mu_thunk_pool_stop(&s_pool);
+}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_parallel_param_validation(void) {
+    uint64_t acc = 0;
+    TEST_ASSERT_FALSE(mu_thunk_parallel_for(NULL, 0, 1, 0, mark_fn, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_parallel_for(&s_pool, 0, 1, 0, NULL, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_parallel_for(&s_pool, 2, 1, 0, mark_fn, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_parallel_reduce(NULL, 0, 1, 0, &acc,
+                                               sizeof(acc), sum_fn, add_fn,
+                                               NULL));
+    TEST_ASSERT_FALSE(mu_thunk_parallel_reduce(&s_pool, 0, 1, 0, NULL,
+                                               sizeof(acc), sum_fn, add_fn,
+                                               NULL));
+    TEST_ASSERT_FALSE(mu_thunk_parallel_reduce(
+        &s_pool, 0, 1, 0, &acc, MU_THUNK_PARALLEL_MAX_ACC + 1, sum_fn,
+        add_fn, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_parallel_reduce(&s_pool, 0, 1, 0, &acc,
+                                               sizeof(acc), NULL, add_fn,
+                                               NULL));
+    TEST_ASSERT_FALSE(mu_thunk_parallel_reduce(&s_pool, 0, 1, 0, &acc,
+                                               sizeof(acc), sum_fn, NULL,
+                                               NULL));
+    // An empty range is valid and runs nothing.
+    TEST_ASSERT_TRUE(mu_thunk_parallel_for(&s_pool, 5, 5, 0, mark_fn, NULL));
+    TEST_ASSERT_TRUE(hit_once(0, 0));
+}
+
+void test_mu_thunk_parallel_for_covers_range_once(void) {
+    static const size_t grains[] = {0, 1, 7, 1000, N_ITEMS, 2 * N_ITEMS};
+    for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+        clear_hits();
+        TEST_ASSERT_TRUE(mu_thunk_parallel_for(&s_pool, 3, N_ITEMS - 5,
+                                               grains[g], mark_fn, NULL));
+        TEST_ASSERT_TRUE_MESSAGE(hit_once(3, N_ITEMS - 5), "grain");
+    }
+}
+
+void test_mu_thunk_parallel_reduce_sum(void) {
+    static uint32_t values[N_ITEMS];
+    uint64_t expect = 0;
+    for (size_t i = 0; i < N_ITEMS; i++) {
+        values[i] = (uint32_t)(i * 2654435761u);
+        expect += values[i];
+    }
+    uint64_t acc = 0;
+    TEST_ASSERT_TRUE(mu_thunk_parallel_reduce(&s_pool, 0, N_ITEMS, 0, &acc,
+                                              sizeof(acc), sum_fn, add_fn,
+                                              values));
+    TEST_ASSERT_EQUAL_UINT64(expect, acc);
+    // A small grain hits the chunk cap, which widens the grain instead.
+    acc = 0;
+    TEST_ASSERT_TRUE(mu_thunk_parallel_reduce(&s_pool, 0, N_ITEMS, 3, &acc,
+                                              sizeof(acc), sum_fn, add_fn,
+                                              values));
+    TEST_ASSERT_EQUAL_UINT64(expect, acc);
+}
+
+void test_mu_thunk_parallel_reduce_combines_in_order(void) {
+    span_acc_t acc = {.empty = true, .ordered = true};
+    TEST_ASSERT_TRUE(mu_thunk_parallel_reduce(&s_pool, 10, N_ITEMS, 100,
+                                              &acc, sizeof(acc), span_fn,
+                                              span_combine_fn, NULL));
+    TEST_ASSERT_FALSE(acc.empty);
+    TEST_ASSERT_TRUE(acc.ordered);
+    TEST_ASSERT_EQUAL_size_t(10, acc.first);
+    TEST_ASSERT_EQUAL_size_t(N_ITEMS, acc.last);
+}
+
+void test_mu_thunk_parallel_nested(void) {
+    TEST_ASSERT_TRUE(
+        mu_thunk_parallel_for(&s_pool, 0, N_OUTER, 1, outer_fn, NULL));
+    TEST_ASSERT_EQUAL_INT(N_OUTER * N_INNER, atomic_load(&s_inner_total));
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_parallel_param_validation);
+    RUN_TEST(test_mu_thunk_parallel_for_covers_range_once);
+    RUN_TEST(test_mu_thunk_parallel_reduce_sum);
+    RUN_TEST(test_mu_thunk_parallel_reduce_combines_in_order);
+    RUN_TEST(test_mu_thunk_parallel_nested);
+
+    return UNITY_END();
+}
@@ -0,0 +1,173 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mu_thunk_pool.h"
+#include "unity.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_WORKERS 4
+#define N_TASKS 1000
+
+#define N_TREE 4095
+
+// Nodes form an implicit binary tree: node i spawns nodes 2i+1 and 2i+2.
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    int index;
+} tree_thunk_t;
+
+static mu_thunk_pool_t s_pool;
+static mu_thunk_pool_worker_t s_workers[N_WORKERS];
+static atomic_int s_calls;
+static atomic_int s_arg_sum;
+static tree_thunk_t s_tree[N_TREE];
+
+static void counting_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    atomic_fetch_add(&s_calls, 1);
+}
+
+static void args_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    atomic_fetch_add(&s_arg_sum, *(int *)args);
+    atomic_fetch_add(&s_calls, 1);
+}
+
+static void tree_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    tree_thunk_t *tt = (tree_thunk_t *)thunk;
+    atomic_fetch_add(&s_calls, 1);
+    for (int child = 2 * tt->index + 1; child <= 2 * tt->index + 2; child++) {
+        // Only fails when called on a non-worker thread (the test thread
+        // helping) and the injection queue is full.
+        while (child < N_TREE &&
+               !mu_thunk_pool_submit(&s_pool, &s_tree[child].thunk, NULL)) {
+            mu_thunk_pool_help(&s_pool);
+        }
+    }
+}
+
+static void wait_for_calls(int n) {
+    while (atomic_load(&s_calls) < n) {
+        mu_thunk_pool_help(&s_pool);
+    }
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    atomic_store(&s_calls, 0);
+    atomic_store(&s_arg_sum, 0);
+    TEST_ASSERT_NOT_NULL(mu_thunk_pool_init(&s_pool, s_workers, N_WORKERS));
+}
+
+void tearDown(void) { mu_thunk_pool_stop(&s_pool); }
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_pool_param_validation(void) {
+    mu_thunk_pool_t pool;
+    mu_thunk_t thunk = MU_THUNK_NULL;
+    TEST_ASSERT_NULL(mu_thunk_pool_init(NULL, s_workers, N_WORKERS));
+    TEST_ASSERT_NULL(mu_thunk_pool_init(&pool, NULL, N_WORKERS));
+    TEST_ASSERT_NULL(mu_thunk_pool_init(&pool, s_workers, 0));
+    TEST_ASSERT_FALSE(mu_thunk_pool_submit(NULL, &thunk, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_pool_submit(&s_pool, NULL, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_pool_submit(&s_pool, &thunk, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_pool_help(NULL));
+    TEST_ASSERT_EQUAL_size_t(N_WORKERS, mu_thunk_pool_worker_count(&s_pool));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_pool_worker_count(NULL));
+}
+
+void test_mu_thunk_pool_runs_external_submissions(void) {
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, counting_fn);
+    for (int i = 0; i < N_TASKS; i++) {
+        while (!mu_thunk_pool_submit(&s_pool, &thunk, NULL)) {
+            mu_thunk_pool_help(&s_pool);
+        }
+    }
+    wait_for_calls(N_TASKS);
+    TEST_ASSERT_EQUAL_INT(N_TASKS, atomic_load(&s_calls));
+}
+
+void test_mu_thunk_pool_passes_args(void) {
+    static int values[N_TASKS];
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, args_fn);
+    int expected = 0;
+    for (int i = 0; i < N_TASKS; i++) {
+        values[i] = i;
+        expected += i;
+        while (!mu_thunk_pool_submit(&s_pool, &thunk, &values[i])) {
+            mu_thunk_pool_help(&s_pool);
+        }
+    }
+    wait_for_calls(N_TASKS);
+    TEST_ASSERT_EQUAL_INT(expected, atomic_load(&s_arg_sum));
+}
+
+// Thunks submitted from worker threads go to the workers' own deques and are
+// spread across the pool by stealing.
+void test_mu_thunk_pool_nested_submissions(void) {
+    for (int i = 0; i < N_TREE; i++) {
+        mu_thunk_init(&s_tree[i].thunk, tree_fn);
+        s_tree[i].index = i;
+    }
+    TEST_ASSERT_TRUE(mu_thunk_pool_submit(&s_pool, &s_tree[0].thunk, NULL));
+    wait_for_calls(N_TREE);
+    TEST_ASSERT_EQUAL_INT(N_TREE, atomic_load(&s_calls));
+}
+
+void test_mu_thunk_pool_stop_is_idempotent(void) {
+    mu_thunk_pool_stop(&s_pool);
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_pool_worker_count(&s_pool));
+    mu_thunk_pool_stop(NULL);
+    TEST_ASSERT_NOT_NULL(mu_thunk_pool_init(&s_pool, s_workers, N_WORKERS));
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_pool_param_validation);
+    RUN_TEST(test_mu_thunk_pool_runs_external_submissions);
+    RUN_TEST(test_mu_thunk_pool_passes_args);
+    RUN_TEST(test_mu_thunk_pool_nested_submissions);
+    RUN_TEST(test_mu_thunk_pool_stop_is_idempotent);
+
+    return UNITY_END();
+}
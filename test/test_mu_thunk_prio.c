@@ -0,0 +1,286 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_prio.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_NODES 64
+#define N_RANDOM 20000
+
+typedef struct {
+    mu_thunk_prio_node_t node; /**< Must be first member */
+    int id;
+    mu_thunk_prio_node_t *spawn; /**< Queued by spawn_fn, if set */
+    unsigned spawn_priority;
+} test_node_t;
+
+static mu_thunk_prio_t s_queue;
+static int s_order[N_NODES];
+static int s_n_order;
+
+static void record_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    test_node_t *tn = (test_node_t *)thunk;
+    if (s_n_order < N_NODES) {
+        s_order[s_n_order] = tn->id;
+    }
+    s_n_order++;
+}
+
+static void spawn_fn(mu_thunk_t *thunk, void *args) {
+    test_node_t *tn = (test_node_t *)thunk;
+    record_fn(thunk, args);
+    mu_thunk_prio_put((mu_thunk_prio_t *)args, tn->spawn, tn->spawn_priority);
+}
+
+static void test_node_init(test_node_t *tn, mu_thunk_fn fn, int id) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_prio_node_init(&tn->node, fn));
+    tn->id = id;
+    tn->spawn = NULL;
+    tn->spawn_priority = 0;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_prio_init(&s_queue));
+    s_n_order = 0;
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_prio_param_validation(void) {
+    mu_thunk_prio_node_t node;
+    TEST_ASSERT_NULL(mu_thunk_prio_init(NULL));
+    TEST_ASSERT_NULL(mu_thunk_prio_node_init(NULL, record_fn));
+    TEST_ASSERT_NULL(mu_thunk_prio_node_init(&node, NULL));
+    mu_thunk_prio_node_init(&node, record_fn);
+    TEST_ASSERT_FALSE(mu_thunk_prio_node_is_queued(&node));
+    TEST_ASSERT_FALSE(mu_thunk_prio_node_is_queued(NULL));
+    TEST_ASSERT_FALSE(mu_thunk_prio_put(NULL, &node, 0));
+    TEST_ASSERT_FALSE(mu_thunk_prio_put(&s_queue, NULL, 0));
+    TEST_ASSERT_FALSE(
+        mu_thunk_prio_put(&s_queue, &node, MU_THUNK_PRIO_LEVELS));
+    TEST_ASSERT_FALSE(mu_thunk_prio_remove(&s_queue, &node));
+    TEST_ASSERT_FALSE(mu_thunk_prio_remove(NULL, &node));
+    TEST_ASSERT_NULL(mu_thunk_prio_get(&s_queue));
+    TEST_ASSERT_NULL(mu_thunk_prio_get(NULL));
+    TEST_ASSERT_EQUAL_INT(-1, mu_thunk_prio_highest(&s_queue));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_prio_count(NULL));
+    TEST_ASSERT_TRUE(mu_thunk_prio_is_empty(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_prio_drain(NULL, NULL, 0));
+
+    // A queued node cannot be queued twice.
+    TEST_ASSERT_TRUE(mu_thunk_prio_put(&s_queue, &node, 3));
+    TEST_ASSERT_FALSE(mu_thunk_prio_put(&s_queue, &node, 5));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_prio_count(&s_queue));
+}
+
+void test_mu_thunk_prio_highest_first(void) {
+    static const unsigned prios[] = {7, 0, MU_THUNK_PRIO_LEVELS - 1, 3, 31};
+    static const int expected[] = {1, 3, 0, 4, 2};
+    test_node_t nodes[5];
+    for (int i = 0; i < 5; i++) {
+        test_node_init(&nodes[i], record_fn, i);
+        TEST_ASSERT_TRUE(mu_thunk_prio_put(&s_queue, &nodes[i].node, prios[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(0, mu_thunk_prio_highest(&s_queue));
+    TEST_ASSERT_EQUAL_size_t(5, mu_thunk_prio_drain(&s_queue, NULL, 0));
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, s_order, 5);
+    TEST_ASSERT_TRUE(mu_thunk_prio_is_empty(&s_queue));
+    TEST_ASSERT_EQUAL_INT(-1, mu_thunk_prio_highest(&s_queue));
+}
+
+void test_mu_thunk_prio_fifo_within_level(void) {
+    test_node_t nodes[N_NODES];
+    int expected[N_NODES];
+    for (int i = 0; i < N_NODES; i++) {
+        test_node_init(&nodes[i], record_fn, i);
+        mu_thunk_prio_put(&s_queue, &nodes[i].node, (unsigned)(i & 1));
+    }
+    // Evens (level 0) in order, then odds (level 1) in order.
+    for (int i = 0; i < N_NODES / 2; i++) {
+        expected[i] = 2 * i;
+        expected[N_NODES / 2 + i] = 2 * i + 1;
+    }
+    TEST_ASSERT_EQUAL_size_t(10, mu_thunk_prio_drain(&s_queue, NULL, 10));
+    TEST_ASSERT_EQUAL_size_t(N_NODES - 10, mu_thunk_prio_count(&s_queue));
+    mu_thunk_prio_drain(&s_queue, NULL, 0);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, s_order, N_NODES);
+}
+
+void test_mu_thunk_prio_remove(void) {
+    test_node_t nodes[3];
+    for (int i = 0; i < 3; i++) {
+        test_node_init(&nodes[i], record_fn, i);
+        mu_thunk_prio_put(&s_queue, &nodes[i].node, 5);
+    }
+    TEST_ASSERT_TRUE(mu_thunk_prio_remove(&s_queue, &nodes[1].node));
+    TEST_ASSERT_FALSE(mu_thunk_prio_node_is_queued(&nodes[1].node));
+    TEST_ASSERT_FALSE(mu_thunk_prio_remove(&s_queue, &nodes[1].node));
+    TEST_ASSERT_EQUAL_INT(5, mu_thunk_prio_highest(&s_queue));
+    TEST_ASSERT_TRUE(mu_thunk_prio_remove(&s_queue, &nodes[0].node));
+    TEST_ASSERT_TRUE(mu_thunk_prio_remove(&s_queue, &nodes[2].node));
+    // Emptying a level clears its ready bit.
+    TEST_ASSERT_EQUAL_INT(-1, mu_thunk_prio_highest(&s_queue));
+    TEST_ASSERT_TRUE(mu_thunk_prio_is_empty(&s_queue));
+    // A removed node can be queued again.
+    TEST_ASSERT_TRUE(mu_thunk_prio_put(&s_queue, &nodes[1].node, 9));
+    TEST_ASSERT_EQUAL_PTR(&nodes[1].node, mu_thunk_prio_get(&s_queue));
+}
+
+void test_mu_thunk_prio_remove_wrong_queue(void) {
+    mu_thunk_prio_t other;
+    test_node_t a, b;
+    mu_thunk_prio_init(&other);
+    test_node_init(&a, record_fn, 0);
+    test_node_init(&b, record_fn, 1);
+    mu_thunk_prio_put(&other, &a.node, 3);
+    mu_thunk_prio_put(&s_queue, &b.node, 3);
+    // Neither queue's links or count may be touched by the other's node.
+    TEST_ASSERT_FALSE(mu_thunk_prio_remove(&s_queue, &a.node));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_prio_count(&s_queue));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_prio_count(&other));
+    TEST_ASSERT_TRUE(mu_thunk_prio_node_is_queued(&a.node));
+    TEST_ASSERT_TRUE(mu_thunk_prio_remove(&other, &a.node));
+    TEST_ASSERT_TRUE(mu_thunk_prio_is_empty(&other));
+    TEST_ASSERT_EQUAL_PTR(&b.node, mu_thunk_prio_get(&s_queue));
+}
+
+void test_mu_thunk_prio_preempt_from_callback(void) {
+    test_node_t low, mid, urgent;
+    test_node_init(&low, spawn_fn, 0);
+    test_node_init(&mid, record_fn, 1);
+    test_node_init(&urgent, record_fn, 2);
+    low.spawn = &urgent.node;
+    low.spawn_priority = 0;
+    mu_thunk_prio_put(&s_queue, &low.node, 2);
+    mu_thunk_prio_put(&s_queue, &mid.node, 10);
+    // urgent, posted by low while it runs, must run before mid; the drain
+    // is bounded by the two nodes queued on entry, which leaves mid.
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_prio_drain(&s_queue, &s_queue, 0));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_prio_drain(&s_queue, &s_queue, 0));
+    TEST_ASSERT_EQUAL_INT(0, s_order[0]);
+    TEST_ASSERT_EQUAL_INT(2, s_order[1]);
+    TEST_ASSERT_EQUAL_INT(1, s_order[2]);
+}
+
+void test_mu_thunk_prio_drain_self_requeue(void) {
+    // Two tasks that yield by re-queueing themselves at their own level,
+    // round-robin: each drain runs each of them once, then returns.
+    test_node_t a, b;
+    test_node_init(&a, spawn_fn, 0);
+    test_node_init(&b, spawn_fn, 1);
+    a.spawn = &a.node;
+    a.spawn_priority = 5;
+    b.spawn = &b.node;
+    b.spawn_priority = 5;
+    mu_thunk_prio_put(&s_queue, &a.node, 5);
+    mu_thunk_prio_put(&s_queue, &b.node, 5);
+    for (int pass = 0; pass < 3; pass++) {
+        TEST_ASSERT_EQUAL_size_t(2,
+                                 mu_thunk_prio_drain(&s_queue, &s_queue, 0));
+        TEST_ASSERT_EQUAL_size_t(2, mu_thunk_prio_count(&s_queue));
+    }
+    TEST_ASSERT_EQUAL_INT(6, s_n_order);
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_INT(i % 2, s_order[i]);
+    }
+}
+
+void test_mu_thunk_prio_random(void) {
+    // Compare against a brute-force scan for the oldest lowest-level node.
+    static test_node_t nodes[N_NODES];
+    static uint64_t seq[N_NODES];
+    uint64_t clock = 0;
+    srand(12345);
+    for (int i = 0; i < N_NODES; i++) {
+        test_node_init(&nodes[i], record_fn, i);
+    }
+    for (int op = 0; op < N_RANDOM; op++) {
+        int i = rand() % N_NODES;
+        if (rand() % 3 != 0) {
+            if (!mu_thunk_prio_node_is_queued(&nodes[i].node)) {
+                unsigned p = (unsigned)rand() % MU_THUNK_PRIO_LEVELS;
+                TEST_ASSERT_TRUE(
+                    mu_thunk_prio_put(&s_queue, &nodes[i].node, p));
+                seq[i] = clock++;
+            } else {
+                TEST_ASSERT_TRUE(
+                    mu_thunk_prio_remove(&s_queue, &nodes[i].node));
+            }
+            continue;
+        }
+        int best = -1;
+        size_t queued = 0;
+        for (int j = 0; j < N_NODES; j++) {
+            mu_thunk_prio_node_t *n = &nodes[j].node;
+            if (!mu_thunk_prio_node_is_queued(n)) {
+                continue;
+            }
+            queued++;
+            if (best < 0 || n->priority < nodes[best].node.priority ||
+                (n->priority == nodes[best].node.priority &&
+                 seq[j] < seq[best])) {
+                best = j;
+            }
+        }
+        TEST_ASSERT_EQUAL_size_t(queued, mu_thunk_prio_count(&s_queue));
+        mu_thunk_prio_node_t *got = mu_thunk_prio_get(&s_queue);
+        TEST_ASSERT_EQUAL_PTR(best < 0 ? NULL : &nodes[best].node, got);
+    }
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_prio_param_validation);
+    RUN_TEST(test_mu_thunk_prio_highest_first);
+    RUN_TEST(test_mu_thunk_prio_fifo_within_level);
+    RUN_TEST(test_mu_thunk_prio_remove);
+    RUN_TEST(test_mu_thunk_prio_remove_wrong_queue);
+    RUN_TEST(test_mu_thunk_prio_preempt_from_callback);
+    RUN_TEST(test_mu_thunk_prio_drain_self_requeue);
+    RUN_TEST(test_mu_thunk_prio_random);
+
+    return UNITY_END();
+}
@@ -0,0 +1,254 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_pt.h"
+#include "mu_thunk_ring.h"
+#include "unity.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_CAPACITY 8
+
+typedef struct {
+    mu_thunk_pt_t pt; /**< Must be first member */
+    int i;
+    int steps;
+    intptr_t args_sum;
+} counter_pt_t;
+
+typedef struct {
+    mu_thunk_pt_t pt; /**< Must be first member */
+    bool ready;
+    int phase;
+} waiter_pt_t;
+
+static counter_pt_t s_counter;
+static waiter_pt_t s_waiter;
+
+/** Yield three times per loop pass through a user `switch`. */
+static void goto_counter_fn(mu_thunk_t *thunk, void *args) {
+    counter_pt_t *c = (counter_pt_t *)thunk;
+    c->args_sum += (intptr_t)args;
+    MU_THUNK_PT_GOTO_BEGIN(&c->pt);
+    for (c->i = 0; c->i < 3; c->i++) {
+        switch (c->i) {
+        case 1:
+            c->steps += 10;
+            MU_THUNK_PT_GOTO_YIELD(&c->pt);
+            break;
+        default:
+            c->steps++;
+            MU_THUNK_PT_GOTO_YIELD(&c->pt);
+            break;
+        }
+    }
+    MU_THUNK_PT_GOTO_END(&c->pt);
+}
+
+static void switch_counter_fn(mu_thunk_t *thunk, void *args) {
+    counter_pt_t *c = (counter_pt_t *)thunk;
+    c->args_sum += (intptr_t)args;
+    MU_THUNK_PT_SWITCH_BEGIN(&c->pt);
+    for (c->i = 0; c->i < 3; c->i++) {
+        c->steps++;
+        MU_THUNK_PT_SWITCH_YIELD(&c->pt);
+    }
+    MU_THUNK_PT_SWITCH_END(&c->pt);
+}
+
+/** Two yields from one macro, so on one source line. */
+#define YIELD_TWICE(pt, step)                                                  \
+    MU_THUNK_PT_GOTO_YIELD(pt);                                                \
+    step;                                                                      \
+    MU_THUNK_PT_GOTO_YIELD(pt)
+
+static void goto_same_line_fn(mu_thunk_t *thunk, void *args) {
+    counter_pt_t *c = (counter_pt_t *)thunk;
+    c->args_sum += (intptr_t)args;
+    MU_THUNK_PT_GOTO_BEGIN(&c->pt);
+    c->steps++;
+    YIELD_TWICE(&c->pt, c->steps += 10);
+    c->steps += 100;
+    MU_THUNK_PT_GOTO_YIELD(&c->pt);
+    MU_THUNK_PT_GOTO_END(&c->pt);
+}
+
+static void goto_waiter_fn(mu_thunk_t *thunk, void *args) {
+    waiter_pt_t *w = (waiter_pt_t *)thunk;
+    (void)args;
+    MU_THUNK_PT_GOTO_BEGIN(&w->pt);
+    w->phase = 1;
+    MU_THUNK_PT_GOTO_WAIT_UNTIL(&w->pt, w->ready);
+    w->phase = 2;
+    MU_THUNK_PT_GOTO_END(&w->pt);
+}
+
+static void switch_waiter_fn(mu_thunk_t *thunk, void *args) {
+    waiter_pt_t *w = (waiter_pt_t *)thunk;
+    (void)args;
+    MU_THUNK_PT_SWITCH_BEGIN(&w->pt);
+    w->phase = 1;
+    MU_THUNK_PT_SWITCH_WAIT_UNTIL(&w->pt, w->ready);
+    w->phase = 2;
+    MU_THUNK_PT_SWITCH_END(&w->pt);
+}
+
+/** Default macros; exits early when args is non-NULL. */
+static void exit_fn(mu_thunk_t *thunk, void *args) {
+    counter_pt_t *c = (counter_pt_t *)thunk;
+    MU_THUNK_PT_BEGIN(&c->pt);
+    while (true) {
+        c->steps++;
+        if (args != NULL) {
+            MU_THUNK_PT_EXIT(&c->pt);
+        }
+        MU_THUNK_PT_YIELD(&c->pt);
+    }
+    MU_THUNK_PT_END(&c->pt);
+}
+
+static void check_counter(mu_thunk_fn fn, int expect_steps) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_pt_init(&s_counter.pt, fn));
+    int calls = 0;
+    while (!mu_thunk_pt_is_done(&s_counter.pt)) {
+        _mu_thunk_call(&s_counter.pt.thunk, (void *)(intptr_t)1);
+        calls++;
+        TEST_ASSERT_TRUE(calls <= 4);
+    }
+    // Three yields, then the call that runs off the end.
+    TEST_ASSERT_EQUAL_INT(4, calls);
+    TEST_ASSERT_EQUAL_INT(expect_steps, s_counter.steps);
+    TEST_ASSERT_EQUAL_INT(4, (int)s_counter.args_sum);
+    // A finished protothread returns at once.
+    _mu_thunk_call(&s_counter.pt.thunk, NULL);
+    TEST_ASSERT_EQUAL_INT(expect_steps, s_counter.steps);
+}
+
+static void check_waiter(mu_thunk_fn fn) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_pt_init(&s_waiter.pt, fn));
+    for (int i = 0; i < 3; i++) {
+        _mu_thunk_call(&s_waiter.pt.thunk, NULL);
+        TEST_ASSERT_EQUAL_INT(1, s_waiter.phase);
+        TEST_ASSERT_FALSE(mu_thunk_pt_is_done(&s_waiter.pt));
+    }
+    s_waiter.ready = true;
+    _mu_thunk_call(&s_waiter.pt.thunk, NULL);
+    TEST_ASSERT_EQUAL_INT(2, s_waiter.phase);
+    TEST_ASSERT_TRUE(mu_thunk_pt_is_done(&s_waiter.pt));
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    s_counter = (counter_pt_t){0};
+    s_waiter = (waiter_pt_t){0};
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_pt_init(void) {
+    TEST_ASSERT_NULL(mu_thunk_pt_init(NULL, exit_fn));
+    TEST_ASSERT_NULL(mu_thunk_pt_init(&s_counter.pt, NULL));
+    TEST_ASSERT_EQUAL_PTR(&s_counter.pt,
+                          mu_thunk_pt_init(&s_counter.pt, exit_fn));
+    TEST_ASSERT_FALSE(mu_thunk_pt_is_done(&s_counter.pt));
+    TEST_ASSERT_TRUE(mu_thunk_pt_is_done(NULL));
+    // No stack is kept: the whole state is the thunk plus one word.
+    TEST_ASSERT_EQUAL_size_t(2 * sizeof(void *), sizeof(mu_thunk_pt_t));
+}
+
+void test_mu_thunk_pt_goto_yield(void) {
+    check_counter(goto_counter_fn, 12);
+}
+
+void test_mu_thunk_pt_goto_yield_same_line(void) {
+    check_counter(goto_same_line_fn, 111);
+}
+
+void test_mu_thunk_pt_switch_yield(void) {
+    check_counter(switch_counter_fn, 3);
+}
+
+void test_mu_thunk_pt_wait_until(void) {
+    check_waiter(goto_waiter_fn);
+    s_waiter = (waiter_pt_t){0};
+    check_waiter(switch_waiter_fn);
+}
+
+void test_mu_thunk_pt_exit_and_restart(void) {
+    mu_thunk_pt_init(&s_counter.pt, exit_fn);
+    mu_thunk_call(&s_counter.pt.thunk, NULL);
+    mu_thunk_call(&s_counter.pt.thunk, NULL);
+    TEST_ASSERT_FALSE(mu_thunk_pt_is_done(&s_counter.pt));
+    mu_thunk_call(&s_counter.pt.thunk, &s_counter);
+    TEST_ASSERT_TRUE(mu_thunk_pt_is_done(&s_counter.pt));
+    TEST_ASSERT_EQUAL_INT(3, s_counter.steps);
+    // Re-initializing starts again from the top.
+    mu_thunk_pt_init(&s_counter.pt, exit_fn);
+    mu_thunk_call(&s_counter.pt.thunk, NULL);
+    TEST_ASSERT_EQUAL_INT(4, s_counter.steps);
+}
+
+void test_mu_thunk_pt_resumed_from_ring(void) {
+    mu_thunk_ring_t ring;
+    mu_thunk_t *store[RING_CAPACITY];
+    mu_thunk_ring_init(&ring, store, RING_CAPACITY);
+    mu_thunk_pt_init(&s_counter.pt, switch_counter_fn);
+    while (!mu_thunk_pt_is_done(&s_counter.pt)) {
+        TEST_ASSERT_TRUE(mu_thunk_ring_put(&ring, &s_counter.pt.thunk));
+        mu_thunk_ring_drain(&ring, (void *)(intptr_t)2);
+    }
+    TEST_ASSERT_EQUAL_INT(3, s_counter.steps);
+    TEST_ASSERT_EQUAL_INT(8, (int)s_counter.args_sum);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_pt_init);
+    RUN_TEST(test_mu_thunk_pt_goto_yield);
+    RUN_TEST(test_mu_thunk_pt_goto_yield_same_line);
+    RUN_TEST(test_mu_thunk_pt_switch_yield);
+    RUN_TEST(test_mu_thunk_pt_wait_until);
+    RUN_TEST(test_mu_thunk_pt_exit_and_restart);
+    RUN_TEST(test_mu_thunk_pt_resumed_from_ring);
+
+    return UNITY_END();
+}
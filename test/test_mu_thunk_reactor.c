@@ -0,0 +1,199 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mu_thunk_reactor.h"
+#include "unity.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_POSTS 1000
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    int fd;
+    int call_count;
+    uint32_t last_events;
+} fd_thunk_t;
+
+typedef struct {
+    mu_thunk_mpsc_node_t node; /**< Must be first member */
+    int call_count;
+    void *last_args;
+} posted_thunk_t;
+
+static mu_thunk_reactor_t s_reactor;
+static int s_pipe[2];
+
+// Reads (and discards) one byte so level-triggered readiness clears.
+static void fd_fn(mu_thunk_t *thunk, void *args) {
+    fd_thunk_t *ft = (fd_thunk_t *)thunk;
+    struct epoll_event *ev = (struct epoll_event *)args;
+    char c;
+    ft->call_count++;
+    ft->last_events = ev->events;
+    TEST_ASSERT_EQUAL_INT(1, read(ft->fd, &c, 1));
+}
+
+static void posted_fn(mu_thunk_t *thunk, void *args) {
+    posted_thunk_t *pt = (posted_thunk_t *)thunk;
+    pt->call_count++;
+    pt->last_args = args;
+}
+
+static void *poster_fn(void *arg) {
+    posted_thunk_t *nodes = (posted_thunk_t *)arg;
+    for (int i = 0; i < N_POSTS; i++) {
+        mu_thunk_reactor_post(&s_reactor, &nodes[i].node);
+    }
+    return NULL;
+}
+
+static void *stopper_fn(void *arg) {
+    (void)arg;
+    mu_thunk_reactor_stop(&s_reactor);
+    return NULL;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_reactor_init(&s_reactor));
+    TEST_ASSERT_EQUAL_INT(0, pipe(s_pipe));
+}
+
+void tearDown(void) {
+    close(s_pipe[0]);
+    close(s_pipe[1]);
+    mu_thunk_reactor_deinit(&s_reactor);
+}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_reactor_param_validation(void) {
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, posted_fn);
+    TEST_ASSERT_NULL(mu_thunk_reactor_init(NULL));
+    TEST_ASSERT_FALSE(mu_thunk_reactor_add(NULL, s_pipe[0], EPOLLIN, &thunk));
+    TEST_ASSERT_FALSE(mu_thunk_reactor_add(&s_reactor, s_pipe[0], EPOLLIN,
+                                           NULL));
+    TEST_ASSERT_FALSE(mu_thunk_reactor_add(&s_reactor, -1, EPOLLIN, &thunk));
+    TEST_ASSERT_FALSE(mu_thunk_reactor_remove(&s_reactor, s_pipe[0]));
+    TEST_ASSERT_FALSE(mu_thunk_reactor_post(NULL, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_reactor_post(&s_reactor, NULL));
+    TEST_ASSERT_EQUAL_INT(-1, mu_thunk_reactor_run_once(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(-1, mu_thunk_reactor_run(NULL));
+}
+
+void test_mu_thunk_reactor_dispatches_readiness(void) {
+    fd_thunk_t ft = {.fd = s_pipe[0]};
+    mu_thunk_init(&ft.thunk, fd_fn);
+    TEST_ASSERT_TRUE(
+        mu_thunk_reactor_add(&s_reactor, s_pipe[0], EPOLLIN, &ft.thunk));
+
+    TEST_ASSERT_EQUAL_INT(0, mu_thunk_reactor_run_once(&s_reactor, 0));
+    TEST_ASSERT_EQUAL_INT(0, ft.call_count);
+
+    TEST_ASSERT_EQUAL_INT(1, write(s_pipe[1], "x", 1));
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_reactor_run_once(&s_reactor, 1000));
+    TEST_ASSERT_EQUAL_INT(1, ft.call_count);
+    TEST_ASSERT_TRUE(ft.last_events & EPOLLIN);
+
+    // Drained by fd_fn, so nothing more to report.
+    TEST_ASSERT_EQUAL_INT(0, mu_thunk_reactor_run_once(&s_reactor, 0));
+}
+
+void test_mu_thunk_reactor_modify_and_remove(void) {
+    fd_thunk_t a = {.fd = s_pipe[0]};
+    fd_thunk_t b = {.fd = s_pipe[0]};
+    mu_thunk_init(&a.thunk, fd_fn);
+    mu_thunk_init(&b.thunk, fd_fn);
+    mu_thunk_reactor_add(&s_reactor, s_pipe[0], EPOLLIN, &a.thunk);
+    TEST_ASSERT_TRUE(
+        mu_thunk_reactor_modify(&s_reactor, s_pipe[0], EPOLLIN, &b.thunk));
+
+    write(s_pipe[1], "x", 1);
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_reactor_run_once(&s_reactor, 1000));
+    TEST_ASSERT_EQUAL_INT(0, a.call_count);
+    TEST_ASSERT_EQUAL_INT(1, b.call_count);
+
+    TEST_ASSERT_TRUE(mu_thunk_reactor_remove(&s_reactor, s_pipe[0]));
+    write(s_pipe[1], "x", 1);
+    TEST_ASSERT_EQUAL_INT(0, mu_thunk_reactor_run_once(&s_reactor, 0));
+    TEST_ASSERT_EQUAL_INT(1, b.call_count);
+}
+
+void test_mu_thunk_reactor_post_from_other_thread(void) {
+    static posted_thunk_t nodes[N_POSTS];
+    for (int i = 0; i < N_POSTS; i++) {
+        mu_thunk_mpsc_node_init(&nodes[i].node, posted_fn);
+        nodes[i].call_count = 0;
+    }
+    pthread_t poster;
+    pthread_create(&poster, NULL, poster_fn, nodes);
+
+    int total = 0;
+    while (total < N_POSTS) {
+        // Blocks until a post wakes the loop.
+        int n = mu_thunk_reactor_run_once(&s_reactor, -1);
+        TEST_ASSERT_TRUE(n >= 0);
+        total += n;
+    }
+    pthread_join(poster, NULL);
+    TEST_ASSERT_EQUAL_INT(N_POSTS, total);
+    for (int i = 0; i < N_POSTS; i++) {
+        TEST_ASSERT_EQUAL_INT(1, nodes[i].call_count);
+        TEST_ASSERT_EQUAL_PTR(&s_reactor, nodes[i].last_args);
+    }
+}
+
+void test_mu_thunk_reactor_stop_from_other_thread(void) {
+    pthread_t stopper;
+    pthread_create(&stopper, NULL, stopper_fn, NULL);
+    TEST_ASSERT_EQUAL_INT(0, mu_thunk_reactor_run(&s_reactor));
+    pthread_join(stopper, NULL);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_reactor_param_validation);
+    RUN_TEST(test_mu_thunk_reactor_dispatches_readiness);
+    RUN_TEST(test_mu_thunk_reactor_modify_and_remove);
+    RUN_TEST(test_mu_thunk_reactor_post_from_other_thread);
+    RUN_TEST(test_mu_thunk_reactor_stop_from_other_thread);
+
+    return UNITY_END();
+}
@@ -0,0 +1,273 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mu_thunk_ring.h"
+#include "unity.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_CAPACITY 8
+#define THREADED_COUNT 100000
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    int id;
+    int call_count;
+} counting_thunk_t;
+
+typedef struct {
+    mu_thunk_ring_t *ring;
+    counting_thunk_t *thunks;
+    int n;
+} producer_ctx_t;
+
+static mu_thunk_t *s_store[RING_CAPACITY];
+static mu_thunk_ring_t s_ring;
+static counting_thunk_t s_thunks[RING_CAPACITY + 1];
+
+// Records the order of invocation in the int array passed as args.
+static int s_order[RING_CAPACITY];
+static int s_order_n;
+
+static void counting_thunk_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    counting_thunk_t *ct = (counting_thunk_t *)thunk;
+    ct->call_count++;
+    if (s_order_n < RING_CAPACITY) {
+        s_order[s_order_n++] = ct->id;
+    }
+}
+
+// Queues one more entry, then drains its own ring from inside a drain.
+static void nested_drain_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    mu_thunk_ring_put(&s_ring, &s_thunks[3].thunk);
+    *(size_t *)args = mu_thunk_ring_drain(&s_ring, NULL);
+}
+
+static void *producer_fn(void *arg) {
+    producer_ctx_t *ctx = (producer_ctx_t *)arg;
+    for (int i = 0; i < ctx->n; i++) {
+        while (!mu_thunk_ring_put(ctx->ring, &ctx->thunks[i].thunk)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_ring_init(&s_ring, s_store, RING_CAPACITY));
+    for (int i = 0; i < RING_CAPACITY + 1; i++) {
+        mu_thunk_init(&s_thunks[i].thunk, counting_thunk_fn);
+        s_thunks[i].id = i;
+        s_thunks[i].call_count = 0;
+    }
+    s_order_n = 0;
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_ring_init_param_validation(void) {
+    mu_thunk_ring_t ring;
+    TEST_ASSERT_NULL(mu_thunk_ring_init(NULL, s_store, RING_CAPACITY));
+    TEST_ASSERT_NULL(mu_thunk_ring_init(&ring, NULL, RING_CAPACITY));
+    TEST_ASSERT_NULL(mu_thunk_ring_init(&ring, s_store, 0));
+    TEST_ASSERT_NULL(mu_thunk_ring_init(&ring, s_store, 6));
+    TEST_ASSERT_EQUAL_PTR(&ring, mu_thunk_ring_init(&ring, s_store, 1));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_ring_capacity(&ring));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_ring_capacity(NULL));
+}
+
+void test_mu_thunk_ring_put_get_fifo(void) {
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&s_ring));
+    TEST_ASSERT_NULL(mu_thunk_ring_get(&s_ring));
+
+    TEST_ASSERT_TRUE(mu_thunk_ring_put(&s_ring, &s_thunks[0].thunk));
+    TEST_ASSERT_TRUE(mu_thunk_ring_put(&s_ring, &s_thunks[1].thunk));
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_ring_count(&s_ring));
+
+    TEST_ASSERT_EQUAL_PTR(&s_thunks[0].thunk, mu_thunk_ring_get(&s_ring));
+    TEST_ASSERT_EQUAL_PTR(&s_thunks[1].thunk, mu_thunk_ring_get(&s_ring));
+    TEST_ASSERT_NULL(mu_thunk_ring_get(&s_ring));
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&s_ring));
+}
+
+void test_mu_thunk_ring_full(void) {
+    for (int i = 0; i < RING_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(mu_thunk_ring_put(&s_ring, &s_thunks[i].thunk));
+    }
+    TEST_ASSERT_FALSE(
+        mu_thunk_ring_put(&s_ring, &s_thunks[RING_CAPACITY].thunk));
+    TEST_ASSERT_EQUAL_size_t(RING_CAPACITY, mu_thunk_ring_count(&s_ring));
+
+    // Freeing one slot makes room for exactly one more.
+    TEST_ASSERT_EQUAL_PTR(&s_thunks[0].thunk, mu_thunk_ring_get(&s_ring));
+    TEST_ASSERT_TRUE(
+        mu_thunk_ring_put(&s_ring, &s_thunks[RING_CAPACITY].thunk));
+    TEST_ASSERT_FALSE(mu_thunk_ring_put(&s_ring, &s_thunks[0].thunk));
+}
+
+void test_mu_thunk_ring_put_null_safety(void) {
+    TEST_ASSERT_FALSE(mu_thunk_ring_put(NULL, &s_thunks[0].thunk));
+    TEST_ASSERT_FALSE(mu_thunk_ring_put(&s_ring, NULL));
+    TEST_ASSERT_NULL(mu_thunk_ring_get(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_ring_drain(NULL, NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_ring_count(NULL));
+}
+
+void test_mu_thunk_ring_drain_invokes_in_order(void) {
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_ring_drain(&s_ring, NULL));
+    for (int i = 0; i < 5; i++) {
+        mu_thunk_ring_put(&s_ring, &s_thunks[i].thunk);
+    }
+    TEST_ASSERT_EQUAL_size_t(5, mu_thunk_ring_drain(&s_ring, NULL));
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&s_ring));
+    TEST_ASSERT_EQUAL_INT(5, s_order_n);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_INT(i, s_order[i]);
+        TEST_ASSERT_EQUAL_INT(1, s_thunks[i].call_count);
+    }
+}
+
+void test_mu_thunk_ring_drain_reentrant(void) {
+    mu_thunk_t nested;
+    mu_thunk_init(&nested, nested_drain_fn);
+    size_t inner = 0;
+    mu_thunk_ring_put(&s_ring, &nested);
+    mu_thunk_ring_put(&s_ring, &s_thunks[1].thunk);
+    mu_thunk_ring_put(&s_ring, &s_thunks[2].thunk);
+    // The inner drain runs 1, 2 and the newly added 3; the outer one must
+    // neither run them again nor move head backwards.
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_ring_drain(&s_ring, &inner));
+    TEST_ASSERT_EQUAL_size_t(3, inner);
+    for (int i = 1; i <= 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, s_thunks[i].call_count);
+    }
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&s_ring));
+    TEST_ASSERT_TRUE(mu_thunk_ring_put(&s_ring, &s_thunks[0].thunk));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_ring_count(&s_ring));
+}
+
+void test_mu_thunk_ring_wraparound(void) {
+    // Cycle through the ring several times so the indices wrap the mask.
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < RING_CAPACITY - 1; i++) {
+            TEST_ASSERT_TRUE(mu_thunk_ring_put(&s_ring, &s_thunks[i].thunk));
+        }
+        for (int i = 0; i < RING_CAPACITY - 1; i++) {
+            TEST_ASSERT_EQUAL_PTR(&s_thunks[i].thunk,
+                                  mu_thunk_ring_get(&s_ring));
+        }
+    }
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&s_ring));
+}
+
+void test_mu_thunk_ring_get_batch(void) {
+    mu_thunk_t *out[RING_CAPACITY];
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_ring_get_batch(NULL, out, 1));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_ring_get_batch(&s_ring, NULL, 1));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_ring_get_batch(&s_ring, out, 4));
+    // Start part-way round so the batch spans the wrap.
+    for (int i = 0; i < RING_CAPACITY - 2; i++) {
+        mu_thunk_ring_put(&s_ring, &s_thunks[i].thunk);
+        mu_thunk_ring_get(&s_ring);
+    }
+    for (int i = 0; i < 6; i++) {
+        mu_thunk_ring_put(&s_ring, &s_thunks[i].thunk);
+    }
+    TEST_ASSERT_EQUAL_size_t(4, mu_thunk_ring_get_batch(&s_ring, out, 4));
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_ring_count(&s_ring));
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_ring_get_batch(&s_ring, out + 4, 8));
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_PTR(&s_thunks[i].thunk, out[i]);
+    }
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&s_ring));
+}
+
+void test_mu_thunk_ring_reset(void) {
+    mu_thunk_ring_put(&s_ring, &s_thunks[0].thunk);
+    TEST_ASSERT_EQUAL_PTR(&s_ring, mu_thunk_ring_reset(&s_ring));
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&s_ring));
+    TEST_ASSERT_NULL(mu_thunk_ring_reset(NULL));
+}
+
+// One producer thread, consumer on the test thread: every thunk arrives once,
+// in order.
+void test_mu_thunk_ring_threaded(void) {
+    static counting_thunk_t thunks[THREADED_COUNT];
+    for (int i = 0; i < THREADED_COUNT; i++) {
+        mu_thunk_init(&thunks[i].thunk, counting_thunk_fn);
+        thunks[i].id = i;
+        thunks[i].call_count = 0;
+    }
+    producer_ctx_t ctx = {.ring = &s_ring, .thunks = thunks,
+                          .n = THREADED_COUNT};
+    pthread_t producer;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL, producer_fn, &ctx));
+
+    int expected = 0;
+    while (expected < THREADED_COUNT) {
+        mu_thunk_t *thunk = mu_thunk_ring_get(&s_ring);
+        if (thunk == NULL) {
+            sched_yield();
+            continue;
+        }
+        TEST_ASSERT_EQUAL_PTR(&thunks[expected].thunk, thunk);
+        expected++;
+    }
+    pthread_join(producer, NULL);
+    TEST_ASSERT_TRUE(mu_thunk_ring_is_empty(&s_ring));
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_ring_init_param_validation);
+    RUN_TEST(test_mu_thunk_ring_put_get_fifo);
+    RUN_TEST(test_mu_thunk_ring_full);
+    RUN_TEST(test_mu_thunk_ring_put_null_safety);
+    RUN_TEST(test_mu_thunk_ring_drain_invokes_in_order);
+    RUN_TEST(test_mu_thunk_ring_drain_reentrant);
+    RUN_TEST(test_mu_thunk_ring_wraparound);
+    RUN_TEST(test_mu_thunk_ring_get_batch);
+    RUN_TEST(test_mu_thunk_ring_reset);
+    RUN_TEST(test_mu_thunk_ring_threaded);
+
+    return UNITY_END();
+}
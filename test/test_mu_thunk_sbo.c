@@ -0,0 +1,239 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_sbo.h"
+#include "unity.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_CAPACITY 8
+#define THREADED_COUNT 100000
+
+typedef struct {
+    uint64_t seq;
+    uint64_t check; /**< ~seq, to catch torn payloads */
+    char tag[16];
+} test_args_t;
+
+static mu_thunk_sbo_t s_store[RING_CAPACITY];
+static mu_thunk_sbo_ring_t s_ring;
+static test_args_t s_seen[RING_CAPACITY * 2];
+static int s_n_seen;
+static uint64_t s_next_seq;
+static int s_bad;
+static size_t s_inner;
+
+static void record_fn(mu_thunk_t *thunk, void *args) {
+    // args is the slot's inline payload.
+    TEST_ASSERT_EQUAL_PTR(mu_thunk_sbo_payload(thunk), args);
+    if (s_n_seen < RING_CAPACITY * 2) {
+        memcpy(&s_seen[s_n_seen], args, sizeof(test_args_t));
+    }
+    s_n_seen++;
+}
+
+static void repost_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    test_args_t next = *(test_args_t *)args;
+    next.seq++;
+    record_fn(thunk, args);
+    mu_thunk_sbo_ring_put(&s_ring, record_fn, &next, sizeof(next));
+}
+
+// Posts one more entry, then drains its own ring from inside a drain.
+static void nested_drain_fn(mu_thunk_t *thunk, void *args) {
+    test_args_t next = *(test_args_t *)args;
+    next.seq = 3;
+    record_fn(thunk, args);
+    mu_thunk_sbo_ring_put(&s_ring, record_fn, &next, sizeof(next));
+    s_inner = mu_thunk_sbo_ring_drain(&s_ring);
+    // Our slot is still held, so the payload is intact.
+    TEST_ASSERT_EQUAL_UINT64(0, ((test_args_t *)args)->seq);
+}
+
+static void check_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    const test_args_t *a = args;
+    if (a->seq != s_next_seq || a->check != ~a->seq) {
+        s_bad++;
+    }
+    s_next_seq++;
+}
+
+static void *producer_fn(void *arg) {
+    (void)arg;
+    for (uint64_t i = 0; i < THREADED_COUNT; i++) {
+        test_args_t a = {.seq = i, .check = ~i};
+        while (!mu_thunk_sbo_ring_put(&s_ring, check_fn, &a, sizeof(a))) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(
+        mu_thunk_sbo_ring_init(&s_ring, s_store, RING_CAPACITY));
+    s_n_seen = 0;
+    s_next_seq = 0;
+    s_bad = 0;
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_sbo_param_validation(void) {
+    mu_thunk_sbo_t sbo;
+    mu_thunk_sbo_ring_t ring;
+    unsigned char big[MU_THUNK_SBO_SIZE + 1] = {0};
+    TEST_ASSERT_NULL(mu_thunk_sbo_init(NULL, record_fn, NULL, 0));
+    TEST_ASSERT_NULL(mu_thunk_sbo_init(&sbo, NULL, NULL, 0));
+    TEST_ASSERT_NULL(mu_thunk_sbo_init(&sbo, record_fn, NULL, 4));
+    TEST_ASSERT_NULL(mu_thunk_sbo_init(&sbo, record_fn, big, sizeof(big)));
+    TEST_ASSERT_NOT_NULL(mu_thunk_sbo_init(&sbo, record_fn, NULL, 0));
+    TEST_ASSERT_NULL(mu_thunk_sbo_ring_init(NULL, s_store, RING_CAPACITY));
+    TEST_ASSERT_NULL(mu_thunk_sbo_ring_init(&ring, NULL, RING_CAPACITY));
+    TEST_ASSERT_NULL(mu_thunk_sbo_ring_init(&ring, s_store, 0));
+    TEST_ASSERT_NULL(mu_thunk_sbo_ring_init(&ring, s_store, 6));
+    TEST_ASSERT_FALSE(mu_thunk_sbo_ring_put(NULL, record_fn, NULL, 0));
+    TEST_ASSERT_FALSE(mu_thunk_sbo_ring_put(&s_ring, NULL, NULL, 0));
+    TEST_ASSERT_FALSE(
+        mu_thunk_sbo_ring_put(&s_ring, record_fn, big, sizeof(big)));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_sbo_ring_drain(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_sbo_ring_count(NULL));
+    mu_thunk_sbo_call(NULL);
+}
+
+void test_mu_thunk_sbo_fits_a_cache_line(void) {
+    TEST_ASSERT_EQUAL_size_t(0, offsetof(mu_thunk_sbo_t, thunk));
+    TEST_ASSERT_EQUAL_size_t(0, offsetof(mu_thunk_sbo_t, payload) % 16);
+    if (MU_THUNK_SBO_SIZE == 48) {
+        TEST_ASSERT_EQUAL_size_t(64, sizeof(mu_thunk_sbo_t));
+    }
+}
+
+void test_mu_thunk_sbo_call_standalone(void) {
+    mu_thunk_sbo_t sbo;
+    test_args_t a = {.seq = 7, .check = ~7ull, .tag = "standalone"};
+    mu_thunk_sbo_init(&sbo, record_fn, &a, sizeof(a));
+    memset(&a, 0, sizeof(a)); // the thunk holds its own copy
+    mu_thunk_sbo_call(&sbo);
+    TEST_ASSERT_EQUAL_INT(1, s_n_seen);
+    TEST_ASSERT_EQUAL_UINT64(7, s_seen[0].seq);
+    TEST_ASSERT_EQUAL_STRING("standalone", s_seen[0].tag);
+}
+
+void test_mu_thunk_sbo_ring_copies_payload(void) {
+    test_args_t a = {.tag = "x"};
+    for (uint64_t i = 0; i < RING_CAPACITY; i++) {
+        a.seq = i;
+        TEST_ASSERT_TRUE(mu_thunk_sbo_ring_put(&s_ring, record_fn, &a,
+                                               sizeof(a)));
+    }
+    TEST_ASSERT_FALSE(mu_thunk_sbo_ring_put(&s_ring, record_fn, &a, 8));
+    TEST_ASSERT_EQUAL_size_t(RING_CAPACITY, mu_thunk_sbo_ring_count(&s_ring));
+    TEST_ASSERT_EQUAL_size_t(RING_CAPACITY, mu_thunk_sbo_ring_drain(&s_ring));
+    for (int i = 0; i < RING_CAPACITY; i++) {
+        TEST_ASSERT_EQUAL_UINT64((uint64_t)i, s_seen[i].seq);
+    }
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_sbo_ring_count(&s_ring));
+}
+
+void test_mu_thunk_sbo_ring_repost_from_thunk(void) {
+    // A thunk may post into the ring it is running from; the new entry is
+    // left for the next drain.
+    test_args_t a = {.seq = 100};
+    mu_thunk_sbo_ring_put(&s_ring, repost_fn, &a, sizeof(a));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_sbo_ring_drain(&s_ring));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_sbo_ring_drain(&s_ring));
+    TEST_ASSERT_EQUAL_INT(2, s_n_seen);
+    TEST_ASSERT_EQUAL_UINT64(101, s_seen[1].seq);
+}
+
+void test_mu_thunk_sbo_ring_drain_reentrant(void) {
+    test_args_t a = {.seq = 0};
+    mu_thunk_sbo_ring_put(&s_ring, nested_drain_fn, &a, sizeof(a));
+    for (a.seq = 1; a.seq <= 2; a.seq++) {
+        mu_thunk_sbo_ring_put(&s_ring, record_fn, &a, sizeof(a));
+    }
+    // The inner drain runs 1, 2 and the newly posted 3; the outer one must
+    // neither run them again nor release a slot that is still running.
+    s_inner = 0;
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_sbo_ring_drain(&s_ring));
+    TEST_ASSERT_EQUAL_size_t(3, s_inner);
+    TEST_ASSERT_EQUAL_INT(4, s_n_seen);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_UINT64((uint64_t)i, s_seen[i].seq);
+    }
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_sbo_ring_count(&s_ring));
+    for (int i = 0; i < RING_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(mu_thunk_sbo_ring_put(&s_ring, record_fn, &a, 8));
+    }
+}
+
+void test_mu_thunk_sbo_ring_threaded(void) {
+    pthread_t producer;
+    TEST_ASSERT_EQUAL_INT(0,
+                          pthread_create(&producer, NULL, producer_fn, NULL));
+    while (s_next_seq < THREADED_COUNT) {
+        if (mu_thunk_sbo_ring_drain(&s_ring) == 0) {
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+    TEST_ASSERT_EQUAL_INT(0, s_bad);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_sbo_param_validation);
+    RUN_TEST(test_mu_thunk_sbo_fits_a_cache_line);
+    RUN_TEST(test_mu_thunk_sbo_call_standalone);
+    RUN_TEST(test_mu_thunk_sbo_ring_copies_payload);
+    RUN_TEST(test_mu_thunk_sbo_ring_repost_from_thunk);
+    RUN_TEST(test_mu_thunk_sbo_ring_drain_reentrant);
+    RUN_TEST(test_mu_thunk_sbo_ring_threaded);
+
+    return UNITY_END();
+}
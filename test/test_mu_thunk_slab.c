@@ -0,0 +1,203 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mu_thunk.h"
+#include "mu_thunk_slab.h"
+#include "unity.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_OBJECTS 10000
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    int id;
+    char payload[40];
+} request_t;
+
+typedef struct {
+    mu_thunk_slab_cache_t *cache;
+    request_t **objs;
+    size_t n;
+} remote_ctx_t;
+
+static mu_thunk_slab_t s_slab;
+static mu_thunk_slab_cache_t s_cache;
+
+static int compare_ptr(const void *a, const void *b) {
+    uintptr_t x = *(const uintptr_t *)a;
+    uintptr_t y = *(const uintptr_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Frees every object on a second thread with its own cache.
+static void *remote_free_main(void *arg) {
+    remote_ctx_t *ctx = (remote_ctx_t *)arg;
+    mu_thunk_slab_cache_t cache;
+    mu_thunk_slab_cache_init(&cache, &s_slab);
+    for (size_t i = 0; i < ctx->n; i++) {
+        mu_thunk_slab_free(&cache, ctx->objs[i]);
+    }
+    mu_thunk_slab_cache_flush(&cache);
+    return NULL;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_slab_init(&s_slab, sizeof(request_t)));
+    TEST_ASSERT_NOT_NULL(mu_thunk_slab_cache_init(&s_cache, &s_slab));
+}
+
+void tearDown(void) { mu_thunk_slab_deinit(&s_slab); }
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_slab_param_validation(void) {
+    mu_thunk_slab_t slab;
+    mu_thunk_slab_cache_t cache;
+    TEST_ASSERT_NULL(mu_thunk_slab_init(NULL, 64));
+    TEST_ASSERT_NULL(mu_thunk_slab_init(&slab, 0));
+    TEST_ASSERT_NULL(mu_thunk_slab_init(&slab, MU_THUNK_SLAB_CHUNK_SIZE));
+    TEST_ASSERT_NULL(mu_thunk_slab_cache_init(NULL, &s_slab));
+    TEST_ASSERT_NULL(mu_thunk_slab_cache_init(&cache, NULL));
+    TEST_ASSERT_NULL(mu_thunk_slab_alloc(NULL));
+    mu_thunk_slab_free(&s_cache, NULL); // no-op
+    mu_thunk_slab_free(NULL, NULL);     // no-op
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_slab_object_size(NULL));
+}
+
+void test_mu_thunk_slab_size_and_alignment(void) {
+    TEST_ASSERT_EQUAL_size_t(MU_THUNK_CACHE_LINE,
+                             mu_thunk_slab_object_size(&s_slab));
+    mu_thunk_slab_t big;
+    mu_thunk_slab_init(&big, MU_THUNK_CACHE_LINE + 1);
+    TEST_ASSERT_EQUAL_size_t(2 * MU_THUNK_CACHE_LINE,
+                             mu_thunk_slab_object_size(&big));
+    mu_thunk_slab_deinit(&big);
+
+    for (int i = 0; i < 100; i++) {
+        void *obj = mu_thunk_slab_alloc(&s_cache);
+        TEST_ASSERT_NOT_NULL(obj);
+        TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)obj % MU_THUNK_CACHE_LINE);
+    }
+}
+
+void test_mu_thunk_slab_reuses_freed_object(void) {
+    request_t *a = mu_thunk_slab_alloc(&s_cache);
+    request_t *b = mu_thunk_slab_alloc(&s_cache);
+    TEST_ASSERT_TRUE(a != b);
+    mu_thunk_slab_free(&s_cache, a);
+    TEST_ASSERT_EQUAL_PTR(a, mu_thunk_slab_alloc(&s_cache));
+}
+
+void test_mu_thunk_slab_many_objects_are_distinct(void) {
+    request_t **objs = malloc(sizeof(request_t *) * N_OBJECTS);
+    for (int i = 0; i < N_OBJECTS; i++) {
+        objs[i] = mu_thunk_slab_alloc(&s_cache);
+        TEST_ASSERT_NOT_NULL(objs[i]);
+        objs[i]->id = i;
+        memset(objs[i]->payload, (char)i, sizeof(objs[i]->payload));
+    }
+    for (int i = 0; i < N_OBJECTS; i++) {
+        TEST_ASSERT_EQUAL_INT(i, objs[i]->id);
+    }
+    qsort(objs, N_OBJECTS, sizeof(request_t *), compare_ptr);
+    for (int i = 1; i < N_OBJECTS; i++) {
+        TEST_ASSERT_TRUE((char *)objs[i] - (char *)objs[i - 1] >=
+                         (ptrdiff_t)mu_thunk_slab_object_size(&s_slab));
+    }
+    for (int i = 0; i < N_OBJECTS; i++) {
+        mu_thunk_slab_free(&s_cache, objs[i]);
+    }
+    free(objs);
+}
+
+void test_mu_thunk_slab_remote_free_returns_to_owner(void) {
+    request_t **objs = malloc(sizeof(request_t *) * N_OBJECTS);
+    for (int i = 0; i < N_OBJECTS; i++) {
+        objs[i] = mu_thunk_slab_alloc(&s_cache);
+    }
+    remote_ctx_t ctx = {.objs = objs, .n = N_OBJECTS};
+    pthread_t thread;
+    pthread_create(&thread, NULL, remote_free_main, &ctx);
+    pthread_join(thread, NULL);
+
+    // Every object comes back to the owner before any new memory is carved.
+    request_t **again = malloc(sizeof(request_t *) * N_OBJECTS);
+    for (int i = 0; i < N_OBJECTS; i++) {
+        again[i] = mu_thunk_slab_alloc(&s_cache);
+    }
+    qsort(objs, N_OBJECTS, sizeof(request_t *), compare_ptr);
+    qsort(again, N_OBJECTS, sizeof(request_t *), compare_ptr);
+    TEST_ASSERT_EQUAL_MEMORY(objs, again, sizeof(request_t *) * N_OBJECTS);
+    free(again);
+    free(objs);
+}
+
+void test_mu_thunk_slab_partial_batch_needs_flush(void) {
+    mu_thunk_slab_cache_t other;
+    mu_thunk_slab_cache_init(&other, &s_slab);
+    request_t *mine = mu_thunk_slab_alloc(&s_cache);
+    request_t *theirs = mu_thunk_slab_alloc(&other);
+    TEST_ASSERT_TRUE(mine != theirs);
+
+    // A single remote free sits in the batch until it is flushed.
+    mu_thunk_slab_free(&other, mine);
+    request_t *next = mu_thunk_slab_alloc(&s_cache);
+    TEST_ASSERT_TRUE(next != mine);
+    mu_thunk_slab_cache_flush(&other);
+    TEST_ASSERT_EQUAL_PTR(mine, mu_thunk_slab_alloc(&s_cache));
+
+    // Freeing to a different owner flushes the previous batch.
+    mu_thunk_slab_free(&other, mine);
+    mu_thunk_slab_free(&s_cache, theirs);
+    mu_thunk_slab_cache_flush(&s_cache);
+    TEST_ASSERT_EQUAL_PTR(theirs, mu_thunk_slab_alloc(&other));
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_slab_param_validation);
+    RUN_TEST(test_mu_thunk_slab_size_and_alignment);
+    RUN_TEST(test_mu_thunk_slab_reuses_freed_object);
+    RUN_TEST(test_mu_thunk_slab_many_objects_are_distinct);
+    RUN_TEST(test_mu_thunk_slab_remote_free_returns_to_owner);
+    RUN_TEST(test_mu_thunk_slab_partial_batch_needs_flush);
+
+    return UNITY_END();
+}
@@ -0,0 +1,264 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Instrument _mu_thunk_call() in this file.
+#define MU_THUNK_STATS
+
+#include "mu_thunk.h"
+#include "mu_thunk_compact.h"
+#include "mu_thunk_stats.h"
+#include "unity.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_THREADS 4
+#define PER_THREAD 1000
+
+// Statistics accumulate for the life of the process, so each test records
+// against functions of its own.
+
+static mu_thunk_stats_snapshot_t s_snap;
+static mu_thunk_stats_snapshot_t s_other;
+
+static void nop_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+static void sleep_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    struct timespec ts = {.tv_sec = 0, .tv_nsec = *(long *)args};
+    nanosleep(&ts, NULL);
+}
+
+static void threaded_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+static void merged_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+static void compact_fn(mu_thunk_compact_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+static void recycled_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+static void *recycled_main(void *arg) {
+    (void)arg;
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, recycled_fn);
+    for (int i = 0; i < PER_THREAD; i++) {
+        _mu_thunk_call(&thunk, NULL);
+    }
+    return NULL;
+}
+
+static void *caller_main(void *arg) {
+    (void)arg;
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, threaded_fn);
+    for (int i = 0; i < PER_THREAD; i++) {
+        _mu_thunk_call(&thunk, NULL);
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_stats_buckets(void) {
+    // Exact below 2^SUB_BITS, then log-linear and monotonic.
+    for (uint64_t ns = 0; ns < (1u << MU_THUNK_STATS_SUB_BITS); ns++) {
+        TEST_ASSERT_EQUAL_size_t(ns, mu_thunk_stats_bucket(ns));
+    }
+    size_t prev = 0;
+    for (uint64_t ns = 1; ns < (1ull << 30); ns = ns * 5 / 4 + 1) {
+        size_t b = mu_thunk_stats_bucket(ns);
+        TEST_ASSERT_TRUE(b >= prev);
+        TEST_ASSERT_TRUE(b < MU_THUNK_STATS_BUCKETS);
+        uint64_t floor = mu_thunk_stats_bucket_floor(b);
+        uint64_t next = mu_thunk_stats_bucket_floor(b + 1);
+        TEST_ASSERT_TRUE(floor <= ns && ns < next);
+        // Width 1 in the exact range, then at most floor / 2^SUB_BITS.
+        if (floor < (1u << MU_THUNK_STATS_SUB_BITS)) {
+            TEST_ASSERT_EQUAL_UINT64(1, next - floor);
+        } else {
+            TEST_ASSERT_TRUE((next - floor) << MU_THUNK_STATS_SUB_BITS <=
+                             floor);
+        }
+        prev = b;
+    }
+    TEST_ASSERT_EQUAL_size_t(MU_THUNK_STATS_BUCKETS - 1,
+                             mu_thunk_stats_bucket(UINT64_MAX));
+}
+
+void test_mu_thunk_stats_counts_calls(void) {
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, nop_fn);
+    mu_thunk_stats_snapshot(&s_snap);
+    TEST_ASSERT_NULL(mu_thunk_stats_find(&s_snap, nop_fn));
+
+    for (int i = 0; i < 100; i++) {
+        _mu_thunk_call(&thunk, NULL);
+    }
+    mu_thunk_stats_call(&thunk, NULL);
+    mu_thunk_stats_snapshot(&s_snap);
+    const mu_thunk_stats_entry_t *e = mu_thunk_stats_find(&s_snap, nop_fn);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT64(101, e->count);
+    uint64_t in_buckets = 0;
+    for (size_t b = 0; b < MU_THUNK_STATS_BUCKETS; b++) {
+        in_buckets += e->buckets[b];
+    }
+    TEST_ASSERT_EQUAL_UINT64(101, in_buckets);
+    TEST_ASSERT_TRUE(e->max_ns >= e->total_ns / e->count);
+}
+
+void test_mu_thunk_stats_counts_compact_calls(void) {
+    mu_thunk_compact_t thunk;
+    mu_thunk_compact_id_t id = mu_thunk_compact_register(compact_fn);
+    TEST_ASSERT_TRUE(id != MU_THUNK_COMPACT_NONE);
+    _mu_thunk_compact_init(&thunk, id);
+    for (int i = 0; i < 6; i++) {
+        _mu_thunk_compact_call(&thunk, NULL);
+    }
+    // Recorded against the registered function, not the id.
+    mu_thunk_stats_snapshot(&s_snap);
+    const mu_thunk_stats_entry_t *e =
+        mu_thunk_stats_find(&s_snap, (mu_thunk_fn)compact_fn);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT64(6, e->count);
+}
+
+void test_mu_thunk_stats_latency_percentiles(void) {
+    mu_thunk_t thunk;
+    long delay_ns = 2000000; // 2 ms
+    mu_thunk_init(&thunk, sleep_fn);
+    for (int i = 0; i < 5; i++) {
+        _mu_thunk_call(&thunk, &delay_ns);
+    }
+    mu_thunk_stats_snapshot(&s_snap);
+    const mu_thunk_stats_entry_t *e = mu_thunk_stats_find(&s_snap, sleep_fn);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT64(5, e->count);
+    uint64_t p50 = mu_thunk_stats_percentile(e, 50);
+    TEST_ASSERT_TRUE(p50 >= (uint64_t)delay_ns);
+    TEST_ASSERT_TRUE(p50 <= e->max_ns);
+    TEST_ASSERT_EQUAL_UINT64(e->max_ns, mu_thunk_stats_percentile(e, 100));
+    TEST_ASSERT_TRUE(mu_thunk_stats_percentile(e, 0) >= (uint64_t)delay_ns);
+    TEST_ASSERT_EQUAL_UINT64(0, mu_thunk_stats_percentile(NULL, 50));
+}
+
+void test_mu_thunk_stats_merges_threads(void) {
+    pthread_t threads[N_THREADS];
+    for (int i = 0; i < N_THREADS; i++) {
+        pthread_create(&threads[i], NULL, caller_main, NULL);
+    }
+    for (int i = 0; i < N_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    // Tables of exited threads are still counted.
+    mu_thunk_stats_snapshot(&s_snap);
+    const mu_thunk_stats_entry_t *e =
+        mu_thunk_stats_find(&s_snap, threaded_fn);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT64(N_THREADS * PER_THREAD, e->count);
+}
+
+void test_mu_thunk_stats_recycles_tables(void) {
+    // One thread at a time: each adopts the table its predecessor left.
+    for (int i = 0; i < 4 * N_THREADS; i++) {
+        pthread_t thread;
+        pthread_create(&thread, NULL, recycled_main, NULL);
+        pthread_join(thread, NULL);
+    }
+    mu_thunk_stats_snapshot(&s_snap);
+    const mu_thunk_stats_entry_t *e =
+        mu_thunk_stats_find(&s_snap, recycled_fn);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT64(4 * N_THREADS * PER_THREAD, e->count);
+    // Earlier tests' counts are still there too.
+    e = mu_thunk_stats_find(&s_snap, threaded_fn);
+    TEST_ASSERT_EQUAL_UINT64(N_THREADS * PER_THREAD, e->count);
+}
+
+void test_mu_thunk_stats_merge_snapshots(void) {
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, merged_fn);
+    for (int i = 0; i < 10; i++) {
+        _mu_thunk_call(&thunk, NULL);
+    }
+    mu_thunk_stats_snapshot(&s_snap);
+    mu_thunk_stats_snapshot(&s_other);
+    size_t n = s_snap.n_entries;
+    mu_thunk_stats_merge(&s_snap, &s_other);
+    TEST_ASSERT_EQUAL_size_t(n, s_snap.n_entries);
+    const mu_thunk_stats_entry_t *e = mu_thunk_stats_find(&s_snap, merged_fn);
+    TEST_ASSERT_EQUAL_UINT64(20, e->count);
+
+    // Functions missing from dst are appended.
+    s_other.n_entries = 0;
+    s_other.dropped = 0;
+    mu_thunk_stats_merge(&s_other, &s_snap);
+    e = mu_thunk_stats_find(&s_other, merged_fn);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT64(20, e->count);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_stats_buckets);
+    RUN_TEST(test_mu_thunk_stats_counts_calls);
+    RUN_TEST(test_mu_thunk_stats_counts_compact_calls);
+    RUN_TEST(test_mu_thunk_stats_latency_percentiles);
+    RUN_TEST(test_mu_thunk_stats_merges_threads);
+    RUN_TEST(test_mu_thunk_stats_recycles_tables);
+    RUN_TEST(test_mu_thunk_stats_merge_snapshots);
+
+    return UNITY_END();
+}
@@ -0,0 +1,244 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk_ring.h"
+#include "mu_thunk_task.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define STACK_SIZE (64 * 1024)
+#define RING_CAPACITY 8
+
+typedef struct {
+    mu_thunk_task_t task; /**< Must be first member */
+    int limit;
+    int yielded;
+    intptr_t received;
+} counter_task_t;
+
+static char s_stack_a[STACK_SIZE] __attribute__((aligned(16)));
+static char s_stack_b[STACK_SIZE] __attribute__((aligned(16)));
+static counter_task_t s_a;
+static counter_task_t s_b;
+static mu_thunk_task_t *s_seen_current[4];
+
+/** Yield `limit` times, adding up the args of each resume. */
+static void counter_body(mu_thunk_t *thunk, void *args) {
+    counter_task_t *c = (counter_task_t *)thunk;
+    c->received += (intptr_t)args;
+    for (c->yielded = 0; c->yielded < c->limit;) {
+        c->yielded++;
+        c->received += (intptr_t)mu_thunk_task_yield();
+    }
+}
+
+/** Resume task b from inside task a. */
+static void outer_body(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    s_seen_current[0] = mu_thunk_task_current();
+    mu_thunk_task_resume(&s_b.task, NULL);
+    s_seen_current[1] = mu_thunk_task_current();
+    mu_thunk_task_yield();
+    s_seen_current[2] = mu_thunk_task_current();
+    (void)thunk;
+}
+
+static void inner_body(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    s_seen_current[3] = mu_thunk_task_current();
+    mu_thunk_task_yield();
+}
+
+/** Floating-point and integer state live across yields. */
+static void fp_body(mu_thunk_t *thunk, void *args) {
+    counter_task_t *c = (counter_task_t *)thunk;
+    (void)args;
+    double x = 1.0;
+    uint64_t h = 1469598103934665603ull;
+    for (int i = 0; i < 100; i++) {
+        x = x * 1.5 + 0.25;
+        h = (h ^ (uint64_t)i) * 1099511628211ull;
+        mu_thunk_task_yield();
+    }
+    c->received = (x > 1e17 && h != 0) ? 1 : 0;
+}
+
+static int recurse(int depth) {
+    volatile char pad[512];
+    pad[0] = (char)depth;
+    return depth == 0 ? pad[0] : recurse(depth - 1) + 1 + pad[0] * 0;
+}
+
+static void deep_body(mu_thunk_t *thunk, void *args) {
+    counter_task_t *c = (counter_task_t *)thunk;
+    (void)args;
+    c->received = recurse(64); // ~32 KiB of a 64 KiB stack
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    s_a = (counter_task_t){0};
+    s_b = (counter_task_t){0};
+    for (int i = 0; i < 4; i++) {
+        s_seen_current[i] = NULL;
+    }
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_task_param_validation(void) {
+    TEST_ASSERT_NULL(
+        mu_thunk_task_init(NULL, counter_body, s_stack_a, STACK_SIZE));
+    TEST_ASSERT_NULL(mu_thunk_task_init(&s_a.task, NULL, s_stack_a,
+                                        STACK_SIZE));
+    TEST_ASSERT_NULL(
+        mu_thunk_task_init(&s_a.task, counter_body, NULL, STACK_SIZE));
+    TEST_ASSERT_NULL(mu_thunk_task_init(&s_a.task, counter_body, s_stack_a,
+                                        MU_THUNK_TASK_MIN_STACK - 1));
+    TEST_ASSERT_NULL(mu_thunk_task_stack_alloc(0));
+    TEST_ASSERT_NULL(mu_thunk_task_yield()); // not in a task
+    TEST_ASSERT_NULL(mu_thunk_task_current());
+    TEST_ASSERT_TRUE(mu_thunk_task_is_done(NULL));
+    mu_thunk_task_resume(NULL, NULL);
+    mu_thunk_task_stack_free(NULL, STACK_SIZE);
+}
+
+void test_mu_thunk_task_yield_and_resume(void) {
+    s_a.limit = 3;
+    TEST_ASSERT_NOT_NULL(
+        mu_thunk_task_init(&s_a.task, counter_body, s_stack_a, STACK_SIZE));
+    TEST_ASSERT_EQUAL_INT(MU_THUNK_TASK_READY, mu_thunk_task_state(&s_a.task));
+    for (int i = 1; i <= 3; i++) {
+        // Resuming is just calling the thunk.
+        _mu_thunk_call(&s_a.task.thunk, (void *)(intptr_t)(10 * i));
+        TEST_ASSERT_EQUAL_INT(i, s_a.yielded);
+        TEST_ASSERT_EQUAL_INT(MU_THUNK_TASK_SUSPENDED,
+                              mu_thunk_task_state(&s_a.task));
+        TEST_ASSERT_NULL(mu_thunk_task_current());
+    }
+    mu_thunk_call(&s_a.task.thunk, (void *)(intptr_t)40);
+    TEST_ASSERT_TRUE(mu_thunk_task_is_done(&s_a.task));
+    TEST_ASSERT_EQUAL_INT(100, (int)s_a.received);
+    // Resuming a finished task does nothing.
+    mu_thunk_task_resume(&s_a.task, (void *)(intptr_t)1000);
+    TEST_ASSERT_EQUAL_INT(100, (int)s_a.received);
+}
+
+void test_mu_thunk_task_resumed_from_ring(void) {
+    mu_thunk_ring_t ring;
+    mu_thunk_t *store[RING_CAPACITY];
+    mu_thunk_ring_init(&ring, store, RING_CAPACITY);
+    s_a.limit = 2;
+    mu_thunk_task_init(&s_a.task, counter_body, s_stack_a, STACK_SIZE);
+    while (!mu_thunk_task_is_done(&s_a.task)) {
+        TEST_ASSERT_TRUE(mu_thunk_ring_put(&ring, &s_a.task.thunk));
+        mu_thunk_ring_drain(&ring, (void *)(intptr_t)5);
+    }
+    TEST_ASSERT_EQUAL_INT(2, s_a.yielded);
+    TEST_ASSERT_EQUAL_INT(15, (int)s_a.received);
+}
+
+void test_mu_thunk_task_nested(void) {
+    mu_thunk_task_init(&s_a.task, outer_body, s_stack_a, STACK_SIZE);
+    mu_thunk_task_init(&s_b.task, inner_body, s_stack_b, STACK_SIZE);
+    mu_thunk_task_resume(&s_a.task, NULL);
+    TEST_ASSERT_EQUAL_PTR(&s_a.task, s_seen_current[0]);
+    TEST_ASSERT_EQUAL_PTR(&s_b.task, s_seen_current[3]);
+    // b yielded back to a, not to the outermost caller.
+    TEST_ASSERT_EQUAL_PTR(&s_a.task, s_seen_current[1]);
+    TEST_ASSERT_EQUAL_INT(MU_THUNK_TASK_SUSPENDED,
+                          mu_thunk_task_state(&s_b.task));
+    TEST_ASSERT_NULL(mu_thunk_task_current());
+    mu_thunk_task_resume(&s_a.task, NULL);
+    TEST_ASSERT_EQUAL_PTR(&s_a.task, s_seen_current[2]);
+    TEST_ASSERT_TRUE(mu_thunk_task_is_done(&s_a.task));
+    // b can still be finished from here.
+    mu_thunk_task_resume(&s_b.task, NULL);
+    TEST_ASSERT_TRUE(mu_thunk_task_is_done(&s_b.task));
+}
+
+void test_mu_thunk_task_preserves_registers(void) {
+    // Live values on both sides of every switch, checked against the same
+    // computation without switches.
+    double y = 3.0, y_ref = 3.0;
+    uint64_t k = 0x0123456789abcdefull, k_ref = k;
+    int n = 0;
+    mu_thunk_task_init(&s_a.task, fp_body, s_stack_a, STACK_SIZE);
+    while (!mu_thunk_task_is_done(&s_a.task)) {
+        mu_thunk_task_resume(&s_a.task, NULL);
+        y = y * 1.25 - 0.5;
+        k = (k << 1) | (k >> 63);
+        n++;
+    }
+    for (int i = 0; i < n; i++) {
+        y_ref = y_ref * 1.25 - 0.5;
+        k_ref = (k_ref << 1) | (k_ref >> 63);
+    }
+    TEST_ASSERT_EQUAL_INT(101, n);
+    TEST_ASSERT_EQUAL_INT(1, (int)s_a.received);
+    TEST_ASSERT_TRUE(y == y_ref);
+    TEST_ASSERT_EQUAL_HEX64(k_ref, k);
+}
+
+void test_mu_thunk_task_guarded_stack(void) {
+    void *stack = mu_thunk_task_stack_alloc(STACK_SIZE);
+    TEST_ASSERT_NOT_NULL(stack);
+    TEST_ASSERT_NOT_NULL(
+        mu_thunk_task_init(&s_a.task, deep_body, stack, STACK_SIZE));
+    mu_thunk_task_resume(&s_a.task, NULL);
+    TEST_ASSERT_TRUE(mu_thunk_task_is_done(&s_a.task));
+    TEST_ASSERT_EQUAL_INT(64, (int)s_a.received);
+    mu_thunk_task_stack_free(stack, STACK_SIZE);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_task_param_validation);
+    RUN_TEST(test_mu_thunk_task_yield_and_resume);
+    RUN_TEST(test_mu_thunk_task_resumed_from_ring);
+    RUN_TEST(test_mu_thunk_task_nested);
+    RUN_TEST(test_mu_thunk_task_preserves_registers);
+    RUN_TEST(test_mu_thunk_task_guarded_stack);
+
+    return UNITY_END();
+}
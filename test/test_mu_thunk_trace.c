@@ -0,0 +1,193 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Trace _mu_thunk_call() in this file.
+#define MU_THUNK_TRACE
+#define _GNU_SOURCE // open_memstream, pthread_setname_np
+
+#include "mu_thunk.h"
+#include "mu_thunk_compact.h"
+#include "mu_thunk_trace.h"
+#include "unity.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+static char *s_json;
+static size_t s_json_len;
+
+// Not static, so dladdr() can name it (the test is linked -rdynamic).
+void traced_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+void traced_compact_fn(mu_thunk_compact_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+static void call_n(int n) {
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, traced_fn);
+    for (int i = 0; i < n; i++) {
+        _mu_thunk_call(&thunk, NULL);
+    }
+}
+
+static size_t flush(void) {
+    free(s_json);
+    FILE *out = open_memstream(&s_json, &s_json_len);
+    size_t n = mu_thunk_trace_flush(out);
+    fclose(out);
+    return n;
+}
+
+static size_t count(const char *needle) {
+    size_t n = 0;
+    for (const char *p = s_json; (p = strstr(p, needle)) != NULL; p++) {
+        n++;
+    }
+    return n;
+}
+
+static void *worker_main(void *arg) {
+    pthread_setname_np(pthread_self(), (const char *)arg);
+    call_n(3);
+    return NULL;
+}
+
+static void run_worker(const char *name) {
+    pthread_t thread;
+    pthread_create(&thread, NULL, worker_main, (void *)name);
+    pthread_join(thread, NULL);
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    mu_thunk_trace_set_sampling(1);
+    flush(); // start each test with empty rings
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_trace_sampling_setting(void) {
+    TEST_ASSERT_EQUAL_UINT(1, mu_thunk_trace_sampling());
+    mu_thunk_trace_set_sampling(8);
+    TEST_ASSERT_EQUAL_UINT(8, mu_thunk_trace_sampling());
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_trace_flush(NULL));
+}
+
+void test_mu_thunk_trace_records_and_names_calls(void) {
+    call_n(10);
+    TEST_ASSERT_EQUAL_size_t(10, flush());
+    TEST_ASSERT_NOT_NULL(strstr(s_json, "\"traceEvents\":["));
+    TEST_ASSERT_EQUAL_size_t(10, count("\"ph\":\"X\""));
+    TEST_ASSERT_EQUAL_size_t(10, count("\"name\":\"traced_fn\""));
+    TEST_ASSERT_TRUE(count("\"ph\":\"M\"") >= 1);
+    TEST_ASSERT_EQUAL_STRING("]}\n", s_json + s_json_len - 3);
+
+    // Flushed events are consumed.
+    TEST_ASSERT_EQUAL_size_t(0, flush());
+    TEST_ASSERT_EQUAL_size_t(0, count("\"ph\":\"X\""));
+}
+
+void test_mu_thunk_trace_records_compact_calls(void) {
+    mu_thunk_compact_t thunk;
+    _mu_thunk_compact_init(&thunk,
+                           mu_thunk_compact_register(traced_compact_fn));
+    _mu_thunk_compact_call(&thunk, NULL);
+    _mu_thunk_compact_call(&thunk, NULL);
+    TEST_ASSERT_EQUAL_size_t(2, flush());
+    TEST_ASSERT_EQUAL_size_t(2, count("\"name\":\"traced_compact_fn\""));
+}
+
+void test_mu_thunk_trace_samples_one_in_n(void) {
+    mu_thunk_trace_set_sampling(4);
+    call_n(100);
+    TEST_ASSERT_EQUAL_size_t(25, flush());
+
+    mu_thunk_trace_set_sampling(0);
+    call_n(100);
+    TEST_ASSERT_EQUAL_size_t(0, flush());
+}
+
+void test_mu_thunk_trace_ring_overwrites_oldest(void) {
+    size_t dropped = mu_thunk_trace_dropped();
+    call_n(MU_THUNK_TRACE_RING_SIZE + 100);
+    TEST_ASSERT_EQUAL_size_t(MU_THUNK_TRACE_RING_SIZE, flush());
+    TEST_ASSERT_EQUAL_size_t(dropped + 100, mu_thunk_trace_dropped());
+}
+
+void test_mu_thunk_trace_other_threads(void) {
+    run_worker("trace worker");
+    call_n(2);
+    TEST_ASSERT_EQUAL_size_t(5, flush());
+    TEST_ASSERT_NOT_NULL(strstr(s_json, "\"name\":\"trace worker\""));
+}
+
+void test_mu_thunk_trace_recycles_rings(void) {
+    // Exited threads' rings are not reused while they hold unflushed events.
+    run_worker("trace first");
+    run_worker("trace second");
+    TEST_ASSERT_EQUAL_size_t(6, flush());
+    TEST_ASSERT_NOT_NULL(strstr(s_json, "\"name\":\"trace first\""));
+    TEST_ASSERT_NOT_NULL(strstr(s_json, "\"name\":\"trace second\""));
+    size_t rings = count("\"ph\":\"M\"");
+
+    // Once flushed, the next thread adopts one instead of allocating.
+    run_worker("trace third");
+    TEST_ASSERT_EQUAL_size_t(3, flush());
+    TEST_ASSERT_EQUAL_size_t(rings, count("\"ph\":\"M\""));
+    TEST_ASSERT_NOT_NULL(strstr(s_json, "\"name\":\"trace third\""));
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_trace_sampling_setting);
+    RUN_TEST(test_mu_thunk_trace_records_and_names_calls);
+    RUN_TEST(test_mu_thunk_trace_records_compact_calls);
+    RUN_TEST(test_mu_thunk_trace_samples_one_in_n);
+    RUN_TEST(test_mu_thunk_trace_ring_overwrites_oldest);
+    RUN_TEST(test_mu_thunk_trace_other_threads);
+    RUN_TEST(test_mu_thunk_trace_recycles_rings);
+
+    free(s_json);
+    return UNITY_END();
+}
@@ -0,0 +1,282 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mu_thunk_uring.h"
+#include "unity.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define ENTRIES 8
+
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first member */
+    int call_count;
+    int last_res;
+    int chain; /**< chain_fn queues this many follow-up NOPs */
+} completion_thunk_t;
+
+static mu_thunk_uring_t s_uring;
+static unsigned s_init_flags;
+static char s_path[] = "/tmp/test_mu_thunk_uring_XXXXXX";
+static int s_file_fd;
+
+static void completion_fn(mu_thunk_t *thunk, void *args) {
+    completion_thunk_t *ct = (completion_thunk_t *)thunk;
+    struct io_uring_cqe *cqe = (struct io_uring_cqe *)args;
+    TEST_ASSERT_EQUAL_PTR(thunk, (mu_thunk_t *)(uintptr_t)cqe->user_data);
+    ct->call_count++;
+    ct->last_res = cqe->res;
+}
+
+static void chain_fn(mu_thunk_t *thunk, void *args) {
+    completion_thunk_t *ct = (completion_thunk_t *)thunk;
+    completion_fn(thunk, args);
+    if (ct->chain-- > 0) {
+        TEST_ASSERT_NOT_NULL(mu_thunk_uring_prep_nop(&s_uring, thunk));
+    }
+}
+
+static void completion_init(completion_thunk_t *ct, mu_thunk_fn fn) {
+    mu_thunk_init(&ct->thunk, fn);
+    ct->call_count = 0;
+    ct->last_res = 0;
+    ct->chain = 0;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_uring_init(&s_uring, ENTRIES, s_init_flags));
+    strcpy(s_path + strlen(s_path) - 6, "XXXXXX");
+    s_file_fd = mkstemp(s_path);
+    TEST_ASSERT_TRUE(s_file_fd >= 0);
+    TEST_ASSERT_EQUAL_INT(11, write(s_file_fd, "hello world", 11));
+}
+
+void tearDown(void) {
+    close(s_file_fd);
+    unlink(s_path);
+    mu_thunk_uring_deinit(&s_uring);
+}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_uring_param_validation(void) {
+    mu_thunk_uring_t uring;
+    mu_thunk_t thunk;
+    mu_thunk_init(&thunk, completion_fn);
+    TEST_ASSERT_NULL(mu_thunk_uring_init(NULL, ENTRIES, 0));
+    TEST_ASSERT_NULL(mu_thunk_uring_init(&uring, 0, 0));
+    TEST_ASSERT_NULL(
+        mu_thunk_uring_init(&uring, MU_THUNK_URING_MAX_ENTRIES + 1, 0));
+    TEST_ASSERT_NULL(mu_thunk_uring_get_sqe(NULL, &thunk));
+    TEST_ASSERT_NULL(mu_thunk_uring_get_sqe(&s_uring, NULL));
+    TEST_ASSERT_FALSE(mu_thunk_uring_register_buffers(&s_uring, NULL, 1));
+    TEST_ASSERT_FALSE(mu_thunk_uring_register_files(&s_uring, NULL, 1));
+    TEST_ASSERT_EQUAL_INT(-1, mu_thunk_uring_submit(NULL));
+    TEST_ASSERT_EQUAL_INT(-1, mu_thunk_uring_run_once(NULL, 0));
+    TEST_ASSERT_FALSE(mu_thunk_uring_is_native(NULL));
+    if (s_init_flags & MU_THUNK_URING_FALLBACK) {
+        TEST_ASSERT_FALSE(mu_thunk_uring_is_native(&s_uring));
+    }
+}
+
+void test_mu_thunk_uring_nop_batch(void) {
+    completion_thunk_t ct[3];
+    for (int i = 0; i < 3; i++) {
+        completion_init(&ct[i], completion_fn);
+        TEST_ASSERT_NOT_NULL(mu_thunk_uring_prep_nop(&s_uring, &ct[i].thunk));
+    }
+    int dispatched = 0;
+    while (dispatched < 3) {
+        int n = mu_thunk_uring_run_once(&s_uring, 3 - dispatched);
+        TEST_ASSERT_TRUE(n >= 0);
+        dispatched += n;
+    }
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, ct[i].call_count);
+        TEST_ASSERT_EQUAL_INT(0, ct[i].last_res);
+    }
+}
+
+void test_mu_thunk_uring_read_file(void) {
+    completion_thunk_t ct;
+    char buf[8] = {0};
+    completion_init(&ct, completion_fn);
+    TEST_ASSERT_NOT_NULL(
+        mu_thunk_uring_prep_read(&s_uring, s_file_fd, buf, 5, 6, &ct.thunk));
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_run_once(&s_uring, 1));
+    TEST_ASSERT_EQUAL_INT(5, ct.last_res);
+    TEST_ASSERT_EQUAL_STRING("world", buf);
+}
+
+void test_mu_thunk_uring_write_then_read_errors(void) {
+    completion_thunk_t ct;
+    char buf[4];
+    completion_init(&ct, completion_fn);
+    mu_thunk_uring_prep_read(&s_uring, -1, buf, sizeof(buf), 0, &ct.thunk);
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_run_once(&s_uring, 1));
+    TEST_ASSERT_EQUAL_INT(-EBADF, ct.last_res);
+
+    mu_thunk_uring_prep_write(&s_uring, s_file_fd, "HELLO", 5, 0, &ct.thunk);
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_run_once(&s_uring, 1));
+    TEST_ASSERT_EQUAL_INT(5, ct.last_res);
+    TEST_ASSERT_EQUAL_INT(4, pread(s_file_fd, buf, 4, 0));
+    TEST_ASSERT_EQUAL_MEMORY("HELL", buf, 4);
+}
+
+void test_mu_thunk_uring_registered_buffers_and_files(void) {
+    static char fixed[64];
+    struct iovec iov = {.iov_base = fixed, .iov_len = sizeof(fixed)};
+    int files[1] = {s_file_fd};
+    completion_thunk_t ct;
+    completion_init(&ct, completion_fn);
+
+    TEST_ASSERT_TRUE(mu_thunk_uring_register_buffers(&s_uring, &iov, 1));
+    TEST_ASSERT_TRUE(mu_thunk_uring_register_files(&s_uring, files, 1));
+
+    struct io_uring_sqe *sqe = mu_thunk_uring_prep_read_fixed(
+        &s_uring, 0, fixed + 8, 5, 0, 0, &ct.thunk);
+    TEST_ASSERT_NOT_NULL(sqe);
+    sqe->flags |= IOSQE_FIXED_FILE;
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_run_once(&s_uring, 1));
+    TEST_ASSERT_EQUAL_INT(5, ct.last_res);
+    TEST_ASSERT_EQUAL_MEMORY("hello", fixed + 8, 5);
+}
+
+void test_mu_thunk_uring_recv_waits_for_data(void) {
+    int sv[2];
+    char buf[8] = {0};
+    completion_thunk_t ct;
+    completion_init(&ct, completion_fn);
+    TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+
+    mu_thunk_uring_prep_recv(&s_uring, sv[0], buf, sizeof(buf), 0, &ct.thunk);
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_submit(&s_uring));
+    TEST_ASSERT_EQUAL_INT(0, mu_thunk_uring_run_once(&s_uring, 0));
+    TEST_ASSERT_EQUAL_INT(0, ct.call_count);
+
+    TEST_ASSERT_EQUAL_INT(3, send(sv[1], "abc", 3, 0));
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_run_once(&s_uring, 1));
+    TEST_ASSERT_EQUAL_INT(3, ct.last_res);
+    TEST_ASSERT_EQUAL_STRING("abc", buf);
+
+    completion_init(&ct, completion_fn);
+    mu_thunk_uring_prep_send(&s_uring, sv[0], "xyz", 3, 0, &ct.thunk);
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_run_once(&s_uring, 1));
+    TEST_ASSERT_EQUAL_INT(3, ct.last_res);
+    TEST_ASSERT_EQUAL_INT(3, recv(sv[1], buf, sizeof(buf), 0));
+    close(sv[0]);
+    close(sv[1]);
+}
+
+void test_mu_thunk_uring_read_blocking_pipe(void) {
+    int pfd[2];
+    char buf[8] = {0};
+    completion_thunk_t ct;
+    completion_init(&ct, completion_fn);
+    // A pipe without O_NONBLOCK must not stall the fallback's first attempt.
+    TEST_ASSERT_EQUAL_INT(0, pipe(pfd));
+
+    mu_thunk_uring_prep_read(&s_uring, pfd[0], buf, sizeof(buf),
+                             MU_THUNK_URING_CUR_POS, &ct.thunk);
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_submit(&s_uring));
+    TEST_ASSERT_EQUAL_INT(0, mu_thunk_uring_run_once(&s_uring, 0));
+    TEST_ASSERT_EQUAL_INT(0, ct.call_count);
+    TEST_ASSERT_EQUAL_INT(0, fcntl(pfd[0], F_GETFL) & O_NONBLOCK);
+
+    TEST_ASSERT_EQUAL_INT(3, write(pfd[1], "abc", 3));
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_run_once(&s_uring, 1));
+    TEST_ASSERT_EQUAL_INT(3, ct.last_res);
+    TEST_ASSERT_EQUAL_STRING("abc", buf);
+    close(pfd[0]);
+    close(pfd[1]);
+}
+
+void test_mu_thunk_uring_queue_full(void) {
+    completion_thunk_t ct;
+    completion_init(&ct, completion_fn);
+    int n = 0;
+    while (mu_thunk_uring_prep_nop(&s_uring, &ct.thunk) != NULL) {
+        n++;
+        TEST_ASSERT_TRUE(n <= MU_THUNK_URING_MAX_ENTRIES);
+    }
+    TEST_ASSERT_TRUE(n >= ENTRIES);
+    int dispatched = 0;
+    while (dispatched < n) {
+        dispatched += mu_thunk_uring_run_once(&s_uring, 1);
+    }
+    TEST_ASSERT_EQUAL_INT(n, ct.call_count);
+    TEST_ASSERT_NOT_NULL(mu_thunk_uring_prep_nop(&s_uring, &ct.thunk));
+    TEST_ASSERT_EQUAL_INT(1, mu_thunk_uring_run_once(&s_uring, 1));
+}
+
+void test_mu_thunk_uring_queue_from_completion(void) {
+    completion_thunk_t ct;
+    completion_init(&ct, chain_fn);
+    ct.chain = 3;
+    mu_thunk_uring_prep_nop(&s_uring, &ct.thunk);
+    while (ct.call_count < 4) {
+        TEST_ASSERT_TRUE(mu_thunk_uring_run_once(&s_uring, 1) >= 0);
+    }
+    TEST_ASSERT_EQUAL_INT(4, ct.call_count);
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+static void run_suite(void) {
+    RUN_TEST(test_mu_thunk_uring_param_validation);
+    RUN_TEST(test_mu_thunk_uring_nop_batch);
+    RUN_TEST(test_mu_thunk_uring_read_file);
+    RUN_TEST(test_mu_thunk_uring_write_then_read_errors);
+    RUN_TEST(test_mu_thunk_uring_registered_buffers_and_files);
+    RUN_TEST(test_mu_thunk_uring_recv_waits_for_data);
+    RUN_TEST(test_mu_thunk_uring_read_blocking_pipe);
+    RUN_TEST(test_mu_thunk_uring_queue_full);
+    RUN_TEST(test_mu_thunk_uring_queue_from_completion);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Native io_uring if the kernel allows it, then the epoll fallback.
+    s_init_flags = 0;
+    run_suite();
+    s_init_flags = MU_THUNK_URING_FALLBACK;
+    run_suite();
+
+    return UNITY_END();
+}
@@ -0,0 +1,267 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mu_thunk_wheel.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_RANDOM 2000
+#define MAX_FIRES 8
+
+typedef struct {
+    mu_thunk_timer_t timer; /**< Must be first member */
+    int n_fired;
+    uint64_t fired_at[MAX_FIRES];
+    mu_thunk_timer_t *victim; /**< Cancelled by cancel_fn, if set */
+    int cancel_after;         /**< cancel_self_fn cancels on this firing */
+} test_timer_t;
+
+static mu_thunk_wheel_t s_wheel;
+
+static void record_fn(mu_thunk_t *thunk, void *args) {
+    test_timer_t *tt = (test_timer_t *)thunk;
+    mu_thunk_wheel_t *wheel = (mu_thunk_wheel_t *)args;
+    if (tt->n_fired < MAX_FIRES) {
+        tt->fired_at[tt->n_fired] = mu_thunk_wheel_now(wheel);
+    }
+    tt->n_fired++;
+}
+
+static void cancel_fn(mu_thunk_t *thunk, void *args) {
+    test_timer_t *tt = (test_timer_t *)thunk;
+    record_fn(thunk, args);
+    mu_thunk_wheel_cancel((mu_thunk_wheel_t *)args, tt->victim);
+}
+
+static void cancel_self_fn(mu_thunk_t *thunk, void *args) {
+    test_timer_t *tt = (test_timer_t *)thunk;
+    record_fn(thunk, args);
+    if (tt->n_fired == tt->cancel_after) {
+        mu_thunk_wheel_cancel((mu_thunk_wheel_t *)args, &tt->timer);
+    }
+}
+
+static void reschedule_fn(mu_thunk_t *thunk, void *args) {
+    test_timer_t *tt = (test_timer_t *)thunk;
+    record_fn(thunk, args);
+    if (tt->n_fired < 3) {
+        // Delay 0 must land on the next tick, not the one being processed.
+        mu_thunk_wheel_schedule((mu_thunk_wheel_t *)args, &tt->timer, 0, 0);
+    }
+}
+
+static void test_timer_init(test_timer_t *tt, mu_thunk_fn fn) {
+    TEST_ASSERT_NOT_NULL(mu_thunk_timer_init(&tt->timer, fn));
+    tt->n_fired = 0;
+    tt->victim = NULL;
+    tt->cancel_after = 0;
+}
+
+// *****************************************************************************
+// Unity boilerplate
+
+void setUp(void) { TEST_ASSERT_NOT_NULL(mu_thunk_wheel_init(&s_wheel, 0)); }
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Tests
+// *****************************************************************************
+
+void test_mu_thunk_wheel_param_validation(void) {
+    mu_thunk_timer_t timer;
+    TEST_ASSERT_NULL(mu_thunk_wheel_init(NULL, 0));
+    TEST_ASSERT_NULL(mu_thunk_timer_init(NULL, record_fn));
+    TEST_ASSERT_NULL(mu_thunk_timer_init(&timer, NULL));
+    mu_thunk_timer_init(&timer, record_fn);
+    TEST_ASSERT_FALSE(mu_thunk_timer_is_pending(&timer));
+    TEST_ASSERT_FALSE(mu_thunk_timer_is_pending(NULL));
+    TEST_ASSERT_NULL(mu_thunk_wheel_schedule(NULL, &timer, 1, 0));
+    TEST_ASSERT_NULL(mu_thunk_wheel_schedule(&s_wheel, NULL, 1, 0));
+    TEST_ASSERT_FALSE(mu_thunk_wheel_cancel(NULL, &timer));
+    TEST_ASSERT_FALSE(mu_thunk_wheel_cancel(&s_wheel, &timer));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_wheel_advance(NULL, 10));
+    TEST_ASSERT_EQUAL_UINT64(0, mu_thunk_wheel_now(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_wheel_count(NULL));
+}
+
+void test_mu_thunk_wheel_fires_on_time(void) {
+    test_timer_t tt;
+    test_timer_init(&tt, record_fn);
+    mu_thunk_wheel_schedule(&s_wheel, &tt.timer, 10, 0);
+    TEST_ASSERT_TRUE(mu_thunk_timer_is_pending(&tt.timer));
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_wheel_count(&s_wheel));
+
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_wheel_advance(&s_wheel, 9));
+    TEST_ASSERT_EQUAL_INT(0, tt.n_fired);
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_wheel_advance(&s_wheel, 10));
+    TEST_ASSERT_EQUAL_INT(1, tt.n_fired);
+    TEST_ASSERT_EQUAL_UINT64(10, tt.fired_at[0]);
+    TEST_ASSERT_FALSE(mu_thunk_timer_is_pending(&tt.timer));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_wheel_count(&s_wheel));
+}
+
+void test_mu_thunk_wheel_cancel(void) {
+    test_timer_t tt;
+    test_timer_init(&tt, record_fn);
+    mu_thunk_wheel_schedule(&s_wheel, &tt.timer, 5000, 0);
+    TEST_ASSERT_TRUE(mu_thunk_wheel_cancel(&s_wheel, &tt.timer));
+    TEST_ASSERT_FALSE(mu_thunk_wheel_cancel(&s_wheel, &tt.timer));
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_wheel_count(&s_wheel));
+    mu_thunk_wheel_advance(&s_wheel, 10000);
+    TEST_ASSERT_EQUAL_INT(0, tt.n_fired);
+}
+
+void test_mu_thunk_wheel_reschedule_pending(void) {
+    test_timer_t tt;
+    test_timer_init(&tt, record_fn);
+    mu_thunk_wheel_schedule(&s_wheel, &tt.timer, 100, 0);
+    mu_thunk_wheel_schedule(&s_wheel, &tt.timer, 300, 0);
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_wheel_count(&s_wheel));
+    mu_thunk_wheel_advance(&s_wheel, 1000);
+    TEST_ASSERT_EQUAL_INT(1, tt.n_fired);
+    TEST_ASSERT_EQUAL_UINT64(300, tt.fired_at[0]);
+}
+
+void test_mu_thunk_wheel_periodic(void) {
+    test_timer_t tt;
+    test_timer_init(&tt, cancel_self_fn);
+    tt.cancel_after = 4;
+    mu_thunk_wheel_schedule(&s_wheel, &tt.timer, 50, 100);
+    mu_thunk_wheel_advance(&s_wheel, 100000);
+    TEST_ASSERT_EQUAL_INT(4, tt.n_fired);
+    TEST_ASSERT_EQUAL_UINT64(50, tt.fired_at[0]);
+    TEST_ASSERT_EQUAL_UINT64(150, tt.fired_at[1]);
+    TEST_ASSERT_EQUAL_UINT64(250, tt.fired_at[2]);
+    TEST_ASSERT_EQUAL_UINT64(350, tt.fired_at[3]);
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_wheel_count(&s_wheel));
+}
+
+void test_mu_thunk_wheel_zero_delay_from_callback(void) {
+    test_timer_t tt;
+    test_timer_init(&tt, reschedule_fn);
+    mu_thunk_wheel_schedule(&s_wheel, &tt.timer, 0, 0);
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_wheel_advance(&s_wheel, 1));
+    TEST_ASSERT_EQUAL_size_t(2, mu_thunk_wheel_advance(&s_wheel, 3));
+    TEST_ASSERT_EQUAL_INT(3, tt.n_fired);
+    TEST_ASSERT_EQUAL_UINT64(1, tt.fired_at[0]);
+    TEST_ASSERT_EQUAL_UINT64(2, tt.fired_at[1]);
+    TEST_ASSERT_EQUAL_UINT64(3, tt.fired_at[2]);
+}
+
+void test_mu_thunk_wheel_cancel_from_callback(void) {
+    test_timer_t a;
+    test_timer_t b;
+    test_timer_init(&a, cancel_fn);
+    test_timer_init(&b, record_fn);
+    a.victim = &b.timer;
+    // Same tick: a runs first and cancels b before it is called.
+    mu_thunk_wheel_schedule(&s_wheel, &a.timer, 7, 0);
+    mu_thunk_wheel_schedule(&s_wheel, &b.timer, 7, 0);
+    TEST_ASSERT_EQUAL_size_t(1, mu_thunk_wheel_advance(&s_wheel, 7));
+    TEST_ASSERT_EQUAL_INT(1, a.n_fired);
+    TEST_ASSERT_EQUAL_INT(0, b.n_fired);
+    TEST_ASSERT_EQUAL_size_t(0, mu_thunk_wheel_count(&s_wheel));
+}
+
+void test_mu_thunk_wheel_beyond_range(void) {
+    // Longer than the wheel can place exactly; must still fire on time.
+    uint64_t range =
+        (uint64_t)1 << (MU_THUNK_WHEEL_BITS * MU_THUNK_WHEEL_LEVELS);
+    test_timer_t tt;
+    test_timer_init(&tt, record_fn);
+    mu_thunk_wheel_init(&s_wheel, range - 3);
+    mu_thunk_wheel_schedule(&s_wheel, &tt.timer, range + 5, 0);
+    mu_thunk_wheel_advance(&s_wheel, 2 * range + 1);
+    TEST_ASSERT_EQUAL_INT(0, tt.n_fired);
+    mu_thunk_wheel_advance(&s_wheel, 2 * range + 2);
+    TEST_ASSERT_EQUAL_INT(1, tt.n_fired);
+    TEST_ASSERT_EQUAL_UINT64(2 * range + 2, tt.fired_at[0]);
+}
+
+// Skipping idle ticks must not jump over a cascade that is due on the very
+// next tick just because the innermost level has a later entry.
+void test_mu_thunk_wheel_skip_keeps_cascade(void) {
+    test_timer_t a;
+    test_timer_t b;
+    test_timer_init(&a, record_fn);
+    test_timer_init(&b, record_fn);
+    mu_thunk_wheel_schedule(&s_wheel, &b.timer, 100, 0); // level 1
+    mu_thunk_wheel_advance(&s_wheel, MU_THUNK_WHEEL_SLOTS - 1);
+    mu_thunk_wheel_schedule(&s_wheel, &a.timer, 10, 0); // level 0
+    mu_thunk_wheel_advance(&s_wheel, 1000);
+    TEST_ASSERT_EQUAL_UINT64(MU_THUNK_WHEEL_SLOTS - 1 + 10, a.fired_at[0]);
+    TEST_ASSERT_EQUAL_UINT64(100, b.fired_at[0]);
+}
+
+// Random delays spanning several levels, including cascades: every timer
+// fires exactly once, on its tick.
+void test_mu_thunk_wheel_random(void) {
+    static test_timer_t timers[N_RANDOM];
+    static uint64_t expected[N_RANDOM];
+    srand(1234);
+    mu_thunk_wheel_init(&s_wheel, 12345);
+    for (int i = 0; i < N_RANDOM; i++) {
+        uint64_t delay = 1 + (uint64_t)rand() % (1u << (i % 20 + 1));
+        test_timer_init(&timers[i], record_fn);
+        mu_thunk_wheel_schedule(&s_wheel, &timers[i].timer, delay, 0);
+        expected[i] = 12345 + delay;
+    }
+    // Advance in uneven steps.
+    uint64_t now = 12345;
+    while (mu_thunk_wheel_count(&s_wheel) > 0) {
+        now += 1 + (uint64_t)rand() % 5000;
+        mu_thunk_wheel_advance(&s_wheel, now);
+    }
+    for (int i = 0; i < N_RANDOM; i++) {
+        TEST_ASSERT_EQUAL_INT(1, timers[i].n_fired);
+        TEST_ASSERT_EQUAL_UINT64(expected[i], timers[i].fired_at[0]);
+    }
+}
+
+// *****************************************************************************
+// Test driver
+// *****************************************************************************
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mu_thunk_wheel_param_validation);
+    RUN_TEST(test_mu_thunk_wheel_fires_on_time);
+    RUN_TEST(test_mu_thunk_wheel_cancel);
+    RUN_TEST(test_mu_thunk_wheel_reschedule_pending);
+    RUN_TEST(test_mu_thunk_wheel_periodic);
+    RUN_TEST(test_mu_thunk_wheel_zero_delay_from_callback);
+    RUN_TEST(test_mu_thunk_wheel_cancel_from_callback);
+    RUN_TEST(test_mu_thunk_wheel_beyond_range);
+    RUN_TEST(test_mu_thunk_wheel_skip_keeps_cascade);
+    RUN_TEST(test_mu_thunk_wheel_random);
+
+    return UNITY_END();
+}